@@ -0,0 +1,93 @@
+#!/bin/bash
+
+# Release build variants of the raylib robot face: baseline, LTO, LTO + PGO
+#
+# Builds raylib/ three times, trains the PGO build on the scripted scenario
+# (--scenario, no keyboard or mouse needed), then reports binary size and frame
+# time for every variant and executable.
+#
+# Usage: ./build-pgo.sh [scenario frames]   (default 3600 = one minute of face time)
+#
+# Linux without a display: runs the scenario under xvfb-run on Mesa llvmpipe.
+
+set -e
+
+# Colors
+GREEN='\033[0;32m'
+YELLOW='\033[1;33m'
+RED='\033[0;31m'
+NC='\033[0m'
+
+FRAMES=${1:-3600}
+ROOT="$(pwd)/build-pgo"
+PROFILE_DIR="${ROOT}/profile"
+TARGETS="robot_face_raylib robot_face_c robot_face_cpp"
+CMAKE_OPTIONS="-DCMAKE_BUILD_TYPE=Release -DBUILD_TOOLS=OFF -DROBOT_FACE_ALLOC_CHECK=OFF"
+JOBS=$(getconf _NPROCESSORS_ONLN 2>/dev/null || echo 4)
+
+echo "======================================="
+echo "Robot Face - LTO / PGO Release Builds"
+echo "======================================="
+
+build_variant() {
+    local name=$1
+    shift
+    echo -e "${YELLOW}Building ${name}...${NC}"
+    cmake -S raylib -B "${ROOT}/${name}" ${CMAKE_OPTIONS} "$@" > /dev/null
+    cmake --build "${ROOT}/${name}" -j"${JOBS}" > /dev/null
+}
+
+# Prints "<ms per frame>" for one scenario run
+run_scenario() {
+    local binary=$1
+    local output
+    if [ "$(uname)" = "Linux" ] && [ -z "${DISPLAY}" ] && command -v xvfb-run > /dev/null; then
+        output=$(LIBGL_ALWAYS_SOFTWARE=1 xvfb-run -a "${binary}" --scenario "${FRAMES}" 2> /dev/null)
+    else
+        output=$("${binary}" --scenario "${FRAMES}" 2> /dev/null)
+    fi
+    echo "${output}" | sed -n 's/.*frames, \([0-9.]*\) ms\/frame.*/\1/p' | tail -n 1
+}
+
+# Baseline and LTO (face core compiled once as a static library in both)
+build_variant baseline
+build_variant lto -DROBOT_FACE_LTO=ON
+
+# PGO: instrument, train, rebuild in the same directory with the profile
+rm -rf "${PROFILE_DIR}"
+build_variant lto-pgo -DROBOT_FACE_LTO=ON -DROBOT_FACE_PGO=GENERATE -DROBOT_FACE_PGO_DIR="${PROFILE_DIR}"
+
+echo -e "${YELLOW}Training on ${FRAMES} scenario frames...${NC}"
+for target in ${TARGETS}; do
+    if [ -z "$(run_scenario "${ROOT}/lto-pgo/${target}")" ]; then
+        echo -e "${RED}✗ Training run of ${target} failed${NC}"
+        exit 1
+    fi
+done
+
+# Clang writes raw profiles that need merging; GCC reads its .gcda files directly
+if ls "${PROFILE_DIR}"/*.profraw > /dev/null 2>&1; then
+    llvm-profdata merge -o "${PROFILE_DIR}/default.profdata" "${PROFILE_DIR}"/*.profraw
+fi
+
+build_variant lto-pgo -DROBOT_FACE_PGO=USE
+
+# Report
+echo ""
+printf "%-20s %-10s %12s %12s %12s\n" "Executable" "Variant" "Size (B)" "Stripped (B)" "ms/frame"
+for target in ${TARGETS}; do
+    for variant in baseline lto lto-pgo; do
+        binary="${ROOT}/${variant}/${target}"
+        if [ ! -f "${binary}" ]; then
+            echo -e "${RED}✗ Missing ${binary}${NC}"
+            exit 1
+        fi
+        size=$(wc -c < "${binary}" | tr -d ' ')
+        strip -o "${binary}.stripped" "${binary}" 2> /dev/null || cp "${binary}" "${binary}.stripped"
+        stripped=$(wc -c < "${binary}.stripped" | tr -d ' ')
+        printf "%-20s %-10s %12s %12s %12s\n" "${target}" "${variant}" "${size}" "${stripped}" "$(run_scenario "${binary}")"
+    done
+done
+
+echo ""
+echo -e "${GREEN}✓ Variants in ${ROOT}/{baseline,lto,lto-pgo}${NC}"
@@ -0,0 +1,174 @@
+#ifndef ROBOT_FACE_ALLOC_COUNTER_HPP
+#define ROBOT_FACE_ALLOC_COUNTER_HPP
+
+/**
+ * Heap allocation accounting for zero-heap render loop checks
+ *
+ * Exactly one translation unit of a program defines
+ * ROBOT_FACE_ALLOC_COUNTER_IMPLEMENTATION before including this header.
+ * That unit replaces the global operator new/delete and, on glibc, malloc,
+ * calloc, realloc and free, so allocations made by C code (raylib, the C
+ * face, Skia internals) are counted too. Elsewhere only operator new is seen.
+ *
+ * Usage per frame:
+ *   uint64_t before = robotface::alloc::allocationCount();
+ *   ... update + draw ...
+ *   uint64_t frameAllocations = robotface::alloc::allocationCount() - before;
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace robotface {
+namespace alloc {
+
+// Totals since program start (relaxed atomics, all threads)
+uint64_t allocationCount() noexcept;
+uint64_t allocatedBytes() noexcept;
+
+// Peak resident set size of the process in KiB (0 if unavailable)
+size_t peakRssKb() noexcept;
+
+// Current resident set size in KiB (Linux /proc, macOS task info; 0 if unavailable)
+size_t currentRssKb() noexcept;
+
+} // namespace alloc
+} // namespace robotface
+
+#ifdef ROBOT_FACE_ALLOC_COUNTER_IMPLEMENTATION
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <sys/resource.h>
+#include <unistd.h>
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#endif
+
+#if defined(__GLIBC__)
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* __libc_calloc(size_t count, size_t size);
+extern "C" void* __libc_realloc(void* ptr, size_t size);
+extern "C" void __libc_free(void* ptr);
+#define ROBOT_FACE_RAW_MALLOC __libc_malloc
+#define ROBOT_FACE_RAW_FREE __libc_free
+#else
+#define ROBOT_FACE_RAW_MALLOC std::malloc
+#define ROBOT_FACE_RAW_FREE std::free
+#endif
+
+namespace robotface {
+namespace alloc {
+
+namespace {
+
+std::atomic<uint64_t> g_allocations{0};
+std::atomic<uint64_t> g_bytes{0};
+
+inline void record(size_t size) noexcept {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+inline void* countedMalloc(size_t size) noexcept {
+    record(size);
+    return ROBOT_FACE_RAW_MALLOC(size ? size : 1);
+}
+
+} // namespace
+
+uint64_t allocationCount() noexcept {
+    return g_allocations.load(std::memory_order_relaxed);
+}
+
+uint64_t allocatedBytes() noexcept {
+    return g_bytes.load(std::memory_order_relaxed);
+}
+
+size_t peakRssKb() noexcept {
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#if defined(__APPLE__)
+    return static_cast<size_t>(usage.ru_maxrss) / 1024;   // Bytes on macOS
+#else
+    return static_cast<size_t>(usage.ru_maxrss);          // KiB on Linux
+#endif
+}
+
+size_t currentRssKb() noexcept {
+#if defined(__APPLE__)
+    mach_task_basic_info info{};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) !=
+        KERN_SUCCESS) {
+        return 0;
+    }
+    return static_cast<size_t>(info.resident_size) / 1024;
+#else
+    FILE* statm = std::fopen("/proc/self/statm", "r");   // Pages: size resident ...
+    if (!statm) return 0;
+    unsigned long size = 0;
+    unsigned long resident = 0;
+    const bool ok = std::fscanf(statm, "%lu %lu", &size, &resident) == 2;
+    std::fclose(statm);
+    return ok ? static_cast<size_t>(resident) * static_cast<size_t>(sysconf(_SC_PAGESIZE)) / 1024 : 0;
+#endif
+}
+
+} // namespace alloc
+} // namespace robotface
+
+// C allocator (glibc exports the __libc_* entry points used underneath)
+#if defined(__GLIBC__)
+extern "C" void* malloc(size_t size) {
+    return robotface::alloc::countedMalloc(size);
+}
+
+extern "C" void* calloc(size_t count, size_t size) {
+    robotface::alloc::record(count * size);
+    return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* ptr, size_t size) {
+    robotface::alloc::record(size);
+    return __libc_realloc(ptr, size);
+}
+
+extern "C" void free(void* ptr) {
+    __libc_free(ptr);
+}
+#endif
+
+// C++ allocator
+void* operator new(size_t size) {
+    void* ptr = robotface::alloc::countedMalloc(size);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](size_t size) {
+    void* ptr = robotface::alloc::countedMalloc(size);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    return robotface::alloc::countedMalloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return robotface::alloc::countedMalloc(size);
+}
+
+void operator delete(void* ptr) noexcept { ROBOT_FACE_RAW_FREE(ptr); }
+void operator delete[](void* ptr) noexcept { ROBOT_FACE_RAW_FREE(ptr); }
+void operator delete(void* ptr, size_t) noexcept { ROBOT_FACE_RAW_FREE(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { ROBOT_FACE_RAW_FREE(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { ROBOT_FACE_RAW_FREE(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { ROBOT_FACE_RAW_FREE(ptr); }
+
+#endif // ROBOT_FACE_ALLOC_COUNTER_IMPLEMENTATION
+
+#endif // ROBOT_FACE_ALLOC_COUNTER_HPP
@@ -0,0 +1,297 @@
+#ifndef ROBOT_FACE_ASSET_PACK_HPP
+#define ROBOT_FACE_ASSET_PACK_HPP
+
+/**
+ * Read-only asset pack: the baked assets of the face in one memory-mapped file
+ *
+ * Fonts, atlases and sprite sheets are baked at build time and packed into one
+ * file (robot_face_pack). At startup a process maps it and hands out views into
+ * the mapping: SdfFont and RfsOpen parse in place and textures upload straight
+ * from it, so nothing is read into the heap. Every face process on the box maps
+ * the same page cache pages: the pack is resident once, however many faces run.
+ *
+ * Layout (little-endian):
+ * - AssetPackHeader (64 bytes)
+ * - entryCount AssetEntry records (64 bytes each), sorted by name
+ * - Sections, each starting on a multiple of `alignment` (default: one page, so
+ *   a section's pages are shared and evicted independently of its neighbours)
+ *
+ * Checksums are CRC-32 (IEEE). open() checks the header, the index checksum and
+ * the bounds of every section, touching only the first page; a section's own
+ * checksum is checked when it is asked for with section() (or verify()).
+ *
+ * Packs are replaced by renaming a new file over the old one (AssetPackWriter
+ * does), never rewritten in place: processes still mapping the old file keep
+ * its pages instead of faulting on a truncated one.
+ *
+ * Usage:
+ *   AssetPack pack;
+ *   if (pack.open("robot_face_assets.rfpk")) {
+ *       const AssetView atlas = pack.section("font/status", kAssetTypeSdfAtlas);
+ *       font.load(atlas.data, atlas.size);   // Valid while the pack is open
+ *   }
+ */
+
+#include "robot_face_mapped_file.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace robotface {
+
+constexpr uint32_t kAssetPackMagic = 0x4B504652u;   // "RFPK"
+constexpr uint16_t kAssetPackVersion = 1;
+constexpr uint32_t kAssetPackDefaultAlignment = 4096;
+constexpr size_t kAssetNameLength = 40;             // Including the terminating NUL
+
+// Section types: the first four bytes of the formats the face bakes
+constexpr uint32_t kAssetTypeSdfAtlas = 0x46534652u;     // "RFSF" (robot_face_sdf_font.hpp)
+constexpr uint32_t kAssetTypeSpriteSheet = 0x53534652u;  // "RFSS" (robot_face_sprite.h)
+constexpr uint32_t kAssetTypeRaw = 0x20574152u;          // "RAW "
+
+struct AssetPackHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t entryCount;
+    uint32_t alignment;       // Power of two, >= 64
+    uint32_t indexChecksum;   // CRC-32 of the entries
+    uint64_t fileSize;
+    uint8_t reserved[40];
+};
+
+struct AssetEntry {
+    char name[kAssetNameLength];   // NUL-padded, e.g. "font/status"
+    uint32_t type;
+    uint32_t checksum;             // CRC-32 of the section
+    uint64_t offset;               // From the start of the file, multiple of the alignment
+    uint64_t size;
+};
+
+static_assert(sizeof(AssetPackHeader) == 64, "AssetPackHeader layout");
+static_assert(sizeof(AssetEntry) == 64, "AssetEntry layout");
+
+namespace pack {
+
+// Slicing-by-8 tables: table[k][i] is the CRC of byte i followed by k zero bytes
+constexpr std::array<std::array<uint32_t, 256>, 8> makeCrcTables() {
+    std::array<std::array<uint32_t, 256>, 8> tables{};
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; bit++) crc = (crc >> 1) ^ ((crc & 1u) ? 0xEDB88320u : 0u);
+        tables[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; i++) {
+        for (int k = 1; k < 8; k++) tables[k][i] = (tables[k - 1][i] >> 8) ^ tables[0][tables[k - 1][i] & 0xFFu];
+    }
+    return tables;
+}
+
+inline constexpr std::array<std::array<uint32_t, 256>, 8> kCrcTables = makeCrcTables();
+
+} // namespace pack
+
+// CRC-32 (IEEE 802.3, as zlib), eight bytes per step; pass the previous result to continue a checksum
+inline uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc = 0) noexcept {
+    const auto& t = pack::kCrcTables;
+    crc = ~crc;
+    for (; size >= 8; data += 8, size -= 8) {
+        const uint32_t low = crc ^ (uint32_t(data[0]) | uint32_t(data[1]) << 8 | uint32_t(data[2]) << 16 |
+                                    uint32_t(data[3]) << 24);
+        crc = t[7][low & 0xFFu] ^ t[6][(low >> 8) & 0xFFu] ^ t[5][(low >> 16) & 0xFFu] ^ t[4][low >> 24] ^
+              t[3][data[4]] ^ t[2][data[5]] ^ t[1][data[6]] ^ t[0][data[7]];
+    }
+    for (; size > 0; data++, size--) crc = t[0][(crc ^ *data) & 0xFFu] ^ (crc >> 8);
+    return ~crc;
+}
+
+// Bytes of one section, valid while the pack that returned it stays open
+struct AssetView {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+
+    [[nodiscard]] bool empty() const noexcept { return data == nullptr; }
+};
+
+class AssetPack {
+public:
+    // Maps the file and checks its header and index; false (see error()) if it is not a valid pack
+    bool open(const char* path) {
+        close();
+        if (!m_file.open(path)) return fail("cannot open the file");
+        if (m_file.size() < sizeof(AssetPackHeader)) return fail("too small for a pack header");
+
+        std::memcpy(&m_header, m_file.data(), sizeof(m_header));
+        if (m_header.magic != kAssetPackMagic) return fail("not an asset pack");
+        if (m_header.version != kAssetPackVersion) return fail("unsupported pack version");
+        if (m_header.fileSize != m_file.size()) return fail("truncated or extended");
+        if (m_header.alignment < 64 || (m_header.alignment & (m_header.alignment - 1)) != 0) {
+            return fail("bad section alignment");
+        }
+
+        const size_t indexSize = static_cast<size_t>(m_header.entryCount) * sizeof(AssetEntry);
+        if (sizeof(AssetPackHeader) + indexSize > m_file.size()) return fail("index past the end of the file");
+        const uint8_t* index = m_file.data() + sizeof(AssetPackHeader);
+        if (crc32(index, indexSize) != m_header.indexChecksum) return fail("index checksum mismatch");
+
+        m_entries.resize(m_header.entryCount);
+        std::memcpy(m_entries.data(), index, indexSize);
+        for (const AssetEntry& entry : m_entries) {
+            if (entry.name[kAssetNameLength - 1] != '\0') return fail("unterminated section name");
+            if (entry.offset % m_header.alignment != 0 || entry.offset < sizeof(AssetPackHeader) + indexSize ||
+                entry.size > m_file.size() || entry.offset > m_file.size() - entry.size) {
+                return fail("section out of bounds");
+            }
+            if (&entry != &m_entries.front() && std::strcmp((&entry - 1)->name, entry.name) >= 0) {
+                return fail("index not sorted by name");
+            }
+        }
+        m_error = nullptr;
+        return true;
+    }
+
+    void close() noexcept {
+        m_file.close();
+        m_entries.clear();
+        m_header = AssetPackHeader{};
+    }
+
+    [[nodiscard]] bool isOpen() const noexcept { return !m_file.empty(); }
+    [[nodiscard]] const char* error() const noexcept { return m_error ? m_error : ""; }
+    [[nodiscard]] const AssetPackHeader& header() const noexcept { return m_header; }
+    [[nodiscard]] const std::vector<AssetEntry>& entries() const noexcept { return m_entries; }
+    [[nodiscard]] const uint8_t* data() const noexcept { return m_file.data(); }
+    [[nodiscard]] size_t size() const noexcept { return m_file.size(); }
+
+    [[nodiscard]] const AssetEntry* find(const char* name) const noexcept {
+        const auto it = std::lower_bound(m_entries.begin(), m_entries.end(), name,
+                                         [](const AssetEntry& entry, const char* key) {
+                                             return std::strcmp(entry.name, key) < 0;
+                                         });
+        return (it != m_entries.end() && std::strcmp(it->name, name) == 0) ? &*it : nullptr;
+    }
+
+    [[nodiscard]] AssetView view(const AssetEntry& entry) const noexcept {
+        return AssetView{m_file.data() + entry.offset, static_cast<size_t>(entry.size)};
+    }
+
+    // Reads every byte of the section (faulting it in if it is not resident)
+    [[nodiscard]] bool verify(const AssetEntry& entry) const noexcept {
+        const AssetView bytes = view(entry);
+        return crc32(bytes.data, bytes.size) == entry.checksum;
+    }
+
+    // The section with this name and type, checksum verified; empty (see error()) otherwise
+    AssetView section(const char* name, uint32_t type) {
+        const AssetEntry* entry = find(name);
+        if (!entry) return failView("no such section");
+        if (entry->type != type) return failView("section has another type");
+        if (!verify(*entry)) return failView("section checksum mismatch");
+        return view(*entry);
+    }
+
+private:
+    bool fail(const char* message) {
+        close();
+        m_error = message;
+        return false;
+    }
+
+    AssetView failView(const char* message) noexcept {
+        m_error = message;
+        return AssetView{};
+    }
+
+    MappedFile m_file;
+    AssetPackHeader m_header{};
+    std::vector<AssetEntry> m_entries;
+    const char* m_error = nullptr;
+};
+
+// Builds a pack (robot_face_pack, benchmarks)
+class AssetPackWriter {
+public:
+    // False if the name is too long or already used
+    bool add(const char* name, uint32_t type, std::vector<uint8_t> bytes) {
+        if (std::strlen(name) >= kAssetNameLength) return false;
+        for (const Section& section : m_sections) {
+            if (section.name == name) return false;
+        }
+        m_sections.push_back(Section{name, type, std::move(bytes)});
+        return true;
+    }
+
+    [[nodiscard]] size_t sectionCount() const noexcept { return m_sections.size(); }
+
+    // Writes to path.tmp and renames it over path (see the note on replacing packs)
+    bool write(const char* path, uint32_t alignment = kAssetPackDefaultAlignment) {
+        if (alignment < 64 || (alignment & (alignment - 1)) != 0 || m_sections.size() > 0xFFFFu) return false;
+
+        std::vector<Section*> order;
+        for (Section& section : m_sections) order.push_back(&section);
+        std::sort(order.begin(), order.end(), [](const Section* a, const Section* b) { return a->name < b->name; });
+
+        auto alignUp = [alignment](uint64_t offset) { return (offset + alignment - 1) & ~uint64_t(alignment - 1); };
+        std::vector<AssetEntry> entries(order.size());
+        uint64_t offset = alignUp(sizeof(AssetPackHeader) + entries.size() * sizeof(AssetEntry));
+        for (size_t i = 0; i < order.size(); i++) {
+            AssetEntry& entry = entries[i];
+            std::memset(&entry, 0, sizeof(entry));
+            std::memcpy(entry.name, order[i]->name.c_str(), order[i]->name.size());
+            entry.type = order[i]->type;
+            entry.checksum = crc32(order[i]->bytes.data(), order[i]->bytes.size());
+            entry.offset = offset;
+            entry.size = order[i]->bytes.size();
+            offset = alignUp(offset + entry.size);
+        }
+        const uint64_t fileSize = entries.empty() ? sizeof(AssetPackHeader)
+                                                  : entries.back().offset + entries.back().size;
+
+        AssetPackHeader header{};
+        header.magic = kAssetPackMagic;
+        header.version = kAssetPackVersion;
+        header.entryCount = static_cast<uint16_t>(entries.size());
+        header.alignment = alignment;
+        header.indexChecksum = crc32(reinterpret_cast<const uint8_t*>(entries.data()),
+                                     entries.size() * sizeof(AssetEntry));
+        header.fileSize = fileSize;
+
+        const std::string temporary = std::string(path) + ".tmp";
+        std::FILE* file = std::fopen(temporary.c_str(), "wb");
+        if (!file) return false;
+        bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+        if (!entries.empty()) {
+            ok = ok && std::fwrite(entries.data(), sizeof(AssetEntry), entries.size(), file) == entries.size();
+        }
+        uint64_t written = sizeof(AssetPackHeader) + entries.size() * sizeof(AssetEntry);
+        for (size_t i = 0; i < order.size() && ok; i++) {
+            for (; written < entries[i].offset && ok; written++) ok = std::fputc(0, file) != EOF;
+            const std::vector<uint8_t>& bytes = order[i]->bytes;
+            if (!bytes.empty()) ok = ok && std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+            written += bytes.size();
+        }
+        ok = (std::fclose(file) == 0) && ok;
+        if (!ok || std::rename(temporary.c_str(), path) != 0) {
+            std::remove(temporary.c_str());
+            return false;
+        }
+        return true;
+    }
+
+private:
+    struct Section {
+        std::string name;
+        uint32_t type;
+        std::vector<uint8_t> bytes;
+    };
+
+    std::vector<Section> m_sections;
+};
+
+} // namespace robotface
+
+#endif // ROBOT_FACE_ASSET_PACK_HPP
@@ -0,0 +1,42 @@
+#ifndef ROBOT_FACE_BLINK_H
+#define ROBOT_FACE_BLINK_H
+
+/**
+ * Automatic blink timer shared by every robot face implementation
+ *
+ * The timer accumulates frame time and a blink is due once it reaches the
+ * interval (and the face is not already blinking). The overshoot past the
+ * interval carries over: resetting to 0 drops up to a frame per blink, a
+ * steady drift against wall time. Whole intervals missed in a stall are
+ * skipped, not replayed as a burst of blinks.
+ *
+ * Header-only (static inline), C11 / C++17. C++ callers use
+ * robotface::advanceBlinkTimer, which also takes float timers.
+ */
+
+#include <math.h>
+#include <stdbool.h>
+
+// Adds deltaTime; returns true when a blink should start now
+static inline bool RobotFaceAdvanceBlinkTimer(double* timer, double deltaTime, double interval, bool blinking) {
+    *timer += deltaTime;
+    if (blinking || *timer < interval) return false;
+    *timer = fmod(*timer, interval);
+    return true;
+}
+
+#ifdef __cplusplus
+namespace robotface {
+
+template <typename Timer>
+inline bool advanceBlinkTimer(Timer& timer, float deltaTime, float interval, bool blinking) noexcept {
+    double value = timer;
+    const bool due = RobotFaceAdvanceBlinkTimer(&value, deltaTime, interval, blinking);
+    timer = static_cast<Timer>(value);
+    return due;
+}
+
+} // namespace robotface
+#endif
+
+#endif // ROBOT_FACE_BLINK_H
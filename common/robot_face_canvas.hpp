@@ -0,0 +1,69 @@
+#ifndef ROBOT_FACE_CANVAS_HPP
+#define ROBOT_FACE_CANVAS_HPP
+
+/**
+ * Backend-neutral drawing interface for robot face implementations
+ *
+ * The face is described with five primitives (clear, filled circle, ring,
+ * stroked path, text) in the 800x600 design space. Each backend (raylib,
+ * Skia, software rasterizer, display-list recorder) implements Canvas.
+ *
+ * Groups mark draw calls whose output depends only on the group key.
+ * A canvas that already holds the output for a key returns false from
+ * beginGroup() and the caller skips the group; otherwise the group's draw
+ * calls follow and endGroup() closes it.
+ *
+ * Sprites are optional cached images placed anywhere at any scale. A canvas
+ * that supports them returns true from beginSprite() when it wants the
+ * sprite's shapes now (drawn centred in a size x size box at the origin,
+ * closed with endSprite()); sprite() then places the cached image and
+ * returns true. By default there is no sprite support: sprite() returns
+ * false and the caller draws live shapes.
+ */
+
+#include <cstdint>
+
+namespace robotface {
+
+// Color layout matches raylib's Color and SoftColor (r, g, b, a)
+struct Rgba {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+    uint8_t a;
+};
+
+inline bool operator==(Rgba lhs, Rgba rhs) noexcept {
+    return lhs.r == rhs.r && lhs.g == rhs.g && lhs.b == rhs.b && lhs.a == rhs.a;
+}
+
+// Point in design space
+struct Point2 {
+    float x;
+    float y;
+};
+
+class Canvas {
+public:
+    virtual ~Canvas() = default;
+
+    // Primitives
+    virtual void clear(Rgba color) = 0;
+    virtual void circle(Point2 center, float radius, Rgba color) = 0;
+    virtual void ring(Point2 center, float radius, float thickness, Rgba color) = 0;
+    virtual void strokePath(const Point2* points, int count, float width, Rgba color) = 0;
+    virtual void text(const char* text, Point2 topLeft, float size, Rgba color) = 0;
+
+    // Reusable groups (default: always draw)
+    virtual bool beginGroup(uint32_t key) { (void)key; return true; }
+    virtual void endGroup() {}
+
+    // Cached sprites (default: unsupported)
+    virtual bool beginSprite(uint32_t key, int size) { (void)key; (void)size; return false; }
+    virtual void endSprite() {}
+    virtual bool sprite(uint32_t key, Point2 center, float scale) { (void)key; (void)center; (void)scale; return false; }
+};
+
+} // namespace robotface
+
+#endif // ROBOT_FACE_CANVAS_HPP
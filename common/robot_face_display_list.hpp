@@ -0,0 +1,390 @@
+#ifndef ROBOT_FACE_DISPLAY_LIST_HPP
+#define ROBOT_FACE_DISPLAY_LIST_HPP
+
+/**
+ * Compact binary display list for robot face frames
+ *
+ * - DisplayList: packed draw ops (1-byte opcode + payload in host byte order; every
+ *   supported target is little-endian, captures do not load on big-endian hosts)
+ * - DisplayListLibrary: reusable sub-lists keyed by Canvas group key
+ * - DisplayListRecorder: Canvas that records into a list (RobotFace::draw target)
+ * - replay(): plays a list back into any Canvas (raylib, Skia, software, recorder)
+ * - serializeFrame()/deserializeFrame(): self-contained capture for bug reports
+ *
+ * Op payloads:
+ *   Clear      rgba
+ *   Circle     x y radius rgba
+ *   Ring       x y radius thickness rgba
+ *   StrokePath u16 count, width, rgba, count * (x y)
+ *   Text       x y size rgba, u16 length, bytes
+ *   CallList   u32 key (sub-list from the library, nested at most kMaxCallDepth deep)
+ */
+
+#include "robot_face_canvas.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+namespace robotface {
+
+enum class DisplayOp : uint8_t {
+    Clear = 1,
+    Circle,
+    Ring,
+    StrokePath,
+    Text,
+    CallList
+};
+
+// Limits enforced by the recorder and replayer (keeps replay allocation-free)
+constexpr int kMaxPathPoints = 256;
+constexpr int kMaxTextLength = 255;
+constexpr int kMaxCallDepth = 8;   // CallList nesting; deeper (or a cycle) is malformed
+
+class DisplayList {
+public:
+    void clear() noexcept { m_bytes.clear(); m_opCount = 0; }
+    void reserve(size_t bytes) { m_bytes.reserve(bytes); }
+
+    [[nodiscard]] const uint8_t* data() const noexcept { return m_bytes.data(); }
+    [[nodiscard]] size_t size() const noexcept { return m_bytes.size(); }
+    [[nodiscard]] uint32_t opCount() const noexcept { return m_opCount; }
+    [[nodiscard]] bool empty() const noexcept { return m_opCount == 0; }
+
+    bool operator==(const DisplayList& other) const noexcept {
+        return m_opCount == other.m_opCount && m_bytes == other.m_bytes;
+    }
+    bool operator!=(const DisplayList& other) const noexcept { return !(*this == other); }
+
+    // Writers (used by the recorder)
+    void beginOp(DisplayOp op) {
+        m_bytes.push_back(static_cast<uint8_t>(op));
+        m_opCount++;
+    }
+    void writeU16(uint16_t value) { writeBytes(&value, sizeof(value)); }
+    void writeU32(uint32_t value) { writeBytes(&value, sizeof(value)); }
+    void writeF32(float value) { writeBytes(&value, sizeof(value)); }
+    void writeRgba(Rgba color) { writeBytes(&color, sizeof(color)); }
+    void writeBytes(const void* bytes, size_t count) {
+        const uint8_t* p = static_cast<const uint8_t*>(bytes);
+        m_bytes.insert(m_bytes.end(), p, p + count);
+    }
+
+    // Replace the contents (used by deserialization and remote clients)
+    void assign(const uint8_t* bytes, size_t count, uint32_t opCount) {
+        m_bytes.assign(bytes, bytes + count);
+        m_opCount = opCount;
+    }
+
+    // In-place update (used by remote delta decoding)
+    void resize(size_t size, uint32_t opCount) {
+        m_bytes.resize(size);
+        m_opCount = opCount;
+    }
+
+    bool patch(size_t offset, const void* bytes, size_t count) noexcept {
+        if (offset > m_bytes.size() || count > m_bytes.size() - offset) return false;
+        std::memcpy(m_bytes.data() + offset, bytes, count);
+        return true;
+    }
+
+private:
+    std::vector<uint8_t> m_bytes;
+    uint32_t m_opCount = 0;
+};
+
+// Sub-lists shared between frames (node-based map keeps references stable)
+class DisplayListLibrary {
+public:
+    [[nodiscard]] const DisplayList* find(uint32_t key) const {
+        auto it = m_lists.find(key);
+        return it == m_lists.end() ? nullptr : &it->second;
+    }
+
+    DisplayList& insert(uint32_t key) {
+        DisplayList& list = m_lists[key];
+        list.clear();
+        return list;
+    }
+
+    void erase(uint32_t key) { m_lists.erase(key); }
+    void clear() { m_lists.clear(); }
+    [[nodiscard]] size_t size() const noexcept { return m_lists.size(); }
+
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        for (const auto& entry : m_lists) fn(entry.first, entry.second);
+    }
+
+private:
+    std::unordered_map<uint32_t, DisplayList> m_lists;
+};
+
+// Canvas that records draw calls instead of executing them
+class DisplayListRecorder final : public Canvas {
+public:
+    explicit DisplayListRecorder(DisplayList& frame, DisplayListLibrary* library = nullptr)
+        : m_library(library)
+    {
+        m_stack[0] = &frame;
+    }
+
+    void clear(Rgba color) override {
+        current().beginOp(DisplayOp::Clear);
+        current().writeRgba(color);
+    }
+
+    void circle(Point2 center, float radius, Rgba color) override {
+        DisplayList& list = current();
+        list.beginOp(DisplayOp::Circle);
+        list.writeF32(center.x);
+        list.writeF32(center.y);
+        list.writeF32(radius);
+        list.writeRgba(color);
+    }
+
+    void ring(Point2 center, float radius, float thickness, Rgba color) override {
+        DisplayList& list = current();
+        list.beginOp(DisplayOp::Ring);
+        list.writeF32(center.x);
+        list.writeF32(center.y);
+        list.writeF32(radius);
+        list.writeF32(thickness);
+        list.writeRgba(color);
+    }
+
+    void strokePath(const Point2* points, int count, float width, Rgba color) override {
+        if (count < 2) return;
+        if (count > kMaxPathPoints) count = kMaxPathPoints;
+
+        DisplayList& list = current();
+        list.beginOp(DisplayOp::StrokePath);
+        list.writeU16(static_cast<uint16_t>(count));
+        list.writeF32(width);
+        list.writeRgba(color);
+        list.writeBytes(points, sizeof(Point2) * count);
+    }
+
+    void text(const char* text, Point2 topLeft, float size, Rgba color) override {
+        size_t length = std::strlen(text);
+        if (length > static_cast<size_t>(kMaxTextLength)) length = kMaxTextLength;
+
+        DisplayList& list = current();
+        list.beginOp(DisplayOp::Text);
+        list.writeF32(topLeft.x);
+        list.writeF32(topLeft.y);
+        list.writeF32(size);
+        list.writeRgba(color);
+        list.writeU16(static_cast<uint16_t>(length));
+        list.writeBytes(text, length);
+    }
+
+    // Without a library groups are recorded inline; with one they become CallList ops
+    bool beginGroup(uint32_t key) override {
+        if (m_library == nullptr || m_depth + 1 >= kMaxDepth) {
+            m_inlineDepth++;
+            return true;
+        }
+
+        current().beginOp(DisplayOp::CallList);
+        current().writeU32(key);
+        if (m_library->find(key) != nullptr) {
+            m_skipped++;
+            return false;
+        }
+
+        m_stack[++m_depth] = &m_library->insert(key);
+        return true;
+    }
+
+    void endGroup() override {
+        if (m_inlineDepth > 0) m_inlineDepth--;
+        else if (m_depth > 0) m_depth--;
+    }
+
+    // Number of groups reused from the library since construction
+    [[nodiscard]] int reusedGroups() const noexcept { return m_skipped; }
+
+private:
+    static constexpr int kMaxDepth = 8;
+
+    DisplayList& current() noexcept { return *m_stack[m_depth]; }
+
+    DisplayListLibrary* m_library;
+    DisplayList* m_stack[kMaxDepth] = {};
+    int m_depth = 0;
+    int m_inlineDepth = 0;
+    int m_skipped = 0;
+};
+
+namespace detail {
+
+// Bounds-checked little-endian reader over a display list
+class DisplayListReader {
+public:
+    DisplayListReader(const uint8_t* data, size_t size) : m_p(data), m_end(data + size) {}
+
+    [[nodiscard]] bool atEnd() const noexcept { return m_p >= m_end; }
+
+    bool read(void* out, size_t count) noexcept {
+        if (static_cast<size_t>(m_end - m_p) < count) return false;
+        std::memcpy(out, m_p, count);
+        m_p += count;
+        return true;
+    }
+
+    template <typename T>
+    bool read(T& out) noexcept { return read(&out, sizeof(T)); }
+
+    // Pointer to the next count bytes (nullptr if truncated)
+    const uint8_t* take(size_t count) noexcept {
+        if (static_cast<size_t>(m_end - m_p) < count) return nullptr;
+        const uint8_t* p = m_p;
+        m_p += count;
+        return p;
+    }
+
+private:
+    const uint8_t* m_p;
+    const uint8_t* m_end;
+};
+
+} // namespace detail
+
+// Play a display list into a canvas; returns false on malformed input (including sub-lists
+// that call each other in a cycle). depth counts the CallList levels above this list.
+inline bool replay(const DisplayList& list, Canvas& canvas, const DisplayListLibrary* library = nullptr,
+                   int depth = 0) {
+    if (depth > kMaxCallDepth) return false;
+    detail::DisplayListReader reader(list.data(), list.size());
+
+    while (!reader.atEnd()) {
+        uint8_t op = 0;
+        Rgba color{};
+        Point2 p{};
+        float radius = 0.0f;
+
+        reader.read(op);
+        switch (static_cast<DisplayOp>(op)) {
+            case DisplayOp::Clear:
+                if (!reader.read(color)) return false;
+                canvas.clear(color);
+                break;
+
+            case DisplayOp::Circle:
+                if (!reader.read(p) || !reader.read(radius) || !reader.read(color)) return false;
+                canvas.circle(p, radius, color);
+                break;
+
+            case DisplayOp::Ring: {
+                float thickness = 0.0f;
+                if (!reader.read(p) || !reader.read(radius) || !reader.read(thickness) ||
+                    !reader.read(color)) return false;
+                canvas.ring(p, radius, thickness, color);
+            } break;
+
+            case DisplayOp::StrokePath: {
+                uint16_t count = 0;
+                float width = 0.0f;
+                Point2 points[kMaxPathPoints];
+                if (!reader.read(count) || count > kMaxPathPoints) return false;
+                if (!reader.read(width) || !reader.read(color)) return false;
+                if (!reader.read(points, sizeof(Point2) * count)) return false;
+                canvas.strokePath(points, count, width, color);
+            } break;
+
+            case DisplayOp::Text: {
+                float size = 0.0f;
+                uint16_t length = 0;
+                char text[kMaxTextLength + 1];
+                if (!reader.read(p) || !reader.read(size) || !reader.read(color)) return false;
+                if (!reader.read(length) || length > kMaxTextLength) return false;
+                if (!reader.read(text, length)) return false;
+                text[length] = '\0';
+                canvas.text(text, p, size, color);
+            } break;
+
+            case DisplayOp::CallList: {
+                uint32_t key = 0;
+                if (!reader.read(key)) return false;
+                const DisplayList* sub = library ? library->find(key) : nullptr;
+                if (sub == nullptr) return false;
+                if (canvas.beginGroup(key)) {
+                    bool ok = replay(*sub, canvas, library, depth + 1);
+                    canvas.endGroup();
+                    if (!ok) return false;
+                }
+            } break;
+
+            default:
+                return false;
+        }
+    }
+
+    return true;
+}
+
+// Self-contained capture: "RFDL", u16 version, u16 reserved, u32 sub-list count,
+// per sub-list { u32 key, u32 opCount, u32 size, bytes }, then { u32 opCount, u32 size, bytes }
+constexpr uint16_t kDisplayListVersion = 1;
+
+inline std::vector<uint8_t> serializeFrame(const DisplayList& frame, const DisplayListLibrary* library = nullptr) {
+    DisplayList out;
+    const uint32_t subCount = library ? static_cast<uint32_t>(library->size()) : 0;
+
+    out.writeBytes("RFDL", 4);
+    out.writeU16(kDisplayListVersion);
+    out.writeU16(0);
+    out.writeU32(subCount);
+
+    if (library) {
+        library->forEach([&out](uint32_t key, const DisplayList& list) {
+            out.writeU32(key);
+            out.writeU32(list.opCount());
+            out.writeU32(static_cast<uint32_t>(list.size()));
+            out.writeBytes(list.data(), list.size());
+        });
+    }
+
+    out.writeU32(frame.opCount());
+    out.writeU32(static_cast<uint32_t>(frame.size()));
+    out.writeBytes(frame.data(), frame.size());
+
+    return std::vector<uint8_t>(out.data(), out.data() + out.size());
+}
+
+inline bool deserializeFrame(const uint8_t* data, size_t size, DisplayList& frame, DisplayListLibrary& library) {
+    detail::DisplayListReader reader(data, size);
+    char magic[4];
+    uint16_t version = 0;
+    uint16_t reserved = 0;
+    uint32_t subCount = 0;
+
+    if (!reader.read(magic, 4) || std::memcmp(magic, "RFDL", 4) != 0) return false;
+    if (!reader.read(version) || version != kDisplayListVersion) return false;
+    if (!reader.read(reserved) || !reader.read(subCount)) return false;
+
+    auto readList = [&reader](DisplayList& list) {
+        uint32_t opCount = 0;
+        uint32_t bytes = 0;
+        if (!reader.read(opCount) || !reader.read(bytes)) return false;
+        const uint8_t* payload = reader.take(bytes);
+        if (payload == nullptr) return false;
+        list.assign(payload, bytes, opCount);
+        return true;
+    };
+
+    library.clear();
+    for (uint32_t i = 0; i < subCount; i++) {
+        uint32_t key = 0;
+        if (!reader.read(key) || !readList(library.insert(key))) return false;
+    }
+
+    return readList(frame);
+}
+
+} // namespace robotface
+
+#endif // ROBOT_FACE_DISPLAY_LIST_HPP
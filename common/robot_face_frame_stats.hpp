@@ -0,0 +1,58 @@
+#ifndef ROBOT_FACE_FRAME_STATS_HPP
+#define ROBOT_FACE_FRAME_STATS_HPP
+
+/**
+ * Per-frame submission counters for Canvas backends
+ *
+ * A backend canvas given a FrameStats (setStats) adds what it submits to
+ * its graphics API for every Canvas call:
+ *
+ *   drawCalls     API draw calls (DrawCircle, SkCanvas::drawPath, ...)
+ *   vertices      Vertices submitted after the backend's own tessellation
+ *   triangles     Triangles among them (lines submit vertices only)
+ *   batchFlushes  Batches the canvas forced to the GPU (render target switches)
+ *   stateChanges  Texture / primitive mode / paint switches between draws
+ *   glyphs        Text glyphs drawn
+ *
+ * Counts are modelled on each backend's documented behaviour rather than read
+ * back from the driver, so they are exact for a given library version and
+ * cost nothing but a few adds. They are a proxy for submission cost.
+ */
+
+#include <cstdint>
+
+namespace robotface {
+
+struct FrameStats {
+    uint32_t drawCalls = 0;
+    uint32_t vertices = 0;
+    uint32_t triangles = 0;
+    uint32_t batchFlushes = 0;
+    uint32_t stateChanges = 0;
+    uint32_t glyphs = 0;
+
+    void reset() noexcept { *this = FrameStats{}; }
+
+    FrameStats& operator+=(const FrameStats& other) noexcept {
+        drawCalls += other.drawCalls;
+        vertices += other.vertices;
+        triangles += other.triangles;
+        batchFlushes += other.batchFlushes;
+        stateChanges += other.stateChanges;
+        glyphs += other.glyphs;
+        return *this;
+    }
+};
+
+// Glyphs a text call renders (spaces, tabs and newlines only advance the pen)
+inline uint32_t countGlyphs(const char* text) noexcept {
+    uint32_t glyphs = 0;
+    for (const char* c = text; *c; c++) {
+        glyphs += (*c != ' ' && *c != '\t' && *c != '\n');
+    }
+    return glyphs;
+}
+
+} // namespace robotface
+
+#endif // ROBOT_FACE_FRAME_STATS_HPP
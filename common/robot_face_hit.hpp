@@ -0,0 +1,236 @@
+#ifndef ROBOT_FACE_HIT_HPP
+#define ROBOT_FACE_HIT_HPP
+
+/**
+ * Hit testing for robot faces: which face, and which part of it, is under a pointer
+ *
+ * Regions come from the geometry the face is drawn with, in its 800x600 design space:
+ *   left-eye / right-eye   the eye circles
+ *   mouth                  the bounding box of the lips as drawn right now (emotion
+ *                          curve, speech opening, stroke width)
+ *   face                   the rest of the design space
+ * `slop` widens eyes and mouth for coarse pointers (touch, hover).
+ *
+ * HitGrid indexes many faces on one surface. It is a spatial hash of square cells:
+ * every face is listed in the cells its bounds overlap, so a query looks at one
+ * cell's faces instead of all of them. move() only touches the cells a face leaves
+ * and enters; faces can be rearranged every frame without a rebuild. Faces draw in
+ * id order, so a query returns the highest id whose bounds contain the point.
+ * Queries are const and may run on several threads while no face is being moved.
+ */
+
+#include "robot_face_canvas.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace robotface {
+
+enum class FaceRegion : uint8_t { None, Face, LeftEye, RightEye, Mouth };
+
+constexpr const char* kFaceRegionNames[] = {"none", "face", "left-eye", "right-eye", "mouth"};
+
+// Where the shapes are, in design space (defaults: the face every version draws)
+struct FaceGeometry {
+    Point2 leftEye{250.0f, 200.0f};
+    Point2 rightEye{550.0f, 200.0f};
+    float eyeRadius = 60.0f;
+    Point2 mouthStart{300.0f, 400.0f};
+    Point2 mouthEnd{500.0f, 400.0f};
+    float mouthCenterY = 400.0f;       // Control point at happiness 0.5
+    float mouthCurveFactor = 60.0f;
+    float mouthOpenFactor = 60.0f;
+    float mouthUpperShare = 0.2f;
+    float mouthOpenEpsilon = 0.01f;
+    float mouthStrokeWidth = 8.0f;
+    float width = 800.0f;
+    float height = 600.0f;
+};
+
+struct HitBox {
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+
+    [[nodiscard]] bool contains(Point2 p) const noexcept {
+        return p.x >= minX && p.x <= maxX && p.y >= minY && p.y <= maxY;
+    }
+};
+
+// Vertical extent of a quadratic Bezier: its end points, plus the turning point when
+// it lies inside the curve
+inline void quadraticExtent(float p0, float c, float p1, float& lo, float& hi) noexcept {
+    lo = std::min(p0, p1);
+    hi = std::max(p0, p1);
+    const float denominator = p0 - 2.0f * c + p1;
+    if (denominator == 0.0f) return;
+    const float t = (p0 - c) / denominator;
+    if (t <= 0.0f || t >= 1.0f) return;
+    const float u = 1.0f - t;
+    const float extreme = u * u * p0 + 2.0f * u * t * c + t * t * p1;
+    lo = std::min(lo, extreme);
+    hi = std::max(hi, extreme);
+}
+
+// Lips as they are drawn for this happiness and mouth openness
+inline HitBox mouthBounds(const FaceGeometry& g, float happiness, float openness) noexcept {
+    const float controlY = g.mouthCenterY + (happiness - 0.5f) * g.mouthCurveFactor;
+    float upperControl = controlY;
+    float lowerControl = controlY;
+    if (openness >= g.mouthOpenEpsilon) {
+        const float gap = openness * g.mouthOpenFactor;
+        upperControl = controlY - gap * g.mouthUpperShare;
+        lowerControl = controlY + gap * (1.0f - g.mouthUpperShare);
+    }
+
+    float upperLo, upperHi, lowerLo, lowerHi;
+    quadraticExtent(g.mouthStart.y, upperControl, g.mouthEnd.y, upperLo, upperHi);
+    quadraticExtent(g.mouthStart.y, lowerControl, g.mouthEnd.y, lowerLo, lowerHi);
+    const float half = g.mouthStrokeWidth * 0.5f;
+    return HitBox{std::min(g.mouthStart.x, g.mouthEnd.x) - half, std::min(upperLo, lowerLo) - half,
+                  std::max(g.mouthStart.x, g.mouthEnd.x) + half, std::max(upperHi, lowerHi) + half};
+}
+
+// Region under a point given in design space
+inline FaceRegion hitTestFace(const FaceGeometry& g, Point2 p, float happiness, float openness,
+                              float slop = 0.0f) noexcept {
+    const float eyeReach = (g.eyeRadius + slop) * (g.eyeRadius + slop);
+    for (const auto& [center, region] : {std::pair{g.leftEye, FaceRegion::LeftEye},
+                                         std::pair{g.rightEye, FaceRegion::RightEye}}) {
+        const float dx = p.x - center.x;
+        const float dy = p.y - center.y;
+        if (dx * dx + dy * dy <= eyeReach) return region;
+    }
+
+    HitBox mouth = mouthBounds(g, happiness, openness);
+    mouth = HitBox{mouth.minX - slop, mouth.minY - slop, mouth.maxX + slop, mouth.maxY + slop};
+    if (mouth.contains(p)) return FaceRegion::Mouth;
+
+    return HitBox{0.0f, 0.0f, g.width, g.height}.contains(p) ? FaceRegion::Face : FaceRegion::None;
+}
+
+class HitGrid {
+public:
+    static constexpr uint32_t kNone = 0xFFFFFFFFu;
+
+    // Cells should be about the size of one item; buckets is rounded up to a power of two
+    explicit HitGrid(float cellSize = 128.0f, size_t buckets = 4096)
+        : m_inverseCell(1.0f / cellSize) {
+        size_t count = 1;
+        while (count < buckets) count <<= 1;
+        m_buckets.resize(count);
+        m_mask = count - 1;
+    }
+
+    // Ids index a dense table: keep them small (face ids, 0..n-1)
+    void insert(uint32_t id, const HitBox& bounds) {
+        if (id >= m_items.size()) m_items.resize(static_cast<size_t>(id) + 1);
+        Item& item = m_items[id];
+        if (item.present) remove(id);
+        item = Item{bounds, cellRange(bounds), true};
+        forEachCell(item.cells, [&](size_t bucket) { m_buckets[bucket].push_back(id); });
+        m_count++;
+    }
+
+    // Only the cells the item leaves and enters change
+    void move(uint32_t id, const HitBox& bounds) {
+        if (id >= m_items.size() || !m_items[id].present) {
+            insert(id, bounds);
+            return;
+        }
+        Item& item = m_items[id];
+        const CellRange from = item.cells;
+        const CellRange to = cellRange(bounds);
+        item.bounds = bounds;
+        if (from == to) return;
+
+        item.cells = to;
+        forEachCell(from, [&](int x, int y, size_t bucket) {
+            if (!to.contains(x, y)) erase(bucket, id);
+        });
+        forEachCell(to, [&](int x, int y, size_t bucket) {
+            if (!from.contains(x, y)) m_buckets[bucket].push_back(id);
+        });
+    }
+
+    void remove(uint32_t id) {
+        if (id >= m_items.size() || !m_items[id].present) return;
+        Item& item = m_items[id];
+        forEachCell(item.cells, [&](size_t bucket) { erase(bucket, id); });
+        item.present = false;
+        m_count--;
+    }
+
+    // Topmost (highest id) item whose bounds contain the point, kNone if there is none
+    [[nodiscard]] uint32_t query(Point2 p) const noexcept {
+        const std::vector<uint32_t>& bucket = m_buckets[bucketOf(cellOf(p.x), cellOf(p.y))];
+        uint32_t best = kNone;
+        for (const uint32_t id : bucket) {
+            if ((best == kNone || id > best) && m_items[id].bounds.contains(p)) best = id;
+        }
+        return best;
+    }
+
+    [[nodiscard]] const HitBox& bounds(uint32_t id) const noexcept { return m_items[id].bounds; }
+    [[nodiscard]] size_t size() const noexcept { return m_count; }
+
+private:
+    struct CellRange {
+        int x0, y0, x1, y1;
+
+        [[nodiscard]] bool contains(int x, int y) const noexcept { return x >= x0 && x <= x1 && y >= y0 && y <= y1; }
+        bool operator==(const CellRange& o) const noexcept {
+            return x0 == o.x0 && y0 == o.y0 && x1 == o.x1 && y1 == o.y1;
+        }
+    };
+
+    struct Item {
+        HitBox bounds{};
+        CellRange cells{};
+        bool present = false;
+    };
+
+    [[nodiscard]] int cellOf(float v) const noexcept { return static_cast<int>(std::floor(v * m_inverseCell)); }
+
+    [[nodiscard]] CellRange cellRange(const HitBox& b) const noexcept {
+        return CellRange{cellOf(b.minX), cellOf(b.minY), cellOf(b.maxX), cellOf(b.maxY)};
+    }
+
+    [[nodiscard]] size_t bucketOf(int x, int y) const noexcept {
+        const uint32_t h = static_cast<uint32_t>(x) * 73856093u ^ static_cast<uint32_t>(y) * 19349663u;
+        return h & m_mask;
+    }
+
+    template <typename Fn>
+    void forEachCell(const CellRange& r, Fn fn) const {
+        for (int y = r.y0; y <= r.y1; y++) {
+            for (int x = r.x0; x <= r.x1; x++) {
+                if constexpr (std::is_invocable_v<Fn, size_t>) fn(bucketOf(x, y));
+                else fn(x, y, bucketOf(x, y));
+            }
+        }
+    }
+
+    void erase(size_t bucket, uint32_t id) {
+        std::vector<uint32_t>& ids = m_buckets[bucket];
+        const auto found = std::find(ids.begin(), ids.end(), id);
+        if (found == ids.end()) return;
+        *found = ids.back();
+        ids.pop_back();
+    }
+
+    float m_inverseCell;
+    size_t m_mask = 0;
+    size_t m_count = 0;
+    std::vector<Item> m_items;                     // By id
+    std::vector<std::vector<uint32_t>> m_buckets;  // Cell hash -> ids (one entry per overlapped cell)
+};
+
+} // namespace robotface
+
+#endif // ROBOT_FACE_HIT_HPP
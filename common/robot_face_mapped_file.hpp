@@ -0,0 +1,119 @@
+#ifndef ROBOT_FACE_MAPPED_FILE_HPP
+#define ROBOT_FACE_MAPPED_FILE_HPP
+
+/**
+ * Read-only memory-mapped file
+ *
+ * Maps a whole file once; the bytes stay valid until the object is destroyed or
+ * moved from. Loaders parse straight out of the mapping, so nothing is copied
+ * and pages the parser never touches are never read. On platforms without
+ * mmap the file is read into a heap buffer instead (same interface).
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ROBOT_FACE_HAS_MMAP 1
+#else
+#include <vector>
+#define ROBOT_FACE_HAS_MMAP 0
+#endif
+
+namespace robotface {
+
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            close();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+#if !ROBOT_FACE_HAS_MMAP
+            m_buffer = std::move(other.m_buffer);
+#endif
+        }
+        return *this;
+    }
+
+    // False when the file cannot be opened or read; an empty file maps to size 0
+    bool open(const char* path) {
+        close();
+#if ROBOT_FACE_HAS_MMAP
+        const int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size < 0) {
+            ::close(fd);
+            return false;
+        }
+        m_size = static_cast<size_t>(info.st_size);
+        if (m_size > 0) {
+            void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                ::close(fd);
+                m_size = 0;
+                return false;
+            }
+            m_data = static_cast<const uint8_t*>(data);
+        }
+        ::close(fd);   // The mapping keeps the file referenced
+        return true;
+#else
+        std::FILE* file = std::fopen(path, "rb");
+        if (!file) return false;
+        std::fseek(file, 0, SEEK_END);
+        const long size = std::ftell(file);
+        std::fseek(file, 0, SEEK_SET);
+        if (size < 0) {
+            std::fclose(file);
+            return false;
+        }
+        m_buffer.resize(static_cast<size_t>(size));
+        const bool read = std::fread(m_buffer.data(), 1, m_buffer.size(), file) == m_buffer.size();
+        std::fclose(file);
+        if (!read) return false;
+        m_data = m_buffer.data();
+        m_size = m_buffer.size();
+        return true;
+#endif
+    }
+
+    void close() noexcept {
+#if ROBOT_FACE_HAS_MMAP
+        if (m_data) munmap(const_cast<uint8_t*>(m_data), m_size);
+#else
+        m_buffer.clear();
+#endif
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    [[nodiscard]] const uint8_t* data() const noexcept { return m_data; }
+    [[nodiscard]] size_t size() const noexcept { return m_size; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+#if !ROBOT_FACE_HAS_MMAP
+    std::vector<uint8_t> m_buffer;
+#endif
+};
+
+} // namespace robotface
+
+#endif // ROBOT_FACE_MAPPED_FILE_HPP
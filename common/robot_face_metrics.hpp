@@ -0,0 +1,422 @@
+#ifndef ROBOT_FACE_METRICS_HPP
+#define ROBOT_FACE_METRICS_HPP
+
+/**
+ * Render telemetry in Prometheus text format
+ *
+ * The render loop publishes one FrameSample per presented frame into a
+ * MetricsRegistry; a MetricsExporter serves the registry on a background thread
+ * over HTTP, on 127.0.0.1:<port> or on a Unix socket:
+ *
+ *   curl -s http://127.0.0.1:9464/metrics
+ *   curl -s --unix-socket /tmp/robot_face_metrics.sock http://localhost/metrics
+ *
+ * publish() is wait-free: relaxed stores into atomics inside a sequence lock
+ * (odd while a frame is being written). A scrape copies the counters and retries
+ * if the sequence moved, so it sees whole frames only and the render loop never
+ * waits for it. One writer thread; any number of scrapers. Neither side takes a
+ * mutex, and serving a scrape does not touch the heap (fixed buffers).
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace robotface {
+
+constexpr int kDefaultMetricsPort = 9464;
+
+// One presented frame, as the render loop saw it
+struct FrameSample {
+    float intervalMs = 0.0f;          // Present to present
+    float busyMs = 0.0f;              // Update + draw, without the limiter's wait
+    float targetMs = 0.0f;            // Interval the limiter aims for (0: uncapped, no drops counted)
+    float inputLatencyMs = -1.0f;     // Input to present (< 0: no input this frame)
+    float happiness = 0.0f;
+    const char* emotion = "";         // Static string, exported as a label value
+    bool blinking = false;
+    int qualityLevel = 0;
+    int64_t allocations = -1;         // Heap allocations this frame (< 0: not counted)
+};
+
+class MetricsRegistry {
+public:
+    // Upper bounds of the time histograms in seconds (+Inf implied)
+    static constexpr double kBucketBounds[] = {0.001, 0.002, 0.004, 0.008, 0.012, 0.0167,
+                                               0.02,  0.025, 0.0333, 0.05, 0.1,   0.25};
+    static constexpr size_t kBucketCount = sizeof(kBucketBounds) / sizeof(kBucketBounds[0]) + 1;
+
+    // backend: static string, e.g. "raylib" or "skia"
+    explicit MetricsRegistry(const char* backend) noexcept : m_backend(backend) {}
+
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    // Render thread only (single writer); never blocks
+    void publish(const FrameSample& sample) noexcept {
+        const uint32_t sequence = m_sequence.load(std::memory_order_relaxed);
+        m_sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        add(m_frames, 1);
+        observe(m_interval, sample.intervalMs);
+        observe(m_busy, sample.busyMs);
+        if (sample.inputLatencyMs >= 0.0f) observe(m_inputLatency, sample.inputLatencyMs);
+        if (sample.targetMs > 0.0f) {
+            const int intervals = static_cast<int>(sample.intervalMs / sample.targetMs + 0.5f);
+            if (intervals > 1) add(m_dropped, static_cast<uint64_t>(intervals - 1));
+        }
+        if (sample.blinking && !m_wasBlinking) add(m_blinks, 1);
+        m_wasBlinking = sample.blinking;
+
+        uint32_t happiness = 0;
+        std::memcpy(&happiness, &sample.happiness, sizeof(happiness));
+        m_happiness.store(happiness, std::memory_order_relaxed);
+        m_emotion.store(sample.emotion, std::memory_order_relaxed);
+        m_blinking.store(sample.blinking, std::memory_order_relaxed);
+        m_quality.store(sample.qualityLevel, std::memory_order_relaxed);
+        if (sample.allocations >= 0) {
+            m_frameAllocations.store(sample.allocations, std::memory_order_relaxed);
+            add(m_allocations, static_cast<uint64_t>(sample.allocations));
+        }
+
+        m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    // Any thread: writes the exposition text (truncated to capacity), returns its length
+    size_t format(char* out, size_t capacity) const noexcept {
+        const Snapshot s = snapshot();
+        Writer w{out, capacity};
+        w.print("# HELP robot_face_info Face process; the label names the render backend.\n"
+                "# TYPE robot_face_info gauge\n"
+                "robot_face_info{backend=\"%s\"} 1\n", m_backend);
+        w.print("# HELP robot_face_frames_total Frames presented.\n"
+                "# TYPE robot_face_frames_total counter\n"
+                "robot_face_frames_total %llu\n", static_cast<unsigned long long>(s.frames));
+        writeHistogram(w, "robot_face_frame_interval_seconds", "Time from one present to the next.", s.interval);
+        writeHistogram(w, "robot_face_frame_busy_seconds", "Update and draw time, without the frame limiter's wait.",
+                       s.busy);
+        writeHistogram(w, "robot_face_input_latency_seconds", "Time from an input event to the frame presenting it.",
+                       s.inputLatency);
+        w.print("# HELP robot_face_dropped_frames_total Target intervals missed by late frames.\n"
+                "# TYPE robot_face_dropped_frames_total counter\n"
+                "robot_face_dropped_frames_total %llu\n", static_cast<unsigned long long>(s.dropped));
+        w.print("# HELP robot_face_happiness Current emotion value (0 sad, 1 happy).\n"
+                "# TYPE robot_face_happiness gauge\n"
+                "robot_face_happiness %.4f\n", static_cast<double>(s.happiness));
+        w.print("# HELP robot_face_emotion Current emotion.\n"
+                "# TYPE robot_face_emotion gauge\n"
+                "robot_face_emotion{emotion=\"%s\"} 1\n", s.emotion ? s.emotion : "");
+        w.print("# HELP robot_face_blinking 1 while a blink is playing.\n"
+                "# TYPE robot_face_blinking gauge\n"
+                "robot_face_blinking %d\n", s.blinking ? 1 : 0);
+        w.print("# HELP robot_face_blinks_total Blinks started.\n"
+                "# TYPE robot_face_blinks_total counter\n"
+                "robot_face_blinks_total %llu\n", static_cast<unsigned long long>(s.blinks));
+        w.print("# HELP robot_face_quality_level Quality governor level (0 full detail).\n"
+                "# TYPE robot_face_quality_level gauge\n"
+                "robot_face_quality_level %d\n", s.quality);
+        if (s.frameAllocations >= 0) {
+            w.print("# HELP robot_face_frame_allocations Heap allocations in the last frame.\n"
+                    "# TYPE robot_face_frame_allocations gauge\n"
+                    "robot_face_frame_allocations %lld\n"
+                    "# HELP robot_face_allocations_total Heap allocations made by frames.\n"
+                    "# TYPE robot_face_allocations_total counter\n"
+                    "robot_face_allocations_total %llu\n",
+                    static_cast<long long>(s.frameAllocations), static_cast<unsigned long long>(s.allocations));
+        }
+        return w.length;
+    }
+
+    [[nodiscard]] uint64_t frames() const noexcept { return m_frames.load(std::memory_order_relaxed); }
+
+private:
+    struct Histogram {
+        std::atomic<uint64_t> buckets[kBucketCount] = {};   // Per bucket, not cumulative
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> sumNs{0};
+    };
+
+    struct HistogramCopy {
+        uint64_t buckets[kBucketCount] = {};
+        uint64_t count = 0;
+        uint64_t sumNs = 0;
+    };
+
+    struct Snapshot {
+        uint64_t frames = 0;
+        HistogramCopy interval;
+        HistogramCopy busy;
+        HistogramCopy inputLatency;
+        uint64_t dropped = 0;
+        uint64_t blinks = 0;
+        float happiness = 0.0f;
+        const char* emotion = nullptr;
+        bool blinking = false;
+        int quality = 0;
+        int64_t frameAllocations = -1;
+        uint64_t allocations = 0;
+    };
+
+    struct Writer {
+        char* out;
+        size_t capacity;
+        size_t length = 0;
+
+        template <typename... Args>
+        void print(const char* format, Args... args) noexcept {
+            if (length + 1 >= capacity) return;
+            const int written = std::snprintf(out + length, capacity - length, format, args...);
+            if (written > 0) length += std::min(static_cast<size_t>(written), capacity - length - 1);
+        }
+    };
+
+    // Single writer: a load and a store, no read-modify-write
+    static void add(std::atomic<uint64_t>& counter, uint64_t value) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    static void observe(Histogram& histogram, float ms) noexcept {
+        const double seconds = static_cast<double>(ms) * 1e-3;
+        size_t bucket = 0;
+        while (bucket + 1 < kBucketCount && seconds > kBucketBounds[bucket]) bucket++;
+        add(histogram.buckets[bucket], 1);
+        add(histogram.count, 1);
+        add(histogram.sumNs, static_cast<uint64_t>(seconds > 0.0 ? seconds * 1e9 : 0.0));
+    }
+
+    static void copy(const Histogram& from, HistogramCopy& to) noexcept {
+        for (size_t i = 0; i < kBucketCount; i++) to.buckets[i] = from.buckets[i].load(std::memory_order_relaxed);
+        to.count = from.count.load(std::memory_order_relaxed);
+        to.sumNs = from.sumNs.load(std::memory_order_relaxed);
+    }
+
+    // Retries while a publish is in flight; the writer never waits for this
+    Snapshot snapshot() const noexcept {
+        Snapshot s;
+        for (;;) {
+            const uint32_t before = m_sequence.load(std::memory_order_acquire);
+            if (before & 1u) {
+                std::this_thread::yield();
+                continue;
+            }
+            s.frames = m_frames.load(std::memory_order_relaxed);
+            copy(m_interval, s.interval);
+            copy(m_busy, s.busy);
+            copy(m_inputLatency, s.inputLatency);
+            s.dropped = m_dropped.load(std::memory_order_relaxed);
+            s.blinks = m_blinks.load(std::memory_order_relaxed);
+            const uint32_t happiness = m_happiness.load(std::memory_order_relaxed);
+            std::memcpy(&s.happiness, &happiness, sizeof(happiness));
+            s.emotion = m_emotion.load(std::memory_order_relaxed);
+            s.blinking = m_blinking.load(std::memory_order_relaxed);
+            s.quality = m_quality.load(std::memory_order_relaxed);
+            s.frameAllocations = m_frameAllocations.load(std::memory_order_relaxed);
+            s.allocations = m_allocations.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_sequence.load(std::memory_order_relaxed) == before) return s;
+        }
+    }
+
+    static void writeHistogram(Writer& w, const char* name, const char* help, const HistogramCopy& h) noexcept {
+        w.print("# HELP %s %s\n# TYPE %s histogram\n", name, help, name);
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i + 1 < kBucketCount; i++) {
+            cumulative += h.buckets[i];
+            w.print("%s_bucket{le=\"%g\"} %llu\n", name, kBucketBounds[i], static_cast<unsigned long long>(cumulative));
+        }
+        w.print("%s_bucket{le=\"+Inf\"} %llu\n%s_sum %.9f\n%s_count %llu\n", name,
+                static_cast<unsigned long long>(h.count), name, static_cast<double>(h.sumNs) * 1e-9, name,
+                static_cast<unsigned long long>(h.count));
+    }
+
+    const char* m_backend;
+    std::atomic<uint32_t> m_sequence{0};
+    std::atomic<uint64_t> m_frames{0};
+    Histogram m_interval;
+    Histogram m_busy;
+    Histogram m_inputLatency;
+    std::atomic<uint64_t> m_dropped{0};
+    std::atomic<uint64_t> m_blinks{0};
+    std::atomic<uint32_t> m_happiness{0};   // float bits
+    std::atomic<const char*> m_emotion{""};
+    std::atomic<bool> m_blinking{false};
+    std::atomic<int> m_quality{0};
+    std::atomic<int64_t> m_frameAllocations{-1};
+    std::atomic<uint64_t> m_allocations{0};
+    bool m_wasBlinking = false;   // Writer state
+};
+
+// Serves GET /metrics from a background thread, one connection at a time
+class MetricsExporter {
+public:
+    MetricsExporter() = default;
+    ~MetricsExporter() { stop(); }
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    // address: a port number (listens on 127.0.0.1 only) or a Unix socket path.
+    // False if the socket cannot be bound; the registry must outlive the exporter.
+    bool start(const MetricsRegistry& registry, const char* address) {
+        stop();
+        m_registry = &registry;
+        const bool isPort = address[0] != '\0' && std::strspn(address, "0123456789") == std::strlen(address);
+        m_listenFd = isPort ? listenTcp(std::atoi(address)) : listenUnix(address);
+        if (m_listenFd < 0) return false;
+        m_stop.store(false, std::memory_order_relaxed);
+        m_thread = std::thread([this] { serve(); });
+        return true;
+    }
+
+    void stop() {
+        if (m_listenFd < 0) return;
+        m_stop.store(true, std::memory_order_relaxed);
+        if (m_thread.joinable()) m_thread.join();
+        ::close(m_listenFd);
+        m_listenFd = -1;
+        if (m_path[0]) ::unlink(m_path);
+        m_path[0] = '\0';
+    }
+
+    [[nodiscard]] bool running() const noexcept { return m_listenFd >= 0; }
+    [[nodiscard]] uint64_t scrapes() const noexcept { return m_scrapes.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr int kPollMs = 200;        // stop() latency
+    static constexpr int kClientTimeoutMs = 1000;
+
+    int listenTcp(int port) {
+        if (port <= 0 || port > 65535) return -1;
+        const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) return -1;
+        const int reuse = 1;
+        ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(static_cast<uint16_t>(port));
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);   // Never exposed beyond the machine
+        if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(fd, 4) != 0) {
+            ::close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    int listenUnix(const char* path) {
+        sockaddr_un addr{};
+        if (std::strlen(path) >= sizeof(addr.sun_path)) return -1;
+        const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return -1;
+        addr.sun_family = AF_UNIX;
+        std::strcpy(addr.sun_path, path);
+        ::unlink(path);   // Stale socket from a previous run
+        if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(fd, 4) != 0) {
+            ::close(fd);
+            return -1;
+        }
+        std::strcpy(m_path, path);
+        return fd;
+    }
+
+    void serve() {
+        while (!m_stop.load(std::memory_order_relaxed)) {
+            pollfd listener{m_listenFd, POLLIN, 0};
+            if (::poll(&listener, 1, kPollMs) <= 0) continue;
+            const int client = ::accept(m_listenFd, nullptr, nullptr);
+            if (client < 0) continue;
+            // Non-blocking: a scraper that stops reading times out instead of holding stop()
+            ::fcntl(client, F_SETFL, ::fcntl(client, F_GETFL) | O_NONBLOCK);
+#ifdef SO_NOSIGPIPE
+            const int noSigpipe = 1;
+            ::setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &noSigpipe, sizeof(noSigpipe));
+#endif
+            respond(client);
+            ::close(client);
+        }
+    }
+
+    // Reads the request head, answers GET /metrics (or /) and closes
+    void respond(int client) {
+        size_t received = 0;
+        while (received + 1 < sizeof(m_request)) {
+            pollfd readable{client, POLLIN, 0};
+            if (::poll(&readable, 1, kClientTimeoutMs) <= 0) return;
+            const ssize_t n = ::recv(client, m_request + received, sizeof(m_request) - 1 - received, 0);
+            if (n <= 0) return;
+            received += static_cast<size_t>(n);
+            m_request[received] = '\0';
+            if (std::strstr(m_request, "\r\n\r\n") || std::strstr(m_request, "\n\n")) break;
+        }
+
+        // "/metrics" exactly, optionally with a query; "/metricsfoo" is not it
+        const bool get = std::strncmp(m_request, "GET ", 4) == 0;
+        const bool metrics = get && ((std::strncmp(m_request + 4, "/metrics", 8) == 0 &&
+                                      (m_request[12] == ' ' || m_request[12] == '?')) ||
+                                     std::strncmp(m_request + 4, "/ ", 2) == 0);
+        size_t bodyLength = 0;
+        const char* status = "404 Not Found";
+        if (metrics) {
+            bodyLength = m_registry->format(m_body, sizeof(m_body));
+            status = "200 OK";
+            m_scrapes.fetch_add(1, std::memory_order_relaxed);
+        } else if (!get) {
+            status = "405 Method Not Allowed";
+        }
+        char head[160];
+        const int headLength = std::snprintf(head, sizeof(head),
+                                             "HTTP/1.1 %s\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                                             "Content-Length: %zu\r\nConnection: close\r\n\r\n",
+                                             status, bodyLength);
+        if (sendAll(client, head, static_cast<size_t>(headLength))) sendAll(client, m_body, bodyLength);
+    }
+
+    // Gives up when the client accepts nothing for kClientTimeoutMs, or on stop()
+    bool sendAll(int fd, const char* data, size_t size) const {
+#ifdef MSG_NOSIGNAL
+        constexpr int kFlags = MSG_NOSIGNAL;   // A scraper hanging up must not kill the face
+#else
+        constexpr int kFlags = 0;
+#endif
+        while (size > 0) {
+            const ssize_t n = ::send(fd, data, size, kFlags);
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                pollfd writable{fd, POLLOUT, 0};
+                if (m_stop.load(std::memory_order_relaxed) || ::poll(&writable, 1, kClientTimeoutMs) <= 0) return false;
+                continue;
+            }
+            if (n <= 0) return false;
+            data += n;
+            size -= static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    const MetricsRegistry* m_registry = nullptr;
+    int m_listenFd = -1;
+    std::thread m_thread;
+    std::atomic<bool> m_stop{false};
+    std::atomic<uint64_t> m_scrapes{0};
+    char m_path[108] = {};   // Unix socket to unlink on stop
+    char m_request[2048] = {};
+    char m_body[16384] = {};
+};
+
+} // namespace robotface
+
+#endif // ROBOT_FACE_METRICS_HPP
@@ -0,0 +1,251 @@
+#ifndef ROBOT_FACE_PACING_HPP
+#define ROBOT_FACE_PACING_HPP
+
+/**
+ * Frame pacing analysis from present timestamps
+ *
+ * The render loop hands PacingAnalyzer the time each frame was presented and
+ * the interval it aimed for (the frame limiter's target, or 0 when uncapped:
+ * then the display's refresh period is expected). Each interval T' against
+ * the expected T is classified:
+ *
+ *   Doubled  T' < T/2: two presents inside one refresh, one never shown
+ *   Missed   T' >= 1.5 T: the frame stayed on screen for round(T'/T) periods,
+ *            round(T'/T) - 1 vsyncs were missed
+ *   Jitter   |T' - T| > max(jitterFraction * T, jitterMinMs): on its vsync
+ *            but uneven enough to be seen as judder
+ *   OnTime   otherwise
+ *
+ * A mean frame time can look perfect while the intervals alternate 8/25 ms;
+ * the session metrics are about the spread instead: the share of on-time
+ * intervals, RMS deviation from the target, judder (mean change between
+ * consecutive intervals), percentiles and the longest on-time run.
+ *
+ * The last kHistory intervals are kept for an overlay graph (PacingGraph).
+ * Nothing allocates: fixed arrays, safe to call every frame.
+ */
+
+#include "robot_face_canvas.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+namespace robotface {
+
+struct PacingConfig {
+    float refreshHz = 60.0f;        // Expected rate when the loop is uncapped
+    float jitterFraction = 0.2f;    // Allowed deviation as a share of the expected interval
+    float jitterMinMs = 1.0f;       // ... but never less than this (timer and compositor noise)
+};
+
+enum class PacingEvent : uint8_t {
+    OnTime = 0,
+    Jitter,
+    Missed,
+    Doubled
+};
+
+constexpr int kPacingEventCount = 4;
+constexpr const char* kPacingEventNames[kPacingEventCount] = {"on-time", "jitter", "missed", "doubled"};
+constexpr Rgba kPacingEventColors[kPacingEventCount] = {
+    {0, 158, 47, 255},     // Green
+    {255, 161, 0, 255},    // Orange
+    {230, 41, 55, 255},    // Red
+    {0, 121, 241, 255},    // Blue
+};
+
+struct PacingStats {
+    uint64_t intervals = 0;
+    uint64_t events[kPacingEventCount] = {};
+    uint64_t missedVsyncs = 0;        // Refresh periods skipped by Missed intervals
+    double sumMs = 0.0;
+    double sumDeviationSq = 0.0;      // (T' - T)^2
+    double sumJudderMs = 0.0;         // |T'(n) - T'(n-1)|
+    double worstMs = 0.0;
+    uint64_t onTimeRun = 0;
+    uint64_t longestOnTimeRun = 0;
+
+    [[nodiscard]] double meanMs() const noexcept { return intervals ? sumMs / static_cast<double>(intervals) : 0.0; }
+    [[nodiscard]] double rmsDeviationMs() const noexcept {
+        return intervals ? std::sqrt(sumDeviationSq / static_cast<double>(intervals)) : 0.0;
+    }
+    [[nodiscard]] double judderMs() const noexcept {
+        return intervals > 1 ? sumJudderMs / static_cast<double>(intervals - 1) : 0.0;
+    }
+    [[nodiscard]] double share(PacingEvent event) const noexcept {
+        return intervals ? static_cast<double>(events[static_cast<int>(event)]) / static_cast<double>(intervals) : 0.0;
+    }
+};
+
+class PacingAnalyzer {
+public:
+    static constexpr int kHistory = 256;        // ~4 s at 60 Hz
+    static constexpr float kBinMs = 0.25f;      // Percentile resolution
+    static constexpr int kBins = 1024;          // Up to 256 ms; longer intervals share the last bin
+
+    explicit PacingAnalyzer(const PacingConfig& config = PacingConfig{}) noexcept : m_config(config) {}
+
+    [[nodiscard]] const PacingConfig& config() const noexcept { return m_config; }
+
+    // Present at `seconds` (any monotonic clock) aiming for targetMs (0: uncapped). The first
+    // present only starts the clock. Returns the interval's classification.
+    PacingEvent addPresent(double seconds, float targetMs = 0.0f) noexcept {
+        if (!m_started) {
+            m_started = true;
+            m_lastPresent = seconds;
+            return PacingEvent::OnTime;
+        }
+        const float intervalMs = static_cast<float>((seconds - m_lastPresent) * 1000.0);
+        m_lastPresent = seconds;
+        return addInterval(intervalMs, targetMs);
+    }
+
+    PacingEvent addInterval(float intervalMs, float targetMs = 0.0f) noexcept {
+        const float expectedMs = targetMs > 0.0f ? targetMs : 1000.0f / m_config.refreshHz;
+        const float ratio = intervalMs / expectedMs;
+        PacingEvent event = PacingEvent::OnTime;
+        if (ratio < 0.5f) {
+            event = PacingEvent::Doubled;
+        } else if (ratio >= 1.5f) {
+            event = PacingEvent::Missed;
+            m_stats.missedVsyncs += static_cast<uint64_t>(std::lround(ratio)) - 1;
+        } else if (std::fabs(intervalMs - expectedMs) > std::max(m_config.jitterFraction * expectedMs, m_config.jitterMinMs)) {
+            event = PacingEvent::Jitter;
+        }
+
+        const double deviation = static_cast<double>(intervalMs - expectedMs);
+        if (m_stats.intervals > 0) m_stats.sumJudderMs += std::fabs(static_cast<double>(intervalMs - m_lastIntervalMs));
+        m_stats.intervals++;
+        m_stats.events[static_cast<int>(event)]++;
+        m_stats.sumMs += intervalMs;
+        m_stats.sumDeviationSq += deviation * deviation;
+        m_stats.worstMs = std::max(m_stats.worstMs, static_cast<double>(intervalMs));
+        m_stats.onTimeRun = event == PacingEvent::OnTime ? m_stats.onTimeRun + 1 : 0;
+        m_stats.longestOnTimeRun = std::max(m_stats.longestOnTimeRun, m_stats.onTimeRun);
+        m_bins[std::min(static_cast<int>(std::max(intervalMs, 0.0f) / kBinMs), kBins - 1)]++;
+        m_lastIntervalMs = intervalMs;
+
+        m_history[m_next] = Sample{intervalMs, expectedMs, event};
+        m_next = (m_next + 1) % kHistory;
+        m_count = std::min(m_count + 1, kHistory);
+        return event;
+    }
+
+    void reset() noexcept { *this = PacingAnalyzer(m_config); }
+
+    [[nodiscard]] const PacingStats& stats() const noexcept { return m_stats; }
+
+    // Interval below which `fraction` of all intervals fall (bin upper edge)
+    [[nodiscard]] double percentileMs(double fraction) const noexcept {
+        if (m_stats.intervals == 0) return 0.0;
+        const double rank = fraction * static_cast<double>(m_stats.intervals);
+        uint64_t seen = 0;
+        for (int bin = 0; bin < kBins; bin++) {
+            seen += m_bins[bin];
+            if (static_cast<double>(seen) >= rank) return (bin + 1) * static_cast<double>(kBinMs);
+        }
+        return kBins * static_cast<double>(kBinMs);
+    }
+
+    // Recent intervals, oldest first (index < historySize())
+    struct Sample {
+        float intervalMs;
+        float expectedMs;
+        PacingEvent event;
+    };
+    [[nodiscard]] int historySize() const noexcept { return m_count; }
+    [[nodiscard]] const Sample& history(int index) const noexcept {
+        return m_history[(m_next - m_count + index + kHistory) % kHistory];
+    }
+
+    // Overlay line: "Pacing 98.2% on time  missed 3  doubled 0  jitter 12  judder 0.41 ms"
+    int summary(char* buffer, size_t size) const noexcept {
+        return std::snprintf(buffer, size, "Pacing %.1f%% on time  missed %llu  doubled %llu  jitter %llu  judder %.2f ms",
+                             m_stats.share(PacingEvent::OnTime) * 100.0,
+                             static_cast<unsigned long long>(m_stats.events[static_cast<int>(PacingEvent::Missed)]),
+                             static_cast<unsigned long long>(m_stats.events[static_cast<int>(PacingEvent::Doubled)]),
+                             static_cast<unsigned long long>(m_stats.events[static_cast<int>(PacingEvent::Jitter)]),
+                             m_stats.judderMs());
+    }
+
+    // Session report, one "pacing" block per run
+    void report(std::FILE* out, const char* name) const {
+        const PacingStats& s = m_stats;
+        std::fprintf(out, "pacing %s: %llu intervals, mean %.3f ms, RMS deviation from target %.3f ms, judder %.3f ms\n",
+                     name, static_cast<unsigned long long>(s.intervals), s.meanMs(), s.rmsDeviationMs(), s.judderMs());
+        std::fprintf(out, "pacing %s: p50 %.2f ms  p95 %.2f ms  p99 %.2f ms  worst %.2f ms\n", name, percentileMs(0.50),
+                     percentileMs(0.95), percentileMs(0.99), s.worstMs);
+        for (int i = 0; i < kPacingEventCount; i++) {
+            std::fprintf(out, "pacing %s: %-8s %8llu  %6.2f%%\n", name, kPacingEventNames[i],
+                         static_cast<unsigned long long>(s.events[i]), s.share(static_cast<PacingEvent>(i)) * 100.0);
+        }
+        std::fprintf(out, "pacing %s: %llu vsyncs missed, longest on-time run %llu frames\n", name,
+                     static_cast<unsigned long long>(s.missedVsyncs), static_cast<unsigned long long>(s.longestOnTimeRun));
+    }
+
+private:
+    PacingConfig m_config;
+    PacingStats m_stats;
+    bool m_started = false;
+    double m_lastPresent = 0.0;
+    float m_lastIntervalMs = 0.0f;
+    uint32_t m_bins[kBins] = {};
+    Sample m_history[kHistory] = {};
+    int m_next = 0;
+    int m_count = 0;
+};
+
+// Overlay graph of the recent intervals, laid out into a box for any backend: the
+// polyline is interval / expected (so the scale survives target changes), from 0 at
+// the bottom to kRange at the top, newest on the right; reference lines mark on-time
+// (1) and one missed vsync (2); every non on-time interval gets a marker.
+struct PacingGraph {
+    static constexpr float kRange = 3.0f;
+
+    Point2 line[PacingAnalyzer::kHistory];
+    int lineCount = 0;
+    Point2 markers[PacingAnalyzer::kHistory];
+    PacingEvent markerEvents[PacingAnalyzer::kHistory];
+    int markerCount = 0;
+    Point2 onTime[2];
+    Point2 missed[2];
+
+    void layout(const PacingAnalyzer& pacing, float x, float y, float width, float height) noexcept {
+        const float step = width / static_cast<float>(PacingAnalyzer::kHistory - 1);
+        const int count = pacing.historySize();
+        const float left = x + width - step * static_cast<float>(std::max(count - 1, 0));
+        auto level = [&](float ratio) { return y + height - std::min(ratio, kRange) / kRange * height; };
+
+        lineCount = 0;
+        markerCount = 0;
+        for (int i = 0; i < count; i++) {
+            const PacingAnalyzer::Sample& sample = pacing.history(i);
+            const Point2 point{left + step * static_cast<float>(i), level(sample.intervalMs / sample.expectedMs)};
+            line[lineCount++] = point;
+            if (sample.event != PacingEvent::OnTime) {
+                markers[markerCount] = point;
+                markerEvents[markerCount++] = sample.event;
+            }
+        }
+        onTime[0] = Point2{x, level(1.0f)};
+        onTime[1] = Point2{x + width, level(1.0f)};
+        missed[0] = Point2{x, level(2.0f)};
+        missed[1] = Point2{x + width, level(2.0f)};
+    }
+
+    // Through the backend-neutral canvas (raylib, software, display lists)
+    void draw(Canvas& canvas) const {
+        canvas.strokePath(onTime, 2, 1.0f, Rgba{130, 130, 130, 160});
+        canvas.strokePath(missed, 2, 1.0f, Rgba{230, 41, 55, 120});
+        if (lineCount > 1) canvas.strokePath(line, lineCount, 1.5f, Rgba{80, 80, 80, 255});
+        for (int i = 0; i < markerCount; i++) {
+            canvas.circle(markers[i], 2.5f, kPacingEventColors[static_cast<int>(markerEvents[i])]);
+        }
+    }
+};
+
+} // namespace robotface
+
+#endif // ROBOT_FACE_PACING_HPP
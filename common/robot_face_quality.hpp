@@ -0,0 +1,153 @@
+#ifndef ROBOT_FACE_QUALITY_HPP
+#define ROBOT_FACE_QUALITY_HPP
+
+/**
+ * Adaptive quality governor for robot face renderers
+ *
+ * The governor watches frame times against a budget. Under pressure it steps
+ * down a fixed ladder of quality levels, and it steps back up once there is
+ * headroom again:
+ *
+ *   0 full         30 mouth segments, anti-aliasing, overlay, live eyes, full resolution
+ *   1 mouth-16     16 mouth segments
+ *   2 no-aa        Anti-aliasing off (Skia; raylib shapes are never anti-aliased)
+ *   3 no-overlay   Emotion / FPS / counter text off
+ *   4 eye-sprites  12 mouth segments, pupils drawn from a cached sprite
+ *   5 half-res     Face rendered at half resolution, upscaled to the window
+ *
+ * Rules (frames are grouped into windows of `window` frames):
+ *   down  as soon as `downFrames` frames of the current window exceed the budget
+ *   up    after `upWindows` consecutive windows whose slowest frame stays below
+ *         budget * upHeadroom
+ * Both decisions start a new window, so a level gets at least one full window
+ * before the next step. A step up that is undone within its first window doubles
+ * the calm windows the next step up needs (up to maxUpWindows), so a load that
+ * sits between two levels does not make the governor flip between them; a level
+ * that holds for a full window resets the requirement. The level depends only on
+ * the sequence of frame times fed in, so a recorded frame time trace always
+ * replays to the same levels.
+ * addFrame() returns true on a change; the caller logs it.
+ */
+
+#include <cstdint>
+
+namespace robotface {
+
+struct QualitySettings {
+    int mouthSegments;        // Bezier segments per lip
+    bool antiAlias;           // Anti-aliased paints (Skia)
+    bool overlay;             // Status text (emotion, FPS, counters)
+    bool eyeSprites;          // Pupils from a cached sprite
+    float resolutionScale;    // Internal resolution, upscaled to the window
+};
+
+constexpr int kQualityLevelCount = 6;
+
+constexpr QualitySettings kQualityLevels[kQualityLevelCount] = {
+    {30, true, true, false, 1.0f},
+    {16, true, true, false, 1.0f},
+    {16, false, true, false, 1.0f},
+    {16, false, false, false, 1.0f},
+    {12, false, false, true, 1.0f},
+    {12, false, false, true, 0.5f},
+};
+
+constexpr const char* kQualityLevelNames[kQualityLevelCount] = {
+    "full", "mouth-16", "no-aa", "no-overlay", "eye-sprites", "half-res",
+};
+
+struct GovernorConfig {
+    float budgetMs = 1000.0f / 60.0f;   // Frame budget
+    int window = 30;                    // Frames per decision window
+    int downFrames = 3;                 // Over-budget frames in a window that step down
+    float upHeadroom = 0.75f;           // Slowest frame below budget * upHeadroom counts as calm
+    int upWindows = 3;                  // Calm windows in a row that step up
+    int maxUpWindows = 12;              // Back-off limit after failed steps up
+};
+
+class QualityGovernor {
+public:
+    explicit QualityGovernor(const GovernorConfig& config = GovernorConfig{}) noexcept : m_config(config) {}
+
+    // One frame's time; true when the level changed
+    bool addFrame(float frameMs) noexcept {
+        m_frames++;
+        m_windowFrames++;
+        if (frameMs > m_config.budgetMs) m_overBudget++;
+        if (frameMs > m_windowMax) m_windowMax = frameMs;
+
+        if (m_overBudget >= m_config.downFrames) {
+            m_calmWindows = 0;
+            if (m_probing) m_upWindows = m_upWindows * 2 < m_config.maxUpWindows ? m_upWindows * 2 : m_config.maxUpWindows;
+            m_probing = false;
+            return changeLevel(m_level + 1);
+        }
+        if (m_windowFrames < m_config.window) return false;
+
+        if (m_probing) {
+            m_probing = false;
+            m_upWindows = m_config.upWindows;
+        }
+        const bool calm = m_windowMax < m_config.budgetMs * m_config.upHeadroom;
+        m_calmWindows = calm ? m_calmWindows + 1 : 0;
+        if (m_calmWindows >= m_upWindows) {
+            m_calmWindows = 0;
+            m_probing = m_level > 0;
+            return changeLevel(m_level - 1);
+        }
+        resetWindow();
+        return false;
+    }
+
+    // Jump to a level; later frames adapt from there
+    void setLevel(int level) noexcept {
+        m_level = clampLevel(level);
+        m_previousLevel = m_level;
+        m_calmWindows = 0;
+        m_upWindows = m_config.upWindows;
+        m_probing = false;
+        resetWindow();
+    }
+
+    [[nodiscard]] int level() const noexcept { return m_level; }
+    [[nodiscard]] int previousLevel() const noexcept { return m_previousLevel; }
+    [[nodiscard]] const QualitySettings& settings() const noexcept { return kQualityLevels[m_level]; }
+    [[nodiscard]] const char* levelName() const noexcept { return kQualityLevelNames[m_level]; }
+    [[nodiscard]] uint64_t frames() const noexcept { return m_frames; }
+    [[nodiscard]] const GovernorConfig& config() const noexcept { return m_config; }
+
+private:
+    static int clampLevel(int level) noexcept {
+        return level < 0 ? 0 : (level >= kQualityLevelCount ? kQualityLevelCount - 1 : level);
+    }
+
+    bool changeLevel(int level) noexcept {
+        resetWindow();
+        level = clampLevel(level);
+        if (level == m_level) return false;
+        m_previousLevel = m_level;
+        m_level = level;
+        return true;
+    }
+
+    void resetWindow() noexcept {
+        m_windowFrames = 0;
+        m_overBudget = 0;
+        m_windowMax = 0.0f;
+    }
+
+    GovernorConfig m_config;
+    int m_level = 0;
+    int m_previousLevel = 0;
+    uint64_t m_frames = 0;
+    int m_windowFrames = 0;
+    int m_overBudget = 0;
+    float m_windowMax = 0.0f;
+    int m_calmWindows = 0;
+    int m_upWindows = m_config.upWindows;   // Calm windows the next step up needs
+    bool m_probing = false;                 // In the first window after a step up
+};
+
+} // namespace robotface
+
+#endif // ROBOT_FACE_QUALITY_HPP
@@ -0,0 +1,110 @@
+#ifndef ROBOT_FACE_SCENARIO_H
+#define ROBOT_FACE_SCENARIO_H
+
+/**
+ * Scripted input scenario shared by the robot face executables
+ *
+ * `--scenario N` replaces keyboard and mouse input with a fixed 12 second
+ * script: emotion changes, manual blinks, a mouth hover, a moving gaze
+ * target and a stretch of speech. It runs N frames at a fixed 60 Hz step,
+ * uncapped, then exits and prints the mean frame time. The run is the same
+ * every time, so it serves both as the training run for profile-guided
+ * builds and as a frame time benchmark for each build variant.
+ *
+ * Usage in a main loop:
+ *   RobotFaceScenario scenario;
+ *   RobotFaceScenarioInit(&scenario, argc, argv);
+ *   ...
+ *   RobotFaceScenarioInput input;
+ *   if (scenario.frames > 0 && !RobotFaceScenarioNext(&scenario, &input)) break;
+ *   ...
+ *   RobotFaceScenarioReport(&scenario, "robot_face_c");
+ *
+ * Header-only (static inline), C11 / C++17.
+ */
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define ROBOT_FACE_SCENARIO_LENGTH 720     // Frames per script cycle (12 s at 60 Hz)
+#define ROBOT_FACE_SCENARIO_WARMUP 60      // Frames excluded from the frame time
+
+typedef struct {
+    int frames;              // Scripted frames to run (0: interactive)
+    int frame;               // Next frame
+    double startSeconds;     // Clock at the end of the warm-up
+    double endSeconds;       // Clock after the last frame
+} RobotFaceScenario;
+
+typedef struct {
+    float deltaTime;         // Fixed step
+    float happiness;         // Emotion to set this frame (< 0: unchanged)
+    bool blink;              // Trigger a manual blink
+    bool hover;              // Mouse over the mouth
+    float gazeX;             // Look-at target (face coordinates)
+    float gazeY;
+    float mouthOpenness;     // Speech, 0..1
+} RobotFaceScenarioInput;
+
+static inline double RobotFaceScenarioClock(void) {
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+// Reads `--scenario N` from the command line (frames = 0 without it)
+static inline void RobotFaceScenarioInit(RobotFaceScenario* scenario, int argc, char** argv) {
+    memset(scenario, 0, sizeof(*scenario));
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--scenario") == 0) {
+            int frames = atoi(argv[i + 1]);
+            scenario->frames = (frames > ROBOT_FACE_SCENARIO_WARMUP) ? frames : ROBOT_FACE_SCENARIO_WARMUP + 1;
+        }
+    }
+}
+
+// Input for the next frame; false once all frames have run
+static inline bool RobotFaceScenarioNext(RobotFaceScenario* scenario, RobotFaceScenarioInput* input) {
+    const float twoPi = 6.28318531f;
+    const int frame = scenario->frame;
+
+    if (frame == ROBOT_FACE_SCENARIO_WARMUP) scenario->startSeconds = RobotFaceScenarioClock();
+    if (frame >= scenario->frames) {
+        scenario->endSeconds = RobotFaceScenarioClock();
+        return false;
+    }
+    scenario->frame++;
+
+    const int t = frame % ROBOT_FACE_SCENARIO_LENGTH;
+    input->deltaTime = 1.0f / 60.0f;
+
+    // Happy, neutral, sad, back to the default (automatic blinks keep running)
+    input->happiness = -1.0f;
+    if (t == 0) input->happiness = 1.0f;
+    else if (t == 180) input->happiness = 0.5f;
+    else if (t == 360) input->happiness = 0.0f;
+    else if (t == 540) input->happiness = 0.8f;
+
+    input->blink = (t == 90 || t == 450);
+    input->hover = (t >= 600 && t < 660);
+
+    // Gaze sweeps the window, speech runs while the face is sad
+    input->gazeX = 400.0f + 300.0f * sinf(twoPi * (float)t / 240.0f);
+    input->gazeY = 200.0f + 120.0f * sinf(twoPi * (float)t / 180.0f);
+    input->mouthOpenness = (t >= 360 && t < 540) ? 0.5f + 0.5f * sinf(twoPi * (float)t / 12.0f) : 0.0f;
+    return true;
+}
+
+static inline void RobotFaceScenarioReport(const RobotFaceScenario* scenario, const char* name) {
+    const int measured = scenario->frames - ROBOT_FACE_SCENARIO_WARMUP;
+    if (scenario->frames == 0 || scenario->frame < scenario->frames) return;
+
+    printf("%s: scenario %d frames, %.4f ms/frame\n", name, scenario->frames,
+           (scenario->endSeconds - scenario->startSeconds) * 1000.0 / measured);
+}
+
+#endif // ROBOT_FACE_SCENARIO_H
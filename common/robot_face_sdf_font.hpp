@@ -0,0 +1,417 @@
+#ifndef ROBOT_FACE_SDF_FONT_HPP
+#define ROBOT_FACE_SDF_FONT_HPP
+
+/**
+ * Signed distance field font for the status text overlay
+ *
+ * The glyphs are a monospace stroke font (printable ASCII) drawn on a 9x17 unit
+ * grid: cap height 0..12, x-height 4, baseline 12, descenders down to 16. Each
+ * glyph is baked into a cell of a single-channel atlas that stores the distance
+ * to the nearest stroke edge instead of coverage (0.5 = edge, 1 = deep inside).
+ * Sampled bilinearly and thresholded at 0.5, one small atlas draws sharp text at
+ * any size, so a scaled face no longer blurs its text and every glyph costs the
+ * same textured quad.
+ *
+ * The atlas is one blob: a SdfAtlasHeader followed by the pixels. bakeSdfAtlas()
+ * writes it (at build time with robot_face_font_baker, or at startup), and
+ * SdfFont::load() views it in place: nothing is copied or allocated.
+ *
+ * TextBatch collects the text of a frame as quads in one reused buffer; a backend
+ * submits it in one draw (or one per run where the edge smoothing is a uniform).
+ *
+ * Usage:
+ *   SdfFont font;
+ *   font.load(blob, blobSize);
+ *   TextBatch batch;
+ *   batch.add(font, "FPS: 60", Point2{10, 70}, 20, color);   // Canvas::text semantics
+ *   ... submit batch.quads(), then batch.clear()
+ */
+
+#include "robot_face_canvas.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace robotface {
+
+// Blob header (little-endian, pixels at pixelOffset, row stride = width)
+struct SdfAtlasHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t firstChar;       // Cell 0
+    uint16_t glyphCount;
+    uint16_t columns;         // Cells per atlas row
+    uint16_t cellWidth;       // Pixels
+    uint16_t cellHeight;
+    uint16_t width;           // Atlas pixels
+    uint16_t height;
+    uint16_t originX;         // Pixel of grid point (0, 0) inside a cell
+    uint16_t originY;
+    uint16_t pixelsPerUnit;
+    uint16_t spread;          // Distance in pixels from the edge to 0 or 1
+    uint16_t emUnits;         // Text size (line height) in grid units
+    uint16_t ascentUnits;     // Top of the line to grid y = 0 (cap height)
+    uint16_t baselineUnits;   // Grid y of the baseline
+    uint16_t advanceUnits;    // Pen advance per glyph
+    uint32_t pixelOffset;
+};
+
+static_assert(sizeof(SdfAtlasHeader) == 40, "SdfAtlasHeader is serialized as is");
+
+constexpr uint32_t kSdfAtlasMagic = 0x46534652u;   // "RFSF"
+constexpr uint16_t kSdfAtlasVersion = 1;
+
+namespace sdf {
+
+constexpr int kFirstChar = 32;
+constexpr int kGlyphCount = 95;          // ' ' .. '~'
+constexpr int kColumns = 16;
+constexpr int kPixelsPerUnit = 3;
+constexpr int kSpread = 6;               // Pixels (two grid units)
+constexpr int kCellWidth = 40;           // Grid -2.7 .. 10.7
+constexpr int kCellHeight = 64;          // Grid -2.7 .. 18.7
+constexpr int kOrigin = 8;
+constexpr int kEmUnits = 17;
+constexpr int kAscentUnits = 1;
+constexpr int kBaselineUnits = 12;
+constexpr int kAdvanceUnits = 10;
+constexpr float kStrokeHalfWidth = 0.8f; // Grid units
+constexpr uint32_t kPixelOffset = 64;
+
+// Strokes per glyph: polylines separated by spaces, each point two digits (x, y) of
+// base 17 on the grid. Uppercase, lowercase and digits share the cap, x-height and
+// baseline so mixed text lines up.
+constexpr const char* kGlyphStrokes[kGlyphCount] = {
+    "",                                                            // space
+    "4048 4b4c",                                                   // !
+    "2023 6063",                                                   // "
+    "312b 716b 0484 0888",                                         // #
+    "82602002042666888a6c2c0a 404c",                               // $
+    "0c80 0020220200 6a8a8c6c6a",                                  // %
+    "8c141120405153080a2c5c88",                                    // &
+    "4043",                                                        // '
+    "60434b6e",                                                    // (
+    "20434b2e",                                                    // )
+    "424a 1478 7418",                                              // *
+    "434b 0787",                                                   // +
+    "4b4c3e",                                                      // ,
+    "1777",                                                        // -
+    "4b4c",                                                        // .
+    "0c80",                                                        // /
+    "2060828a6c2c0a0220 2963",                                     // 0
+    "22404c 2c6c",                                                 // 1
+    "02206082840c8c",                                              // 2
+    "01206082846636 66888a6c2c0b",                                 // 3
+    "6c600888",                                                    // 4
+    "80000565878a6c2c0a",                                          // 5
+    "7030030a2c6c8a88662608",                                      // 6
+    "00803c",                                                      // 7
+    "260402206082846626080a2c6c8a8866",                            // 8
+    "8466260402206082895c1c",                                      // 9
+    "4445 4b4c",                                                   // :
+    "4445 4b4c3e",                                                 // ;
+    "82178c",                                                      // <
+    "0585 0989",                                                   // =
+    "02770c",                                                      // >
+    "02206082844748 4b4c",                                         // ?
+    "68643426386886826020020a2c7c",                                // @
+    "0c408c 1979",                                                 // A
+    "0666888a6c0c0050727456",                                      // B
+    "826020020a2c6c8a",                                            // C
+    "000c5c89835000",                                              // D
+    "80000c8c 0666",                                               // E
+    "80000c 0666",                                                 // F
+    "826020020a2c6c8a8757",                                        // G
+    "000c 808c 0686",                                              // H
+    "2060 404c 2c6c",                                              // I
+    "808a6c2c0a",                                                  // J
+    "000c 8007 258c",                                              // K
+    "000c8c",                                                      // L
+    "0c0047808c",                                                  // M
+    "0c008c80",                                                    // N
+    "2060828a6c2c0a0220",                                          // O
+    "0c006082846606",                                              // P
+    "2060828a6c2c0a0220 598d",                                     // Q
+    "0c006082846606 468c",                                         // R
+    "82602002042666888a6c2c0a",                                    // S
+    "0080 404c",                                                   // T
+    "000a2c6c8a80",                                                // U
+    "004c80",                                                      // V
+    "002c456c80",                                                  // W
+    "008c 800c",                                                   // X
+    "004680 464c",                                                 // Y
+    "00800c8c",                                                    // Z
+    "60303e6e",                                                    // [
+    "008c",                                                        // backslash
+    "20505e2e",                                                    // ]
+    "144074",                                                      // ^
+    "0e8e",                                                        // _
+    "3052",                                                        // `
+    "1464868c 88280a2c6c8a",                                       // a
+    "000c 062464868a6c2c0a",                                       // b
+    "857424060a2c7c8b",                                            // c
+    "808c 866424060a2c6c8a",                                       // d
+    "0888866424060a2c7c",                                          // e
+    "7050323c 0474",                                               // f
+    "848e6g1g 866424060a2c6c8a",                                   // g
+    "000c 062464868c",                                             // h
+    "444c 4041",                                                   // i
+    "545e3g1g 5051",                                               // j
+    "000c 7409 378c",                                              // k
+    "303a5c6c",                                                    // l
+    "0c04 061434464c 465474868c",                                  // m
+    "040c 062464868c",                                             // n
+    "2464868a6c2c0a0624",                                          // o
+    "040g 062464868a6c2c0a",                                       // p
+    "848g 866424060a2c6c8a",                                       // q
+    "040c 07347485",                                               // r
+    "85741405071878898b7c1c0b",                                    // s
+    "303a5c7c 0474",                                               // t
+    "040a2c6c8a 848c",                                             // u
+    "044c84",                                                      // v
+    "042c466c84",                                                  // w
+    "048c 840c",                                                   // x
+    "044c 842g",                                                   // y
+    "04840c8c",                                                    // z
+    "60414527494d6e",                                              // {
+    "404e",                                                        // |
+    "20414567494d2e",                                              // }
+    "0826476886",                                                  // ~
+};
+
+constexpr int strokeDigit(char c) noexcept {
+    return c <= '9' ? c - '0' : c - 'a' + 10;
+}
+
+// Squared distance from (px, py) to the segment a-b (grid units)
+inline float segmentDistanceSq(float px, float py, float ax, float ay, float bx, float by) noexcept {
+    const float dx = bx - ax;
+    const float dy = by - ay;
+    const float lengthSq = dx * dx + dy * dy;
+    float t = lengthSq > 0.0f ? ((px - ax) * dx + (py - ay) * dy) / lengthSq : 0.0f;
+    t = std::clamp(t, 0.0f, 1.0f);
+    const float ex = px - ax - t * dx;
+    const float ey = py - ay - t * dy;
+    return ex * ex + ey * ey;
+}
+
+} // namespace sdf
+
+// One glyph: screen rectangle, atlas rectangle (normalized) and color
+struct TextQuad {
+    float x0;
+    float y0;
+    float x1;
+    float y1;
+    float u0;
+    float v0;
+    float u1;
+    float v1;
+    Rgba color;
+};
+
+// Consecutive quads sharing a size and color
+struct TextRun {
+    uint32_t first;
+    uint32_t count;
+    float size;
+    Rgba color;
+};
+
+// Writes a complete atlas blob (header + pixels) into `blob`
+inline void bakeSdfAtlas(std::vector<uint8_t>& blob) {
+    using namespace sdf;
+
+    const int rows = (kGlyphCount + kColumns - 1) / kColumns;
+    SdfAtlasHeader header{};
+    header.magic = kSdfAtlasMagic;
+    header.version = kSdfAtlasVersion;
+    header.firstChar = kFirstChar;
+    header.glyphCount = kGlyphCount;
+    header.columns = kColumns;
+    header.cellWidth = kCellWidth;
+    header.cellHeight = kCellHeight;
+    header.width = kColumns * kCellWidth;
+    header.height = static_cast<uint16_t>(rows * kCellHeight);
+    header.originX = kOrigin;
+    header.originY = kOrigin;
+    header.pixelsPerUnit = kPixelsPerUnit;
+    header.spread = kSpread;
+    header.emUnits = kEmUnits;
+    header.ascentUnits = kAscentUnits;
+    header.baselineUnits = kBaselineUnits;
+    header.advanceUnits = kAdvanceUnits;
+    header.pixelOffset = kPixelOffset;
+
+    blob.assign(kPixelOffset + static_cast<size_t>(header.width) * header.height, 0);
+    std::memcpy(blob.data(), &header, sizeof(header));
+    uint8_t* pixels = blob.data() + kPixelOffset;
+
+    struct Segment {
+        float ax, ay, bx, by;
+    };
+    std::vector<Segment> segments;
+
+    for (int glyph = 0; glyph < kGlyphCount; glyph++) {
+        // Polylines to segments
+        segments.clear();
+        for (const char* s = kGlyphStrokes[glyph]; *s;) {
+            if (*s == ' ') {
+                s++;
+                continue;
+            }
+            float x = static_cast<float>(strokeDigit(s[0]));
+            float y = static_cast<float>(strokeDigit(s[1]));
+            for (s += 2; *s && *s != ' '; s += 2) {
+                const float nx = static_cast<float>(strokeDigit(s[0]));
+                const float ny = static_cast<float>(strokeDigit(s[1]));
+                segments.push_back(Segment{x, y, nx, ny});
+                x = nx;
+                y = ny;
+            }
+        }
+        if (segments.empty()) continue;   // Space
+
+        // Signed distance to the stroke edge at every pixel center of the cell
+        uint8_t* cell = pixels + (glyph / kColumns) * kCellHeight * header.width + (glyph % kColumns) * kCellWidth;
+        for (int py = 0; py < kCellHeight; py++) {
+            const float gy = (static_cast<float>(py - kOrigin) + 0.5f) / kPixelsPerUnit;
+            for (int px = 0; px < kCellWidth; px++) {
+                const float gx = (static_cast<float>(px - kOrigin) + 0.5f) / kPixelsPerUnit;
+                float distanceSq = 1e9f;
+                for (const Segment& seg : segments) {
+                    distanceSq = std::min(distanceSq, segmentDistanceSq(gx, gy, seg.ax, seg.ay, seg.bx, seg.by));
+                }
+                const float distance = std::sqrt(distanceSq);
+                const float inside = (kStrokeHalfWidth - distance) * kPixelsPerUnit;   // Pixels
+                const float value = std::clamp(0.5f + inside / (2.0f * kSpread), 0.0f, 1.0f);
+                cell[py * header.width + px] = static_cast<uint8_t>(std::lround(value * 255.0f));
+            }
+        }
+    }
+}
+
+// Zero-copy view of an atlas blob
+class SdfFont {
+public:
+    // `data` must outlive the font; false if it is not a valid atlas blob
+    bool load(const uint8_t* data, size_t size) noexcept {
+        m_pixels = nullptr;
+        if (!data || size < sizeof(SdfAtlasHeader)) return false;
+
+        SdfAtlasHeader header;
+        std::memcpy(&header, data, sizeof(header));   // The blob may be unaligned
+        if (header.magic != kSdfAtlasMagic || header.version != kSdfAtlasVersion) return false;
+        if (header.columns == 0 || header.pixelsPerUnit == 0 || header.emUnits == 0) return false;
+        const int rows = (header.glyphCount + header.columns - 1) / header.columns;
+        if (header.columns * header.cellWidth > header.width || rows * header.cellHeight > header.height) return false;
+        if (header.pixelOffset < sizeof(header) ||
+            header.pixelOffset + static_cast<size_t>(header.width) * header.height > size) {
+            return false;
+        }
+
+        m_header = header;
+        m_pixels = data + header.pixelOffset;
+        return true;
+    }
+
+    [[nodiscard]] bool loaded() const noexcept { return m_pixels != nullptr; }
+    [[nodiscard]] const SdfAtlasHeader& header() const noexcept { return m_header; }
+    [[nodiscard]] const uint8_t* pixels() const noexcept { return m_pixels; }
+    [[nodiscard]] int width() const noexcept { return m_header.width; }
+    [[nodiscard]] int height() const noexcept { return m_header.height; }
+
+    // Metrics in pixels for a text size (Canvas::text size: the line height)
+    [[nodiscard]] float unitSize(float size) const noexcept { return size / m_header.emUnits; }
+    [[nodiscard]] float advance(float size) const noexcept { return unitSize(size) * m_header.advanceUnits; }
+    [[nodiscard]] float baseline(float size) const noexcept {   // Top of the line to the baseline
+        return unitSize(size) * (m_header.ascentUnits + m_header.baselineUnits);
+    }
+
+    // Half-width of the antialiased edge in atlas values (0..1) at a text size, for
+    // backends that cannot take it from screen-space derivatives: half a screen pixel
+    [[nodiscard]] float edgeSmoothing(float size) const noexcept {
+        const float screenPerAtlas = unitSize(size) / m_header.pixelsPerUnit;
+        return 0.25f / (m_header.spread * std::max(screenPerAtlas, 1e-3f));
+    }
+
+    // Quad of one character whose grid origin (cap height, left edge) is at (x, y)
+    void glyphQuad(char c, float x, float y, float size, Rgba color, TextQuad& quad) const noexcept {
+        int index = static_cast<unsigned char>(c) - m_header.firstChar;
+        if (index < 0 || index >= m_header.glyphCount) index = '?' - m_header.firstChar;
+
+        const float cellX = static_cast<float>(index % m_header.columns * m_header.cellWidth);
+        const float cellY = static_cast<float>(index / m_header.columns * m_header.cellHeight);
+        const float scale = unitSize(size) / m_header.pixelsPerUnit;   // Screen pixels per atlas pixel
+        quad.x0 = x - m_header.originX * scale;
+        quad.y0 = y - m_header.originY * scale;
+        quad.x1 = quad.x0 + m_header.cellWidth * scale;
+        quad.y1 = quad.y0 + m_header.cellHeight * scale;
+        quad.u0 = cellX / m_header.width;
+        quad.v0 = cellY / m_header.height;
+        quad.u1 = (cellX + m_header.cellWidth) / m_header.width;
+        quad.v1 = (cellY + m_header.cellHeight) / m_header.height;
+        quad.color = color;
+    }
+
+private:
+    SdfAtlasHeader m_header{};
+    const uint8_t* m_pixels = nullptr;
+};
+
+// The text of a frame as one quad buffer; clear() keeps the capacity (no steady-state heap)
+class TextBatch {
+public:
+    // Canvas::text semantics (top-left corner, size = line height); returns glyphs added
+    uint32_t add(const SdfFont& font, const char* text, Point2 topLeft, float size, Rgba color) {
+        if (!font.loaded() || size <= 0.0f) return 0;
+
+        const float advance = font.advance(size);
+        const float capTop = font.unitSize(size) * font.header().ascentUnits;
+        const auto first = static_cast<uint32_t>(m_quads.size());
+        float x = topLeft.x;
+        float y = topLeft.y + capTop;
+        for (const char* c = text; *c; c++) {
+            if (*c == '\n') {
+                x = topLeft.x;
+                y += size;
+                continue;
+            }
+            if (*c != ' ' && *c != '\t') {
+                m_quads.emplace_back();
+                font.glyphQuad(*c, x, y, size, color, m_quads.back());
+            }
+            x += advance;
+        }
+
+        const auto count = static_cast<uint32_t>(m_quads.size()) - first;
+        if (count == 0) return 0;
+        if (!m_runs.empty() && m_runs.back().size == size && m_runs.back().color == color) {
+            m_runs.back().count += count;   // Runs are always contiguous
+        } else {
+            m_runs.push_back(TextRun{first, count, size, color});
+        }
+        return count;
+    }
+
+    void clear() noexcept {
+        m_quads.clear();
+        m_runs.clear();
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return m_quads.empty(); }
+    [[nodiscard]] uint32_t glyphCount() const noexcept { return static_cast<uint32_t>(m_quads.size()); }
+    [[nodiscard]] const std::vector<TextQuad>& quads() const noexcept { return m_quads; }
+    [[nodiscard]] const std::vector<TextRun>& runs() const noexcept { return m_runs; }
+
+private:
+    std::vector<TextQuad> m_quads;
+    std::vector<TextRun> m_runs;
+};
+
+} // namespace robotface
+
+#endif // ROBOT_FACE_SDF_FONT_HPP
@@ -0,0 +1,83 @@
+#ifndef ROBOT_FACE_STARTUP_H
+#define ROBOT_FACE_STARTUP_H
+
+/**
+ * Cold start timeline shared by the robot face executables
+ *
+ * Each executable marks the end of its start-up phases (window / GL / font
+ * init, face init, first draw, first present, deferred work). With
+ * `--startup` it prints one line per phase and exits after the frame that
+ * finishes the deferred work:
+ *
+ *   startup: first-frame 41.203 ms      (printed as soon as it is presented)
+ *   startup: window 39.870 ms
+ *   ...
+ *
+ * Times are relative to main(). The time from exec to main (dynamic loading,
+ * static constructors) is measured from the outside by robot_face_startup_bench.
+ *
+ * Header-only (static inline), C11 / C++17.
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define ROBOT_FACE_STARTUP_MAX_PHASES 8
+
+typedef struct {
+    bool enabled;            // --startup: print the timeline and exit early
+    double origin;           // main() entry (seconds)
+    double last;             // End of the previous phase
+    double firstFrameMs;     // main() to the first presented frame
+    int count;
+    const char* names[ROBOT_FACE_STARTUP_MAX_PHASES];
+    double ms[ROBOT_FACE_STARTUP_MAX_PHASES];
+} RobotFaceStartup;
+
+static inline double RobotFaceStartupClock(void) {
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+// Call first thing in main()
+static inline void RobotFaceStartupBegin(RobotFaceStartup* startup, int argc, char** argv) {
+    memset(startup, 0, sizeof(*startup));
+    startup->origin = RobotFaceStartupClock();
+    startup->last = startup->origin;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--startup") == 0) startup->enabled = true;
+    }
+}
+
+// Ends the current phase (name must be a string literal)
+static inline void RobotFaceStartupMark(RobotFaceStartup* startup, const char* phase) {
+    const double now = RobotFaceStartupClock();
+    if (startup->count < ROBOT_FACE_STARTUP_MAX_PHASES) {
+        startup->names[startup->count] = phase;
+        startup->ms[startup->count] = (now - startup->last) * 1000.0;
+        startup->count++;
+    }
+    startup->last = now;
+}
+
+// After the first EndDrawing / swap; printed at once so an observer sees it immediately
+static inline void RobotFaceStartupFirstFrame(RobotFaceStartup* startup) {
+    startup->firstFrameMs = (RobotFaceStartupClock() - startup->origin) * 1000.0;
+    if (startup->enabled) {
+        printf("startup: first-frame %.3f ms\n", startup->firstFrameMs);
+        fflush(stdout);
+    }
+}
+
+static inline void RobotFaceStartupReport(const RobotFaceStartup* startup) {
+    if (!startup->enabled) return;
+    for (int i = 0; i < startup->count; i++) {
+        printf("startup: %s %.3f ms\n", startup->names[i], startup->ms[i]);
+    }
+    fflush(stdout);
+}
+
+#endif // ROBOT_FACE_STARTUP_H
@@ -30,7 +30,12 @@ typedef struct {
 // Core functions
 void InitRobotFace(RobotFace* face);
 void UpdateRobotFace(RobotFace* face, float deltaTime);
-void DrawRobotFace(RobotFace* face, int width, int height);
+void DrawRobotFace(RobotFace* face, int width, int height);   // First call: face only, text follows next frame
+
+// Static layer cache (background, title, controls, eye whites in a render texture)
+void InvalidateRobotFaceStaticLayer(void);           // Re-render after a config change
+void SetRobotFaceStaticLayerCache(bool enabled);     // Disabled: redraw every frame
+void UnloadRobotFaceStaticLayer(void);               // Free the texture (before CloseWindow)
 
 // Emotion control
 void SetEmotion(RobotFace* face, float happiness);
@@ -41,6 +46,14 @@ const char* GetEmotionName(const RobotFace* face);
 float GetHappiness(const RobotFace* face);
 bool IsBlinking(const RobotFace* face);
 
+// Geometry helpers (shared by the raylib and software draw paths)
+float GetBlinkFactor(float blinkProgress);
+float GetPupilRadius(float blinkProgress);
+float GetMouthControlY(float happiness);
+
+// Quadratic Bezier weights (w0, w1, w2) for t = i / MOUTH_SEGMENTS, i = 0..MOUTH_SEGMENTS
+const float* GetMouthBezierBasis(void);
+
 #ifdef __cplusplus
 }
 #endif
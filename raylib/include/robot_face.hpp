@@ -14,6 +14,17 @@
 #define ROBOT_FACE_HPP
 
 #include "raylib.h"
+#include "robot_face_animation.hpp"
+#include "robot_face_blink.h"
+#include "robot_face_canvas.hpp"
+#include "robot_face_hit.hpp"
+#include "robot_face_pacing.hpp"
+#include "robot_face_program.hpp"
+#include "robot_face_quality.hpp"
+#include "robot_face_raylib_canvas.hpp"
+#include "robot_face_tables.hpp"
+#include <cstdint>
+#include <memory>
 #include <string>
 
 namespace robotface {
@@ -35,6 +46,7 @@ struct Config {
     static constexpr float EYE_RADIUS = 60.0f;
     static constexpr float PUPIL_RADIUS = 40.0f;
     static constexpr float PUPIL_MIN_RADIUS = 5.0f;
+    static constexpr float PUPIL_MAX_OFFSET = EYE_RADIUS - PUPIL_RADIUS;   // Pupil stays inside the eye
     static constexpr float HIGHLIGHT_RADIUS = 15.0f;
     static constexpr Vector2 LEFT_EYE_POS = {250.0f, 200.0f};
     static constexpr Vector2 RIGHT_EYE_POS = {550.0f, 200.0f};
@@ -45,22 +57,85 @@ struct Config {
     static constexpr Vector2 MOUTH_CENTER = {400.0f, 400.0f};
     static constexpr float MOUTH_STROKE_WIDTH = 8.0f;
     static constexpr float MOUTH_CURVE_FACTOR = 60.0f;
+    static constexpr float MOUTH_OPEN_FACTOR = 60.0f;     // Lip separation at full openness (speech)
+    static constexpr float MOUTH_OPEN_UPPER_SHARE = 0.2f; // Part of the opening taken by the upper lip
+    static constexpr float MOUTH_OPEN_EPSILON = 0.01f;    // Below this the mouth is drawn closed
     static constexpr int MOUTH_SEGMENTS = 30;
 
     // Animation
     static constexpr float BLINK_INTERVAL = 3.0f;
     static constexpr float BLINK_SPEED = 5.0f;
     static constexpr float BLINK_COMPLETE_THRESHOLD = 2.0f;
+    using BlinkEasing = tables::easing::Sine;             // Any tables::easing policy
     static constexpr float HOVER_HAPPINESS_SPEED = 0.5f;
+    static constexpr float EMOTION_SMOOTH_TIME = 0.25f;   // Spring settle time for emotion changes
+    static constexpr int TARGET_FPS = 60;
+    static constexpr int IDLE_FPS = 10;                   // While every channel is at rest
 
-    // Hover area (mouth region)
-    static constexpr Rectangle HOVER_AREA = {300.0f, 350.0f, 200.0f, 100.0f};
+    // Mouse hover tolerance around the mouth (hit regions follow the drawn geometry)
+    static constexpr float HOVER_SLOP = 20.0f;
 
     // Emotion thresholds
     static constexpr float EMOTION_HAPPY_THRESHOLD = 0.7f;
     static constexpr float EMOTION_SAD_THRESHOLD = 0.3f;
 };
 
+// Hit regions of the face as drawn
+inline constexpr FaceGeometry kFaceGeometry = {
+    {Config::LEFT_EYE_POS.x, Config::LEFT_EYE_POS.y},
+    {Config::RIGHT_EYE_POS.x, Config::RIGHT_EYE_POS.y},
+    Config::EYE_RADIUS,
+    {Config::MOUTH_START.x, Config::MOUTH_START.y},
+    {Config::MOUTH_END.x, Config::MOUTH_END.y},
+    Config::MOUTH_CENTER.y,
+    Config::MOUTH_CURVE_FACTOR,
+    Config::MOUTH_OPEN_FACTOR,
+    Config::MOUTH_OPEN_UPPER_SHARE,
+    Config::MOUTH_OPEN_EPSILON,
+    Config::MOUTH_STROKE_WIDTH,
+    static_cast<float>(Config::SCREEN_WIDTH),
+    static_cast<float>(Config::SCREEN_HEIGHT),
+};
+
+// Animated parameters that can be tweened from outside (scripts, behaviours)
+enum class FaceChannel : uint32_t {
+    Happiness = 0
+};
+
+// Plain copy of the animation state (sync, logging, snapshots)
+// Same fields as the C RobotFace struct so it maps 1:1 onto robot_face_snapshot.h
+struct FaceState {
+    float happiness = 0.8f;
+    float blinkProgress = 0.0f;
+    double blinkTimer = 0.0;
+    bool isBlinking = false;
+    float blinkSpeed = Config::BLINK_SPEED;
+};
+
+// Animated part of one face as drawn (RobotFace, FaceScene instances)
+struct FacePose {
+    float happiness = 0.8f;
+    float blinkFactor = 0.0f;     // 0 = open, 1 = closed
+    float mouthOpenness = 0.0f;
+    float pupilX = 0.0f;          // Gaze offset from the eye centres (design space)
+    float pupilY = 0.0f;
+};
+
+// Placement and appearance of one face: the 800x600 design space drawn at `origin`, scaled
+struct FaceLook {
+    Point2 origin = {0.0f, 0.0f};
+    float scale = 1.0f;
+    Rgba eyeColor = {255, 255, 255, 255};
+    Rgba featureColor = {0, 0, 0, 255};   // Outlines, pupils, mouth
+    int mouthSegments = Config::MOUTH_SEGMENTS;   // 30, 16 or 12 (quality levels)
+    uint32_t pupilSprite = 0;             // Recorded pupil sprite to stamp (0: shapes)
+};
+
+// Per-face drawing shared by RobotFace and FaceScene
+void drawEyeWhites(Canvas& canvas, const FaceLook& look);
+void drawFaceFeatures(Canvas& canvas, const FacePose& pose, const FaceLook& look);   // Pupils and mouth
+void drawPupil(Canvas& canvas, Point2 center, float radius, const FaceLook& look);   // Design space centre
+
 // Robot face class with RAII design
 class RobotFace {
 public:
@@ -78,38 +153,121 @@ public:
     RobotFace(RobotFace&&) = default;
     RobotFace& operator=(RobotFace&&) = default;
 
-    // Core update and rendering
+    // Core update and rendering. The window parts (immediate drawing, static layer, font,
+    // input) are in robot_face_window.cpp; headless builds leave it and raylib out.
     void update(float deltaTime);
-    void draw(int width, int height) const;
+    void draw(int width, int height) const;                  // Immediate raylib drawing (first frame: face only)
+    void draw(Canvas& canvas, int width, int height) const;  // Any backend or recorder
+
+    // Static layer caching for draw(width, height)
+    void invalidateStaticLayer() noexcept;   // After a config change
+    void setStaticLayerCache(bool enabled);
+    void unloadStaticLayer();   // Before CloseWindow (also frees the sprite, low-resolution and text targets)
+
+    // Quality level (QualityGovernor); antiAlias has no effect with raylib
+    void setQuality(const QualitySettings& quality) noexcept { m_quality = quality; }
+    [[nodiscard]] const QualitySettings& quality() const noexcept { return m_quality; }
+
+    // Draw from a compiled face description instead of the built-in shapes (nullptr: built-in).
+    // The program must outlive its use; the status text overlay is still drawn by the face.
+    void setProgram(const FaceProgram* program) noexcept { m_program = program; }
+    [[nodiscard]] const FaceProgram* program() const noexcept { return m_program; }
+    [[nodiscard]] FaceInputs programInputs(int width, int height) const noexcept;
 
-    // Emotion control
+    // Text of draw(width, height) from an SDF font atlas, batched into one draw (nullptr:
+    // raylib's default font). The font must outlive its use; it is uploaded on first use.
+    void setFont(const SdfFont* font) noexcept;
+    [[nodiscard]] const SdfFont* font() const noexcept { return m_font; }
+
+    // Submission counters of the last draw(width, height), optionally shown in the overlay
+    void setStatsOverlay(bool enabled) noexcept { m_statsOverlay = enabled; }
+    [[nodiscard]] bool statsOverlay() const noexcept { return m_statsOverlay; }
+    [[nodiscard]] const FrameStats& frameStats() const noexcept { return m_frameStats; }
+
+    // Frame pacing graph of the loop's analyzer, shown in the overlay (F4). The loop feeds
+    // the analyzer; it must outlive its use (nullptr: no graph).
+    void setPacing(const PacingAnalyzer* pacing) noexcept { m_pacing = pacing; }
+    void setPacingOverlay(bool enabled) noexcept { m_pacingOverlay = enabled; }
+    [[nodiscard]] bool pacingOverlay() const noexcept { return m_pacingOverlay; }
+
+    // Emotion control (setEmotion snaps, animateEmotion springs towards the target)
     void setEmotion(float happiness);
     void setEmotion(Emotion emotion);
+    void animateEmotion(float happiness, float smoothTime = Config::EMOTION_SMOOTH_TIME);
+    void animateEmotion(Emotion emotion, float smoothTime = Config::EMOTION_SMOOTH_TIME);
+    void tween(FaceChannel channel, float target, float duration, Ease ease = Ease::Sine);
+    [[nodiscard]] bool channelAtRest(FaceChannel channel) const noexcept;
     void triggerBlink();
+    void setMouthOpenness(float openness) noexcept;   // 0 = closed, 1 = open (lip sync)
+    void setPupilOffset(float x, float y) noexcept;    // Gaze, clamped to PUPIL_MAX_OFFSET
 
     // State queries (const methods)
-    [[nodiscard]] float happiness() const noexcept { return m_happiness; }
+    [[nodiscard]] float happiness() const noexcept { return m_animation.value(kHappinessChannel); }
     [[nodiscard]] bool isBlinking() const noexcept { return m_isBlinking; }
-    [[nodiscard]] float blinkProgress() const noexcept { return m_blinkProgress; }
+    [[nodiscard]] float blinkProgress() const noexcept { return m_animation.value(kBlinkChannel); }
+    [[nodiscard]] float mouthOpenness() const noexcept { return m_mouthOpenness; }
+    [[nodiscard]] Vector2 pupilOffset() const noexcept { return m_pupilOffset; }
+
+    // Frame scheduling: nothing moves until the next automatic blink
+    [[nodiscard]] bool isAtRest() const noexcept { return !m_isBlinking && m_animation.allAtRest(); }
+    [[nodiscard]] float timeUntilNextAnimation() const noexcept;
     [[nodiscard]] Emotion currentEmotion() const noexcept;
     [[nodiscard]] std::string emotionName() const;
+    [[nodiscard]] const char* emotionLabel() const noexcept;   // Static string, no allocation
+
+    // Full state export/import (blinkSpeed is fixed to Config::BLINK_SPEED here)
+    [[nodiscard]] FaceState state() const noexcept;
+    void setState(const FaceState& state) noexcept;
 
     // Interaction helpers
     void handleKeyboardInput();
     void handleMouseInput();
     bool isMouseOverMouth() const;
+    [[nodiscard]] FaceRegion regionAt(Point2 point, float slop = 0.0f) const noexcept;   // Window pixels
 
 private:
+    // Animated channels (happiness, blink progress)
+    static constexpr AnimationEngine::Channel kHappinessChannel = 0;
+    static constexpr AnimationEngine::Channel kBlinkChannel = 1;
+    static constexpr size_t kChannelCount = 2;
+
     // State variables (initialized in constructor)
-    float m_happiness = 0.8f;
-    float m_blinkProgress = 0.0f;
+    AnimationEngine m_animation{kChannelCount};
     double m_blinkTimer = 0.0;
     bool m_isBlinking = false;
+    float m_mouthOpenness = 0.0f;   // Set from outside every frame (speech), not animated
+    Vector2 m_pupilOffset = {0.0f, 0.0f};   // Set from outside every frame (gaze)
+
+    // raylib targets of draw(width, height): static layer, sprites, low resolution, SDF
+    // text. Made by its first cached frame and freed through the deleter set with them.
+    struct WindowTargets;
+    mutable std::unique_ptr<WindowTargets, void (*)(WindowTargets*)> m_window{nullptr, nullptr};
+    bool m_layerCacheEnabled = true;
+    mutable int m_fps = 0;   // Of the last draw(width, height), shown by drawUI
+
+    QualitySettings m_quality = kQualityLevels[0];
+    const FaceProgram* m_program = nullptr;
+    const SdfFont* m_font = nullptr;   // SDF status text (immediate raylib drawing only)
+
+    // Counters of the previous immediate frame (drawn one frame late by drawUI)
+    mutable FrameStats m_frameStats;
+    bool m_statsOverlay = false;
+
+    const PacingAnalyzer* m_pacing = nullptr;
+    bool m_pacingOverlay = false;
+
+    // Set once the first (face only) frame has been drawn
+    mutable bool m_firstFrameDrawn = false;
+
+    // Plays blink progress from `from` to BLINK_COMPLETE_THRESHOLD at BLINK_SPEED
+    void startBlink(float from);
 
     // Private drawing methods (const because they don't modify state)
-    void drawEye(float x, float y, float blinkProgress) const;
-    void drawMouth(float centerX, float centerY, float happiness) const;
-    void drawUI(int width, int height) const;
+    [[nodiscard]] FacePose pose() const noexcept;
+    [[nodiscard]] FaceLook look() const noexcept;
+    void drawStaticLayer(Canvas& canvas, int width, int height) const;
+    void preparePupilSprite(Canvas& canvas) const;
+    void drawUI(Canvas& canvas, int width, int height) const;
 
     // Helper to calculate blink factor
     [[nodiscard]] float calculateBlinkFactor(float progress) const noexcept;
@@ -118,6 +276,11 @@ private:
     static float clampHappiness(float value) noexcept;
 };
 
+// Group key of the static layer (background, title, controls, eye whites)
+inline uint32_t staticLayerKey(int width, int height) noexcept {
+    return 0x53000000u ^ (static_cast<uint32_t>(width) << 12) ^ static_cast<uint32_t>(height);
+}
+
 // Utility function to convert emotion enum to float
 inline float emotionToHappiness(Emotion emotion) noexcept {
     switch (emotion) {
@@ -0,0 +1,106 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Animation Engine (Modern C++)
+ *
+ *   Features:
+ *   - Any number of float channels (happiness, blink, ...), one engine for many faces
+ *   - Critically damped springs (exact integration, frame-rate independent)
+ *   - Keyframe curves with per-segment easing
+ *   - Structure-of-arrays storage, advanced in one loop; no allocation after construction
+ *   - At-rest signal so the frame scheduler can skip idle frames
+ *
+ *******************************************************************************************/
+
+#ifndef ROBOT_FACE_ANIMATION_HPP
+#define ROBOT_FACE_ANIMATION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace robotface {
+
+// Easing of a keyframe segment (applied from the segment's start key)
+enum class Ease : uint8_t {
+    Linear = 0,
+    Smooth,      // Smoothstep (ease in/out)
+    Sine,        // Half cosine (ease in/out)
+    Step,        // Hold the start value until the next key
+    Spring       // Overshoots, settles on the end value
+};
+
+struct Keyframe {
+    float time;      // Seconds from the start of the track
+    float value;
+    Ease ease = Ease::Linear;
+};
+
+class AnimationEngine {
+public:
+    using Channel = uint32_t;
+    static constexpr Channel kInvalidChannel = 0xFFFFFFFFu;
+    static constexpr size_t kMaxKeyframes = 8;      // Per channel track
+    static constexpr float kRestEpsilon = 1e-3f;   // Below one pixel of mouth curve
+
+    // Storage for all channels is reserved here, once
+    explicit AnimationEngine(size_t channelCapacity);
+
+    // Returns kInvalidChannel when the capacity is exhausted
+    Channel addChannel(float value);
+
+    // Channel control
+    void set(Channel channel, float value);                             // Snap, at rest
+    void springTo(Channel channel, float target, float smoothTime);     // ~smoothTime to settle
+    bool play(Channel channel, const Keyframe* keys, size_t count);     // false if count is 0 or too long
+    void stop(Channel channel);                                         // Freeze at the current value
+
+    // Advance every channel; returns the number still in motion
+    size_t update(float deltaTime);
+
+    // Queries
+    [[nodiscard]] float value(Channel channel) const noexcept { return m_value[channel]; }
+    [[nodiscard]] float velocity(Channel channel) const noexcept { return m_velocity[channel]; }
+    [[nodiscard]] float target(Channel channel) const noexcept { return m_target[channel]; }
+    [[nodiscard]] bool atRest(Channel channel) const noexcept { return m_mode[channel] == Mode::Rest; }
+    [[nodiscard]] bool allAtRest() const noexcept { return m_active == 0; }
+    [[nodiscard]] size_t size() const noexcept { return m_value.size(); }
+    [[nodiscard]] size_t capacity() const noexcept { return m_capacity; }
+
+private:
+    enum class Mode : uint8_t { Rest = 0, Spring, Keyframes };
+
+    void setMode(Channel channel, Mode mode) noexcept;
+    float sampleTrack(Channel channel, float time) const noexcept;
+
+    size_t m_capacity;
+    size_t m_active = 0;
+
+    // Hot state, one entry per channel
+    std::vector<float> m_value;
+    std::vector<float> m_velocity;
+    std::vector<float> m_target;
+    std::vector<float> m_omega;      // Spring: 2 / smoothTime
+    std::vector<float> m_time;       // Keyframes: playback time
+    std::vector<Mode> m_mode;
+
+    // Keyframe tracks, kMaxKeyframes slots per channel
+    std::vector<Keyframe> m_keys;
+    std::vector<uint8_t> m_keyCount;
+};
+
+// Evaluate an easing curve on [0, 1]
+[[nodiscard]] float applyEase(Ease ease, float t) noexcept;
+
+// One exact step of a critically damped spring (omega = 2 / smoothTime, decay =
+// exp(-omega * deltaTime)); shared by the engine, the face scene and the gaze batch
+inline void springStep(float& value, float& velocity, float target, float omega, float decay,
+                       float deltaTime) noexcept {
+    const float offset = value - target;
+    const float temp = (velocity + omega * offset) * deltaTime;
+    velocity = (velocity - omega * temp) * decay;
+    value = target + (offset + temp) * decay;
+}
+
+} // namespace robotface
+
+#endif // ROBOT_FACE_ANIMATION_HPP
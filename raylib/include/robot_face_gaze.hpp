@@ -0,0 +1,115 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Gaze and Micro-Saccade Model (Modern C++)
+ *
+ *   Features:
+ *   - Look-at targets in face coordinates (where the perception stack sees a person)
+ *   - Smooth pursuit: critically damped spring towards the target direction
+ *   - Micro-saccades: small random jumps at irregular intervals that drift back
+ *     (paused per face while it rests, so a resting face can drop to its idle frame rate)
+ *   - Pupil offsets constrained to a disk so the pupil stays inside the eye
+ *   - Structure-of-arrays batch for many faces, one branch-free pass per update
+ *
+ *   Targets can be set at any rate (e.g. 1 kHz perception); only the latest one counts,
+ *   and update() runs once per rendered frame. Not thread-safe: hand targets over on
+ *   the render thread. updateRange() lets a scene split one update across threads.
+ *
+ *******************************************************************************************/
+
+#ifndef ROBOT_FACE_GAZE_HPP
+#define ROBOT_FACE_GAZE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace robotface {
+
+struct GazeConfig {
+    float eyeCenterX = 400.0f;       // Midpoint between the eyes (face coordinates)
+    float eyeCenterY = 200.0f;
+    float maxOffset = 20.0f;         // Eye radius - pupil radius
+    float range = 300.0f;            // Target distance that turns the pupils fully
+    float smoothTime = 0.12f;        // Pursuit settle time (seconds)
+    float saccadeAmplitude = 1.5f;   // Micro-saccade jump (pixels)
+    float saccadeInterval = 0.6f;    // Mean seconds between micro-saccades
+    float saccadeDecay = 4.0f;       // Drift back rate (1/s)
+};
+
+struct GazePoint {
+    float x;
+    float y;
+};
+
+class GazeBatch {
+public:
+    using Index = uint32_t;
+    static constexpr Index kInvalidIndex = 0xFFFFFFFFu;
+
+    // Storage for all faces is reserved here, once
+    explicit GazeBatch(size_t capacity, const GazeConfig& config = GazeConfig{});
+
+    // Returns kInvalidIndex when the capacity is exhausted; the new face looks ahead
+    Index add(uint32_t seed = 0);
+
+    // Look-at targets (face coordinates); setTargets fills faces 0..count-1
+    void setTarget(Index face, GazePoint target) noexcept;
+    void setTargets(const GazePoint* targets, size_t count) noexcept;
+    void lookAhead(Index face) noexcept;
+
+    // Micro-saccades on or off (on by default); off, the last jump drifts back and none follow
+    void setSaccades(Index face, bool enabled) noexcept { m_saccadeScale[face] = enabled ? 1.0f : 0.0f; }
+
+    // Pupil at rest: pursuit on its target, stopped, no micro-saccade offset left (all
+    // within `tolerance` pixels, velocity within tolerance per 100 ms)
+    [[nodiscard]] bool settled(Index face, float tolerance = 0.1f) const noexcept;
+
+    // Advance every face (pursuit, saccades, disk constraint)
+    void update(float deltaTime) noexcept;
+    // Advance faces [begin, end) only; disjoint ranges may run on different threads
+    void updateRange(size_t begin, size_t end, float deltaTime) noexcept;
+
+    // Pupil offsets from the eye centres, |offset| <= maxOffset
+    [[nodiscard]] GazePoint offset(Index face) const noexcept { return GazePoint{m_offsetX[face], m_offsetY[face]}; }
+    [[nodiscard]] const float* offsetsX() const noexcept { return m_offsetX.data(); }
+    [[nodiscard]] const float* offsetsY() const noexcept { return m_offsetY.data(); }
+    [[nodiscard]] size_t size() const noexcept { return m_offsetX.size(); }
+    [[nodiscard]] size_t capacity() const noexcept { return m_capacity; }
+    [[nodiscard]] const GazeConfig& config() const noexcept { return m_config; }
+
+private:
+    // Passes of update(), each over a few arrays
+    void pursue(size_t n, float deltaTime, const float* __restrict target, float* __restrict position,
+                float* __restrict velocity) const noexcept;
+    void saccade(size_t n, float deltaTime, const float* __restrict scale, uint32_t* __restrict random,
+                 float* __restrict timer, float* __restrict saccadeX, float* __restrict saccadeY) const noexcept;
+    void constrain(size_t n, const float* __restrict pursuitX, const float* __restrict pursuitY,
+                   const float* __restrict saccadeX, const float* __restrict saccadeY,
+                   float* __restrict offsetX, float* __restrict offsetY) const noexcept;
+
+    GazeConfig m_config;
+    size_t m_capacity;
+
+    // Pursuit target (already mapped to a pupil offset) and spring state
+    std::vector<float> m_targetX;
+    std::vector<float> m_targetY;
+    std::vector<float> m_pursuitX;
+    std::vector<float> m_pursuitY;
+    std::vector<float> m_velocityX;
+    std::vector<float> m_velocityY;
+
+    // Micro-saccade offset, countdown, jump scale (0: paused) and per-face random state
+    std::vector<float> m_saccadeX;
+    std::vector<float> m_saccadeY;
+    std::vector<float> m_saccadeTimer;
+    std::vector<float> m_saccadeScale;
+    std::vector<uint32_t> m_random;
+
+    // Output
+    std::vector<float> m_offsetX;
+    std::vector<float> m_offsetY;
+};
+
+} // namespace robotface
+
+#endif // ROBOT_FACE_GAZE_HPP
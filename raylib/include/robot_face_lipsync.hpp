@@ -0,0 +1,146 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Audio-Driven Lip Sync (Modern C++)
+ *
+ *   Features:
+ *   - Streaming 16-bit PCM from a WAV file, raw PCM pipe (stdin) or an in-process ring buffer
+ *   - Analysis on a dedicated thread in small hops (4 ms by default)
+ *   - Sliding RMS envelope with attack/release, optional band energies from a 256-point FFT
+ *   - Mouth openness published through one atomic word: the render loop never locks
+ *
+ *   Usage:
+ *     LipSync lipSync;
+ *     lipSync.startFile("speech.wav");            // or startStream() + push(samples, n)
+ *     ...
+ *     face.setMouthOpenness(lipSync.openness());  // once per frame, wait-free
+ *
+ *   All buffers are allocated before analysis starts (in startStream(), or by the reader
+ *   thread once a file's header is read); the analysis itself does not allocate.
+ *
+ *******************************************************************************************/
+
+#ifndef ROBOT_FACE_LIPSYNC_HPP
+#define ROBOT_FACE_LIPSYNC_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace robotface {
+
+struct LipSyncConfig {
+    int sampleRate = 16000;       // Raw PCM and ring buffer input (WAV files carry their own)
+    float hopMs = 4.0f;           // Analysis step: bounds the added latency
+    float windowMs = 12.0f;       // RMS window (rounded to whole hops)
+    float attackMs = 4.0f;        // Envelope rise time constant
+    float releaseMs = 60.0f;      // Envelope fall time constant
+    float noiseFloor = 0.01f;     // RMS (full scale = 1) mapped to openness 0
+    float fullOpen = 0.25f;       // RMS mapped to openness 1
+    bool bands = false;           // Also compute band energies (FFT per hop)
+    size_t ringCapacity = 1u << 15;  // Samples, rounded up to a power of two
+};
+
+// One published analysis result
+struct LipSyncFrame {
+    float openness = 0.0f;   // 0 = closed, 1 = fully open
+    float low = 0.0f;        // Share of energy below 500 Hz (bands only)
+    float mid = 0.0f;        // 500 - 2000 Hz
+    float high = 0.0f;       // Above 2000 Hz
+};
+
+// Mono 16-bit clip (WAV fixtures, tools)
+struct PcmClip {
+    int sampleRate = 16000;
+    std::vector<int16_t> samples;
+};
+
+// PCM16 WAV, mono or stereo (mixed down); false on any other format
+bool loadWav(const char* path, PcmClip& clip);
+bool saveWav(const char* path, const PcmClip& clip);
+
+class LipSync {
+public:
+    enum class Pacing {
+        RealTime,     // Analyse file audio as it would play (speech synced to the face)
+        AsFastAsRead  // Pipes and live sources already arrive in real time
+    };
+
+    explicit LipSync(const LipSyncConfig& config = LipSyncConfig{});
+    ~LipSync();
+
+    LipSync(const LipSync&) = delete;
+    LipSync& operator=(const LipSync&) = delete;
+
+    // Sources (one at a time; each stops the previous one)
+    bool startStream();                                              // Feed with push()
+    bool startFile(const char* path, Pacing pacing = Pacing::RealTime);  // WAV or raw s16le, "-" = stdin
+    void stop();   // Returns within one poll slice (20 ms) even while a pipe is quiet
+
+    // Producer side of the ring buffer (single producer); returns samples accepted
+    size_t push(const int16_t* samples, size_t count) noexcept;
+
+    // Render side (wait-free)
+    [[nodiscard]] float openness() const noexcept;
+    [[nodiscard]] LipSyncFrame frame() const noexcept;
+    [[nodiscard]] bool running() const noexcept { return m_running.load(std::memory_order_acquire); }
+    [[nodiscard]] bool failed() const noexcept { return m_failed.load(std::memory_order_acquire); }   // Not PCM16
+    [[nodiscard]] uint64_t samplesAnalyzed() const noexcept { return m_analyzed.load(std::memory_order_relaxed); }
+    [[nodiscard]] int sampleRate() const noexcept { return m_sampleRate; }   // File sources: set by the reader thread
+    [[nodiscard]] int hopSamples() const noexcept { return m_hop; }
+
+private:
+    bool prepare(int sampleRate);
+    void streamLoop();
+    void fileLoop(std::FILE* file, bool closeFile, Pacing pacing);
+    void analyze(const float* hop) noexcept;
+    void computeBands(LipSyncFrame& frame) noexcept;
+    void publish(const LipSyncFrame& frame) noexcept;
+
+    LipSyncConfig m_config;
+    int m_sampleRate = 0;
+    int m_hop = 0;
+
+    // Thread control
+    std::thread m_thread;
+    std::atomic<bool> m_stop{false};
+    std::atomic<bool> m_running{false};
+    std::atomic<bool> m_failed{false};     // The file source was empty or not PCM16
+
+    // Ring buffer (single producer, single consumer)
+    std::vector<int16_t> m_ring;
+    size_t m_ringMask = 0;
+    std::atomic<size_t> m_writePos{0};
+    std::atomic<size_t> m_readPos{0};
+
+    // File / pipe input, one hop of interleaved s16le frames
+    std::vector<unsigned char> m_readBytes;
+
+    // Analysis state (worker thread only)
+    std::vector<float> m_hopBuffer;
+    std::vector<float> m_hopEnergy;       // Sum of squares per hop, circular
+    size_t m_hopIndex = 0;
+    int m_windowSamples = 0;
+    float m_envelope = 0.0f;
+    float m_attack = 0.0f;
+    float m_release = 0.0f;
+
+    std::vector<float> m_history;         // Last kFftSize samples, circular
+    size_t m_historyPos = 0;
+    std::vector<float> m_fftWindow;
+    std::vector<float> m_fftRe;
+    std::vector<float> m_fftIm;
+    std::vector<float> m_twiddleRe;
+    std::vector<float> m_twiddleIm;
+    std::vector<uint16_t> m_bitReverse;
+
+    // Published result: openness and bands packed as four 16-bit fractions
+    std::atomic<uint64_t> m_published{0};
+    std::atomic<uint64_t> m_analyzed{0};
+};
+
+} // namespace robotface
+
+#endif // ROBOT_FACE_LIPSYNC_HPP
@@ -0,0 +1,147 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Multi-Output Presentation (Modern C++)
+ *
+ *   Features:
+ *   - One software render at the largest output's resolution feeds every output (head
+ *     display, status LCD, console thumbnails) instead of one render per output
+ *   - Smaller outputs come from a 2x2 box pyramid of the frame: an output the size of a
+ *     level is that level (converted to its pixel format), any other size is resampled
+ *     bilinearly from the nearest level at least as large
+ *   - Pixel formats: RGBA8888, RGB565 (SPI panels), Gray8
+ *   - Damage: the frame is compared with the previous one in 32x32 tiles; only levels and
+ *     output pixels under changed tiles are recomputed, the rest is reused. dirty(i)
+ *     tells a display driver which rectangle to push
+ *   - SSE2 kernels for the box filter, the bilinear taps and RGB565 packing (WebAssembly
+ *     SIMD128 in the web build); portable loops elsewhere (identical results)
+ *
+ *   Outputs must share the frame's aspect ratio (within a pixel). An RGBA8888 output the
+ *   size of a level points into it: no copy.
+ *
+ *   Usage:
+ *     OutputPyramid outputs;
+ *     outputs.configure(specs, 3);
+ *     SoftwareCanvas canvas(outputs.source());
+ *     face.draw(canvas, width, height);   // Every frame, whole frame
+ *     outputs.present();                  // Then read pixels(i) / dirty(i)
+ *
+ *******************************************************************************************/
+
+#ifndef ROBOT_FACE_OUTPUTS_HPP
+#define ROBOT_FACE_OUTPUTS_HPP
+
+#include "robot_face_soft.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace robotface {
+
+enum class PixelFormat : uint8_t { Rgba8888, Rgb565, Gray8 };
+
+constexpr const char* kPixelFormatNames[] = {"rgba8888", "rgb565", "gray8"};
+
+constexpr int bytesPerPixel(PixelFormat format) noexcept {
+    return format == PixelFormat::Rgba8888 ? 4 : format == PixelFormat::Rgb565 ? 2 : 1;
+}
+
+struct OutputSpec {
+    int width = 0;
+    int height = 0;
+    PixelFormat format = PixelFormat::Rgba8888;
+};
+
+// Pixels [x0, x1) x [y0, y1)
+struct PixelRect {
+    int x0 = 0;
+    int y0 = 0;
+    int x1 = 0;
+    int y1 = 0;
+
+    [[nodiscard]] bool empty() const noexcept { return x0 >= x1 || y0 >= y1; }
+};
+
+// "320x240" or "320x240:rgb565"
+bool parseOutputSpec(const char* text, OutputSpec& spec);
+
+// RGBA8888 -> format (RGB565 little-endian, Gray8 BT.601 luma)
+void convertPixels(const uint8_t* rgba, uint8_t* out, int count, PixelFormat format) noexcept;
+
+class OutputPyramid {
+public:
+    static constexpr int kTileSize = 32;    // Source pixels per damage tile side
+    static constexpr int kMaxLevel = 5;     // Level 5 = 1/32 (one pixel per tile)
+
+    // Source size is the largest output; false if there is no output or an aspect differs
+    bool configure(const OutputSpec* outputs, size_t count);
+
+    // Render target for the next frame (the whole frame must be drawn)
+    [[nodiscard]] SoftCanvas& source() noexcept { return m_source; }
+
+    // Diff against the previous frame, refresh damaged levels and outputs, flip buffers
+    void present();
+
+    // Next present() recomputes everything (outputs read or written elsewhere)
+    void invalidate() noexcept { m_valid = false; }
+
+    // SSE2 kernels when the build has them (off: portable loops, same output)
+    void setVectorized(bool enabled) noexcept { m_vectorized = enabled && vectorAvailable(); }
+    [[nodiscard]] static bool vectorAvailable() noexcept;
+
+    [[nodiscard]] size_t outputCount() const noexcept { return m_outputs.size(); }
+    [[nodiscard]] const OutputSpec& spec(size_t i) const noexcept { return m_outputs[i].spec; }
+    [[nodiscard]] const uint8_t* pixels(size_t i) const noexcept;
+    [[nodiscard]] int stride(size_t i) const noexcept;
+    [[nodiscard]] const PixelRect& dirty(size_t i) const noexcept { return m_outputs[i].dirty; }   // Last present()
+    [[nodiscard]] int sourceLevel(size_t i) const noexcept { return m_outputs[i].level; }
+
+    [[nodiscard]] int levelCount() const noexcept { return static_cast<int>(m_levels.size()) + 1; }
+    [[nodiscard]] int tileCount() const noexcept { return m_tilesX * m_tilesY; }
+    [[nodiscard]] int damagedTiles() const noexcept { return m_damagedTiles; }
+
+private:
+    struct Level {
+        int width;
+        int height;
+        std::vector<uint8_t> pixels;   // RGBA8888, stride width * 4
+    };
+
+    struct Output {
+        OutputSpec spec;
+        int level = 0;                 // 0 = the frame itself
+        bool direct = false;           // Level-sized: convert, or alias when RGBA8888
+        std::vector<uint8_t> pixels;
+        std::vector<uint16_t> columnX; // Bilinear taps: left column and weight (0..256)
+        std::vector<uint16_t> columnF;
+        std::vector<uint16_t> rowY;
+        std::vector<uint16_t> rowF;
+        PixelRect dirty;
+    };
+
+    [[nodiscard]] const uint8_t* levelPixels(int level) const noexcept;
+    [[nodiscard]] int levelWidth(int level) const noexcept;
+    [[nodiscard]] int levelHeight(int level) const noexcept;
+    [[nodiscard]] bool tileChanged(int tx, int ty) const noexcept;
+
+    void downscale(int level, const PixelRect& rect) noexcept;
+    void refreshOutput(Output& output, const PixelRect& levelRect) noexcept;
+
+    SoftCanvas m_source{};
+    std::vector<uint8_t> m_frames[2];  // Front (presented) and back (being drawn)
+    int m_front = 0;
+    int m_width = 0;
+    int m_height = 0;
+    std::vector<Level> m_levels;       // Levels 1..n (level 0 is the front frame)
+    std::vector<Output> m_outputs;
+    std::vector<PixelRect> m_runs;     // Damaged tile runs of the current frame (source pixels)
+    std::vector<uint8_t> m_row;        // RGBA scratch row for converted outputs
+    int m_tilesX = 0;
+    int m_tilesY = 0;
+    int m_damagedTiles = 0;
+    bool m_valid = false;
+    bool m_vectorized = vectorAvailable();
+};
+
+} // namespace robotface
+
+#endif // ROBOT_FACE_OUTPUTS_HPP
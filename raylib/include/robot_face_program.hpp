@@ -0,0 +1,148 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Face Descriptions (Modern C++)
+ *
+ *   A face description is a small text file: shapes, named anchors and expressions
+ *   that bind shape parameters to the face's inputs. It is compiled once into a flat
+ *   array of 8-byte instructions over a float register file; run() walks that array
+ *   every frame. At load time:
+ *   - expressions that do not depend on an input are folded to constants, so a shape
+ *     with constant parameters costs one instruction (the draw itself)
+ *   - identical subexpressions are computed once per frame (lets and conditions
+ *     shared by several shapes)
+ *   - curve terms with constant end points are precomputed per segment
+ *
+ *   Format (one statement per line, '#' followed by a non-hex character starts a comment):
+ *
+ *     let pupil = 40 * (1 - blink * 0.875)     Named value (computed once per frame)
+ *     point eye = 250, 200                     Anchor: defines eye.x and eye.y
+ *     color ink = #000000                      Named color (#RRGGBB or #RRGGBBAA)
+ *     layer ... end                            Static layer (cached by canvases that
+ *                                              cache groups; inputs: width, height only)
+ *     clear color
+ *     circle x, y, radius, color
+ *     ring x, y, radius, thickness, color
+ *     quad x0, y0, cx, cy, x1, y1, segments, width, color   Stroked quadratic Bezier
+ *     text x, y, size, color, "string"
+ *
+ *   Any draw statement can end in `if <expression>` (drawn when non-zero).
+ *   Expressions: numbers, inputs, lets, + - * /, unary -, < <= > >= == !=,
+ *   min(a, b), max(a, b), clamp(x, lo, hi), abs(x), mix(a, b, t), parentheses.
+ *   Inputs: happiness, blink (0 open .. 1 closed), openness, gazeX, gazeY, width, height.
+ *
+ *   A FaceProgram is immutable after loading; run() uses a register file and curve paths
+ *   owned by the program, so one program is run from one thread at a time.
+ *
+ *******************************************************************************************/
+
+#ifndef ROBOT_FACE_PROGRAM_HPP
+#define ROBOT_FACE_PROGRAM_HPP
+
+#include "robot_face_canvas.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace robotface {
+
+// Per-frame values a description can bind to
+struct FaceInputs {
+    float happiness = 0.8f;
+    float blink = 0.0f;       // Blink factor: 0 = open, 1 = closed
+    float openness = 0.0f;    // Mouth (speech)
+    float gazeX = 0.0f;       // Pupil offset
+    float gazeY = 0.0f;
+    float width = 800.0f;     // Output size
+    float height = 600.0f;
+};
+
+enum class FaceOp : uint8_t {
+    // r[dst] = r[a] op r[b]
+    Add, Sub, Mul, Div, Min, Max, Abs, Neg,
+    Less, LessEqual, Greater, GreaterEqual, Equal, NotEqual,
+    // Control: skip the next b instructions when r[a] == 0 / the canvas has the group
+    SkipIfZero, BeginGroup, EndGroup,
+    // Control: skip the next dst instructions unless r[a] < r[b] / r[a] <= r[b]
+    SkipUnlessLess, SkipUnlessLessEqual,
+    // Draws: operand registers listed at operands[dst]; a = color index; b = string offset / curve index
+    Clear, Circle, Ring, Quad, Text,
+};
+
+struct FaceInstr {
+    FaceOp op;
+    uint8_t pad;
+    uint16_t dst;
+    uint16_t a;
+    uint16_t b;
+};
+
+static_assert(sizeof(FaceInstr) == 8, "FaceInstr must stay 8 bytes");
+
+// Load or compile error: 1-based line (0 when the file itself failed) and message
+struct FaceProgramError {
+    int line = 0;
+    std::string message;
+};
+
+class FaceProgram {
+public:
+    static constexpr int kMaxSegments = 64;
+    static constexpr size_t kMaxRegisters = 0xFFFF;
+
+    // Map the file and compile it; on failure the program is left empty
+    bool load(const char* path, FaceProgramError* error = nullptr);
+    bool compile(const char* source, size_t length, FaceProgramError* error = nullptr);
+
+    // Execute the instructions on a canvas
+    void run(Canvas& canvas, const FaceInputs& inputs) const;
+
+    [[nodiscard]] bool empty() const noexcept { return m_code.empty(); }
+    [[nodiscard]] const std::vector<FaceInstr>& code() const noexcept { return m_code; }
+    [[nodiscard]] size_t registerCount() const noexcept { return m_registers.size(); }
+    [[nodiscard]] size_t sharedExpressions() const noexcept { return m_shared; }
+    [[nodiscard]] size_t foldedExpressions() const noexcept { return m_folded; }
+    [[nodiscard]] uint32_t hash() const noexcept { return m_hash; }   // Of the source; salts group keys
+
+private:
+    friend class FaceCompiler;
+
+    // Per-axis sampling of a quad: B(t) = w0 p0 + w1 c + w2 p1, evaluated left to right
+    enum class CurveAxis : uint8_t {
+        Constant,   // Whole axis precomputed into the curve's points
+        Ends,       // w0 p0 and w2 p1 precomputed, w1 c at run time
+        Live,       // All three terms at run time
+    };
+
+    struct Curve {
+        uint8_t segments;
+        CurveAxis x;
+        CurveAxis y;
+        uint32_t points;    // Path in m_curvePoints (constant axes filled in, others sampled in place)
+        uint32_t weights;   // w0, w1, w2 in m_curveData (segments + 1 each)
+        uint32_t xData;     // Ends: w0 p0, w2 p1 in m_curveData
+        uint32_t yData;
+    };
+
+    template <float Point2::*Axis>
+    static void sampleAxis(CurveAxis mode, int count, const float* weights, const float* ends, float p0, float c,
+                           float p1, Point2* path) noexcept;
+
+    void strokeCurve(Canvas& canvas, const Curve& curve, const float* r, const uint16_t* o, Rgba color) const;
+
+    std::vector<FaceInstr> m_code;
+    std::vector<uint16_t> m_operands;         // Operand registers of the draws
+    mutable std::vector<float> m_registers;   // Inputs, constants, computed values
+    std::vector<Rgba> m_colors;
+    std::vector<char> m_strings;              // NUL-terminated, indexed by offset
+    std::vector<Curve> m_curves;
+    mutable std::vector<Point2> m_curvePoints;   // Handed to strokePath as they are
+    std::vector<float> m_curveData;
+    size_t m_folded = 0;
+    size_t m_shared = 0;
+    uint32_t m_hash = 0;
+};
+
+} // namespace robotface
+
+#endif // ROBOT_FACE_PROGRAM_HPP
@@ -0,0 +1,203 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Raylib Canvas Backend
+ *
+ *   Executes Canvas draw calls immediately with raylib
+ *   (call between BeginDrawing/EndDrawing or BeginTextureMode/EndTextureMode)
+ *
+ *   With a RaylibLayerCache, a group (the face's static layer) is rendered once into a
+ *   RenderTexture2D and then drawn as a single full-screen quad until the group key
+ *   (size) changes or the cache is invalidated.
+ *
+ *   With a RaylibSpriteCache, sprites (e.g. the pupil) are rendered once into small
+ *   render textures and drawn as one textured quad each. RaylibScaledTarget renders a
+ *   frame at reduced resolution and upscales it to the window.
+ *
+ *   With a RaylibSdfText, text is queued as quads of a signed distance field atlas and
+ *   submitted in one draw under an edge shader (sharp at any size) when the group ends
+ *   and at flushText(), instead of one DrawText per string.
+ *
+ *   With setStats(), every call also adds the submission raylib makes for it (rlgl batch
+ *   vertices, texture / primitive mode switches) to a FrameStats. The EndDrawing flush
+ *   is outside the canvas and not counted.
+ *
+ *******************************************************************************************/
+
+#ifndef ROBOT_FACE_RAYLIB_CANVAS_HPP
+#define ROBOT_FACE_RAYLIB_CANVAS_HPP
+
+#include "raylib.h"
+#include "robot_face_canvas.hpp"
+#include "robot_face_frame_stats.hpp"
+#include "robot_face_sdf_font.hpp"
+
+namespace robotface {
+
+// Color conversions (identical layouts)
+inline Rgba toRgba(Color color) noexcept { return Rgba{color.r, color.g, color.b, color.a}; }
+inline Color toColor(Rgba color) noexcept { return Color{color.r, color.g, color.b, color.a}; }
+
+// Render target for one cached group (needs a window / GL context to fill)
+class RaylibLayerCache {
+public:
+    RaylibLayerCache() = default;
+    ~RaylibLayerCache();
+
+    RaylibLayerCache(const RaylibLayerCache&) = delete;
+    RaylibLayerCache& operator=(const RaylibLayerCache&) = delete;
+    RaylibLayerCache(RaylibLayerCache&& other) noexcept;
+    RaylibLayerCache& operator=(RaylibLayerCache&& other) noexcept;
+
+    void invalidate() noexcept { m_valid = false; }   // Re-render on next use (config change)
+    void unload();                                    // Free the texture (before CloseWindow)
+    void setEnabled(bool enabled);                    // Disabled: groups draw directly
+    [[nodiscard]] bool enabled() const noexcept { return m_enabled; }
+    [[nodiscard]] bool valid() const noexcept { return m_valid; }
+
+private:
+    friend class RaylibCanvas;
+
+    RenderTexture2D m_target{};
+    uint32_t m_key = 0;
+    bool m_valid = false;
+    bool m_enabled = true;
+};
+
+// Render targets for a few cached sprites (needs a window / GL context to fill)
+class RaylibSpriteCache {
+public:
+    static constexpr int kMaxSprites = 4;
+
+    RaylibSpriteCache() = default;
+    ~RaylibSpriteCache();
+
+    RaylibSpriteCache(const RaylibSpriteCache&) = delete;
+    RaylibSpriteCache& operator=(const RaylibSpriteCache&) = delete;
+    RaylibSpriteCache(RaylibSpriteCache&& other) noexcept;
+    RaylibSpriteCache& operator=(RaylibSpriteCache&& other) noexcept;
+
+    void invalidate() noexcept;   // Re-render every sprite on next use
+    void unload();                // Free the textures (before CloseWindow)
+
+private:
+    friend class RaylibCanvas;
+
+    struct Slot {
+        RenderTexture2D target{};
+        uint32_t key = 0;
+        bool valid = false;
+    };
+
+    Slot* find(uint32_t key) noexcept;
+    Slot* acquire(uint32_t key, int size);   // nullptr: no free slot or no framebuffer support
+
+    Slot m_slots[kMaxSprites];
+};
+
+// Frame rendered at a fraction of the window size, then upscaled (bilinear)
+class RaylibScaledTarget {
+public:
+    RaylibScaledTarget() = default;
+    ~RaylibScaledTarget();
+
+    RaylibScaledTarget(const RaylibScaledTarget&) = delete;
+    RaylibScaledTarget& operator=(const RaylibScaledTarget&) = delete;
+    RaylibScaledTarget(RaylibScaledTarget&& other) noexcept;
+    RaylibScaledTarget& operator=(RaylibScaledTarget&& other) noexcept;
+
+    // Between begin() and end() draw in window coordinates; false: draw directly instead
+    bool begin(int width, int height, float scale);
+    void end(FrameStats* stats = nullptr);
+    void unload();   // Free the texture (before CloseWindow)
+
+private:
+    RenderTexture2D m_target{};
+    int m_width = 0;
+    int m_height = 0;
+    bool m_active = false;
+};
+
+// SDF font atlas texture, its edge shader and the queued text (needs a window / GL context)
+class RaylibSdfText {
+public:
+    RaylibSdfText() = default;
+    ~RaylibSdfText();
+
+    RaylibSdfText(const RaylibSdfText&) = delete;
+    RaylibSdfText& operator=(const RaylibSdfText&) = delete;
+    RaylibSdfText(RaylibSdfText&& other) noexcept;
+    RaylibSdfText& operator=(RaylibSdfText&& other) noexcept;
+
+    // Upload the atlas straight from the font's blob and compile the shader; false: the
+    // canvas keeps drawing text with DrawText. The font must outlive its use.
+    bool load(const SdfFont& font);
+    void unload();   // Free the texture and shader (before CloseWindow)
+    [[nodiscard]] bool ready() const noexcept { return m_atlas.id != 0; }
+    [[nodiscard]] const SdfFont* font() const noexcept { return m_font; }   // Last load(), even failed
+
+private:
+    friend class RaylibCanvas;
+
+    void flush();   // One textured quad per glyph in a single shader pass, then clear
+
+    const SdfFont* m_font = nullptr;
+    Texture2D m_atlas{};
+    Shader m_shader{};
+    TextBatch m_batch;   // Capacity reused frame to frame
+};
+
+// Atlas baked at build time by robot_face_font_baker (linked into robot_face_cpp)
+bool loadEmbeddedSdfFont(SdfFont& font) noexcept;
+
+class RaylibCanvas final : public Canvas {
+public:
+    RaylibCanvas() = default;
+    RaylibCanvas(RaylibLayerCache* cache, int width, int height) noexcept
+        : m_cache(cache), m_width(width), m_height(height) {}
+
+    void clear(Rgba color) override;
+    void circle(Point2 center, float radius, Rgba color) override;
+    void ring(Point2 center, float radius, float thickness, Rgba color) override;
+    void strokePath(const Point2* points, int count, float width, Rgba color) override;
+    void text(const char* text, Point2 topLeft, float size, Rgba color) override;
+
+    bool beginGroup(uint32_t key) override;
+    void endGroup() override;
+
+    // Sprites need a cache (setSpriteCache); without one they are unsupported
+    bool beginSprite(uint32_t key, int size) override;
+    void endSprite() override;
+    bool sprite(uint32_t key, Point2 center, float scale) override;
+    void setSpriteCache(RaylibSpriteCache* sprites) noexcept { m_sprites = sprites; }
+
+    // SDF text (nullptr or not ready: DrawText). Text queued outside a group is drawn by
+    // flushText(), so call it once the frame is complete.
+    void setSdfText(RaylibSdfText* text) noexcept { m_text = text; }
+    void flushText();
+
+    // Submission counters (nullptr: not counted)
+    void setStats(FrameStats* stats) noexcept { m_stats = stats; }
+
+private:
+    // rlgl batch state a draw needs: primitive mode and bound texture
+    enum class BatchState : uint8_t { None, Quads, Triangles, Lines, FontTexture, LayerTexture, SpriteTexture, SdfText };
+
+    void drawCachedLayer();
+    void countDraw(BatchState state, uint32_t vertices, uint32_t triangles) noexcept;
+    void countFlush() noexcept;
+
+    RaylibLayerCache* m_cache = nullptr;
+    RaylibSpriteCache* m_sprites = nullptr;
+    RaylibSpriteCache::Slot* m_recordingSprite = nullptr;
+    RaylibSdfText* m_text = nullptr;
+    FrameStats* m_stats = nullptr;
+    int m_width = 0;
+    int m_height = 0;
+    bool m_recording = false;
+    BatchState m_batchState = BatchState::None;
+    uint32_t m_batchVertices = 0;
+};
+
+} // namespace robotface
+
+#endif // ROBOT_FACE_RAYLIB_CANVAS_HPP
@@ -0,0 +1,98 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Remote Rendering Protocol (Unix socket)
+ *
+ *   A headless server runs the face logic and streams display lists; thin clients
+ *   replay them with raylib or the software rasterizer.
+ *
+ *   Message = 24-byte header + payload:
+ *   - DefineList: u32 key, u32 opCount, list bytes (static sub-lists, sent once)
+ *   - Frame:      u32 opCount, list bytes (full frame, sent on connect)
+ *   - FrameDelta: u32 opCount, u32 newSize, u16 patchCount,
+ *                 patchCount * { u32 offset, u16 length, bytes } against the previous frame
+ *
+ *   sentNs is CLOCK_MONOTONIC, so latency is only meaningful on the same machine.
+ *   Payloads and frame sizes are capped at kMaxPayloadBytes; a peer announcing more is
+ *   dropped instead of being allowed to make the receiver allocate it.
+ *
+ *******************************************************************************************/
+
+#ifndef ROBOT_FACE_REMOTE_HPP
+#define ROBOT_FACE_REMOTE_HPP
+
+#include "robot_face_display_list.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace robotface {
+namespace remote {
+
+constexpr const char* kDefaultSocketPath = "/tmp/robot_face.sock";
+constexpr uint32_t kMaxPayloadBytes = 16u << 20;   // 16 MiB; a face frame is a few KiB
+
+enum class MessageType : uint8_t {
+    DefineList = 1,
+    Frame,
+    FrameDelta
+};
+
+struct MessageHeader {
+    uint8_t type;
+    uint8_t reserved[3];
+    uint32_t size;           // Payload bytes
+    uint32_t frameId;
+    uint32_t reserved2;
+    uint64_t sentNs;         // Server CLOCK_MONOTONIC at send
+};
+static_assert(sizeof(MessageHeader) == 24, "MessageHeader must be packed to 24 bytes");
+
+// Clock shared by server and client on one machine
+[[nodiscard]] uint64_t monotonicNs() noexcept;
+
+// Sockets (return -1 on failure)
+int listenUnix(const char* path);
+int acceptClient(int listenFd);          // Non-blocking, -1 when nobody is waiting
+int connectUnix(const char* path);
+void closeSocket(int fd);
+
+// Send one message; returns bytes written (0 on failure, e.g. client gone or payload too large)
+size_t sendMessage(int fd, MessageType type, uint32_t frameId, const void* payload, size_t size);
+
+// Payload encoding
+void encodeDefineList(uint32_t key, const DisplayList& list, std::vector<uint8_t>& out);
+void encodeFrame(const DisplayList& frame, std::vector<uint8_t>& out);
+void encodeFrameDelta(const DisplayList& previous, const DisplayList& next, std::vector<uint8_t>& out);
+
+// Payload decoding
+bool applyDefineList(const uint8_t* payload, size_t size, DisplayListLibrary& library);
+bool applyFrame(const uint8_t* payload, size_t size, DisplayList& frame);
+bool applyFrameDelta(const uint8_t* payload, size_t size, DisplayList& frame);
+
+// Incremental reader over a non-blocking socket
+class MessageReader {
+public:
+    explicit MessageReader(int fd) : m_fd(fd) {}
+
+    // Read what is available; returns false when the peer closed the connection or
+    // announced a message larger than kMaxPayloadBytes (drop the connection)
+    bool poll();
+
+    // Next complete message (payload valid until the next poll())
+    bool next(MessageHeader& header, const uint8_t*& payload);
+
+    [[nodiscard]] uint64_t bytesReceived() const noexcept { return m_bytesReceived; }
+
+private:
+    [[nodiscard]] bool pendingTooLarge() const noexcept;
+
+    int m_fd;
+    std::vector<uint8_t> m_buffer;
+    size_t m_consumed = 0;
+    uint64_t m_bytesReceived = 0;
+};
+
+} // namespace remote
+} // namespace robotface
+
+#endif // ROBOT_FACE_REMOTE_HPP
@@ -0,0 +1,174 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Multi-Face Scene (Modern C++)
+ *
+ *   Features:
+ *   - Many heterogeneous faces in one process: own style, happiness script, gaze target
+ *     and output surface per face
+ *   - Component arrays (transform, animation state, config, render target), no face objects
+ *   - update() runs in chunks on a WorkStealingPool; every chunk writes its faces' draw
+ *     submissions straight into their output's slice, so no merge pass follows
+ *   - Styles and scripts are shared tables referenced by index
+ *   - hitTest() picks the face and region under a pointer from a spatial hash per output,
+ *     kept current as faces move (robot_face_hit.hpp)
+ *
+ *   Faces are added up front (capacity is fixed at construction). Control calls
+ *   (setGazeTarget, setEmotion, ...) must not overlap update().
+ *
+ *******************************************************************************************/
+
+#ifndef ROBOT_FACE_SCENE_HPP
+#define ROBOT_FACE_SCENE_HPP
+
+#include "robot_face.hpp"
+#include "robot_face_animation.hpp"
+#include "robot_face_canvas.hpp"
+#include "robot_face_gaze.hpp"
+#include "robot_face_hit.hpp"
+#include "robot_face_thread_pool.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace robotface {
+
+// Placement of a face's 800x600 design space on its output
+struct FaceTransform {
+    float x = 0.0f;
+    float y = 0.0f;
+    float scale = 1.0f;
+};
+
+// Per-face configuration, shared by every face that references it
+struct FaceStyle {
+    float blinkInterval = Config::BLINK_INTERVAL;
+    float blinkSpeed = Config::BLINK_SPEED;
+    float emotionSmoothTime = Config::EMOTION_SMOOTH_TIME;
+    Rgba eyeColor = {255, 255, 255, 255};
+    Rgba featureColor = {0, 0, 0, 255};   // Outlines, pupils, mouth
+};
+
+// One face, ready to draw (everything the canvas needs, nothing else)
+struct FaceInstance {
+    FaceTransform transform;
+    float happiness;
+    float blinkFactor;       // 0 = open, 1 = closed
+    float mouthOpenness;
+    float pupilX;            // Gaze offset from the eye centres (design space)
+    float pupilY;
+    uint16_t style;
+};
+
+class FaceScene {
+public:
+    using FaceId = uint32_t;
+    using StyleId = uint16_t;
+    using ScriptId = uint16_t;
+    using OutputId = uint16_t;
+    static constexpr FaceId kInvalidFace = 0xFFFFFFFFu;
+    static constexpr ScriptId kNoScript = 0xFFFFu;
+    static constexpr size_t kChunkSize = 256;   // Faces per parallel task
+    static constexpr float kHitCellSize = 128.0f;   // Output pixels per hit grid cell
+
+    // Draw submissions of one output, in face order
+    struct Submissions {
+        const FaceInstance* data;
+        size_t size;
+    };
+
+    // Face and region under a point of an output
+    struct Hit {
+        FaceId face = kInvalidFace;
+        FaceRegion region = FaceRegion::None;
+    };
+
+    // Storage for all faces is reserved here, once; style 0 is the default style
+    FaceScene(size_t capacity, size_t outputCount);
+
+    // Shared tables (a script is a happiness track that loops)
+    StyleId addStyle(const FaceStyle& style);
+    ScriptId addScript(const Keyframe* keys, size_t count);   // kNoScript if count is 0 or too long
+
+    // Returns kInvalidFace when the capacity is exhausted or an id is out of range
+    FaceId add(const FaceTransform& transform, OutputId output, StyleId style = 0,
+               ScriptId script = kNoScript, float happiness = 0.8f);
+
+    // Per-face control
+    void setTransform(FaceId face, const FaceTransform& transform);
+    void setOutput(FaceId face, OutputId output);
+    void setScript(FaceId face, ScriptId script) noexcept;
+    void setEmotion(FaceId face, float happiness) noexcept;   // Springs there (stops the script)
+    void setMouthOpenness(FaceId face, float openness) noexcept;
+    void setGazeTarget(FaceId face, GazePoint target) noexcept { m_gaze.setTarget(face, target); }
+    void triggerBlink(FaceId face) noexcept;
+
+    // Advance every face and rebuild the submissions
+    void update(float deltaTime);                              // Calling thread only
+    void update(float deltaTime, WorkStealingPool& pool);      // Parallel chunks
+
+    // Results of the last update
+    [[nodiscard]] Submissions submissions(OutputId output) const noexcept;
+    [[nodiscard]] float happiness(FaceId face) const noexcept { return m_happiness[face]; }
+    [[nodiscard]] const FaceStyle& style(StyleId style) const noexcept { return m_styles[style]; }
+    [[nodiscard]] size_t size() const noexcept { return m_output.size(); }
+    [[nodiscard]] size_t capacity() const noexcept { return m_capacity; }
+    [[nodiscard]] size_t outputCount() const noexcept { return m_outputOffset.size() - 1; }
+
+    // Replays one output's submissions (canvases are not shared between threads)
+    void draw(OutputId output, Canvas& canvas) const;
+
+    // Topmost face under `point` (output pixels) and its region; `slop` widens eyes and
+    // mouth, in design units. Uses the state of the last update.
+    [[nodiscard]] Hit hitTest(OutputId output, Point2 point, float slop = 0.0f) const noexcept;
+
+private:
+    struct ScriptTrack {
+        Keyframe keys[AnimationEngine::kMaxKeyframes];
+        uint8_t count;
+        float length;
+    };
+
+    void updateRange(size_t begin, size_t end, float deltaTime) noexcept;
+    void assignSlots();
+    [[nodiscard]] static HitBox outputBounds(const FaceTransform& transform) noexcept;
+
+    size_t m_capacity;
+    std::vector<FaceStyle> m_styles;
+    std::vector<ScriptTrack> m_scripts;
+
+    // Transform component
+    std::vector<FaceTransform> m_transform;
+
+    // Animation state component (gaze lives in its own batch, same face index)
+    std::vector<float> m_happiness;
+    std::vector<float> m_happinessVelocity;
+    std::vector<float> m_happinessTarget;
+    std::vector<float> m_scriptTime;
+    std::vector<float> m_blinkProgress;
+    std::vector<float> m_blinkTimer;
+    std::vector<uint8_t> m_blinking;
+    std::vector<float> m_mouthOpenness;
+    GazeBatch m_gaze;
+
+    // Config component
+    std::vector<StyleId> m_style;
+    std::vector<ScriptId> m_script;
+
+    // Render target component: output and position in m_instances
+    std::vector<OutputId> m_output;
+    std::vector<uint32_t> m_slot;
+    std::vector<size_t> m_outputOffset;   // outputCount + 1 entries
+    std::vector<size_t> m_outputCursor;   // Scratch for assignSlots
+    bool m_slotsDirty = true;
+    std::vector<HitGrid> m_hitGrids;      // One per output, face bounds in output pixels
+
+    // Draw submissions, grouped by output
+    std::vector<FaceInstance> m_instances;
+};
+
+// Draws one face instance with its style (shapes only, no static layer or text)
+void drawFaceInstance(Canvas& canvas, const FaceInstance& face, const FaceStyle& style);
+
+} // namespace robotface
+
+#endif // ROBOT_FACE_SCENE_HPP
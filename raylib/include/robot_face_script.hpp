@@ -0,0 +1,209 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Coroutine Expression Scripts (C++20)
+ *
+ *   Features:
+ *   - Sequences written as plain code: co_await blink(face), wait(0.5f), tween(...)
+ *   - Coroutine frames come from a fixed-size ScriptPool (no heap after construction)
+ *   - ScriptRunner resumes every runnable script at most once per update()
+ *
+ *   A script is any coroutine returning Script whose FIRST parameter is ScriptPool&:
+ *
+ *     Script greet(ScriptPool& pool, RobotFace& face) {
+ *         co_await blink(face);
+ *         co_await blink(face);
+ *         co_await tween(face, FaceChannel::Happiness, 1.0f, 0.5f);
+ *         co_await wait(1.0f);
+ *         co_await tween(face, FaceChannel::Happiness, 0.5f, 0.3f);
+ *     }
+ *
+ *     runner.start(greet(pool, face));   // false if the pool or runner is full
+ *
+ *   Only this header and robot_face_script.cpp need C++20; the face stays C++17.
+ *
+ *******************************************************************************************/
+
+#ifndef ROBOT_FACE_SCRIPT_HPP
+#define ROBOT_FACE_SCRIPT_HPP
+
+#include "robot_face.hpp"
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <vector>
+
+// The frame allocator below is forced inline so compilers see the frame come from
+// ScriptPool::allocate. Otherwise GCC pairs the variadic operator new template with the
+// usual operator delete that every coroutine frame is freed with, and warns
+// (-Wmismatched-new-delete) although both go through the pool.
+#if defined(__GNUC__) || defined(__clang__)
+#define ROBOT_FACE_SCRIPT_FRAME_NEW [[gnu::always_inline]] inline
+#else
+#define ROBOT_FACE_SCRIPT_FRAME_NEW inline
+#endif
+
+namespace robotface {
+namespace script {
+
+// Fixed-size blocks for coroutine frames
+class ScriptPool {
+public:
+    ScriptPool(size_t blockCount, size_t blockSize = 256);
+
+    ScriptPool(const ScriptPool&) = delete;
+    ScriptPool& operator=(const ScriptPool&) = delete;
+
+    // nullptr when exhausted or the frame does not fit a block
+    void* allocate(size_t frameSize) noexcept;
+    static void release(void* frame) noexcept;
+
+    [[nodiscard]] size_t used() const noexcept { return m_blockCount - m_free.size(); }
+    [[nodiscard]] size_t capacity() const noexcept { return m_blockCount; }
+    [[nodiscard]] size_t blockSize() const noexcept { return m_blockSize; }
+    [[nodiscard]] size_t largestRequest() const noexcept { return m_largestRequest; }
+    [[nodiscard]] size_t failedRequests() const noexcept { return m_failedRequests; }
+
+private:
+    // Stored in front of every frame so release() finds its pool
+    struct alignas(alignof(std::max_align_t)) BlockHeader {
+        ScriptPool* pool;
+        uint32_t index;
+    };
+
+    size_t m_blockCount;
+    size_t m_blockSize;
+    size_t m_stride;
+    std::unique_ptr<unsigned char[]> m_storage;
+    unsigned char* m_base = nullptr;
+    std::vector<uint32_t> m_free;
+    size_t m_largestRequest = 0;
+    size_t m_failedRequests = 0;
+};
+
+// Owning handle to a suspended script coroutine
+class Script {
+public:
+    struct promise_type {
+        float waitRemaining = 0.0f;           // Seconds left (<= 0 carries overshoot into the next wait)
+        const RobotFace* blinkFace = nullptr; // Waiting for this face to finish blinking
+
+        Script get_return_object() noexcept { return Script{Handle::from_promise(*this)}; }
+        static Script get_return_object_on_allocation_failure() noexcept { return Script{}; }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { std::terminate(); }
+
+        // Frames come from the pool passed as the first coroutine argument
+        template <typename... Args>
+        ROBOT_FACE_SCRIPT_FRAME_NEW static void* operator new(size_t size, ScriptPool& pool, Args&...) noexcept {
+            return pool.allocate(size);
+        }
+        static void operator delete(void* frame) noexcept { ScriptPool::release(frame); }
+    };
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Script() noexcept = default;
+    explicit Script(Handle handle) noexcept : m_handle(handle) {}
+    ~Script() { if (m_handle) m_handle.destroy(); }
+
+    Script(Script&& other) noexcept : m_handle(other.m_handle) { other.m_handle = nullptr; }
+    Script& operator=(Script&& other) noexcept {
+        if (this != &other) {
+            if (m_handle) m_handle.destroy();
+            m_handle = other.m_handle;
+            other.m_handle = nullptr;
+        }
+        return *this;
+    }
+
+    Script(const Script&) = delete;
+    Script& operator=(const Script&) = delete;
+
+    [[nodiscard]] bool valid() const noexcept { return static_cast<bool>(m_handle); }
+    [[nodiscard]] Handle release() noexcept { Handle handle = m_handle; m_handle = nullptr; return handle; }
+
+private:
+    Handle m_handle;
+};
+
+// Awaitables
+struct WaitAwaitable {
+    float seconds;
+
+    bool await_ready() const noexcept { return seconds <= 0.0f; }
+    void await_suspend(Script::Handle handle) const noexcept { handle.promise().waitRemaining += seconds; }
+    void await_resume() const noexcept {}
+};
+
+struct TweenAwaitable {
+    RobotFace& face;
+    FaceChannel channel;
+    float target;
+    float duration;
+    Ease ease;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(Script::Handle handle) const {
+        face.tween(channel, target, duration, ease);
+        handle.promise().waitRemaining += duration;
+    }
+    void await_resume() const noexcept {}
+};
+
+struct BlinkAwaitable {
+    RobotFace& face;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(Script::Handle handle) const {
+        face.triggerBlink();
+        handle.promise().blinkFace = &face;
+        handle.promise().waitRemaining = 0.0f;   // Blink length is event-driven, drop any overshoot
+    }
+    void await_resume() const noexcept {}
+};
+
+[[nodiscard]] inline WaitAwaitable wait(float seconds) noexcept {
+    return WaitAwaitable{seconds};
+}
+
+[[nodiscard]] inline TweenAwaitable tween(RobotFace& face, FaceChannel channel, float target, float duration,
+                                          Ease ease = Ease::Sine) noexcept {
+    return TweenAwaitable{face, channel, target, duration, ease};
+}
+
+[[nodiscard]] inline BlinkAwaitable blink(RobotFace& face) noexcept {
+    return BlinkAwaitable{face};
+}
+
+// Resumes scripts; storage for `capacity` scripts is reserved up front
+class ScriptRunner {
+public:
+    explicit ScriptRunner(size_t capacity);
+    ~ScriptRunner();
+
+    ScriptRunner(const ScriptRunner&) = delete;
+    ScriptRunner& operator=(const ScriptRunner&) = delete;
+
+    // false if the script is empty (pool exhausted) or the runner is full
+    bool start(Script&& script);
+
+    // Advance waits by deltaTime and resume every script whose wait is over
+    void update(float deltaTime);
+
+    void stopAll();
+    [[nodiscard]] size_t active() const noexcept { return m_scripts.size(); }
+    [[nodiscard]] size_t capacity() const noexcept { return m_capacity; }
+
+private:
+    size_t m_capacity;
+    std::vector<Script::Handle> m_scripts;
+};
+
+} // namespace script
+} // namespace robotface
+
+#endif // ROBOT_FACE_SCRIPT_HPP
@@ -0,0 +1,83 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Compact Binary State Snapshots (C API)
+ *
+ *   Features:
+ *   - Versioned snapshot of the full face state, 2..23 bytes per record
+ *   - Delta records carry only the fields whose encoded value changed
+ *   - Exact, 16-bit or 8-bit quantization per stream
+ *   - Decoding writes straight into a RobotFace, no intermediate buffers
+ *
+ *   Record layout:
+ *   - Header byte: bits 0-2 version, bit 3 delta, bits 4-5 quantization
+ *   - Field mask: 7 fields per byte, bit 7 set when another mask byte follows
+ *   - Present fields in id order, little-endian:
+ *       EXACT: float32 (blink_timer: float64), Q16: uint16, Q8: uint8
+ *       FLAGS is always one byte
+ *
+ *   New fields get the next id and are scalars, so older decoders can skip
+ *   them by size. Quantized values are mapped linearly over the field range.
+ *
+ *******************************************************************************************/
+
+#ifndef ROBOT_FACE_SNAPSHOT_H
+#define ROBOT_FACE_SNAPSHOT_H
+
+#include "robot_face.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FACE_SNAPSHOT_VERSION 1
+#define FACE_SNAPSHOT_MAX_BYTES 32   // Upper bound of one record (version 1 fields)
+
+// Quantization of scalar fields
+typedef enum {
+    FACE_SNAPSHOT_EXACT = 0,         // Bit-exact floats
+    FACE_SNAPSHOT_Q16 = 1,           // 16-bit fixed point over the field range
+    FACE_SNAPSHOT_Q8 = 2             // 8-bit fixed point over the field range
+} FaceSnapshotQuant;
+
+// Field ids (append only)
+typedef enum {
+    FACE_SNAPSHOT_FIELD_HAPPINESS = 0,       // [0, 1]
+    FACE_SNAPSHOT_FIELD_BLINK_PROGRESS = 1,  // [0, 2.5]
+    FACE_SNAPSHOT_FIELD_BLINK_TIMER = 2,     // [0, 8] seconds
+    FACE_SNAPSHOT_FIELD_BLINK_SPEED = 3,     // [0, 20]
+    FACE_SNAPSHOT_FIELD_FLAGS = 4,           // bit 0: is_blinking
+    FACE_SNAPSHOT_FIELD_COUNT
+} FaceSnapshotField;
+
+// Per-stream encoder state (one per face)
+typedef struct {
+    FaceSnapshotQuant quant;
+    int keyframe_interval;           // Full record every N updates (0 = first update only)
+    int since_keyframe;
+    bool has_previous;
+    uint64_t previous[FACE_SNAPSHOT_FIELD_COUNT];  // Encoded values of the last record
+} FaceSnapshotEncoder;
+
+// Encoder setup
+void InitFaceSnapshotEncoder(FaceSnapshotEncoder* encoder, FaceSnapshotQuant quant, int keyframeInterval);
+void ResetFaceSnapshotEncoder(FaceSnapshotEncoder* encoder);   // Next record is a keyframe
+
+// Encoding (return bytes written, 0 if out is too small)
+size_t EncodeFaceSnapshot(FaceSnapshotEncoder* encoder, const RobotFace* face, uint8_t* out, size_t capacity);
+size_t EncodeFaceSnapshotFull(FaceSnapshotQuant quant, const RobotFace* face, uint8_t* out, size_t capacity);
+
+// Decoding: a full record overwrites every field, a delta record only the ones present.
+// Returns bytes consumed, 0 if the record is malformed or from a newer major version.
+size_t DecodeFaceSnapshot(const uint8_t* data, size_t size, RobotFace* face);
+
+// Record inspection
+bool IsFaceSnapshotDelta(const uint8_t* data, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ROBOT_FACE_SNAPSHOT_H
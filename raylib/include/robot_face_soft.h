@@ -0,0 +1,69 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Software Rasterizer (C API)
+ *
+ *   Features:
+ *   - Draws the robot face into a caller-owned RGBA8888 buffer
+ *   - No raylib, no GPU and no heap allocation
+ *   - Optional analytic antialiasing
+ *   - Face is designed at SCREEN_WIDTH x SCREEN_HEIGHT and scaled to fit the canvas
+ *
+ *******************************************************************************************/
+
+#ifndef ROBOT_FACE_SOFT_H
+#define ROBOT_FACE_SOFT_H
+
+#include "robot_face.h"
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Color layout matches raylib's Color (r, g, b, a)
+typedef struct {
+    unsigned char r;
+    unsigned char g;
+    unsigned char b;
+    unsigned char a;
+} SoftColor;
+
+#ifdef __cplusplus
+#define SOFT_CLITERAL(type) type
+#else
+#define SOFT_CLITERAL(type) (type)
+#endif
+
+#define SOFT_WHITE    SOFT_CLITERAL(SoftColor){ 255, 255, 255, 255 }
+#define SOFT_BLACK    SOFT_CLITERAL(SoftColor){ 0, 0, 0, 255 }
+#define SOFT_RAYWHITE SOFT_CLITERAL(SoftColor){ 245, 245, 245, 255 }
+
+// Software canvas (pixels are RGBA8888, owned by the caller)
+typedef struct {
+    unsigned char* pixels;   // width * height * 4 bytes (row stride below)
+    int width;
+    int height;
+    int stride;              // Bytes per row
+    float scale;             // Design space -> pixel space scale
+    float offset_x;          // Pixel offset of the design-space origin
+    float offset_y;
+    bool antialias;          // Analytic edge coverage when true
+} SoftCanvas;
+
+// Canvas setup (fits the SCREEN_WIDTH x SCREEN_HEIGHT design space, centered)
+void InitSoftCanvas(SoftCanvas* canvas, unsigned char* pixels, int width, int height);
+
+// Primitives (coordinates and sizes are in design space)
+void SoftClear(SoftCanvas* canvas, SoftColor color);
+void SoftFillCircle(SoftCanvas* canvas, float cx, float cy, float radius, SoftColor color);
+void SoftStrokeCircle(SoftCanvas* canvas, float cx, float cy, float radius, float thickness, SoftColor color);
+void SoftStrokePolyline(SoftCanvas* canvas, const float* points, int pointCount, float thickness, SoftColor color);
+
+// Draw complete robot face (no UI text)
+void DrawRobotFaceSoft(const RobotFace* face, SoftCanvas* canvas);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ROBOT_FACE_SOFT_H
@@ -0,0 +1,44 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Software Canvas Backend
+ *
+ *   Canvas adapter over the C software rasterizer (robot_face_soft.h).
+ *   Text is not rasterized; glyph-free targets only need the face itself.
+ *
+ *   Stats: circles and rings are scan-converted analytically (no vertices); a stroked
+ *   path submits its points. There is no batching or pipeline state to switch.
+ *
+ *******************************************************************************************/
+
+#ifndef ROBOT_FACE_SOFT_CANVAS_HPP
+#define ROBOT_FACE_SOFT_CANVAS_HPP
+
+#include "robot_face_canvas.hpp"
+#include "robot_face_frame_stats.hpp"
+#include "robot_face_soft.h"
+
+namespace robotface {
+
+class SoftwareCanvas final : public Canvas {
+public:
+    explicit SoftwareCanvas(SoftCanvas& target) noexcept : m_target(target) {}
+
+    void clear(Rgba color) override;
+    void circle(Point2 center, float radius, Rgba color) override;
+    void ring(Point2 center, float radius, float thickness, Rgba color) override;
+    void strokePath(const Point2* points, int count, float width, Rgba color) override;
+    void text(const char* text, Point2 topLeft, float size, Rgba color) override;
+
+    [[nodiscard]] SoftCanvas& target() noexcept { return m_target; }
+
+    // Submission counters (nullptr: not counted)
+    void setStats(FrameStats* stats) noexcept { m_stats = stats; }
+
+private:
+    SoftCanvas& m_target;
+    FrameStats* m_stats = nullptr;
+};
+
+} // namespace robotface
+
+#endif // ROBOT_FACE_SOFT_CANVAS_HPP
@@ -0,0 +1,87 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Baked Sprite Sheet Format and Decoder (C API)
+ *
+ *   Features:
+ *   - Pre-rendered (blinkProgress, happiness) grid for devices without a GPU
+ *   - Frames are split into tiles, identical tiles are stored once
+ *   - Tiles are RLE compressed in the target pixel format
+ *   - Decoder reads straight from flash/ROM: no heap, no copies of the sheet
+ *
+ *   Layout (little-endian):
+ *   - RfsHeader (RFS_HEADER_SIZE bytes)
+ *   - Frame index: blink_steps * happy_steps * tiles_x * tiles_y tile ids
+ *     (uint8 when the sheet has at most 256 unique tiles, uint16 otherwise)
+ *   - Tile offsets: (tile_count + 1) uint32 offsets into the data section
+ *   - Data: RLE streams, one per unique tile
+ *
+ *   RLE stream (units are one pixel, or 8 pixels for RFS_FORMAT_MONO1):
+ *   - 0x00..0x7F: literal run, (n + 1) units follow
+ *   - 0x80..0xFF: repeat run, next unit is repeated (n - 0x80 + 2) times
+ *
+ *******************************************************************************************/
+
+#ifndef ROBOT_FACE_SPRITE_H
+#define ROBOT_FACE_SPRITE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RFS_MAGIC "RFSS"
+#define RFS_VERSION 1
+#define RFS_HEADER_SIZE 40
+
+// Target pixel formats
+typedef enum {
+    RFS_FORMAT_GRAY8 = 1,    // 8-bit luminance
+    RFS_FORMAT_RGB565 = 2,   // 16-bit color (little-endian)
+    RFS_FORMAT_MONO1 = 3,    // 1 bit per pixel, MSB first, 1 = ink (dark)
+    RFS_FORMAT_RGBA8888 = 4  // 32-bit color
+} RfsPixelFormat;
+
+// Parsed view of a sprite sheet (points into the caller's blob)
+typedef struct {
+    const uint8_t* blob;
+    uint8_t format;
+    uint8_t index_bytes;     // 1 or 2 bytes per frame index entry
+    uint16_t width;
+    uint16_t height;
+    uint16_t tile_width;
+    uint16_t tile_height;
+    uint16_t tiles_x;
+    uint16_t tiles_y;
+    uint16_t blink_steps;
+    uint16_t happy_steps;
+    uint32_t tile_count;
+    const uint8_t* frame_index;
+    const uint8_t* tile_offsets;
+    const uint8_t* data;
+    uint32_t data_size;
+} RfsSheet;
+
+// Sheet access
+bool RfsOpen(RfsSheet* sheet, const void* blob, size_t size);
+int RfsFrameCount(const RfsSheet* sheet);
+int RfsFrameForState(const RfsSheet* sheet, float blinkProgress, float happiness);
+
+// Decoding into a caller-owned framebuffer (rowBytes = bytes per destination row)
+bool RfsDecodeTile(const RfsSheet* sheet, uint32_t tile, uint8_t* dst, size_t rowBytes);
+bool RfsDecodeFrame(const RfsSheet* sheet, int frame, uint8_t* dst, size_t rowBytes);
+
+// Format helpers
+size_t RfsRowBytes(uint8_t format, int width);
+int RfsUnitBytes(uint8_t format);
+
+// RLE encoder (used by the baker); returns bytes written or 0 if dst is too small
+size_t RfsRleEncode(const uint8_t* src, size_t units, int unitBytes, uint8_t* dst, size_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ROBOT_FACE_SPRITE_H
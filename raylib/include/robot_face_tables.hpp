@@ -0,0 +1,186 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Compile-Time Lookup Tables (Modern C++)
+ *
+ *   Features:
+ *   - Quadratic Bezier basis weights for a fixed segment count
+ *   - Easing curves (sine, cubic, spring) sampled into constexpr tables
+ *   - Linear interpolation with a maximum error measured at compile time
+ *   - Easing selected per use site through a template parameter
+ *
+ *   Everything is generated by the compiler; nothing runs at startup.
+ *
+ *******************************************************************************************/
+
+#ifndef ROBOT_FACE_TABLES_HPP
+#define ROBOT_FACE_TABLES_HPP
+
+#include <cstddef>
+
+namespace robotface {
+namespace tables {
+
+// constexpr replacements for <cmath> (double precision, table generation only)
+namespace detail {
+
+constexpr double kPi = 3.14159265358979323846;
+
+constexpr double abs(double x) {
+    return x < 0.0 ? -x : x;
+}
+
+constexpr double sin(double x) {
+    while (x > kPi) x -= 2.0 * kPi;
+    while (x < -kPi) x += 2.0 * kPi;
+
+    double term = x;
+    double sum = x;
+    for (int n = 1; n < 14; n++) {
+        term *= -x * x / ((2.0 * n) * (2.0 * n + 1.0));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double cos(double x) {
+    return sin(x + kPi / 2.0);
+}
+
+constexpr double exp(double x) {
+    int halvings = 0;
+    while (x > 0.5 || x < -0.5) {
+        x /= 2.0;
+        halvings++;
+    }
+
+    double term = 1.0;
+    double sum = 1.0;
+    for (int n = 1; n < 16; n++) {
+        term *= x / n;
+        sum += term;
+    }
+    while (halvings-- > 0) sum *= sum;
+    return sum;
+}
+
+} // namespace detail
+
+// Curves on [0, 1] (exact, double precision)
+namespace curve {
+
+constexpr double sineOut(double t) { return detail::sin(t * detail::kPi / 2.0); }
+constexpr double sineInOut(double t) { return 0.5 - 0.5 * detail::cos(t * detail::kPi); }
+constexpr double cubic(double t) { return t * t * (3.0 - 2.0 * t); }
+constexpr double spring(double t) { return 1.0 - detail::exp(-6.0 * t) * detail::cos(2.5 * detail::kPi * t); }  // Overshoots, ends at 1
+
+} // namespace curve
+
+// Uniformly sampled curve with linear interpolation
+template <size_t N>
+struct CurveTable {
+    float values[N + 1] = {};
+    float maxError = 0.0f;     // Worst |sample(t) - curve(t)| found at compile time
+
+    constexpr float sample(float t) const noexcept {
+        if (!(t > 0.0f)) return values[0];
+        if (t >= 1.0f) return values[N];
+
+        const float x = t * N;
+        const size_t i = static_cast<size_t>(x);
+        const float f = x - static_cast<float>(i);
+        return values[i] + (values[i + 1] - values[i]) * f;
+    }
+};
+
+template <size_t N, typename Curve>
+constexpr CurveTable<N> makeCurveTable(Curve curve) {
+    CurveTable<N> table;
+    for (size_t i = 0; i <= N; i++) {
+        table.values[i] = static_cast<float>(curve(static_cast<double>(i) / N));
+    }
+
+    // Interpolation error, probed 8 times per cell
+    double worst = 0.0;
+    for (size_t i = 0; i < N * 8; i++) {
+        const double t = (static_cast<double>(i) + 0.5) / (N * 8);
+        const double error = detail::abs(static_cast<double>(table.sample(static_cast<float>(t))) - curve(t));
+        if (error > worst) worst = error;
+    }
+    table.maxError = static_cast<float>(worst);
+    return table;
+}
+
+constexpr size_t kCurveTableSize = 256;
+
+inline constexpr CurveTable<kCurveTableSize> kSineOutTable = makeCurveTable<kCurveTableSize>(curve::sineOut);
+inline constexpr CurveTable<kCurveTableSize> kSineInOutTable = makeCurveTable<kCurveTableSize>(curve::sineInOut);
+inline constexpr CurveTable<kCurveTableSize> kSpringTable = makeCurveTable<kCurveTableSize>(curve::spring);
+
+// Error bounds (checked at compile time, in units of the curve's [0, 1] range)
+static_assert(kSineOutTable.maxError < 1e-5f, "sine table too coarse");
+static_assert(kSineInOutTable.maxError < 1e-5f, "sine in/out table too coarse");
+static_assert(kSpringTable.maxError < 2e-4f, "spring table too coarse");
+
+// Easing policies for template parameters: apply(t) maps [0, 1] -> curve value
+namespace easing {
+
+struct Linear {
+    static constexpr const char* kName = "linear";
+    static constexpr float apply(float t) noexcept { return t; }
+};
+
+struct Sine {
+    static constexpr const char* kName = "sine";
+    static constexpr float apply(float t) noexcept { return kSineOutTable.sample(t); }
+};
+
+struct SineInOut {
+    static constexpr const char* kName = "sine-in-out";
+    static constexpr float apply(float t) noexcept { return kSineInOutTable.sample(t); }
+};
+
+// Smoothstep polynomial: exact, cheaper than any table
+struct Cubic {
+    static constexpr const char* kName = "cubic";
+    static constexpr float apply(float t) noexcept { return t * t * (3.0f - 2.0f * t); }
+};
+
+struct Spring {
+    static constexpr const char* kName = "spring";
+    static constexpr float apply(float t) noexcept { return kSpringTable.sample(t); }
+};
+
+} // namespace easing
+
+// Blink factor (0 = open, 1 = closed) for progress 0 -> 1 (closing) -> 2 (open)
+// Folded as 1 - |1 - progress| so the compiler emits no branch
+template <typename Easing>
+constexpr float blinkFactor(float progress) noexcept {
+    const float distance = 1.0f - progress;
+    return Easing::apply(1.0f - (distance < 0.0f ? -distance : distance));
+}
+
+// Quadratic Bezier basis: B(t) = w0 * P0 + w1 * P1 + w2 * P2 at t = i / Segments
+template <int Segments>
+struct QuadraticBasis {
+    float w0[Segments + 1] = {};
+    float w1[Segments + 1] = {};
+    float w2[Segments + 1] = {};
+};
+
+template <int Segments>
+constexpr QuadraticBasis<Segments> makeQuadraticBasis() {
+    QuadraticBasis<Segments> basis;
+    for (int i = 0; i <= Segments; i++) {
+        const double t = static_cast<double>(i) / Segments;
+        basis.w0[i] = static_cast<float>((1.0 - t) * (1.0 - t));
+        basis.w1[i] = static_cast<float>(2.0 * (1.0 - t) * t);
+        basis.w2[i] = static_cast<float>(t * t);
+    }
+    return basis;
+}
+
+} // namespace tables
+} // namespace robotface
+
+#endif // ROBOT_FACE_TABLES_HPP
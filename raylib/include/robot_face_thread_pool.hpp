@@ -0,0 +1,99 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Work-Stealing Thread Pool (Modern C++)
+ *
+ *   Features:
+ *   - parallelFor over index chunks, the calling thread works as worker 0
+ *   - Each worker owns a contiguous range of chunks and takes them from the front
+ *   - An idle worker steals the back half of another worker's range (one CAS)
+ *   - Workers sleep between jobs; no allocation per job (the body is passed by reference)
+ *
+ *   One job at a time: parallelFor blocks until every chunk has run. Not reentrant.
+ *
+ *******************************************************************************************/
+
+#ifndef ROBOT_FACE_THREAD_POOL_HPP
+#define ROBOT_FACE_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace robotface {
+
+class WorkStealingPool {
+public:
+    // threadCount includes the calling thread (0: one per hardware thread)
+    explicit WorkStealingPool(size_t threadCount = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // body(begin, end, worker) for every chunk of [0, count); returns when all have run.
+    // Chunks are chunkSize items, more if count needs over 2^32 - 1 of them
+    template <typename Body>
+    void parallelFor(size_t count, size_t chunkSize, Body&& body) {
+        using BodyType = std::remove_reference_t<Body>;
+        Job job;
+        job.invoke = [](void* context, size_t begin, size_t end, size_t worker) {
+            (*static_cast<BodyType*>(context))(begin, end, worker);
+        };
+        job.context = const_cast<void*>(static_cast<const void*>(&body));
+        job.count = count;
+        job.chunkSize = chunkSize > 0 ? chunkSize : 1;
+        run(job);
+    }
+
+    [[nodiscard]] size_t threadCount() const noexcept { return m_workerCount; }
+    [[nodiscard]] uint64_t steals() const noexcept { return m_steals.load(std::memory_order_relaxed); }
+
+private:
+    struct Job {
+        void (*invoke)(void*, size_t, size_t, size_t) = nullptr;
+        void* context = nullptr;
+        size_t count = 0;
+        size_t chunkSize = 1;
+    };
+
+    // Chunk range [begin, end) packed into one word so owner and thieves agree with one CAS
+    struct alignas(64) Queue {
+        std::atomic<uint64_t> range{0};
+    };
+
+    static constexpr uint64_t pack(uint32_t begin, uint32_t end) noexcept {
+        return (static_cast<uint64_t>(begin) << 32) | end;
+    }
+    static constexpr size_t kMaxChunks = 0xFFFFFFFFu;   // Per job; chunkSize grows beyond that
+
+    void run(Job job);
+    void workerLoop(size_t worker);
+    void work(size_t worker);
+    bool popFront(size_t worker, uint32_t& chunk) noexcept;
+    bool stealHalf(size_t thief) noexcept;
+
+    size_t m_workerCount;
+    std::unique_ptr<Queue[]> m_queues;
+    std::vector<std::thread> m_threads;
+
+    // Job hand-over
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    uint64_t m_generation = 0;
+    size_t m_busy = 0;               // Worker threads still inside the current job
+    bool m_stop = false;
+    Job m_job;
+
+    std::atomic<uint64_t> m_steals{0};
+};
+
+} // namespace robotface
+
+#endif // ROBOT_FACE_THREAD_POOL_HPP
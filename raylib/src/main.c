@@ -9,41 +9,69 @@
  *   - Mouse Click: Trigger blink
  *   - ESC: Exit
  *
+ *   Usage:
+ *     robot_face_c [--scenario frames]   # Scripted input, uncapped, prints frame time
+ *     robot_face_c --startup             # Print the cold start timeline and exit
+ *
  *******************************************************************************************/
 
 #include "robot_face.h"
 #include "robot_face_config.h"
+#include "robot_face_scenario.h"
+#include "robot_face_startup.h"
 #include "raylib.h"
 #include <math.h>
 
-int main(void) {
+int main(int argc, char** argv) {
+    RobotFaceStartup startup;
+    RobotFaceStartupBegin(&startup, argc, argv);
+
+    RobotFaceScenario scenario;
+    RobotFaceScenarioInit(&scenario, argc, argv);
+
     // Initialization
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Robot Face - Raylib (Modular C)");
-    SetTargetFPS(60);
+    SetTargetFPS(scenario.frames > 0 ? 0 : 60);
+    RobotFaceStartupMark(&startup, "window");   // Window, GL context, default font
 
     RobotFace face;
     InitRobotFace(&face);
+    RobotFaceStartupMark(&startup, "face-init");
+    int framesPresented = 0;
 
     // Main game loop
     while (!WindowShouldClose()) {
         // Update
         float deltaTime = GetFrameTime();
+        RobotFaceScenarioInput scripted = {0};
+        if (scenario.frames > 0) {
+            if (!RobotFaceScenarioNext(&scenario, &scripted)) break;
+            deltaTime = scripted.deltaTime;
+        }
         UpdateRobotFace(&face, deltaTime);
 
-        // Keyboard controls
-        if (IsKeyPressed(KEY_H)) SetEmotion(&face, 1.0f);  // Happy
-        if (IsKeyPressed(KEY_N)) SetEmotion(&face, 0.5f);  // Neutral
-        if (IsKeyPressed(KEY_S)) SetEmotion(&face, 0.0f);  // Sad
+        bool hovering = scripted.hover;
+        if (scenario.frames > 0) {
+            if (scripted.happiness >= 0.0f) SetEmotion(&face, scripted.happiness);
+            if (scripted.blink) TriggerBlink(&face);
+        } else {
+            // Keyboard controls
+            if (IsKeyPressed(KEY_H)) SetEmotion(&face, 1.0f);  // Happy
+            if (IsKeyPressed(KEY_N)) SetEmotion(&face, 0.5f);  // Neutral
+            if (IsKeyPressed(KEY_S)) SetEmotion(&face, 0.0f);  // Sad
 
-        // Mouse controls
-        if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
-            TriggerBlink(&face);
+            // Mouse controls
+            if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
+                TriggerBlink(&face);
+            }
+
+            Vector2 mousePos = GetMousePosition();
+            hovering = mousePos.x > HOVER_AREA_MIN_X && mousePos.x < HOVER_AREA_MAX_X &&
+                       mousePos.y > HOVER_AREA_MIN_Y && mousePos.y < HOVER_AREA_MAX_Y;
         }
 
         // Mouse hover effect (wider smile when hovering over mouth area)
-        Vector2 mousePos = GetMousePosition();
-        if (mousePos.x > HOVER_AREA_MIN_X && mousePos.x < HOVER_AREA_MAX_X &&
-            mousePos.y > HOVER_AREA_MIN_Y && mousePos.y < HOVER_AREA_MAX_Y) {
+        if (hovering) {
             // Gradually increase happiness when hovering
             float newHappiness = face.happiness + deltaTime * HOVER_HAPPINESS_SPEED;
             if (newHappiness > 1.0f) newHappiness = 1.0f;
@@ -53,11 +81,26 @@ int main(void) {
         // Draw
         BeginDrawing();
         DrawRobotFace(&face, SCREEN_WIDTH, SCREEN_HEIGHT);
+        if (framesPresented == 0) RobotFaceStartupMark(&startup, "first-draw");
         EndDrawing();
+
+        // Cold start timeline (--startup exits after the second frame)
+        if (framesPresented < 2 && ++framesPresented == 1) {
+            RobotFaceStartupMark(&startup, "present");
+            RobotFaceStartupFirstFrame(&startup);
+        } else if (framesPresented == 2) {
+            RobotFaceStartupMark(&startup, "deferred");
+            RobotFaceStartupReport(&startup);
+            framesPresented++;
+            if (startup.enabled) break;
+        }
     }
 
     // De-Initialization
+    UnloadRobotFaceStaticLayer();
     CloseWindow();
 
+    RobotFaceScenarioReport(&scenario, "robot_face_c");
+
     return 0;
 }
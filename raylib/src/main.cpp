@@ -7,52 +7,323 @@
  *   - S: Sad emotion
  *   - N: Neutral emotion
  *   - Mouse Click: Trigger blink
+ *   - Mouse Move: Pupils follow the cursor
+ *   - F3: Toggle draw call / vertex counters
+ *   - F4: Toggle the frame pacing graph (last ~4 s of present intervals)
+ *   - F12: Capture frame as a display list (robot_face_frame.rfdl)
  *   - ESC: Exit
  *
+ *   Usage:
+ *     robot_face_cpp [speech.wav | -]   # Optional lip sync: WAV file or raw s16le 16 kHz on stdin
+ *     robot_face_cpp --scenario frames  # Scripted input, uncapped, prints frame time
+ *     robot_face_cpp --startup           # Print the cold start timeline and exit
+ *     robot_face_cpp --quality N         # Pin quality level N (0 = full ... 5 = half-res)
+ *     robot_face_cpp --face robot.face   # Draw from a face description (see faces/; default: built-in code)
+ *     robot_face_cpp --bitmap-font       # Status text with raylib's default font, not the SDF atlas
+ *     robot_face_cpp --assets pack.rfpk  # Status font from a mapped asset pack (robot_face_pack)
+ *     robot_face_cpp --metrics 9464      # Prometheus metrics on 127.0.0.1:9464 (or a Unix socket path)
+ *     robot_face_cpp --pacing            # Print frame pacing (jitter, missed vsyncs, double presents) at exit
+ *
  *******************************************************************************************/
 
 #include "robot_face.hpp"
+#include "robot_face_asset_pack.hpp"
+#include "robot_face_display_list.hpp"
+#include "robot_face_gaze.hpp"
+#include "robot_face_lipsync.hpp"
+#include "robot_face_pacing.hpp"
+#include "robot_face_program.hpp"
+#include "robot_face_quality.hpp"
+#include "robot_face_scenario.h"
+#include "robot_face_startup.h"
 #include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#if defined(ROBOT_FACE_ALLOC_CHECK) || defined(ROBOT_FACE_METRICS)
+#define ROBOT_FACE_ALLOC_COUNTER_IMPLEMENTATION
+#include "robot_face_alloc_counter.hpp"
+#endif
+
+#ifdef ROBOT_FACE_METRICS
+#include "robot_face_metrics.hpp"
+
+// Input the face reacts to, delivered by the poll at the end of the previous EndDrawing
+static bool receivedInput() {
+    const Vector2 motion = GetMouseDelta();
+    return IsKeyPressed(KEY_H) || IsKeyPressed(KEY_S) || IsKeyPressed(KEY_N) ||
+           IsMouseButtonPressed(MOUSE_BUTTON_LEFT) || motion.x != 0.0f || motion.y != 0.0f;
+}
+#endif
+
+// Record the current frame and write it for bug reports
+static void captureFrame(const robotface::RobotFace& face, const char* path) {
+    using namespace robotface;
+
+    DisplayList frame;
+    DisplayListLibrary library;
+    DisplayListRecorder recorder(frame, &library);
+    face.draw(recorder, Config::SCREEN_WIDTH, Config::SCREEN_HEIGHT);
+
+    std::vector<uint8_t> bytes = serializeFrame(frame, &library);
+    if (SaveFileData(path, bytes.data(), static_cast<int>(bytes.size()))) {
+        TraceLog(LOG_INFO, "Captured frame: %s (%d bytes)", path, static_cast<int>(bytes.size()));
+    }
+}
 
-int main() {
+int main(int argc, char** argv) {
     using namespace robotface;
 
+    RobotFaceStartup startup;
+    RobotFaceStartupBegin(&startup, argc, argv);
+
+    // Scripted input instead of keyboard, mouse and audio (profile training, frame timing)
+    RobotFaceScenario scenario;
+    RobotFaceScenarioInit(&scenario, argc, argv);
+    const bool scripted = scenario.frames > 0;
+
     // Initialization
     InitWindow(Config::SCREEN_WIDTH, Config::SCREEN_HEIGHT, "Robot Face - Raylib (Modern C++)");
-    SetTargetFPS(60);
+    SetTargetFPS(scripted ? 0 : Config::TARGET_FPS);
+    RobotFaceStartupMark(&startup, "window");   // Window, GL context, default font
 
     // Create robot face with RAII (automatic cleanup on scope exit)
+    FaceProgram program;   // Optional face description, outlives the face's use of it
+    AssetPack assets;      // Optional mapped asset pack, outlives the font that views it
+    SdfFont font;          // Views the atlas embedded at build time (or in the pack), outlives the face's use of it
     RobotFace face(0.8f);  // Start with happiness = 0.8
 
+    // Pupils follow the mouse cursor while it is over the window
+    GazeBatch gaze(1);
+    const GazeBatch::Index gazeIndex = gaze.add();
+    bool resting = false;   // Previous frame: everything but the pupils at rest
+
+    // Speech input drives the mouth from its own thread (started after the first frame)
+    LipSync lipSync;
+    const char* speechPath = (argc > 1 && !scripted && std::strncmp(argv[1], "--", 2) != 0) ? argv[1] : nullptr;
+    RobotFaceStartupMark(&startup, "face-init");
+    int framesPresented = 0;
+
+    // Quality governor: steps detail down when frames run over budget, back up with headroom.
+    // Off for scenarios (frame times must compare like for like) and when a level is pinned.
+    QualityGovernor governor;
+    bool adaptive = !scripted;
+
+    // Options: --quality N pins a level, --face loads a face description
+    for (int i = 1; i + 1 < argc; i++) {
+        if (std::strcmp(argv[i], "--quality") == 0) {
+            governor.setLevel(std::atoi(argv[i + 1]));
+            adaptive = false;
+        } else if (std::strcmp(argv[i], "--face") == 0) {
+            FaceProgramError error;
+            if (program.load(argv[i + 1], &error)) {
+                face.setProgram(&program);
+                TraceLog(LOG_INFO, "FACE: %s compiled to %d instructions, %d registers, %d folded, %d shared expressions",
+                         argv[i + 1], static_cast<int>(program.code().size()), static_cast<int>(program.registerCount()),
+                         static_cast<int>(program.foldedExpressions()), static_cast<int>(program.sharedExpressions()));
+            } else {
+                TraceLog(LOG_WARNING, "FACE: %s:%d: %s (drawing the built-in face)", argv[i + 1], error.line,
+                         error.message.c_str());
+            }
+        }
+    }
+    const bool bitmapFont = std::any_of(argv + 1, argv + argc, [](const char* arg) {
+        return std::strcmp(arg, "--bitmap-font") == 0;
+    });
+    for (int i = 1; i + 1 < argc && !bitmapFont; i++) {
+        if (std::strcmp(argv[i], "--assets") != 0) continue;
+        const AssetView atlas = assets.open(argv[i + 1]) ? assets.section("font/status", kAssetTypeSdfAtlas)
+                                                          : AssetView{};
+        if (!atlas.empty() && font.load(atlas.data, atlas.size)) {
+            TraceLog(LOG_INFO, "ASSETS: %s mapped, status font %dx%d", argv[i + 1], font.width(), font.height());
+        } else {
+            TraceLog(LOG_WARNING, "ASSETS: %s: %s (using the embedded font)", argv[i + 1],
+                     atlas.empty() ? assets.error() : "not a font atlas");
+        }
+    }
+    if (!bitmapFont && (font.loaded() || loadEmbeddedSdfFont(font))) face.setFont(&font);
+    face.setQuality(governor.settings());
+    unsigned long long frameNumber = 0;
+
+    // Frame pacing of the steady state, graphed by the overlay (F4) and reported with --pacing
+    PacingAnalyzer pacing;
+    face.setPacing(&pacing);
+    const bool pacingReport = std::any_of(argv + 1, argv + argc, [](const char* arg) {
+        return std::strcmp(arg, "--pacing") == 0;
+    });
+
+#ifdef ROBOT_FACE_ALLOC_CHECK
+    // Allocations per frame after warm-up (window, GL and font setup happen before)
+    const int warmupFrames = 120;
+    int frame = 0;
+    uint64_t steadyAllocations = 0;
+#endif
+
+#ifdef ROBOT_FACE_METRICS
+    // Prometheus endpoint: the loop publishes each frame, the exporter's thread serves scrapes
+    MetricsRegistry metrics("raylib");
+    MetricsExporter exporter;
+    for (int i = 1; i + 1 < argc; i++) {
+        if (std::strcmp(argv[i], "--metrics") != 0) continue;
+        if (exporter.start(metrics, argv[i + 1])) {
+            TraceLog(LOG_INFO, "METRICS: serving /metrics on %s", argv[i + 1]);
+        } else {
+            TraceLog(LOG_WARNING, "METRICS: cannot listen on %s", argv[i + 1]);
+        }
+    }
+    double lastPresent = GetTime();
+#endif
+
     // Main game loop
     while (!WindowShouldClose()) {
+#if defined(ROBOT_FACE_ALLOC_CHECK) || defined(ROBOT_FACE_METRICS)
+        const uint64_t allocationsBefore = alloc::allocationCount();
+#endif
+#ifdef ROBOT_FACE_ALLOC_CHECK
+        bool captured = false;
+#endif
+
+        const double frameStart = GetTime();
+        frameNumber++;
+#ifdef ROBOT_FACE_METRICS
+        const bool hadInput = !scripted && receivedInput();
+#endif
+
         // Get delta time
-        const float deltaTime = GetFrameTime();
+        RobotFaceScenarioInput input{};
+        if (scripted && !RobotFaceScenarioNext(&scenario, &input)) break;
+        const float deltaTime = scripted ? input.deltaTime : GetFrameTime();
 
         // Update face animation
         face.update(deltaTime);
+        face.setMouthOpenness(scripted ? input.mouthOpenness : lipSync.openness());
 
-        // Handle keyboard input
-        face.handleKeyboardInput();
+        // Gaze (micro-saccades pause while the rest of the face rests, so it can go idle)
+        gaze.setSaccades(gazeIndex, scripted || !resting);
+        if (scripted) {
+            gaze.setTarget(gazeIndex, GazePoint{input.gazeX, input.gazeY});
+        } else if (IsCursorOnScreen()) {
+            const Vector2 mouse = GetMousePosition();
+            gaze.setTarget(gazeIndex, GazePoint{mouse.x, mouse.y});
+        } else {
+            gaze.lookAhead(gazeIndex);
+        }
+        gaze.update(deltaTime);
+        const GazePoint pupil = gaze.offset(gazeIndex);
+        face.setPupilOffset(pupil.x, pupil.y);
 
-        // Handle mouse input
-        face.handleMouseInput();
+        if (scripted) {
+            if (input.happiness >= 0.0f) face.animateEmotion(input.happiness);
+            if (input.blink) face.triggerBlink();
+        } else {
+            // Handle keyboard input
+            face.handleKeyboardInput();
+
+            // Handle mouse input
+            face.handleMouseInput();
+        }
+
+        // Frame capture
+        if (IsKeyPressed(KEY_F12)) {
+            captureFrame(face, "robot_face_frame.rfdl");
+#ifdef ROBOT_FACE_ALLOC_CHECK
+            captured = true;  // Capture allocates by design
+#endif
+        }
 
         // Mouse hover effect (wider smile when hovering over mouth area)
-        if (face.isMouseOverMouth()) {
+        const bool hovering = scripted ? input.hover : face.isMouseOverMouth();
+        if (hovering) {
             // Gradually increase happiness when hovering
             const float newHappiness = std::min(face.happiness() + deltaTime * Config::HOVER_HAPPINESS_SPEED, 1.0f);
             face.setEmotion(newHappiness);
         }
 
+        // Idle frames: nothing moves until the next blink and the pupils have settled, so drop
+        // to a low frame rate
+        resting = face.isAtRest() && face.timeUntilNextAnimation() > 1.0f / Config::IDLE_FPS && !hovering &&
+                  !lipSync.running() && !IsCursorOnScreen();
+        const bool idle = resting && gaze.settled(gazeIndex);
+        if (!scripted) SetTargetFPS(idle ? Config::IDLE_FPS : Config::TARGET_FPS);
+
         // Draw
         BeginDrawing();
         face.draw(Config::SCREEN_WIDTH, Config::SCREEN_HEIGHT);
+        if (framesPresented == 0) RobotFaceStartupMark(&startup, "first-draw");
+        const float busyMs = static_cast<float>((GetTime() - frameStart) * 1000.0);   // Without the limiter wait
         EndDrawing();
+        const double presentedAt = GetTime();
+        const float targetMs = scripted ? 0.0f : 1000.0f / static_cast<float>(idle ? Config::IDLE_FPS : Config::TARGET_FPS);
+        if (framesPresented > 2) pacing.addPresent(presentedAt, targetMs);
+
+        // Startup frames pay for window and texture setup; judge the steady state only
+        if (adaptive && framesPresented > 2 && governor.addFrame(busyMs)) {
+            TraceLog(LOG_INFO, "QUALITY: %s -> %s at frame %llu (%.2f ms, budget %.2f ms)",
+                     kQualityLevelNames[governor.previousLevel()], governor.levelName(), frameNumber,
+                     static_cast<double>(busyMs), static_cast<double>(governor.config().budgetMs));
+            face.setQuality(governor.settings());
+        }
+
+        // Cold start: the face is on screen, now the deferred work
+        if (framesPresented < 2 && ++framesPresented == 1) {
+            RobotFaceStartupMark(&startup, "present");
+            RobotFaceStartupFirstFrame(&startup);
+            if (speechPath && !lipSync.startFile(speechPath)) {
+                TraceLog(LOG_WARNING, "Lip sync: cannot open %s", speechPath);
+                speechPath = nullptr;
+            }
+        } else if (framesPresented == 2) {
+            RobotFaceStartupMark(&startup, "deferred");   // Lip sync start, text, static layer texture
+            RobotFaceStartupReport(&startup);
+            framesPresented++;
+            if (startup.enabled) break;
+        }
+
+        // The lip sync thread reads the header: a source that is not PCM16 shows up later
+        if (speechPath && lipSync.failed()) {
+            TraceLog(LOG_WARNING, "Lip sync: cannot read %s (PCM16 WAV or raw s16le expected)", speechPath);
+            speechPath = nullptr;
+        }
+
+#ifdef ROBOT_FACE_ALLOC_CHECK
+        const uint64_t allocations = alloc::allocationCount() - allocationsBefore;
+        if (++frame > warmupFrames && !captured && allocations > 0) {
+            steadyAllocations += allocations;
+            TraceLog(LOG_WARNING, "ALLOC: frame %d allocated %d times", frame, static_cast<int>(allocations));
+        }
+#endif
+
+#ifdef ROBOT_FACE_METRICS
+        // Input latency runs from the poll to the return of EndDrawing, which includes the
+        // limiter's wait after the swap: an upper bound
+        FrameSample sample;
+        sample.intervalMs = static_cast<float>((presentedAt - lastPresent) * 1000.0);
+        sample.busyMs = busyMs;
+        sample.targetMs = targetMs;
+        sample.inputLatencyMs = hadInput ? static_cast<float>((presentedAt - frameStart) * 1000.0) : -1.0f;
+        sample.happiness = face.happiness();
+        sample.emotion = face.emotionLabel();
+        sample.blinking = face.isBlinking();
+        sample.qualityLevel = governor.level();
+        sample.allocations = static_cast<int64_t>(alloc::allocationCount() - allocationsBefore);
+        metrics.publish(sample);
+        lastPresent = presentedAt;
+#endif
     }
 
-    // De-Initialization (automatic via RAII)
+    // De-Initialization (GPU resources first, the rest automatic via RAII)
+    face.unloadStaticLayer();
     CloseWindow();
 
+    RobotFaceScenarioReport(&scenario, "robot_face_cpp");
+    if (pacingReport) pacing.report(stdout, "robot_face_cpp");
+
+#ifdef ROBOT_FACE_ALLOC_CHECK
+    TraceLog(LOG_INFO, "ALLOC: %d frames, %d steady-state allocations, peak RSS %d KiB", frame,
+             static_cast<int>(steadyAllocations), static_cast<int>(alloc::peakRssKb()));
+    if (steadyAllocations > 0) return 1;
+#endif
+
     return 0;
 }
@@ -5,11 +5,51 @@
  *******************************************************************************************/
 
 #include "robot_face.h"
+#include "robot_face_blink.h"
 #include "robot_face_config.h"
 #include <math.h>
 
+#ifndef PI
+#define PI 3.14159265358979323846f
+#endif
+
+// Lookup tables, built on first use (no sinf or Bezier weights per frame)
+// Blink: sin(t * PI / 2) sampled at 64 steps, linear interpolation error < 8e-5
+#define BLINK_TABLE_SIZE 64
+
+static float blinkTable[BLINK_TABLE_SIZE + 1];
+static float mouthBasis[(MOUTH_SEGMENTS + 1) * 3];
+static bool tablesReady = false;
+
+static void InitTables(void) {
+    for (int i = 0; i <= BLINK_TABLE_SIZE; i++) {
+        blinkTable[i] = sinf((float)i / BLINK_TABLE_SIZE * PI / 2.0f);
+    }
+
+    for (int i = 0; i <= MOUTH_SEGMENTS; i++) {
+        float t = (float)i / MOUTH_SEGMENTS;
+        mouthBasis[i*3] = (1-t)*(1-t);
+        mouthBasis[i*3 + 1] = 2*(1-t)*t;
+        mouthBasis[i*3 + 2] = t*t;
+    }
+
+    tablesReady = true;
+}
+
+static float SampleBlinkTable(float t) {
+    if (!tablesReady) InitTables();
+    if (t <= 0.0f) return 0.0f;
+    if (t >= 1.0f) return 1.0f;
+
+    float x = t * BLINK_TABLE_SIZE;
+    int i = (int)x;
+    return blinkTable[i] + (blinkTable[i + 1] - blinkTable[i]) * (x - (float)i);
+}
+
 // Initialize robot face with default values
 void InitRobotFace(RobotFace* face) {
+    if (!tablesReady) InitTables();
+
     face->happiness = 0.8f;        // Start slightly happy
     face->blink_progress = 0.0f;   // Eyes open
     face->blink_timer = 0.0;       // Reset timer
@@ -20,11 +60,8 @@ void InitRobotFace(RobotFace* face) {
 // Update robot face state (animations)
 void UpdateRobotFace(RobotFace* face, float deltaTime) {
     // Update blink timer for automatic blinking
-    face->blink_timer += deltaTime;
-
-    if (face->blink_timer >= BLINK_INTERVAL && !face->is_blinking) {
+    if (RobotFaceAdvanceBlinkTimer(&face->blink_timer, deltaTime, BLINK_INTERVAL, face->is_blinking)) {
         face->is_blinking = true;
-        face->blink_timer = 0.0;
     }
 
     // Animate blink
@@ -75,3 +112,33 @@ float GetHappiness(const RobotFace* face) {
 bool IsBlinking(const RobotFace* face) {
     return face->is_blinking;
 }
+
+// Calculate blink factor (0 = open, 1 = closed) using a sine wave (table lookup)
+float GetBlinkFactor(float blinkProgress) {
+    if (blinkProgress < 1.0f) {
+        // Closing (0 to 1)
+        return SampleBlinkTable(blinkProgress);
+    } else {
+        // Opening (1 to 0)
+        return SampleBlinkTable(2.0f - blinkProgress);
+    }
+}
+
+// Pupil size changes during blink (shrinks to 5px when closed)
+float GetPupilRadius(float blinkProgress) {
+    return PUPIL_RADIUS * (1.0f - GetBlinkFactor(blinkProgress) * 0.875f);
+}
+
+// Control point Y varies with emotion
+// happiness 1.0 (happy) -> Y = 430 (curve down)
+// happiness 0.5 (neutral) -> Y = 400 (straight)
+// happiness 0.0 (sad) -> Y = 370 (curve up)
+float GetMouthControlY(float happiness) {
+    return MOUTH_CENTER_Y + (happiness - 0.5f) * MOUTH_CURVE_FACTOR;
+}
+
+// Bezier weights for the mouth polyline
+const float* GetMouthBezierBasis(void) {
+    if (!tablesReady) InitTables();
+    return mouthBasis;
+}
@@ -5,65 +5,149 @@
  *******************************************************************************************/
 
 #include "robot_face.hpp"
+#include "robot_face_raylib_canvas.hpp"
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
 
 namespace robotface {
 
+namespace {
+
+// Pupil sprite: pupil and highlight at full size, centred in the box
+constexpr uint32_t kPupilSpriteKey = 0x50555049u;   // 'PUPI'
+constexpr int kPupilSpriteSize = static_cast<int>(Config::PUPIL_RADIUS) * 2 + 2;
+
+} // namespace
+
 // Constructor
 RobotFace::RobotFace(float initialHappiness)
-    : m_happiness(clampHappiness(initialHappiness))
-    , m_blinkProgress(0.0f)
+    : m_animation(kChannelCount)
     , m_blinkTimer(0.0)
     , m_isBlinking(false)
 {
-    // All initialization done in member initializer list (modern C++ style)
+    // Channel order matches kHappinessChannel / kBlinkChannel
+    m_animation.addChannel(clampHappiness(initialHappiness));
+    m_animation.addChannel(0.0f);
 }
 
 // Update animation state
 void RobotFace::update(float deltaTime) {
     // Update blink timer for automatic blinking
-    m_blinkTimer += deltaTime;
-
-    if (m_blinkTimer >= Config::BLINK_INTERVAL && !m_isBlinking) {
+    if (advanceBlinkTimer(m_blinkTimer, deltaTime, Config::BLINK_INTERVAL, m_isBlinking)) {
         m_isBlinking = true;
-        m_blinkTimer = 0.0;
+        startBlink(0.0f);
     }
 
-    // Animate blink
-    if (m_isBlinking) {
-        m_blinkProgress += Config::BLINK_SPEED * deltaTime;
+    // Advance all animated channels
+    m_animation.update(deltaTime);
 
-        if (m_blinkProgress >= Config::BLINK_COMPLETE_THRESHOLD) {
-            m_blinkProgress = 0.0f;
-            m_isBlinking = false;
-        }
+    // Blink track finished: eyes open again
+    if (m_isBlinking && m_animation.atRest(kBlinkChannel)) {
+        m_animation.set(kBlinkChannel, 0.0f);
+        m_isBlinking = false;
     }
 }
 
+// Blink progress runs linearly 0 -> 2; the eye shape comes from calculateBlinkFactor
+void RobotFace::startBlink(float from) {
+    const float duration = (Config::BLINK_COMPLETE_THRESHOLD - from) / Config::BLINK_SPEED;
+    const Keyframe keys[] = {
+        {0.0f, from, Ease::Linear},
+        {duration, Config::BLINK_COMPLETE_THRESHOLD, Ease::Linear},
+    };
+    m_animation.play(kBlinkChannel, keys, 2);
+}
+
+// Seconds until the face changes on its own (0 while animating)
+float RobotFace::timeUntilNextAnimation() const noexcept {
+    if (!isAtRest()) return 0.0f;
+    return std::max(0.0f, Config::BLINK_INTERVAL - static_cast<float>(m_blinkTimer));
+}
+
 // Set emotion by float value
 void RobotFace::setEmotion(float happiness) {
-    m_happiness = clampHappiness(happiness);
+    m_animation.set(kHappinessChannel, clampHappiness(happiness));
 }
 
 // Set emotion by enum
 void RobotFace::setEmotion(Emotion emotion) {
-    m_happiness = emotionToHappiness(emotion);
+    m_animation.set(kHappinessChannel, emotionToHappiness(emotion));
+}
+
+// Smooth emotion transition (critically damped, retargetable mid-flight)
+void RobotFace::animateEmotion(float happiness, float smoothTime) {
+    m_animation.springTo(kHappinessChannel, clampHappiness(happiness), smoothTime);
+}
+
+void RobotFace::animateEmotion(Emotion emotion, float smoothTime) {
+    m_animation.springTo(kHappinessChannel, emotionToHappiness(emotion), smoothTime);
+}
+
+// Keyframed transition from the current value over a fixed duration
+void RobotFace::tween(FaceChannel channel, float target, float duration, Ease ease) {
+    const auto index = static_cast<AnimationEngine::Channel>(channel);
+    if (channel == FaceChannel::Happiness) target = clampHappiness(target);
+
+    if (duration <= 0.0f) {
+        m_animation.set(index, target);
+        return;
+    }
+
+    const Keyframe keys[] = {
+        {0.0f, m_animation.value(index), ease},
+        {duration, target, Ease::Linear},
+    };
+    m_animation.play(index, keys, 2);
+}
+
+void RobotFace::setMouthOpenness(float openness) noexcept {
+    m_mouthOpenness = std::clamp(openness, 0.0f, 1.0f);
+}
+
+void RobotFace::setPupilOffset(float x, float y) noexcept {
+    const float length = std::sqrt(x * x + y * y);
+    const float scale = (length > Config::PUPIL_MAX_OFFSET) ? Config::PUPIL_MAX_OFFSET / length : 1.0f;
+    m_pupilOffset = Vector2{x * scale, y * scale};
+}
+
+bool RobotFace::channelAtRest(FaceChannel channel) const noexcept {
+    return m_animation.atRest(static_cast<AnimationEngine::Channel>(channel));
 }
 
 // Trigger manual blink
 void RobotFace::triggerBlink() {
     if (!m_isBlinking) {
         m_isBlinking = true;
-        m_blinkProgress = 0.0f;
+        startBlink(0.0f);
     }
 }
 
+// Export the animation state
+FaceState RobotFace::state() const noexcept {
+    FaceState state;
+    state.happiness = happiness();
+    state.blinkProgress = blinkProgress();
+    state.blinkTimer = m_blinkTimer;
+    state.isBlinking = m_isBlinking;
+    return state;
+}
+
+// Restore the animation state (e.g. from a decoded snapshot)
+void RobotFace::setState(const FaceState& state) noexcept {
+    m_animation.set(kHappinessChannel, clampHappiness(state.happiness));
+    m_animation.set(kBlinkChannel, state.blinkProgress);
+    m_blinkTimer = state.blinkTimer;
+    m_isBlinking = state.isBlinking;
+    if (m_isBlinking) startBlink(state.blinkProgress);
+}
+
 // Get current emotion based on happiness level
 Emotion RobotFace::currentEmotion() const noexcept {
-    if (m_happiness > Config::EMOTION_HAPPY_THRESHOLD) {
+    const float happinessValue = happiness();
+    if (happinessValue > Config::EMOTION_HAPPY_THRESHOLD) {
         return Emotion::Happy;
-    } else if (m_happiness < Config::EMOTION_SAD_THRESHOLD) {
+    } else if (happinessValue < Config::EMOTION_SAD_THRESHOLD) {
         return Emotion::Sad;
     } else {
         return Emotion::Neutral;
@@ -72,6 +156,11 @@ Emotion RobotFace::currentEmotion() const noexcept {
 
 // Get emotion name as string
 std::string RobotFace::emotionName() const {
+    return emotionLabel();
+}
+
+// Get emotion name without allocating (used by the render loop)
+const char* RobotFace::emotionLabel() const noexcept {
     switch (currentEmotion()) {
         case Emotion::Happy: return "Happy";
         case Emotion::Sad: return "Sad";
@@ -80,35 +169,13 @@ std::string RobotFace::emotionName() const {
     }
 }
 
-// Handle keyboard input
-void RobotFace::handleKeyboardInput() {
-    if (IsKeyPressed(KEY_H)) setEmotion(Emotion::Happy);
-    if (IsKeyPressed(KEY_N)) setEmotion(Emotion::Neutral);
-    if (IsKeyPressed(KEY_S)) setEmotion(Emotion::Sad);
-}
-
-// Handle mouse input
-void RobotFace::handleMouseInput() {
-    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
-        triggerBlink();
-    }
-}
-
-// Check if mouse is over mouth area
-bool RobotFace::isMouseOverMouth() const {
-    Vector2 mousePos = GetMousePosition();
-    return CheckCollisionPointRec(mousePos, Config::HOVER_AREA);
+FaceRegion RobotFace::regionAt(Point2 point, float slop) const noexcept {
+    return hitTestFace(kFaceGeometry, point, happiness(), m_mouthOpenness, slop);
 }
 
-// Calculate blink factor for animation
+// Calculate blink factor for animation (closing 0 -> 1, opening 1 -> 0, table lookup)
 float RobotFace::calculateBlinkFactor(float progress) const noexcept {
-    if (progress < 1.0f) {
-        // Closing (0 to 1)
-        return std::sin(progress * PI / 2.0f);
-    } else {
-        // Opening (1 to 0)
-        return std::sin((2.0f - progress) * PI / 2.0f);
-    }
+    return tables::blinkFactor<Config::BlinkEasing>(progress);
 }
 
 // Clamp happiness to valid range [0, 1]
@@ -116,78 +183,109 @@ float RobotFace::clampHappiness(float value) noexcept {
     return std::clamp(value, 0.0f, 1.0f);
 }
 
-// Draw a single eye with blink animation
-void RobotFace::drawEye(float x, float y, float blinkProgress) const {
-    const float blinkFactor = calculateBlinkFactor(blinkProgress);
+// Current animated state for the shared face drawing
+FacePose RobotFace::pose() const noexcept {
+    return FacePose{happiness(), calculateBlinkFactor(blinkProgress()), m_mouthOpenness, m_pupilOffset.x,
+                    m_pupilOffset.y};
+}
 
-    // Eye white (outer circle)
-    DrawCircle(static_cast<int>(x), static_cast<int>(y), Config::EYE_RADIUS, WHITE);
-    DrawCircleLines(static_cast<int>(x), static_cast<int>(y), Config::EYE_RADIUS, BLACK);
+// Design space at the window origin, detail from the quality level
+FaceLook RobotFace::look() const noexcept {
+    FaceLook result;
+    result.mouthSegments = m_quality.mouthSegments;
+    result.pupilSprite = m_quality.eyeSprites ? kPupilSpriteKey : 0;
+    return result;
+}
 
-    // Pupil size changes during blink
-    const float pupilRadius = Config::PUPIL_RADIUS * (1.0f - blinkFactor * 0.875f);
+// Draw everything that never changes between frames
+void RobotFace::drawStaticLayer(Canvas& canvas, int width, int height) const {
+    (void)width;
 
-    // Pupil (black circle)
-    DrawCircle(static_cast<int>(x), static_cast<int>(y), pupilRadius, BLACK);
+    canvas.clear(toRgba(RAYWHITE));
+    canvas.text("Raylib Robot Face (Modern C++)", Point2{10, 10}, 20, toRgba(DARKGRAY));
+    drawEyeWhites(canvas, look());
+    canvas.text("Controls: H=Happy, S=Sad, N=Neutral, Click=Blink, ESC=Exit",
+                Point2{10, static_cast<float>(height - 30)}, 16, toRgba(GRAY));
+}
 
-    // Highlight (gives eyes a "shiny" look)
-    if (pupilRadius > 10.0f) {
-        const float highlightSize = Config::HIGHLIGHT_RADIUS * (pupilRadius / Config::PUPIL_RADIUS);
-        DrawCircle(static_cast<int>(x - 15), static_cast<int>(y - 15), highlightSize, WHITE);
+// Records the pupil sprite once (canvases without sprite support skip it)
+void RobotFace::preparePupilSprite(Canvas& canvas) const {
+    if (canvas.beginSprite(kPupilSpriteKey, kPupilSpriteSize)) {
+        const float center = static_cast<float>(kPupilSpriteSize) * 0.5f;
+        drawPupil(canvas, Point2{center, center}, Config::PUPIL_RADIUS, FaceLook{});
+        canvas.endSprite();
     }
 }
 
-// Draw mouth as a Bezier curve
-void RobotFace::drawMouth(float centerX, float centerY, float happiness) const {
-    const Vector2 start = Config::MOUTH_START;
-    const Vector2 end = Config::MOUTH_END;
-
-    // Control point Y varies with emotion
-    const float controlY = Config::MOUTH_CENTER.y + (happiness - 0.5f) * Config::MOUTH_CURVE_FACTOR;
-    const Vector2 control = { Config::MOUTH_CENTER.x, controlY };
-
-    // Draw Bezier curve with multiple segments for smoothness
-    for (int i = 0; i < Config::MOUTH_SEGMENTS; i++) {
-        const float t1 = static_cast<float>(i) / Config::MOUTH_SEGMENTS;
-        const float t2 = static_cast<float>(i + 1) / Config::MOUTH_SEGMENTS;
-
-        // Quadratic Bezier formula: B(t) = (1-t)²P0 + 2(1-t)tP1 + t²P2
-        const float x1 = (1-t1)*(1-t1)*start.x + 2*(1-t1)*t1*control.x + t1*t1*end.x;
-        const float y1 = (1-t1)*(1-t1)*start.y + 2*(1-t1)*t1*control.y + t1*t1*end.y;
-
-        const float x2 = (1-t2)*(1-t2)*start.x + 2*(1-t2)*t2*control.x + t2*t2*end.x;
-        const float y2 = (1-t2)*(1-t2)*start.y + 2*(1-t2)*t2*control.y + t2*t2*end.y;
+// Draw dynamic UI elements (emotion, FPS)
+// Fixed stack buffers: the steady-state frame must not touch the heap
+void RobotFace::drawUI(Canvas& canvas, int width, int height) const {
+    if (!m_quality.overlay) return;
+
+    char emotionText[64];
+    std::snprintf(emotionText, sizeof(emotionText), "Emotion: %s (%.2f)", emotionLabel(), happiness());
+    canvas.text(emotionText, Point2{10, 40}, 20, toRgba(DARKGRAY));
+
+    char fpsText[32];
+    std::snprintf(fpsText, sizeof(fpsText), "FPS: %d", m_fps);
+    canvas.text(fpsText, Point2{10, 70}, 20, toRgba(DARKGREEN));
+
+    if (m_statsOverlay) {
+        char statsText[128];
+        std::snprintf(statsText, sizeof(statsText), "Draws %u  Verts %u  Tris %u  Flushes %u  States %u  Glyphs %u",
+                      m_frameStats.drawCalls, m_frameStats.vertices, m_frameStats.triangles,
+                      m_frameStats.batchFlushes, m_frameStats.stateChanges, m_frameStats.glyphs);
+        canvas.text(statsText, Point2{10, 100}, 16, toRgba(MAROON));
+    }
 
-        DrawLineEx(Vector2{x1, y1}, Vector2{x2, y2}, Config::MOUTH_STROKE_WIDTH, BLACK);
+    // Last ~4 s of present intervals, summary above the graph, both above the controls line
+    if (m_pacingOverlay && m_pacing) {
+        constexpr float kGraphHeight = 90.0f;
+        const float graphWidth = std::clamp(static_cast<float>(width - 20), 0.0f, 300.0f);
+        const float graphTop = static_cast<float>(height - 40) - kGraphHeight;
+
+        char pacingText[128];
+        m_pacing->summary(pacingText, sizeof(pacingText));
+        canvas.text(pacingText, Point2{10, graphTop - 24}, 16, toRgba(DARKGRAY));
+        PacingGraph graph;
+        graph.layout(*m_pacing, 10.0f, graphTop, graphWidth, kGraphHeight);
+        graph.draw(canvas);
     }
 }
 
-// Draw UI elements (title, emotion, FPS, controls)
-void RobotFace::drawUI(int width, int height) const {
-    DrawText("Raylib Robot Face (Modern C++)", 10, 10, 20, DARKGRAY);
-
-    const std::string emotionText = "Emotion: " + emotionName() +
-                                   " (" + std::to_string(m_happiness).substr(0, 4) + ")";
-    DrawText(emotionText.c_str(), 10, 40, 20, DARKGRAY);
-
-    DrawText(TextFormat("FPS: %d", GetFPS()), 10, 70, 20, DARKGREEN);
-    DrawText("Controls: H=Happy, S=Sad, N=Neutral, Click=Blink, ESC=Exit",
-             10, height - 30, 16, GRAY);
+// Everything a face description can bind to, for the current state
+FaceInputs RobotFace::programInputs(int width, int height) const noexcept {
+    FaceInputs inputs;
+    inputs.happiness = happiness();
+    inputs.blink = calculateBlinkFactor(blinkProgress());
+    inputs.openness = m_mouthOpenness;
+    inputs.gazeX = m_pupilOffset.x;
+    inputs.gazeY = m_pupilOffset.y;
+    inputs.width = static_cast<float>(width);
+    inputs.height = static_cast<float>(height);
+    return inputs;
 }
 
-// Draw complete robot face
-void RobotFace::draw(int width, int height) const {
-    ClearBackground(RAYWHITE);
+// Draw complete robot face into any canvas
+void RobotFace::draw(Canvas& canvas, int width, int height) const {
+    // Described face: static layer, eyes and mouth come from the program
+    if (m_program) {
+        m_program->run(canvas, programInputs(width, height));
+        drawUI(canvas, width, height);
+        return;
+    }
 
-    // Draw eyes
-    drawEye(Config::LEFT_EYE_POS.x, Config::LEFT_EYE_POS.y, m_blinkProgress);
-    drawEye(Config::RIGHT_EYE_POS.x, Config::RIGHT_EYE_POS.y, m_blinkProgress);
+    // Static layer (reused by canvases that cache groups)
+    if (canvas.beginGroup(staticLayerKey(width, height))) {
+        drawStaticLayer(canvas, width, height);
+        canvas.endGroup();
+    }
 
-    // Draw mouth
-    drawMouth(Config::MOUTH_CENTER.x, Config::MOUTH_CENTER.y, m_happiness);
+    // Draw eyes and mouth
+    drawFaceFeatures(canvas, pose(), look());
 
     // Draw UI
-    drawUI(width, height);
+    drawUI(canvas, width, height);
 }
 
 } // namespace robotface
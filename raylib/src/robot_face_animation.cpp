@@ -0,0 +1,147 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Animation Engine Implementation
+ *
+ *******************************************************************************************/
+
+#include "robot_face_animation.hpp"
+#include "robot_face_tables.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace robotface {
+
+float applyEase(Ease ease, float t) noexcept {
+    switch (ease) {
+        case Ease::Smooth: return tables::easing::Cubic::apply(t);
+        case Ease::Sine: return tables::easing::SineInOut::apply(t);
+        case Ease::Spring: return tables::easing::Spring::apply(t);
+        case Ease::Step: return 0.0f;
+        case Ease::Linear:
+        default: return t;
+    }
+}
+
+AnimationEngine::AnimationEngine(size_t channelCapacity)
+    : m_capacity(channelCapacity)
+{
+    m_value.reserve(channelCapacity);
+    m_velocity.reserve(channelCapacity);
+    m_target.reserve(channelCapacity);
+    m_omega.reserve(channelCapacity);
+    m_time.reserve(channelCapacity);
+    m_mode.reserve(channelCapacity);
+    m_keys.reserve(channelCapacity * kMaxKeyframes);
+    m_keyCount.reserve(channelCapacity);
+}
+
+AnimationEngine::Channel AnimationEngine::addChannel(float value) {
+    if (m_value.size() >= m_capacity) return kInvalidChannel;
+
+    m_value.push_back(value);
+    m_velocity.push_back(0.0f);
+    m_target.push_back(value);
+    m_omega.push_back(0.0f);
+    m_time.push_back(0.0f);
+    m_mode.push_back(Mode::Rest);
+    m_keys.resize(m_keys.size() + kMaxKeyframes, Keyframe{0.0f, value, Ease::Linear});
+    m_keyCount.push_back(0);
+    return static_cast<Channel>(m_value.size() - 1);
+}
+
+void AnimationEngine::setMode(Channel channel, Mode mode) noexcept {
+    const bool wasActive = m_mode[channel] != Mode::Rest;
+    const bool isActive = mode != Mode::Rest;
+    m_mode[channel] = mode;
+    if (isActive && !wasActive) m_active++;
+    if (!isActive && wasActive) m_active--;
+}
+
+void AnimationEngine::set(Channel channel, float value) {
+    m_value[channel] = value;
+    m_target[channel] = value;
+    m_velocity[channel] = 0.0f;
+    setMode(channel, Mode::Rest);
+}
+
+// Velocity carries over, so retargeting mid-flight stays smooth
+void AnimationEngine::springTo(Channel channel, float target, float smoothTime) {
+    m_target[channel] = target;
+    m_omega[channel] = 2.0f / std::max(smoothTime, 1e-4f);
+    setMode(channel, Mode::Spring);
+}
+
+bool AnimationEngine::play(Channel channel, const Keyframe* keys, size_t count) {
+    if (count == 0 || count > kMaxKeyframes) return false;
+
+    std::copy(keys, keys + count, m_keys.begin() + static_cast<std::ptrdiff_t>(channel * kMaxKeyframes));
+    m_keyCount[channel] = static_cast<uint8_t>(count);
+    m_time[channel] = 0.0f;
+    m_target[channel] = keys[count - 1].value;
+    m_velocity[channel] = 0.0f;
+    m_value[channel] = keys[0].value;
+    setMode(channel, Mode::Keyframes);
+    return true;
+}
+
+void AnimationEngine::stop(Channel channel) {
+    m_target[channel] = m_value[channel];
+    m_velocity[channel] = 0.0f;
+    setMode(channel, Mode::Rest);
+}
+
+float AnimationEngine::sampleTrack(Channel channel, float time) const noexcept {
+    const Keyframe* keys = &m_keys[channel * kMaxKeyframes];
+    const size_t count = m_keyCount[channel];
+
+    if (time <= keys[0].time) return keys[0].value;
+    for (size_t i = 1; i < count; i++) {
+        if (time < keys[i].time) {
+            const Keyframe& a = keys[i - 1];
+            const Keyframe& b = keys[i];
+            const float t = (time - a.time) / (b.time - a.time);
+            return a.value + (b.value - a.value) * applyEase(a.ease, t);
+        }
+    }
+    return keys[count - 1].value;
+}
+
+size_t AnimationEngine::update(float deltaTime) {
+    if (m_active == 0) return 0;
+
+    const size_t count = m_value.size();
+    for (size_t i = 0; i < count; i++) {
+        switch (m_mode[i]) {
+            case Mode::Rest:
+                break;
+
+            // Critically damped spring, exact step (stable for any deltaTime)
+            case Mode::Spring: {
+                const float omega = m_omega[i];
+                springStep(m_value[i], m_velocity[i], m_target[i], omega, std::exp(-omega * deltaTime), deltaTime);
+
+                if (std::fabs(m_value[i] - m_target[i]) < kRestEpsilon && std::fabs(m_velocity[i]) < kRestEpsilon) {
+                    set(static_cast<Channel>(i), m_target[i]);
+                }
+                break;
+            }
+
+            case Mode::Keyframes: {
+                const float time = m_time[i] + deltaTime;
+                const float previous = m_value[i];
+                m_time[i] = time;
+                m_value[i] = sampleTrack(static_cast<Channel>(i), time);
+                m_velocity[i] = (deltaTime > 0.0f) ? (m_value[i] - previous) / deltaTime : 0.0f;
+
+                if (time >= m_keys[i * kMaxKeyframes + m_keyCount[i] - 1].time) {
+                    set(static_cast<Channel>(i), m_value[i]);
+                }
+                break;
+            }
+        }
+    }
+
+    return m_active;
+}
+
+} // namespace robotface
@@ -10,25 +10,70 @@
 #include <math.h>
 #include <stdio.h>
 
-// Draw a single eye with blink animation
-static void DrawEye(float x, float y, float blinkProgress) {
-    // Calculate blink factor (0 = open, 1 = closed)
-    // Use sine wave for smooth animation
-    float blinkFactor = 0.0f;
-    if (blinkProgress < 1.0f) {
-        // Closing (0 to 1)
-        blinkFactor = sinf(blinkProgress * PI / 2.0f);
-    } else {
-        // Opening (1 to 0)
-        blinkFactor = sinf((2.0f - blinkProgress) * PI / 2.0f);
+// Static layer cache: background, title, controls and eye whites rendered once
+static RenderTexture2D staticLayer = { 0 };
+static bool staticLayerValid = false;
+static bool staticLayerEnabled = true;
+
+// Cold start: the first frame skips text (font atlas first use) and the render texture
+static bool firstFrameDrawn = false;
+
+// Eye whites (outer circles)
+static void DrawEyeWhites(void) {
+    DrawCircle((int)LEFT_EYE_X, (int)LEFT_EYE_Y, EYE_RADIUS, WHITE);
+    DrawCircleLines((int)LEFT_EYE_X, (int)LEFT_EYE_Y, EYE_RADIUS, BLACK);
+    DrawCircle((int)RIGHT_EYE_X, (int)RIGHT_EYE_Y, EYE_RADIUS, WHITE);
+    DrawCircleLines((int)RIGHT_EYE_X, (int)RIGHT_EYE_Y, EYE_RADIUS, BLACK);
+}
+
+// Draw the parts of the face that never change
+static void DrawStaticLayer(int width, int height) {
+    (void)width;
+
+    // Clear background
+    ClearBackground(RAYWHITE);
+
+    // Draw title
+    DrawText("Raylib Robot Face (Modular C)", 10, 10, 20, DARKGRAY);
+
+    DrawEyeWhites();
+
+    // Draw controls
+    DrawText("Controls: H=Happy, S=Sad, N=Neutral, Click=Blink, ESC=Exit", 10, height - 30, 16, GRAY);
+}
+
+// Static layer from the render texture, re-rendered when invalid or resized
+static void DrawCachedStaticLayer(int width, int height) {
+    if (!staticLayerEnabled) {
+        DrawStaticLayer(width, height);
+        return;
     }
 
-    // Eye white (outer circle)
-    DrawCircle((int)x, (int)y, EYE_RADIUS, WHITE);
-    DrawCircleLines((int)x, (int)y, EYE_RADIUS, BLACK);
+    if (staticLayer.id == 0 || staticLayer.texture.width != width || staticLayer.texture.height != height) {
+        UnloadRobotFaceStaticLayer();
+        staticLayer = LoadRenderTexture(width, height);
+        if (staticLayer.id == 0) {
+            DrawStaticLayer(width, height);   // No framebuffer support
+            return;
+        }
+    }
+
+    if (!staticLayerValid) {
+        BeginTextureMode(staticLayer);
+        DrawStaticLayer(width, height);
+        EndTextureMode();
+        staticLayerValid = true;
+    }
+
+    // Render textures are stored bottom-up: flip with a negative source height
+    Rectangle source = { 0.0f, 0.0f, (float)width, -(float)height };
+    DrawTextureRec(staticLayer.texture, source, (Vector2){ 0.0f, 0.0f }, WHITE);
+}
 
+// Draw a single eye with blink animation (the eye white is in the static layer)
+static void DrawEye(float x, float y, float blinkProgress) {
     // Pupil size changes during blink
-    float pupilRadius = PUPIL_RADIUS * (1.0f - blinkFactor * 0.875f); // Shrinks to 5px when closed
+    float pupilRadius = GetPupilRadius(blinkProgress);
 
     // Pupil (black circle)
     DrawCircle((int)x, (int)y, pupilRadius, BLACK);
@@ -47,35 +92,34 @@ static void DrawMouth(float centerX, float centerY, float happiness) {
     Vector2 end = { MOUTH_END_X, MOUTH_END_Y };
 
     // Control point Y varies with emotion
-    // happiness 1.0 (happy) -> Y = 430 (curve down)
-    // happiness 0.5 (neutral) -> Y = 400 (straight)
-    // happiness 0.0 (sad) -> Y = 370 (curve up)
-    float controlY = MOUTH_CENTER_Y + (happiness - 0.5f) * MOUTH_CURVE_FACTOR;
+    float controlY = GetMouthControlY(happiness);
     Vector2 control = { MOUTH_CENTER_X, controlY };
 
     // Draw Bezier curve with multiple segments for smoothness
-    for (int i = 0; i < MOUTH_SEGMENTS; i++) {
-        float t1 = (float)i / MOUTH_SEGMENTS;
-        float t2 = (float)(i + 1) / MOUTH_SEGMENTS;
-
-        // Quadratic Bezier formula: B(t) = (1-t)²P0 + 2(1-t)tP1 + t²P2
-        float x1 = (1-t1)*(1-t1)*start.x + 2*(1-t1)*t1*control.x + t1*t1*end.x;
-        float y1 = (1-t1)*(1-t1)*start.y + 2*(1-t1)*t1*control.y + t1*t1*end.y;
-
-        float x2 = (1-t2)*(1-t2)*start.x + 2*(1-t2)*t2*control.x + t2*t2*end.x;
-        float y2 = (1-t2)*(1-t2)*start.y + 2*(1-t2)*t2*control.y + t2*t2*end.y;
-
-        DrawLineEx((Vector2){x1, y1}, (Vector2){x2, y2}, MOUTH_STROKE_WIDTH, BLACK);
+    // Quadratic Bezier formula: B(t) = (1-t)²P0 + 2(1-t)tP1 + t²P2, weights precomputed
+    const float* basis = GetMouthBezierBasis();
+    Vector2 previous = start;
+    for (int i = 1; i <= MOUTH_SEGMENTS; i++) {
+        const float* w = &basis[i*3];
+        Vector2 point = {
+            w[0]*start.x + w[1]*control.x + w[2]*end.x,
+            w[0]*start.y + w[1]*control.y + w[2]*end.y
+        };
+
+        DrawLineEx(previous, point, MOUTH_STROKE_WIDTH, BLACK);
+        previous = point;
     }
 }
 
 // Draw complete robot face
 void DrawRobotFace(RobotFace* face, int width, int height) {
-    // Clear background
-    ClearBackground(RAYWHITE);
-
-    // Draw title
-    DrawText("Raylib Robot Face (Modular C)", 10, 10, 20, DARKGRAY);
+    // Background, title, controls and eye whites (first frame: face only)
+    if (firstFrameDrawn) {
+        DrawCachedStaticLayer(width, height);
+    } else {
+        ClearBackground(RAYWHITE);
+        DrawEyeWhites();
+    }
 
     // Draw eyes
     DrawEye(LEFT_EYE_X, LEFT_EYE_Y, face->blink_progress);
@@ -84,11 +128,31 @@ void DrawRobotFace(RobotFace* face, int width, int height) {
     // Draw mouth
     DrawMouth(MOUTH_CENTER_X, MOUTH_CENTER_Y, face->happiness);
 
+    if (!firstFrameDrawn) {
+        firstFrameDrawn = true;
+        return;
+    }
+
     // Draw emotion indicator
     const char* emotion = GetEmotionName(face);
     DrawText(TextFormat("Emotion: %s (%.2f)", emotion, face->happiness), 10, 40, 20, DARKGRAY);
     DrawText(TextFormat("FPS: %d", GetFPS()), 10, 70, 20, DARKGREEN);
+}
 
-    // Draw controls
-    DrawText("Controls: H=Happy, S=Sad, N=Neutral, Click=Blink, ESC=Exit", 10, height - 30, 16, GRAY);
+void InvalidateRobotFaceStaticLayer(void) {
+    staticLayerValid = false;
+}
+
+void SetRobotFaceStaticLayerCache(bool enabled) {
+    staticLayerEnabled = enabled;
+    if (!enabled) UnloadRobotFaceStaticLayer();
+}
+
+// After CloseWindow the context (and the texture with it) is already gone
+void UnloadRobotFaceStaticLayer(void) {
+    if (staticLayer.id != 0 && IsWindowReady()) {
+        UnloadRenderTexture(staticLayer);
+    }
+    staticLayer = (RenderTexture2D){ 0 };
+    staticLayerValid = false;
 }
@@ -0,0 +1,105 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Drawing Functions Implementation (Modern C++)
+ *
+ *   Eyes and mouth of one face through the Canvas interface, shared by RobotFace and
+ *   FaceScene. No raylib calls: headless tools link this without a window.
+ *
+ *******************************************************************************************/
+
+#include "robot_face.hpp"
+#include <algorithm>
+
+namespace robotface {
+
+namespace {
+
+// Bezier weights for the mouth segment counts of the quality levels (generated at compile time)
+constexpr auto kMouthBasis = tables::makeQuadraticBasis<Config::MOUTH_SEGMENTS>();
+constexpr auto kMouthBasis16 = tables::makeQuadraticBasis<16>();
+constexpr auto kMouthBasis12 = tables::makeQuadraticBasis<12>();
+
+// Design space point placed on the canvas
+inline Point2 place(const FaceLook& look, float x, float y) noexcept {
+    return Point2{look.origin.x + x * look.scale, look.origin.y + y * look.scale};
+}
+
+// Quadratic Bezier formula: B(t) = (1-t)²P0 + 2(1-t)tP1 + t²P2, weights precomputed
+template <int Segments>
+int sampleLip(const tables::QuadraticBasis<Segments>& basis, float controlY, const FaceLook& look,
+              Point2* points) noexcept {
+    for (int i = 0; i <= Segments; i++) {
+        const float w0 = basis.w0[i];
+        const float w1 = basis.w1[i];
+        const float w2 = basis.w2[i];
+        points[i] = place(look, w0*Config::MOUTH_START.x + w1*Config::MOUTH_CENTER.x + w2*Config::MOUTH_END.x,
+                          w0*Config::MOUTH_START.y + w1*controlY + w2*Config::MOUTH_END.y);
+    }
+    return Segments + 1;
+}
+
+} // namespace
+
+// Eye whites and outlines (the outline never thins below one pixel)
+void drawEyeWhites(Canvas& canvas, const FaceLook& look) {
+    for (const Vector2 eye : {Config::LEFT_EYE_POS, Config::RIGHT_EYE_POS}) {
+        const Point2 center = place(look, eye.x, eye.y);
+        canvas.circle(center, Config::EYE_RADIUS * look.scale, look.eyeColor);
+        canvas.ring(center, Config::EYE_RADIUS * look.scale, std::max(1.0f, look.scale), look.featureColor);
+    }
+}
+
+void drawPupil(Canvas& canvas, Point2 center, float radius, const FaceLook& look) {
+    // Pupil (feature colour circle)
+    canvas.circle(place(look, center.x, center.y), radius * look.scale, look.featureColor);
+
+    // Highlight (gives eyes a "shiny" look)
+    if (radius > 10.0f) {
+        const float highlightSize = Config::HIGHLIGHT_RADIUS * (radius / Config::PUPIL_RADIUS);
+        canvas.circle(place(look, center.x - 15, center.y - 15), highlightSize * look.scale, look.eyeColor);
+    }
+}
+
+// Pupils over the eye whites, then the mouth as a Bezier curve; speech opens it into
+// upper and lower lips
+void drawFaceFeatures(Canvas& canvas, const FacePose& pose, const FaceLook& look) {
+    // Pupil size changes during blink
+    const float pupilRadius = Config::PUPIL_RADIUS * (1.0f - pose.blinkFactor * 0.875f);
+
+    // Pupil shifted by the gaze; the sprite scales the highlight with it
+    for (const Vector2 eye : {Config::LEFT_EYE_POS, Config::RIGHT_EYE_POS}) {
+        const Point2 pupil{eye.x + pose.pupilX, eye.y + pose.pupilY};
+        if (look.pupilSprite &&
+            canvas.sprite(look.pupilSprite, place(look, pupil.x, pupil.y), pupilRadius / Config::PUPIL_RADIUS * look.scale)) {
+            continue;
+        }
+        drawPupil(canvas, pupil, pupilRadius, look);
+    }
+
+    // Control point Y varies with emotion
+    const float controlY = Config::MOUTH_CENTER.y + (pose.happiness - 0.5f) * Config::MOUTH_CURVE_FACTOR;
+
+    // Sample the Bezier curve with as many segments as the quality level allows
+    auto strokeLip = [&](float lipControlY) {
+        Point2 points[Config::MOUTH_SEGMENTS + 1];
+        int count = 0;
+        switch (look.mouthSegments) {
+            case 16: count = sampleLip(kMouthBasis16, lipControlY, look, points); break;
+            case 12: count = sampleLip(kMouthBasis12, lipControlY, look, points); break;
+            default: count = sampleLip(kMouthBasis, lipControlY, look, points); break;
+        }
+        canvas.strokePath(points, count, Config::MOUTH_STROKE_WIDTH * look.scale, look.featureColor);
+    };
+
+    if (pose.mouthOpenness < Config::MOUTH_OPEN_EPSILON) {
+        strokeLip(controlY);
+        return;
+    }
+
+    // Lips share the corners and part around the emotion curve
+    const float gap = pose.mouthOpenness * Config::MOUTH_OPEN_FACTOR;
+    strokeLip(controlY - gap * Config::MOUTH_OPEN_UPPER_SHARE);
+    strokeLip(controlY + gap * (1.0f - Config::MOUTH_OPEN_UPPER_SHARE));
+}
+
+} // namespace robotface
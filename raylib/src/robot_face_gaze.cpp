@@ -0,0 +1,163 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Gaze Model Implementation
+ *
+ *******************************************************************************************/
+
+#include "robot_face_gaze.hpp"
+#include "robot_face_animation.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace robotface {
+
+namespace {
+
+constexpr float kRandomScale = 1.0f / 65535.0f;
+
+// Direction to the target, turned fully at `range`, as a pupil offset
+inline GazePoint mapTarget(float dx, float dy, float maxOffset, float inverseRange) noexcept {
+    const float distance = std::sqrt(dx * dx + dy * dy);
+    const float scale = maxOffset * std::min(1.0f, distance * inverseRange) / std::max(distance, 1e-3f);
+    return GazePoint{dx * scale, dy * scale};
+}
+
+} // namespace
+
+GazeBatch::GazeBatch(size_t capacity, const GazeConfig& config)
+    : m_config(config)
+    , m_capacity(capacity)
+{
+    for (auto* array : {&m_targetX, &m_targetY, &m_pursuitX, &m_pursuitY, &m_velocityX, &m_velocityY,
+                        &m_saccadeX, &m_saccadeY, &m_saccadeTimer, &m_saccadeScale, &m_offsetX, &m_offsetY}) {
+        array->reserve(capacity);
+    }
+    m_random.reserve(capacity);
+}
+
+GazeBatch::Index GazeBatch::add(uint32_t seed) {
+    if (m_offsetX.size() >= m_capacity) return kInvalidIndex;
+
+    const auto index = static_cast<Index>(m_offsetX.size());
+    for (auto* array : {&m_targetX, &m_targetY, &m_pursuitX, &m_pursuitY, &m_velocityX, &m_velocityY,
+                        &m_saccadeX, &m_saccadeY, &m_offsetX, &m_offsetY}) {
+        array->push_back(0.0f);
+    }
+    m_saccadeScale.push_back(1.0f);
+
+    // Stagger the first saccade so faces added together do not twitch in sync
+    const uint32_t state = (seed ? seed : index + 1u) * 2654435761u;
+    m_random.push_back(state ? state : 1u);
+    m_saccadeTimer.push_back(m_config.saccadeInterval * static_cast<float>(state >> 16) * kRandomScale);
+    return index;
+}
+
+void GazeBatch::setTarget(Index face, GazePoint target) noexcept {
+    const GazePoint mapped = mapTarget(target.x - m_config.eyeCenterX, target.y - m_config.eyeCenterY,
+                                       m_config.maxOffset, 1.0f / m_config.range);
+    m_targetX[face] = mapped.x;
+    m_targetY[face] = mapped.y;
+}
+
+void GazeBatch::setTargets(const GazePoint* targets, size_t count) noexcept {
+    const size_t n = std::min(count, m_offsetX.size());
+    const float cx = m_config.eyeCenterX;
+    const float cy = m_config.eyeCenterY;
+    const float maxOffset = m_config.maxOffset;
+    const float inverseRange = 1.0f / m_config.range;
+
+    float* targetX = m_targetX.data();
+    float* targetY = m_targetY.data();
+    for (size_t i = 0; i < n; i++) {
+        const GazePoint mapped = mapTarget(targets[i].x - cx, targets[i].y - cy, maxOffset, inverseRange);
+        targetX[i] = mapped.x;
+        targetY[i] = mapped.y;
+    }
+}
+
+void GazeBatch::lookAhead(Index face) noexcept {
+    m_targetX[face] = 0.0f;
+    m_targetY[face] = 0.0f;
+}
+
+bool GazeBatch::settled(Index face, float tolerance) const noexcept {
+    const float speedTolerance = tolerance * 10.0f;
+    return std::fabs(m_pursuitX[face] - m_targetX[face]) < tolerance &&
+           std::fabs(m_pursuitY[face] - m_targetY[face]) < tolerance &&
+           std::fabs(m_velocityX[face]) < speedTolerance && std::fabs(m_velocityY[face]) < speedTolerance &&
+           std::fabs(m_saccadeX[face]) < tolerance && std::fabs(m_saccadeY[face]) < tolerance;
+}
+
+void GazeBatch::update(float deltaTime) noexcept {
+    updateRange(0, m_offsetX.size(), deltaTime);
+}
+
+// Each pass works on a few arrays at a time; __restrict tells the compiler they do not
+// overlap, so the loops vectorize without run-time alias checks
+void GazeBatch::updateRange(size_t begin, size_t end, float deltaTime) noexcept {
+    end = std::min(end, m_offsetX.size());
+    if (begin >= end || deltaTime <= 0.0f) return;
+
+    const size_t n = end - begin;
+    pursue(n, deltaTime, m_targetX.data() + begin, m_pursuitX.data() + begin, m_velocityX.data() + begin);
+    pursue(n, deltaTime, m_targetY.data() + begin, m_pursuitY.data() + begin, m_velocityY.data() + begin);
+    saccade(n, deltaTime, m_saccadeScale.data() + begin, m_random.data() + begin, m_saccadeTimer.data() + begin, m_saccadeX.data() + begin,
+            m_saccadeY.data() + begin);
+    constrain(n, m_pursuitX.data() + begin, m_pursuitY.data() + begin, m_saccadeX.data() + begin,
+              m_saccadeY.data() + begin, m_offsetX.data() + begin, m_offsetY.data() + begin);
+}
+
+// Smooth pursuit, one axis (the animation engine's spring step, decay hoisted)
+void GazeBatch::pursue(size_t n, float deltaTime, const float* __restrict target, float* __restrict position,
+                       float* __restrict velocity) const noexcept {
+    const float omega = 2.0f / std::max(m_config.smoothTime, 1e-4f);
+    const float decay = std::exp(-omega * deltaTime);
+
+    for (size_t i = 0; i < n; i++) {
+        springStep(position[i], velocity[i], target[i], omega, decay, deltaTime);
+    }
+}
+
+// Micro-saccades: xorshift32 advances every frame so the select stays branch-free
+void GazeBatch::saccade(size_t n, float deltaTime, const float* __restrict scale, uint32_t* __restrict random,
+                        float* __restrict timer, float* __restrict saccadeX, float* __restrict saccadeY) const noexcept {
+    const float drift = std::exp(-m_config.saccadeDecay * deltaTime);
+    const float amplitude = m_config.saccadeAmplitude;
+    const float interval = m_config.saccadeInterval;
+
+    for (size_t i = 0; i < n; i++) {
+        uint32_t r = random[i];
+        r ^= r << 13;
+        r ^= r >> 17;
+        r ^= r << 5;
+        random[i] = r;
+
+        // Signed conversions: SSE2/NEON have no unsigned int -> float
+        const float u = static_cast<float>(static_cast<int32_t>(r & 0xFFFFu)) * kRandomScale;
+        const float v = static_cast<float>(static_cast<int32_t>(r >> 16)) * kRandomScale;
+
+        const float remaining = timer[i] - deltaTime;
+        const bool fire = remaining <= 0.0f;
+        saccadeX[i] = fire ? (u * 2.0f - 1.0f) * amplitude * scale[i] : saccadeX[i] * drift;
+        saccadeY[i] = fire ? (v * 2.0f - 1.0f) * amplitude * scale[i] : saccadeY[i] * drift;
+        timer[i] = fire ? interval * (0.5f + 0.5f * (u + v)) : remaining;
+    }
+}
+
+// Keep the pupil inside the eye
+void GazeBatch::constrain(size_t n, const float* __restrict pursuitX, const float* __restrict pursuitY,
+                          const float* __restrict saccadeX, const float* __restrict saccadeY,
+                          float* __restrict offsetX, float* __restrict offsetY) const noexcept {
+    const float maxOffset = m_config.maxOffset;
+
+    for (size_t i = 0; i < n; i++) {
+        const float x = pursuitX[i] + saccadeX[i];
+        const float y = pursuitY[i] + saccadeY[i];
+        const float length = std::sqrt(std::max(x * x + y * y, 1e-12f));
+        const float scale = std::min(1.0f, maxOffset / length);
+        offsetX[i] = x * scale;
+        offsetY[i] = y * scale;
+    }
+}
+
+} // namespace robotface
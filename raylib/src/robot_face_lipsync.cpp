@@ -0,0 +1,525 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Audio-Driven Lip Sync Implementation
+ *
+ *******************************************************************************************/
+
+#include "robot_face_lipsync.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#define ROBOT_FACE_HAS_POLL 1
+#else
+#define ROBOT_FACE_HAS_POLL 0
+#endif
+
+namespace robotface {
+
+namespace {
+
+constexpr size_t kFftSize = 256;
+constexpr int kFftLog2 = 8;
+constexpr float kPi = 3.14159265358979323846f;
+constexpr float kPcmScale = 1.0f / 32768.0f;
+
+// Band edges (Hz): low < 500 <= mid < 2000 <= high
+constexpr float kLowMidHz = 500.0f;
+constexpr float kMidHighHz = 2000.0f;
+
+uint32_t readLe32(const unsigned char* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+uint16_t readLe16(const unsigned char* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+void writeLe32(unsigned char* p, uint32_t value) {
+    for (int i = 0; i < 4; i++) p[i] = static_cast<unsigned char>(value >> (8 * i));
+}
+
+void writeLe16(unsigned char* p, uint16_t value) {
+    p[0] = static_cast<unsigned char>(value);
+    p[1] = static_cast<unsigned char>(value >> 8);
+}
+
+// Byte source of the reader thread. With poll() the descriptor is waited on in short
+// slices and the stop flag checked between them, so a pipe that has gone quiet never
+// holds up stop(); elsewhere reads block in fread (files, not live pipes).
+class StreamReader {
+public:
+    StreamReader(std::FILE* file, const std::atomic<bool>* stop) : m_file(file), m_stop(stop) {}
+
+    // Fills `size` bytes; short only at end of stream, on a read error or when stopped
+    size_t read(void* data, size_t size) {
+        if (!m_stop) return std::fread(data, 1, size, m_file);
+#if ROBOT_FACE_HAS_POLL
+        unsigned char* bytes = static_cast<unsigned char*>(data);
+        size_t filled = 0;
+        pollfd waiter{fileno(m_file), POLLIN, 0};
+        while (filled < size && !m_stop->load(std::memory_order_acquire)) {
+            const int ready = ::poll(&waiter, 1, kPollMs);
+            if (ready < 0 && errno != EINTR) break;
+            if (ready <= 0) continue;
+
+            const ssize_t count = ::read(waiter.fd, bytes + filled, size - filled);
+            if (count > 0) {
+                filled += static_cast<size_t>(count);
+            } else if (count == 0 || (errno != EINTR && errno != EAGAIN)) {
+                break;   // End of stream or error
+            }
+        }
+        return filled;
+#else
+        return std::fread(data, 1, size, m_file);
+#endif
+    }
+
+private:
+    static constexpr int kPollMs = 20;   // Bounds how long stop() waits on a quiet pipe
+
+    std::FILE* m_file;
+    const std::atomic<bool>* m_stop;
+};
+
+// Skip bytes on streams that cannot seek (pipes)
+bool skipBytes(StreamReader& reader, uint32_t count) {
+    unsigned char scratch[256];
+    while (count > 0) {
+        const size_t chunk = std::min<size_t>(count, sizeof(scratch));
+        if (reader.read(scratch, chunk) != chunk) return false;
+        count -= static_cast<uint32_t>(chunk);
+    }
+    return true;
+}
+
+struct WavFormat {
+    bool isWav = false;
+    int sampleRate = 0;
+    int channels = 1;
+    unsigned char peek[4] = {};   // First bytes of a raw stream (no RIFF header)
+    size_t peekBytes = 0;
+};
+
+// Reads up to the start of the PCM data; raw streams return isWav = false
+bool readWavHeader(StreamReader& reader, WavFormat& format) {
+    format.peekBytes = reader.read(format.peek, 4);
+    if (format.peekBytes < 4 || std::memcmp(format.peek, "RIFF", 4) != 0) {
+        format.isWav = false;
+        return format.peekBytes > 0;
+    }
+
+    unsigned char riff[8];
+    if (reader.read(riff, 8) != 8 || std::memcmp(riff + 4, "WAVE", 4) != 0) return false;
+    format.isWav = true;
+    format.peekBytes = 0;
+
+    bool haveFormat = false;
+    for (;;) {
+        unsigned char chunk[8];
+        if (reader.read(chunk, 8) != 8) return false;
+        const uint32_t size = readLe32(chunk + 4);
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0) {
+            unsigned char fmt[16];
+            if (size < 16 || reader.read(fmt, 16) != 16) return false;
+            const uint16_t tag = readLe16(fmt);
+            format.channels = readLe16(fmt + 2);
+            format.sampleRate = static_cast<int>(readLe32(fmt + 4));
+            const uint16_t bits = readLe16(fmt + 14);
+
+            // PCM or WAVE_FORMAT_EXTENSIBLE, 16-bit, mono or stereo
+            if ((tag != 1 && tag != 0xFFFE) || bits != 16 || format.channels < 1 || format.channels > 2 ||
+                format.sampleRate <= 0) {
+                return false;
+            }
+            if (!skipBytes(reader, size - 16 + (size & 1u))) return false;
+            haveFormat = true;
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            return haveFormat;
+        } else if (!skipBytes(reader, size + (size & 1u))) {
+            return false;
+        }
+    }
+}
+
+} // namespace
+
+// WAV files
+bool loadWav(const char* path, PcmClip& clip) {
+    std::FILE* file = std::fopen(path, "rb");
+    if (!file) return false;
+
+    StreamReader reader(file, nullptr);
+    WavFormat format;
+    if (!readWavHeader(reader, format) || !format.isWav) {
+        std::fclose(file);
+        return false;
+    }
+
+    clip.sampleRate = format.sampleRate;
+    clip.samples.clear();
+
+    unsigned char frame[4];
+    const size_t frameBytes = static_cast<size_t>(format.channels) * 2;
+    while (std::fread(frame, 1, frameBytes, file) == frameBytes) {
+        int sum = 0;
+        for (int c = 0; c < format.channels; c++) sum += static_cast<int16_t>(readLe16(frame + 2 * c));
+        clip.samples.push_back(static_cast<int16_t>(sum / format.channels));
+    }
+
+    std::fclose(file);
+    return true;
+}
+
+bool saveWav(const char* path, const PcmClip& clip) {
+    std::FILE* file = std::fopen(path, "wb");
+    if (!file) return false;
+
+    const uint32_t dataBytes = static_cast<uint32_t>(clip.samples.size() * 2);
+    unsigned char header[44];
+    std::memcpy(header, "RIFF", 4);
+    writeLe32(header + 4, 36 + dataBytes);
+    std::memcpy(header + 8, "WAVEfmt ", 8);
+    writeLe32(header + 16, 16);
+    writeLe16(header + 20, 1);                                          // PCM
+    writeLe16(header + 22, 1);                                          // Mono
+    writeLe32(header + 24, static_cast<uint32_t>(clip.sampleRate));
+    writeLe32(header + 28, static_cast<uint32_t>(clip.sampleRate) * 2); // Byte rate
+    writeLe16(header + 32, 2);                                          // Block align
+    writeLe16(header + 34, 16);                                         // Bits per sample
+    std::memcpy(header + 36, "data", 4);
+    writeLe32(header + 40, dataBytes);
+
+    bool ok = std::fwrite(header, 1, sizeof(header), file) == sizeof(header);
+    for (int16_t sample : clip.samples) {
+        unsigned char bytes[2];
+        writeLe16(bytes, static_cast<uint16_t>(sample));
+        ok = ok && std::fwrite(bytes, 1, 2, file) == 2;
+    }
+
+    return std::fclose(file) == 0 && ok;
+}
+
+// LipSync
+LipSync::LipSync(const LipSyncConfig& config)
+    : m_config(config)
+{
+}
+
+LipSync::~LipSync() {
+    stop();
+}
+
+// Size every buffer for the sample rate and reset the analysis state
+bool LipSync::prepare(int sampleRate) {
+    if (sampleRate <= 0 || m_config.hopMs <= 0.0f) return false;
+
+    m_sampleRate = sampleRate;
+    m_hop = std::max(1, static_cast<int>(std::lround(sampleRate * m_config.hopMs / 1000.0f)));
+    const int windowHops = std::max(1, static_cast<int>(std::lround(m_config.windowMs / m_config.hopMs)));
+    m_windowSamples = windowHops * m_hop;
+
+    const float hopSeconds = static_cast<float>(m_hop) / static_cast<float>(sampleRate);
+    m_attack = 1.0f - std::exp(-hopSeconds * 1000.0f / std::max(m_config.attackMs, 0.01f));
+    m_release = 1.0f - std::exp(-hopSeconds * 1000.0f / std::max(m_config.releaseMs, 0.01f));
+
+    m_hopBuffer.assign(static_cast<size_t>(m_hop), 0.0f);
+    m_hopEnergy.assign(static_cast<size_t>(windowHops), 0.0f);
+    m_hopIndex = 0;
+    m_envelope = 0.0f;
+
+    if (m_config.bands) {
+        m_history.assign(kFftSize, 0.0f);
+        m_historyPos = 0;
+        m_fftWindow.resize(kFftSize);
+        m_fftRe.resize(kFftSize);
+        m_fftIm.resize(kFftSize);
+        m_twiddleRe.resize(kFftSize / 2);
+        m_twiddleIm.resize(kFftSize / 2);
+        m_bitReverse.resize(kFftSize);
+
+        for (size_t i = 0; i < kFftSize; i++) {
+            m_fftWindow[i] = 0.5f - 0.5f * std::cos(2.0f * kPi * static_cast<float>(i) / kFftSize);
+
+            uint16_t reversed = 0;
+            for (int b = 0; b < kFftLog2; b++) {
+                if (i & (size_t{1} << b)) reversed |= static_cast<uint16_t>(1u << (kFftLog2 - 1 - b));
+            }
+            m_bitReverse[i] = reversed;
+        }
+        for (size_t i = 0; i < kFftSize / 2; i++) {
+            m_twiddleRe[i] = std::cos(-2.0f * kPi * static_cast<float>(i) / kFftSize);
+            m_twiddleIm[i] = std::sin(-2.0f * kPi * static_cast<float>(i) / kFftSize);
+        }
+    }
+
+    m_analyzed.store(0, std::memory_order_relaxed);
+    publish(LipSyncFrame{});
+    return true;
+}
+
+bool LipSync::startStream() {
+    stop();
+    if (!prepare(m_config.sampleRate)) return false;
+
+    size_t capacity = 1;
+    while (capacity < std::max(m_config.ringCapacity, static_cast<size_t>(m_hop) * 2)) capacity <<= 1;
+    m_ring.assign(capacity, 0);
+    m_ringMask = capacity - 1;
+    m_writePos.store(0, std::memory_order_relaxed);
+    m_readPos.store(0, std::memory_order_relaxed);
+
+    m_running.store(true, std::memory_order_release);
+    m_thread = std::thread(&LipSync::streamLoop, this);
+    return true;
+}
+
+// Only opens the source: the header is read by the reader thread, so a slow pipe never
+// stalls the caller (a bad header shows up as failed())
+bool LipSync::startFile(const char* path, Pacing pacing) {
+    stop();
+
+    const bool isStdin = std::strcmp(path, "-") == 0;
+#if ROBOT_FACE_HAS_POLL
+    // Non-blocking open: a named pipe without a writer yet must not block either
+    const int fd = isStdin ? -1 : ::open(path, O_RDONLY | O_NONBLOCK);
+    std::FILE* file = isStdin ? stdin : (fd >= 0 ? ::fdopen(fd, "rb") : nullptr);
+    if (!file && fd >= 0) ::close(fd);
+#else
+    std::FILE* file = isStdin ? stdin : std::fopen(path, "rb");
+#endif
+    if (!file) return false;
+
+    m_running.store(true, std::memory_order_release);
+    m_thread = std::thread(&LipSync::fileLoop, this, file, !isStdin, isStdin ? Pacing::AsFastAsRead : pacing);
+    return true;
+}
+
+void LipSync::stop() {
+    if (m_thread.joinable()) {
+        m_stop.store(true, std::memory_order_release);
+        m_thread.join();
+    }
+    m_stop.store(false, std::memory_order_relaxed);
+    m_failed.store(false, std::memory_order_relaxed);
+    m_running.store(false, std::memory_order_release);
+    publish(LipSyncFrame{});
+}
+
+size_t LipSync::push(const int16_t* samples, size_t count) noexcept {
+    if (m_ring.empty()) return 0;
+
+    const size_t write = m_writePos.load(std::memory_order_relaxed);
+    const size_t read = m_readPos.load(std::memory_order_acquire);
+    const size_t accepted = std::min(count, m_ring.size() - (write - read));
+
+    for (size_t i = 0; i < accepted; i++) {
+        m_ring[(write + i) & m_ringMask] = samples[i];
+    }
+    m_writePos.store(write + accepted, std::memory_order_release);
+    return accepted;
+}
+
+float LipSync::openness() const noexcept {
+    return static_cast<float>(m_published.load(std::memory_order_acquire) & 0xFFFFu) / 65535.0f;
+}
+
+LipSyncFrame LipSync::frame() const noexcept {
+    const uint64_t packed = m_published.load(std::memory_order_acquire);
+
+    LipSyncFrame frame;
+    frame.openness = static_cast<float>(packed & 0xFFFFu) / 65535.0f;
+    frame.low = static_cast<float>((packed >> 16) & 0xFFFFu) / 65535.0f;
+    frame.mid = static_cast<float>((packed >> 32) & 0xFFFFu) / 65535.0f;
+    frame.high = static_cast<float>((packed >> 48) & 0xFFFFu) / 65535.0f;
+    return frame;
+}
+
+void LipSync::publish(const LipSyncFrame& frame) noexcept {
+    auto quantize = [](float value) {
+        return static_cast<uint64_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 65535.0f));
+    };
+    const uint64_t packed = quantize(frame.openness) | (quantize(frame.low) << 16) |
+                            (quantize(frame.mid) << 32) | (quantize(frame.high) << 48);
+    m_published.store(packed, std::memory_order_release);
+}
+
+// Ring buffer consumer: one hop at a time, silence when the producer stalls
+void LipSync::streamLoop() {
+    const auto hopDuration = std::chrono::microseconds(1000000LL * m_hop / m_sampleRate);
+    const auto poll = std::max(std::chrono::microseconds(100), hopDuration / 8);
+    auto lastData = std::chrono::steady_clock::now();
+
+    while (!m_stop.load(std::memory_order_acquire)) {
+        const size_t read = m_readPos.load(std::memory_order_relaxed);
+        const size_t write = m_writePos.load(std::memory_order_acquire);
+
+        if (write - read >= static_cast<size_t>(m_hop)) {
+            for (int i = 0; i < m_hop; i++) {
+                m_hopBuffer[static_cast<size_t>(i)] = m_ring[(read + static_cast<size_t>(i)) & m_ringMask] * kPcmScale;
+            }
+            m_readPos.store(read + static_cast<size_t>(m_hop), std::memory_order_release);
+            analyze(m_hopBuffer.data());
+            lastData = std::chrono::steady_clock::now();
+            continue;
+        }
+
+        // No audio for two hops: the speaker stopped, let the mouth close
+        if (std::chrono::steady_clock::now() - lastData > 2 * hopDuration && m_envelope > 0.0f) {
+            std::fill(m_hopBuffer.begin(), m_hopBuffer.end(), 0.0f);
+            analyze(m_hopBuffer.data());
+            lastData += hopDuration;
+            continue;
+        }
+
+        std::this_thread::sleep_for(poll);
+    }
+}
+
+// File or pipe reader: header probe, then one hop at a time; real-time pacing analyses
+// each hop when it would have played
+void LipSync::fileLoop(std::FILE* file, bool closeFile, Pacing pacing) {
+    const auto start = std::chrono::steady_clock::now();
+    StreamReader reader(file, &m_stop);
+    WavFormat format;
+    if (!readWavHeader(reader, format) || !prepare(format.isWav ? format.sampleRate : m_config.sampleRate)) {
+        if (closeFile) std::fclose(file);
+        m_failed.store(!m_stop.load(std::memory_order_acquire), std::memory_order_release);
+        m_running.store(false, std::memory_order_release);
+        return;
+    }
+
+    // Raw PCM: the bytes read while probing for a header are the first samples
+    const int channels = format.channels;
+    m_readBytes.assign(static_cast<size_t>(m_hop) * static_cast<size_t>(channels) * 2, 0);
+    std::memcpy(m_readBytes.data(), format.peek, format.peekBytes);
+
+    const size_t frameBytes = static_cast<size_t>(channels) * 2;
+    const size_t hopBytes = m_readBytes.size();
+    uint64_t samples = 0;
+    size_t filled = format.peekBytes;
+
+    while (!m_stop.load(std::memory_order_acquire)) {
+        filled += reader.read(m_readBytes.data() + filled, hopBytes - filled);
+        const bool finished = filled < hopBytes;   // Short only at end of stream or on stop
+        if (finished) std::memset(m_readBytes.data() + filled, 0, hopBytes - filled);
+        if (finished && filled < frameBytes) break;
+
+        for (int i = 0; i < m_hop; i++) {
+            const unsigned char* frame = m_readBytes.data() + static_cast<size_t>(i) * frameBytes;
+            int sum = 0;
+            for (int c = 0; c < channels; c++) sum += static_cast<int16_t>(readLe16(frame + 2 * c));
+            m_hopBuffer[static_cast<size_t>(i)] = static_cast<float>(sum) / static_cast<float>(channels) * kPcmScale;
+        }
+
+        samples += static_cast<uint64_t>(m_hop);
+        if (pacing == Pacing::RealTime) {
+            std::this_thread::sleep_until(start + std::chrono::microseconds(samples * 1000000 / static_cast<uint64_t>(m_sampleRate)));
+        }
+
+        analyze(m_hopBuffer.data());
+        filled = 0;
+        if (finished) break;
+    }
+
+    if (closeFile) std::fclose(file);
+    publish(LipSyncFrame{});
+    m_running.store(false, std::memory_order_release);
+}
+
+void LipSync::analyze(const float* hop) noexcept {
+    // Sum of squares in 8 independent lanes: vectorizes without -ffast-math
+    float lanes[8] = {};
+    int i = 0;
+    for (; i + 8 <= m_hop; i += 8) {
+        for (int k = 0; k < 8; k++) lanes[k] += hop[i + k] * hop[i + k];
+    }
+    float energy = ((lanes[0] + lanes[4]) + (lanes[1] + lanes[5])) + ((lanes[2] + lanes[6]) + (lanes[3] + lanes[7]));
+    for (; i < m_hop; i++) energy += hop[i] * hop[i];
+
+    // Sliding window over the last few hops (recomputed, so no drift)
+    m_hopEnergy[m_hopIndex] = energy;
+    m_hopIndex = (m_hopIndex + 1) % m_hopEnergy.size();
+    float windowEnergy = 0.0f;
+    for (float value : m_hopEnergy) windowEnergy += value;
+
+    const float rms = std::sqrt(windowEnergy / static_cast<float>(m_windowSamples));
+    const float range = std::max(m_config.fullOpen - m_config.noiseFloor, 1e-6f);
+    const float target = std::clamp((rms - m_config.noiseFloor) / range, 0.0f, 1.0f);
+    m_envelope += (target - m_envelope) * (target > m_envelope ? m_attack : m_release);
+    if (m_envelope < 1e-4f) m_envelope = 0.0f;
+
+    LipSyncFrame frame;
+    frame.openness = m_envelope;
+
+    if (m_config.bands) {
+        const size_t count = std::min(static_cast<size_t>(m_hop), kFftSize);
+        const float* recent = hop + (static_cast<size_t>(m_hop) - count);
+        for (size_t j = 0; j < count; j++) {
+            m_history[m_historyPos] = recent[j];
+            m_historyPos = (m_historyPos + 1) & (kFftSize - 1);
+        }
+        computeBands(frame);
+    }
+
+    publish(frame);
+    m_analyzed.fetch_add(static_cast<uint64_t>(m_hop), std::memory_order_relaxed);
+}
+
+// Radix-2 FFT over the last kFftSize samples (Hann window), energy share per band
+void LipSync::computeBands(LipSyncFrame& frame) noexcept {
+    for (size_t i = 0; i < kFftSize; i++) {
+        const size_t j = m_bitReverse[i];
+        m_fftRe[j] = m_history[(m_historyPos + i) & (kFftSize - 1)] * m_fftWindow[i];
+        m_fftIm[j] = 0.0f;
+    }
+
+    for (size_t size = 2; size <= kFftSize; size <<= 1) {
+        const size_t half = size / 2;
+        const size_t step = kFftSize / size;
+        for (size_t base = 0; base < kFftSize; base += size) {
+            for (size_t k = 0; k < half; k++) {
+                const float wr = m_twiddleRe[k * step];
+                const float wi = m_twiddleIm[k * step];
+                const size_t a = base + k;
+                const size_t b = a + half;
+                const float tr = m_fftRe[b] * wr - m_fftIm[b] * wi;
+                const float ti = m_fftRe[b] * wi + m_fftIm[b] * wr;
+                m_fftRe[b] = m_fftRe[a] - tr;
+                m_fftIm[b] = m_fftIm[a] - ti;
+                m_fftRe[a] += tr;
+                m_fftIm[a] += ti;
+            }
+        }
+    }
+
+    const float binHz = static_cast<float>(m_sampleRate) / kFftSize;
+    float low = 0.0f;
+    float mid = 0.0f;
+    float high = 0.0f;
+    for (size_t k = 1; k < kFftSize / 2; k++) {
+        const float power = m_fftRe[k] * m_fftRe[k] + m_fftIm[k] * m_fftIm[k];
+        const float hz = static_cast<float>(k) * binHz;
+        if (hz < kLowMidHz) low += power;
+        else if (hz < kMidHighHz) mid += power;
+        else high += power;
+    }
+
+    const float total = low + mid + high;
+    if (total > 1e-9f) {
+        frame.low = low / total;
+        frame.mid = mid / total;
+        frame.high = high / total;
+    }
+}
+
+} // namespace robotface
@@ -0,0 +1,408 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Multi-Output Presentation Implementation
+ *
+ *******************************************************************************************/
+
+#include "robot_face_outputs.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+// Also WebAssembly SIMD128: Emscripten maps the SSE2 intrinsics (emcc -msimd128 -msse2)
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ROBOT_FACE_OUTPUTS_SSE2 1
+#endif
+
+namespace robotface {
+
+namespace {
+
+// Level pixel = rounded mean of a 2x2 block of the level above (count = output pixels)
+void boxRowScalar(const uint8_t* row0, const uint8_t* row1, uint8_t* out, int count) noexcept {
+    for (int i = 0; i < count * 4; i++) {
+        const int p = (i >> 2) * 8 + (i & 3);
+        out[i] = static_cast<uint8_t>((row0[p] + row0[p + 4] + row1[p] + row1[p + 4] + 2) >> 2);
+    }
+}
+
+// Bilinear tap: vertical blend of both columns, then horizontal (weights 0..256, 8-bit fraction)
+void bilinearRowScalar(const uint8_t* row0, const uint8_t* row1, int fy, const uint16_t* columnX,
+                       const uint16_t* columnF, int x0, int x1, uint8_t* out) noexcept {
+    for (int o = x0; o < x1; o++, out += 4) {
+        const uint8_t* top = row0 + columnX[o] * 4;
+        const uint8_t* bottom = row1 + columnX[o] * 4;
+        const int fx = columnF[o];
+        for (int c = 0; c < 4; c++) {
+            const int left = (top[c] * (256 - fy) + bottom[c] * fy + 128) >> 8;
+            const int right = (top[c + 4] * (256 - fy) + bottom[c + 4] * fy + 128) >> 8;
+            out[c] = static_cast<uint8_t>((left * (256 - fx) + right * fx + 128) >> 8);
+        }
+    }
+}
+
+void rgb565Scalar(const uint8_t* rgba, uint8_t* out, int count) noexcept {
+    for (int i = 0; i < count; i++, rgba += 4, out += 2) {
+        const unsigned value = (rgba[0] >> 3) << 11 | (rgba[1] >> 2) << 5 | rgba[2] >> 3;
+        out[0] = static_cast<uint8_t>(value);
+        out[1] = static_cast<uint8_t>(value >> 8);
+    }
+}
+
+#ifdef ROBOT_FACE_OUTPUTS_SSE2
+
+// Four output pixels per step: rows summed and pixel pairs folded in 16-bit lanes
+void boxRowSse2(const uint8_t* row0, const uint8_t* row1, uint8_t* out, int count) noexcept {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i two = _mm_set1_epi16(2);
+    int i = 0;
+    for (; i + 4 <= count; i += 4, row0 += 32, row1 += 32, out += 16) {
+        __m128i halves[2];
+        for (int h = 0; h < 2; h++) {
+            const __m128i top = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + h * 16));
+            const __m128i bottom = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + h * 16));
+            const __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(top, zero), _mm_unpacklo_epi8(bottom, zero));
+            const __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(top, zero), _mm_unpackhi_epi8(bottom, zero));
+            const __m128i sums = _mm_unpacklo_epi64(_mm_add_epi16(lo, _mm_srli_si128(lo, 8)),
+                                                    _mm_add_epi16(hi, _mm_srli_si128(hi, 8)));
+            halves[h] = _mm_srli_epi16(_mm_add_epi16(sums, two), 2);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(halves[0], halves[1]));
+    }
+    boxRowScalar(row0, row1, out, count - i);
+}
+
+// One output pixel per step: both taps of both rows in one register (4 channels x 2 columns)
+void bilinearRowSse2(const uint8_t* row0, const uint8_t* row1, int fy, const uint16_t* columnX,
+                     const uint16_t* columnF, int x0, int x1, uint8_t* out) noexcept {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i round = _mm_set1_epi16(128);
+    const __m128i topWeight = _mm_set1_epi16(static_cast<short>(256 - fy));
+    const __m128i bottomWeight = _mm_set1_epi16(static_cast<short>(fy));
+    for (int o = x0; o < x1; o++, out += 4) {
+        const __m128i top = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(row0 + columnX[o] * 4)), zero);
+        const __m128i bottom = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(row1 + columnX[o] * 4)), zero);
+        const __m128i columns = _mm_srli_epi16(
+            _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(top, topWeight), _mm_mullo_epi16(bottom, bottomWeight)), round), 8);
+
+        const auto fx = static_cast<short>(columnF[o]);
+        const auto fl = static_cast<short>(256 - columnF[o]);
+        const __m128i weighted = _mm_mullo_epi16(columns, _mm_set_epi16(fx, fx, fx, fx, fl, fl, fl, fl));
+        const __m128i sum = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(weighted, _mm_srli_si128(weighted, 8)), round), 8);
+        const int pixel = _mm_cvtsi128_si32(_mm_packus_epi16(sum, sum));
+        std::memcpy(out, &pixel, 4);
+    }
+}
+
+// Eight pixels per step; the 32-bit results are biased so the signed pack keeps all 16 bits
+void rgb565Sse2(const uint8_t* rgba, uint8_t* out, int count) noexcept {
+    const __m128i redMask = _mm_set1_epi32(0xF8);
+    const __m128i greenMask = _mm_set1_epi32(0xFC00);
+    const __m128i blueMask = _mm_set1_epi32(0xF80000);
+    const __m128i bias32 = _mm_set1_epi32(0x8000);
+    const __m128i bias16 = _mm_set1_epi16(static_cast<short>(0x8000));
+    auto pack = [&](__m128i v) {
+        const __m128i value = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(_mm_and_si128(v, redMask), 8),
+                                                        _mm_srli_epi32(_mm_and_si128(v, greenMask), 5)),
+                                           _mm_srli_epi32(_mm_and_si128(v, blueMask), 19));
+        return _mm_sub_epi32(value, bias32);
+    };
+    int i = 0;
+    for (; i + 8 <= count; i += 8, rgba += 32, out += 16) {
+        const __m128i first = pack(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba)));
+        const __m128i second = pack(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba + 16)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_add_epi16(_mm_packs_epi32(first, second), bias16));
+    }
+    rgb565Scalar(rgba, out, count - i);
+}
+
+#endif
+
+void boxRow(bool vectorized, const uint8_t* row0, const uint8_t* row1, uint8_t* out, int count) noexcept {
+#ifdef ROBOT_FACE_OUTPUTS_SSE2
+    if (vectorized) return boxRowSse2(row0, row1, out, count);
+#endif
+    (void)vectorized;
+    boxRowScalar(row0, row1, out, count);
+}
+
+void bilinearRow(bool vectorized, const uint8_t* row0, const uint8_t* row1, int fy, const uint16_t* columnX,
+                 const uint16_t* columnF, int x0, int x1, uint8_t* out) noexcept {
+#ifdef ROBOT_FACE_OUTPUTS_SSE2
+    if (vectorized) return bilinearRowSse2(row0, row1, fy, columnX, columnF, x0, x1, out);
+#endif
+    (void)vectorized;
+    bilinearRowScalar(row0, row1, fy, columnX, columnF, x0, x1, out);
+}
+
+void convertRow(bool vectorized, const uint8_t* rgba, uint8_t* out, int count, PixelFormat format) noexcept {
+#ifdef ROBOT_FACE_OUTPUTS_SSE2
+    if (vectorized && format == PixelFormat::Rgb565) return rgb565Sse2(rgba, out, count);
+#endif
+    (void)vectorized;
+    convertPixels(rgba, out, count, format);
+}
+
+// Bilinear taps of `size` output pixels over `levelSize` level pixels (pixel centers aligned)
+void makeTaps(int size, int levelSize, std::vector<uint16_t>& index, std::vector<uint16_t>& weight) {
+    index.resize(static_cast<size_t>(size));
+    weight.resize(static_cast<size_t>(size));
+    for (int o = 0; o < size; o++) {
+        const long long position = (static_cast<long long>(2 * o + 1) * levelSize - size) * 256 / (2 * size);
+        int tap = static_cast<int>(position >> 8);
+        int fraction = static_cast<int>(position & 255);
+        if (tap >= levelSize - 1) {   // Last pixel: keep both loads inside the row
+            tap = levelSize - 2;
+            fraction = 256;
+        }
+        index[static_cast<size_t>(o)] = static_cast<uint16_t>(tap);
+        weight[static_cast<size_t>(o)] = static_cast<uint16_t>(fraction);
+    }
+}
+
+// Output pixels whose taps read level pixels [from, to)
+void tapRange(const std::vector<uint16_t>& index, int from, int to, int& first, int& last) noexcept {
+    first = static_cast<int>(std::lower_bound(index.begin(), index.end(), from - 1) - index.begin());
+    last = static_cast<int>(std::upper_bound(index.begin(), index.end(), to - 1) - index.begin());
+}
+
+void unite(PixelRect& into, const PixelRect& rect) noexcept {
+    if (rect.empty()) return;
+    if (into.empty()) {
+        into = rect;
+        return;
+    }
+    into = PixelRect{std::min(into.x0, rect.x0), std::min(into.y0, rect.y0), std::max(into.x1, rect.x1),
+                     std::max(into.y1, rect.y1)};
+}
+
+} // namespace
+
+bool parseOutputSpec(const char* text, OutputSpec& spec) {
+    char* end = nullptr;
+    const long width = std::strtol(text, &end, 10);
+    if (*end != 'x') return false;
+    const long height = std::strtol(end + 1, &end, 10);
+    if (width < 1 || height < 1 || width > 16384 || height > 16384) return false;
+
+    PixelFormat format = PixelFormat::Rgba8888;
+    if (*end == ':') {
+        const auto* name = std::find_if(std::begin(kPixelFormatNames), std::end(kPixelFormatNames),
+                                        [&](const char* n) { return std::strcmp(n, end + 1) == 0; });
+        if (name == std::end(kPixelFormatNames)) return false;
+        format = static_cast<PixelFormat>(name - std::begin(kPixelFormatNames));
+    } else if (*end != '\0') {
+        return false;
+    }
+
+    spec = OutputSpec{static_cast<int>(width), static_cast<int>(height), format};
+    return true;
+}
+
+void convertPixels(const uint8_t* rgba, uint8_t* out, int count, PixelFormat format) noexcept {
+    switch (format) {
+        case PixelFormat::Rgba8888:
+            std::memcpy(out, rgba, static_cast<size_t>(count) * 4);
+            break;
+        case PixelFormat::Rgb565:
+            rgb565Scalar(rgba, out, count);
+            break;
+        case PixelFormat::Gray8:
+            for (int i = 0; i < count; i++, rgba += 4) {
+                out[i] = static_cast<uint8_t>((77 * rgba[0] + 150 * rgba[1] + 29 * rgba[2] + 128) >> 8);
+            }
+            break;
+    }
+}
+
+bool OutputPyramid::vectorAvailable() noexcept {
+#ifdef ROBOT_FACE_OUTPUTS_SSE2
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool OutputPyramid::configure(const OutputSpec* outputs, size_t count) {
+    if (count == 0) return false;
+
+    // The widest output (then tallest) is rendered; every other one is derived from it
+    const OutputSpec* largest = std::max_element(outputs, outputs + count, [](const OutputSpec& a, const OutputSpec& b) {
+        return a.width != b.width ? a.width < b.width : a.height < b.height;
+    });
+    const int width = largest->width;
+    const int height = largest->height;
+    for (size_t i = 0; i < count; i++) {
+        const OutputSpec& spec = outputs[i];
+        const long long skew = static_cast<long long>(spec.width) * height - static_cast<long long>(spec.height) * width;
+        if (spec.width < 1 || spec.height < 1 || spec.height > height || std::llabs(skew) > width) return false;
+    }
+
+    m_width = width;
+    m_height = height;
+    for (auto& frame : m_frames) frame.assign(static_cast<size_t>(width) * height * 4, 0);
+    m_front = 0;
+    InitSoftCanvas(&m_source, m_frames[1].data(), width, height);
+    m_tilesX = (width + kTileSize - 1) / kTileSize;
+    m_tilesY = (height + kTileSize - 1) / kTileSize;
+
+    // Each output reads the smallest level that still covers it
+    m_outputs.clear();
+    int deepest = 0;
+    for (size_t i = 0; i < count; i++) {
+        Output output;
+        output.spec = outputs[i];
+        while (output.level < kMaxLevel && (width >> (output.level + 1)) >= output.spec.width &&
+               (height >> (output.level + 1)) >= output.spec.height) {
+            output.level++;
+        }
+        const int levelW = width >> output.level;
+        const int levelH = height >> output.level;
+        output.direct = levelW == output.spec.width && levelH == output.spec.height;
+        if (!output.direct && (levelW < 2 || levelH < 2)) return false;   // No second tap
+        if (!output.direct) {
+            makeTaps(output.spec.width, levelW, output.columnX, output.columnF);
+            makeTaps(output.spec.height, levelH, output.rowY, output.rowF);
+        }
+        if (!output.direct || output.spec.format != PixelFormat::Rgba8888) {
+            output.pixels.assign(static_cast<size_t>(output.spec.width) * output.spec.height *
+                                     bytesPerPixel(output.spec.format), 0);
+        }
+        deepest = std::max(deepest, output.level);
+        m_outputs.push_back(std::move(output));
+    }
+
+    m_levels.clear();
+    for (int level = 1; level <= deepest; level++) {
+        const int levelW = width >> level;
+        const int levelH = height >> level;
+        m_levels.push_back(Level{levelW, levelH, std::vector<uint8_t>(static_cast<size_t>(levelW) * levelH * 4)});
+    }
+    m_row.assign(static_cast<size_t>(width) * 4, 0);
+    m_valid = false;
+    return true;
+}
+
+const uint8_t* OutputPyramid::levelPixels(int level) const noexcept {
+    return level == 0 ? m_frames[m_front].data() : m_levels[static_cast<size_t>(level - 1)].pixels.data();
+}
+
+int OutputPyramid::levelWidth(int level) const noexcept {
+    return level == 0 ? m_width : m_levels[static_cast<size_t>(level - 1)].width;
+}
+
+int OutputPyramid::levelHeight(int level) const noexcept {
+    return level == 0 ? m_height : m_levels[static_cast<size_t>(level - 1)].height;
+}
+
+const uint8_t* OutputPyramid::pixels(size_t i) const noexcept {
+    const Output& output = m_outputs[i];
+    return output.pixels.empty() ? levelPixels(output.level) : output.pixels.data();
+}
+
+int OutputPyramid::stride(size_t i) const noexcept {
+    return m_outputs[i].spec.width * bytesPerPixel(m_outputs[i].spec.format);
+}
+
+// Back buffer (just drawn) against the front buffer (last presented)
+bool OutputPyramid::tileChanged(int tx, int ty) const noexcept {
+    const int x0 = tx * kTileSize;
+    const int x1 = std::min(x0 + kTileSize, m_width);
+    const int y1 = std::min((ty + 1) * kTileSize, m_height);
+    const size_t stride = static_cast<size_t>(m_width) * 4;
+    const uint8_t* before = m_frames[m_front].data();
+    const uint8_t* after = m_frames[m_front ^ 1].data();
+    for (int y = ty * kTileSize; y < y1; y++) {
+        const size_t offset = y * stride + static_cast<size_t>(x0) * 4;
+        if (std::memcmp(before + offset, after + offset, static_cast<size_t>(x1 - x0) * 4) != 0) return true;
+    }
+    return false;
+}
+
+void OutputPyramid::present() {
+    // Damage, as runs of changed tiles along each tile row
+    m_runs.clear();
+    m_damagedTiles = 0;
+    for (int ty = 0; ty < m_tilesY; ty++) {
+        int runStart = -1;
+        for (int tx = 0; tx <= m_tilesX; tx++) {
+            const bool changed = tx < m_tilesX && (!m_valid || tileChanged(tx, ty));
+            if (changed) {
+                m_damagedTiles++;
+                if (runStart < 0) runStart = tx;
+            } else if (runStart >= 0) {
+                m_runs.push_back(PixelRect{runStart * kTileSize, ty * kTileSize, std::min(tx * kTileSize, m_width),
+                                           std::min((ty + 1) * kTileSize, m_height)});
+                runStart = -1;
+            }
+        }
+    }
+
+    m_front ^= 1;
+    m_source.pixels = m_frames[m_front ^ 1].data();
+    m_valid = true;
+
+    auto atLevel = [&](const PixelRect& run, int level) {
+        return PixelRect{run.x0 >> level, run.y0 >> level, std::min(run.x1 >> level, levelWidth(level)),
+                         std::min(run.y1 >> level, levelHeight(level))};
+    };
+
+    // Levels first: a bilinear tap near a run's edge may read the neighbouring run
+    for (int level = 1; level <= static_cast<int>(m_levels.size()); level++) {
+        for (const PixelRect& run : m_runs) downscale(level, atLevel(run, level));
+    }
+    for (Output& output : m_outputs) {
+        output.dirty = PixelRect{};
+        for (const PixelRect& run : m_runs) refreshOutput(output, atLevel(run, output.level));
+    }
+}
+
+void OutputPyramid::downscale(int level, const PixelRect& rect) noexcept {
+    if (rect.empty()) return;
+    const uint8_t* above = levelPixels(level - 1);
+    const size_t aboveStride = static_cast<size_t>(levelWidth(level - 1)) * 4;
+    Level& target = m_levels[static_cast<size_t>(level - 1)];
+    const size_t stride = static_cast<size_t>(target.width) * 4;
+    for (int y = rect.y0; y < rect.y1; y++) {
+        const uint8_t* row0 = above + static_cast<size_t>(2 * y) * aboveStride + static_cast<size_t>(rect.x0) * 8;
+        boxRow(m_vectorized, row0, row0 + aboveStride, target.pixels.data() + y * stride + rect.x0 * 4,
+               rect.x1 - rect.x0);
+    }
+}
+
+void OutputPyramid::refreshOutput(Output& output, const PixelRect& levelRect) noexcept {
+    if (levelRect.empty()) return;
+    const int bpp = bytesPerPixel(output.spec.format);
+    const size_t outputStride = static_cast<size_t>(output.spec.width) * bpp;
+    const uint8_t* level = levelPixels(output.level);
+    const size_t levelStride = static_cast<size_t>(levelWidth(output.level)) * 4;
+
+    if (output.direct) {
+        unite(output.dirty, levelRect);
+        if (output.pixels.empty()) return;   // Aliases the level
+        for (int y = levelRect.y0; y < levelRect.y1; y++) {
+            convertRow(m_vectorized, level + y * levelStride + levelRect.x0 * 4,
+                       output.pixels.data() + y * outputStride + static_cast<size_t>(levelRect.x0) * bpp,
+                       levelRect.x1 - levelRect.x0, output.spec.format);
+        }
+        return;
+    }
+
+    PixelRect rect;
+    tapRange(output.columnX, levelRect.x0, levelRect.x1, rect.x0, rect.x1);
+    tapRange(output.rowY, levelRect.y0, levelRect.y1, rect.y0, rect.y1);
+    if (rect.empty()) return;
+    unite(output.dirty, rect);
+
+    const bool rgba = output.spec.format == PixelFormat::Rgba8888;
+    for (int y = rect.y0; y < rect.y1; y++) {
+        const uint8_t* row0 = level + output.rowY[static_cast<size_t>(y)] * levelStride;
+        uint8_t* target = output.pixels.data() + y * outputStride + static_cast<size_t>(rect.x0) * bpp;
+        bilinearRow(m_vectorized, row0, row0 + levelStride, output.rowF[static_cast<size_t>(y)],
+                    output.columnX.data(), output.columnF.data(), rect.x0, rect.x1, rgba ? target : m_row.data());
+        if (!rgba) convertRow(m_vectorized, m_row.data(), target, rect.x1 - rect.x0, output.spec.format);
+    }
+}
+
+} // namespace robotface
@@ -0,0 +1,902 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Face Description Compiler and Interpreter
+ *
+ *******************************************************************************************/
+
+#include "robot_face_program.hpp"
+#include "robot_face_mapped_file.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+
+namespace robotface {
+
+namespace {
+
+constexpr const char* kInputNames[] = {"happiness", "blink", "openness", "gazeX", "gazeY", "width", "height"};
+constexpr int kInputCount = 7;
+constexpr uint8_t kLayerInputs = (1u << 5) | (1u << 6);   // width, height
+
+// Shared by constant folding and run(), so folded and live results are identical
+inline float applyOp(FaceOp op, float a, float b) noexcept {
+    switch (op) {
+        case FaceOp::Add: return a + b;
+        case FaceOp::Sub: return a - b;
+        case FaceOp::Mul: return a * b;
+        case FaceOp::Div: return a / b;
+        case FaceOp::Min: return b < a ? b : a;
+        case FaceOp::Max: return a < b ? b : a;
+        case FaceOp::Abs: return std::fabs(a);
+        case FaceOp::Neg: return -a;
+        case FaceOp::Less: return a < b ? 1.0f : 0.0f;
+        case FaceOp::LessEqual: return a <= b ? 1.0f : 0.0f;
+        case FaceOp::Greater: return a > b ? 1.0f : 0.0f;
+        case FaceOp::GreaterEqual: return a >= b ? 1.0f : 0.0f;
+        case FaceOp::Equal: return a == b ? 1.0f : 0.0f;
+        case FaceOp::NotEqual: return a != b ? 1.0f : 0.0f;
+        default: return 0.0f;
+    }
+}
+
+inline bool isIdentStart(char c) noexcept { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_'; }
+inline bool isDigit(char c) noexcept { return c >= '0' && c <= '9'; }
+inline bool isHex(char c) noexcept { return isDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'); }
+inline int hexValue(char c) noexcept { return isDigit(c) ? c - '0' : (c | 0x20) - 'a' + 10; }
+
+uint32_t fnv1a(const char* data, size_t length) noexcept {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) hash = (hash ^ static_cast<uint8_t>(data[i])) * 16777619u;
+    return hash;
+}
+
+} // namespace
+
+// Source text -> tokens -> expression nodes and statements -> instructions
+class FaceCompiler {
+public:
+    FaceCompiler(const char* source, size_t length, FaceProgram& program, FaceProgramError* error)
+        : m_source(source), m_length(length), m_program(program), m_error(error) {}
+
+    bool compile();
+
+private:
+    enum class Tok : uint8_t { End, Newline, Number, Ident, String, Color, Punct };
+
+    struct Token {
+        Tok kind;
+        int line;
+        size_t begin;
+        size_t length;
+        float number;
+        Rgba color;
+    };
+
+    // Nodes are hash-consed: equal constants and equal (op, left, right) share one node
+    struct Node {
+        enum class Kind : uint8_t { Constant, Input, Unary, Binary } kind;
+        FaceOp op;
+        uint8_t inputs;   // Inputs the value depends on (bit per input)
+        float value;
+        int index;        // Input index
+        int left;
+        int right;
+        int reg = -1;     // Register once computed unconditionally
+        bool live = false;
+    };
+
+    struct Statement {
+        enum class Kind : uint8_t { Let, Draw, BeginLayer, EndLayer } kind;
+        FaceOp op;
+        int line;
+        int let;          // Let: value node
+        int operands[7];
+        int operandCount;
+        int condition;
+        uint16_t color;
+        uint16_t string;
+        uint8_t segments;
+    };
+
+    // Lexing
+    bool tokenize();
+    [[nodiscard]] const Token& peek() const noexcept { return m_tokens[m_pos]; }
+    bool isPunct(const char* text) const noexcept;
+    bool isIdent(const char* text) const noexcept;
+    bool expectPunct(const char* text);
+    [[nodiscard]] std::string text(const Token& token) const { return std::string(m_source + token.begin, token.length); }
+
+    // Parsing
+    bool parseStatement();
+    bool parseDraw(FaceOp op, int operands, bool hasSegments, bool hasString);
+    bool parseColor(uint16_t& index);
+    int parseExpression();
+    int parseComparison();
+    int parseAdditive();
+    int parseTerm();
+    int parseUnary();
+    int parsePrimary();
+    int makeConstant(float value);
+    int makeUnary(FaceOp op, int child);
+    int makeBinary(FaceOp op, int left, int right);
+    int intern(const Node& node);
+
+    // Emission
+    void markLive(int node);
+    bool emit();
+    int valueRegister(int node);
+    int allocateRegister(float initial = 0.0f);
+    void emitSkip(int condition);
+    uint16_t addCurve(const Statement& statement);
+    void push(FaceOp op, uint16_t dst, uint16_t a = 0, uint16_t b = 0);
+
+    bool fail(int line, const std::string& message);
+
+    const char* m_source;
+    size_t m_length;
+    FaceProgram& m_program;
+    FaceProgramError* m_error;
+
+    std::vector<Token> m_tokens;
+    size_t m_pos = 0;
+    bool m_failed = false;
+
+    std::vector<Node> m_nodes;
+    std::vector<Statement> m_statements;
+    std::unordered_map<std::string, int> m_names;      // Let, point or input -> node
+    std::unordered_map<std::string, Rgba> m_colorNames;
+    std::unordered_map<uint64_t, int> m_interned;      // Constant bits or (op, left, right) -> node
+    std::unordered_map<uint32_t, int> m_constants;     // Float bits -> register
+    std::unordered_map<int, uint32_t> m_weights;       // Segments -> offset in m_curveData
+    bool m_inLayer = false;
+    bool m_conditional = false;   // Emitting code that may be skipped (conditional draw, layer)
+};
+
+bool FaceCompiler::fail(int line, const std::string& message) {
+    if (!m_failed && m_error) {
+        m_error->line = line;
+        m_error->message = message;
+    }
+    m_failed = true;
+    return false;
+}
+
+bool FaceCompiler::tokenize() {
+    int line = 1;
+    size_t i = 0;
+    while (i < m_length) {
+        const char c = m_source[i];
+        if (c == '\n') {
+            m_tokens.push_back(Token{Tok::Newline, line++, i, 1, 0.0f, {}});
+            i++;
+        } else if (c == ' ' || c == '\t' || c == '\r') {
+            i++;
+        } else if (c == '#' && i + 1 < m_length && isHex(m_source[i + 1])) {
+            size_t end = i + 1;
+            while (end < m_length && isHex(m_source[end])) end++;
+            const size_t digits = end - i - 1;
+            if (digits != 6 && digits != 8) return fail(line, "color needs 6 or 8 hex digits");
+            uint8_t channels[4] = {0, 0, 0, 255};
+            for (size_t d = 0; d < digits / 2; d++) {
+                channels[d] = static_cast<uint8_t>(hexValue(m_source[i + 1 + d * 2]) * 16 + hexValue(m_source[i + 2 + d * 2]));
+            }
+            m_tokens.push_back(Token{Tok::Color, line, i, end - i, 0.0f, {channels[0], channels[1], channels[2], channels[3]}});
+            i = end;
+        } else if (c == '#') {
+            while (i < m_length && m_source[i] != '\n') i++;
+        } else if (isDigit(c) || (c == '.' && i + 1 < m_length && isDigit(m_source[i + 1]))) {
+            size_t end = i;
+            while (end < m_length && (isDigit(m_source[end]) || m_source[end] == '.')) end++;
+            char buffer[32];
+            if (end - i >= sizeof(buffer)) return fail(line, "number too long");
+            std::memcpy(buffer, m_source + i, end - i);
+            buffer[end - i] = '\0';
+            char* parsed = nullptr;
+            const float value = std::strtof(buffer, &parsed);
+            if (parsed != buffer + (end - i)) return fail(line, "malformed number '" + std::string(buffer) + "'");
+            m_tokens.push_back(Token{Tok::Number, line, i, end - i, value, {}});
+            i = end;
+        } else if (isIdentStart(c)) {
+            size_t end = i;
+            while (end < m_length && (isIdentStart(m_source[end]) || isDigit(m_source[end]) || m_source[end] == '.')) end++;
+            m_tokens.push_back(Token{Tok::Ident, line, i, end - i, 0.0f, {}});
+            i = end;
+        } else if (c == '"') {
+            size_t end = i + 1;
+            while (end < m_length && m_source[end] != '"' && m_source[end] != '\n') end++;
+            if (end >= m_length || m_source[end] != '"') return fail(line, "unterminated string");
+            m_tokens.push_back(Token{Tok::String, line, i + 1, end - i - 1, 0.0f, {}});
+            i = end + 1;
+        } else {
+            // Two-character operators first
+            const bool pair = i + 1 < m_length && m_source[i + 1] == '=' && (c == '<' || c == '>' || c == '=' || c == '!');
+            if (!pair && !std::strchr("+-*/(),=<>", c)) return fail(line, std::string("unexpected character '") + c + "'");
+            m_tokens.push_back(Token{Tok::Punct, line, i, pair ? 2u : 1u, 0.0f, {}});
+            i += pair ? 2 : 1;
+        }
+    }
+    m_tokens.push_back(Token{Tok::Newline, line, m_length, 0, 0.0f, {}});
+    m_tokens.push_back(Token{Tok::End, line, m_length, 0, 0.0f, {}});
+    return true;
+}
+
+bool FaceCompiler::isPunct(const char* punct) const noexcept {
+    const Token& token = peek();
+    return token.kind == Tok::Punct && token.length == std::strlen(punct) &&
+           std::memcmp(m_source + token.begin, punct, token.length) == 0;
+}
+
+bool FaceCompiler::isIdent(const char* name) const noexcept {
+    const Token& token = peek();
+    return token.kind == Tok::Ident && token.length == std::strlen(name) &&
+           std::memcmp(m_source + token.begin, name, token.length) == 0;
+}
+
+bool FaceCompiler::expectPunct(const char* punct) {
+    if (!isPunct(punct)) return fail(peek().line, std::string("expected '") + punct + "'");
+    m_pos++;
+    return true;
+}
+
+int FaceCompiler::intern(const Node& node) {
+    uint64_t key;
+    if (node.kind == Node::Kind::Constant) {
+        uint32_t bits;
+        std::memcpy(&bits, &node.value, sizeof(bits));
+        key = bits;
+    } else {
+        key = (uint64_t{1} << 63) | (static_cast<uint64_t>(node.op) << 56) |
+              (static_cast<uint64_t>(node.left) << 28) | static_cast<uint64_t>(node.right + 1);
+    }
+    const auto found = m_interned.find(key);
+    if (found != m_interned.end()) return found->second;
+    m_nodes.push_back(node);
+    const int index = static_cast<int>(m_nodes.size() - 1);
+    m_interned.emplace(key, index);
+    return index;
+}
+
+int FaceCompiler::makeConstant(float value) {
+    return intern(Node{Node::Kind::Constant, FaceOp::Add, 0, value, 0, -1, -1});
+}
+
+int FaceCompiler::makeUnary(FaceOp op, int child) {
+    if (child < 0) return -1;
+    const Node& c = m_nodes[child];
+    if (c.kind == Node::Kind::Constant) {
+        m_program.m_folded++;
+        return makeConstant(applyOp(op, c.value, 0.0f));
+    }
+    return intern(Node{Node::Kind::Unary, op, c.inputs, 0.0f, 0, child, -1});
+}
+
+int FaceCompiler::makeBinary(FaceOp op, int left, int right) {
+    if (left < 0 || right < 0) return -1;
+    const Node& l = m_nodes[left];
+    const Node& r = m_nodes[right];
+    if (l.kind == Node::Kind::Constant && r.kind == Node::Kind::Constant) {
+        m_program.m_folded++;
+        return makeConstant(applyOp(op, l.value, r.value));
+    }
+    return intern(Node{Node::Kind::Binary, op, static_cast<uint8_t>(l.inputs | r.inputs), 0.0f, 0, left, right});
+}
+
+int FaceCompiler::parseExpression() {
+    return parseComparison();
+}
+
+int FaceCompiler::parseComparison() {
+    const int left = parseAdditive();
+    static constexpr std::pair<const char*, FaceOp> kComparisons[] = {
+        {"<=", FaceOp::LessEqual}, {">=", FaceOp::GreaterEqual}, {"==", FaceOp::Equal},
+        {"!=", FaceOp::NotEqual}, {"<", FaceOp::Less}, {">", FaceOp::Greater},
+    };
+    for (const auto& [punct, op] : kComparisons) {
+        if (isPunct(punct)) {
+            m_pos++;
+            return makeBinary(op, left, parseAdditive());
+        }
+    }
+    return left;
+}
+
+int FaceCompiler::parseAdditive() {
+    int left = parseTerm();
+    while (isPunct("+") || isPunct("-")) {
+        const FaceOp op = isPunct("+") ? FaceOp::Add : FaceOp::Sub;
+        m_pos++;
+        left = makeBinary(op, left, parseTerm());
+    }
+    return left;
+}
+
+int FaceCompiler::parseTerm() {
+    int left = parseUnary();
+    while (isPunct("*") || isPunct("/")) {
+        const FaceOp op = isPunct("*") ? FaceOp::Mul : FaceOp::Div;
+        m_pos++;
+        left = makeBinary(op, left, parseUnary());
+    }
+    return left;
+}
+
+int FaceCompiler::parseUnary() {
+    if (isPunct("-")) {
+        m_pos++;
+        return makeUnary(FaceOp::Neg, parseUnary());
+    }
+    return parsePrimary();
+}
+
+int FaceCompiler::parsePrimary() {
+    const Token& token = peek();
+    if (token.kind == Tok::Number) {
+        m_pos++;
+        return makeConstant(token.number);
+    }
+    if (isPunct("(")) {
+        m_pos++;
+        const int inner = parseExpression();
+        return expectPunct(")") ? inner : -1;
+    }
+    if (token.kind != Tok::Ident) {
+        fail(token.line, "expected a number, name or '('");
+        return -1;
+    }
+
+    const std::string name = text(token);
+    m_pos++;
+    if (isPunct("(")) {
+        m_pos++;
+        int args[3] = {-1, -1, -1};
+        int count = 0;
+        while (!m_failed && count < 3) {
+            args[count++] = parseExpression();
+            if (!isPunct(",")) break;
+            m_pos++;
+        }
+        if (!expectPunct(")")) return -1;
+
+        auto arity = [&](int expected) {
+            if (count == expected) return true;
+            fail(token.line, name + "() takes " + std::to_string(expected) + " arguments");
+            return false;
+        };
+        if (name == "min") return arity(2) ? makeBinary(FaceOp::Min, args[0], args[1]) : -1;
+        if (name == "max") return arity(2) ? makeBinary(FaceOp::Max, args[0], args[1]) : -1;
+        if (name == "abs") return arity(1) ? makeUnary(FaceOp::Abs, args[0]) : -1;
+        if (name == "clamp") {
+            return arity(3) ? makeBinary(FaceOp::Min, makeBinary(FaceOp::Max, args[0], args[1]), args[2]) : -1;
+        }
+        if (name == "mix") {
+            return arity(3) ? makeBinary(FaceOp::Add, args[0],
+                                         makeBinary(FaceOp::Mul, makeBinary(FaceOp::Sub, args[1], args[0]), args[2]))
+                            : -1;
+        }
+        fail(token.line, "unknown function '" + name + "'");
+        return -1;
+    }
+
+    const auto found = m_names.find(name);
+    if (found == m_names.end()) {
+        fail(token.line, "unknown name '" + name + "'");
+        return -1;
+    }
+    return found->second;
+}
+
+bool FaceCompiler::parseColor(uint16_t& index) {
+    const Token& token = peek();
+    Rgba color{};
+    if (token.kind == Tok::Color) {
+        color = token.color;
+    } else if (token.kind == Tok::Ident && m_colorNames.count(text(token))) {
+        color = m_colorNames[text(token)];
+    } else {
+        return fail(token.line, "expected a color (#RRGGBB, #RRGGBBAA or a color name)");
+    }
+    m_pos++;
+
+    std::vector<Rgba>& colors = m_program.m_colors;
+    for (size_t i = 0; i < colors.size(); i++) {
+        if (std::memcmp(&colors[i], &color, sizeof(Rgba)) == 0) {
+            index = static_cast<uint16_t>(i);
+            return true;
+        }
+    }
+    colors.push_back(color);
+    index = static_cast<uint16_t>(colors.size() - 1);
+    return true;
+}
+
+bool FaceCompiler::parseDraw(FaceOp op, int operands, bool hasSegments, bool hasString) {
+    Statement statement{};
+    statement.kind = Statement::Kind::Draw;
+    statement.op = op;
+    statement.line = peek().line;
+    statement.condition = -1;
+
+    // quad: six coordinates, then segments, then width
+    for (int i = 0; i < operands + (hasSegments ? 1 : 0); i++) {
+        const int node = parseExpression();
+        if (node < 0) return false;
+
+        if (hasSegments && i == 6) {
+            const Node& segments = m_nodes[node];
+            if (segments.kind != Node::Kind::Constant || segments.value < 1.0f ||
+                segments.value > static_cast<float>(FaceProgram::kMaxSegments) ||
+                segments.value != std::floor(segments.value)) {
+                return fail(statement.line, "segments must be a constant from 1 to " +
+                                                std::to_string(FaceProgram::kMaxSegments));
+            }
+            statement.segments = static_cast<uint8_t>(segments.value);
+        } else {
+            if (m_inLayer && (m_nodes[node].inputs & ~kLayerInputs) != 0) {
+                return fail(statement.line, "layer shapes may only depend on width and height");
+            }
+            statement.operands[statement.operandCount++] = node;
+        }
+        if (!expectPunct(",")) return false;
+    }
+    if (!parseColor(statement.color)) return false;
+
+    if (hasString) {
+        if (!expectPunct(",")) return false;
+        const Token& token = peek();
+        if (token.kind != Tok::String) return fail(token.line, "expected a string");
+        std::vector<char>& strings = m_program.m_strings;
+        if (strings.size() + token.length + 1 > 0xFFFF) return fail(token.line, "too much text");
+        statement.string = static_cast<uint16_t>(strings.size());
+        strings.insert(strings.end(), m_source + token.begin, m_source + token.begin + token.length);
+        strings.push_back('\0');
+        m_pos++;
+    }
+
+    if (isIdent("if")) {
+        if (m_inLayer) return fail(statement.line, "layer shapes cannot be conditional");
+        m_pos++;
+        statement.condition = parseExpression();
+        if (statement.condition < 0) return false;
+    }
+    m_statements.push_back(statement);
+    return true;
+}
+
+bool FaceCompiler::parseStatement() {
+    const Token& token = peek();
+    if (token.kind == Tok::Newline) {
+        m_pos++;
+        return true;
+    }
+    if (token.kind != Tok::Ident) return fail(token.line, "expected a statement");
+
+    const std::string keyword = text(token);
+    m_pos++;
+
+    auto newName = [&](std::string& name) {
+        const Token& nameToken = peek();
+        if (nameToken.kind != Tok::Ident) return fail(nameToken.line, "expected a name");
+        name = text(nameToken);
+        if (m_names.count(name) || m_colorNames.count(name)) return fail(nameToken.line, "'" + name + "' is already defined");
+        m_pos++;
+        return expectPunct("=");
+    };
+    auto bind = [&](const std::string& name, int node) {
+        if (m_inLayer) return fail(token.line, "let and point are not allowed inside a layer");
+        m_names[name] = node;
+        const Node::Kind kind = m_nodes[node].kind;
+        if (kind == Node::Kind::Constant || kind == Node::Kind::Input) return true;   // Alias only
+
+        // Computed where it is defined, so every later use reads the same register
+        Statement statement{};
+        statement.kind = Statement::Kind::Let;
+        statement.line = token.line;
+        statement.let = node;
+        m_statements.push_back(statement);
+        return true;
+    };
+
+    bool ok = true;
+    if (keyword == "let") {
+        std::string name;
+        if (!newName(name)) return false;
+        const int node = parseExpression();
+        ok = node >= 0 && bind(name, node);
+    } else if (keyword == "point") {
+        std::string name;
+        if (!newName(name)) return false;
+        const int x = parseExpression();
+        if (x < 0 || !expectPunct(",")) return false;
+        const int y = parseExpression();
+        ok = y >= 0 && bind(name + ".x", x) && bind(name + ".y", y);
+    } else if (keyword == "color") {
+        std::string name;
+        if (!newName(name)) return false;
+        if (peek().kind != Tok::Color) return fail(peek().line, "expected #RRGGBB or #RRGGBBAA");
+        m_colorNames[name] = peek().color;
+        m_pos++;
+    } else if (keyword == "layer") {
+        if (m_inLayer) return fail(token.line, "layers do not nest");
+        m_inLayer = true;
+        Statement statement{};
+        statement.kind = Statement::Kind::BeginLayer;
+        statement.line = token.line;
+        m_statements.push_back(statement);
+    } else if (keyword == "end") {
+        if (!m_inLayer) return fail(token.line, "'end' without 'layer'");
+        m_inLayer = false;
+        Statement statement{};
+        statement.kind = Statement::Kind::EndLayer;
+        statement.line = token.line;
+        m_statements.push_back(statement);
+    } else if (keyword == "clear") {
+        Statement statement{};
+        statement.kind = Statement::Kind::Draw;
+        statement.op = FaceOp::Clear;
+        statement.line = token.line;
+        statement.condition = -1;
+        ok = parseColor(statement.color);
+        if (ok) m_statements.push_back(statement);
+    } else if (keyword == "circle") {
+        ok = parseDraw(FaceOp::Circle, 3, false, false);
+    } else if (keyword == "ring") {
+        ok = parseDraw(FaceOp::Ring, 4, false, false);
+    } else if (keyword == "quad") {
+        ok = parseDraw(FaceOp::Quad, 7, true, false);
+    } else if (keyword == "text") {
+        ok = parseDraw(FaceOp::Text, 3, false, true);
+    } else {
+        return fail(token.line, "unknown statement '" + keyword + "'");
+    }
+
+    if (!ok || m_failed) return false;
+    if (peek().kind != Tok::Newline) return fail(peek().line, "unexpected '" + text(peek()) + "' at end of statement");
+    m_pos++;
+    return true;
+}
+
+// Only values a draw depends on are computed
+void FaceCompiler::markLive(int node) {
+    if (node < 0 || m_nodes[node].live) return;
+    m_nodes[node].live = true;
+    markLive(m_nodes[node].left);
+    markLive(m_nodes[node].right);
+}
+
+int FaceCompiler::allocateRegister(float initial) {
+    m_program.m_registers.push_back(initial);
+    return static_cast<int>(m_program.m_registers.size() - 1);
+}
+
+void FaceCompiler::push(FaceOp op, uint16_t dst, uint16_t a, uint16_t b) {
+    m_program.m_code.push_back(FaceInstr{op, 0, dst, a, b});
+}
+
+// Register holding the node's value. Constants share one register per value; a computed
+// value is reused by later statements once it has been computed outside skippable code.
+int FaceCompiler::valueRegister(int node) {
+    Node& n = m_nodes[node];
+    if (n.kind == Node::Kind::Constant) {
+        uint32_t bits;
+        std::memcpy(&bits, &n.value, sizeof(bits));
+        const auto found = m_constants.find(bits);
+        if (found != m_constants.end()) return found->second;
+        const int reg = allocateRegister(n.value);
+        m_constants.emplace(bits, reg);
+        return reg;
+    }
+    if (n.kind == Node::Kind::Input) return n.index;
+    if (n.reg >= 0) {
+        m_program.m_shared++;
+        return n.reg;
+    }
+
+    const FaceOp op = n.op;
+    const int right = n.right;
+    const auto a = static_cast<uint16_t>(valueRegister(n.left));
+    const auto b = right >= 0 ? static_cast<uint16_t>(valueRegister(right)) : uint16_t{0};
+    const int reg = allocateRegister();
+    push(op, static_cast<uint16_t>(reg), a, b);
+    if (!m_conditional) m_nodes[node].reg = reg;
+    return reg;
+}
+
+// Skip over a conditional draw; comparisons test and jump in one instruction
+void FaceCompiler::emitSkip(int condition) {
+    const Node& n = m_nodes[condition];
+    if (n.kind == Node::Kind::Binary) {
+        // a > b is b < a and a >= b is b <= a, NaN included
+        const int left = n.left;
+        const int right = n.right;
+        switch (n.op) {
+            case FaceOp::Less:
+            case FaceOp::LessEqual:
+            case FaceOp::Greater:
+            case FaceOp::GreaterEqual: {
+                const bool swap = n.op == FaceOp::Greater || n.op == FaceOp::GreaterEqual;
+                const FaceOp op = n.op == FaceOp::Less || n.op == FaceOp::Greater ? FaceOp::SkipUnlessLess
+                                                                                 : FaceOp::SkipUnlessLessEqual;
+                const auto a = static_cast<uint16_t>(valueRegister(swap ? right : left));
+                const auto b = static_cast<uint16_t>(valueRegister(swap ? left : right));
+                push(op, 0, a, b);
+                return;
+            }
+            default:
+                break;
+        }
+    }
+    push(FaceOp::SkipIfZero, 0, static_cast<uint16_t>(valueRegister(condition)));
+}
+
+// Per-axis precomputation for a quad whose end points (or whole axis) are constant
+uint16_t FaceCompiler::addCurve(const Statement& statement) {
+    const int segments = statement.segments;
+    std::vector<float>& data = m_program.m_curveData;
+
+    auto found = m_weights.find(segments);
+    if (found == m_weights.end()) {
+        // Same weights as tables::makeQuadraticBasis
+        const auto offset = static_cast<uint32_t>(data.size());
+        data.resize(data.size() + 3 * (segments + 1));
+        for (int i = 0; i <= segments; i++) {
+            const double t = static_cast<double>(i) / segments;
+            data[offset + i] = static_cast<float>((1.0 - t) * (1.0 - t));
+            data[offset + segments + 1 + i] = static_cast<float>(2.0 * (1.0 - t) * t);
+            data[offset + 2 * (segments + 1) + i] = static_cast<float>(t * t);
+        }
+        found = m_weights.emplace(segments, offset).first;
+    }
+
+    FaceProgram::Curve curve{};
+    curve.segments = static_cast<uint8_t>(segments);
+    curve.weights = found->second;
+
+    std::vector<Point2>& points = m_program.m_curvePoints;
+    curve.points = static_cast<uint32_t>(points.size());
+    points.resize(points.size() + segments + 1, Point2{0.0f, 0.0f});
+
+    // Operands: x0 y0 cx cy x1 y1 width
+    auto axis = [&](int axisIndex, float Point2::*member, FaceProgram::CurveAxis& mode, uint32_t& offset) {
+        const Node& p0 = m_nodes[statement.operands[axisIndex]];
+        const Node& c = m_nodes[statement.operands[2 + axisIndex]];
+        const Node& p1 = m_nodes[statement.operands[4 + axisIndex]];
+        const bool ends = p0.kind == Node::Kind::Constant && p1.kind == Node::Kind::Constant;
+        mode = !ends ? FaceProgram::CurveAxis::Live
+                     : c.kind == Node::Kind::Constant ? FaceProgram::CurveAxis::Constant : FaceProgram::CurveAxis::Ends;
+        if (mode == FaceProgram::CurveAxis::Live) return;
+
+        if (mode == FaceProgram::CurveAxis::Ends) {
+            offset = static_cast<uint32_t>(data.size());
+            data.resize(data.size() + 2 * (segments + 1));
+        }
+        const float* w0 = data.data() + curve.weights;
+        const float* w1 = w0 + segments + 1;
+        const float* w2 = w1 + segments + 1;
+        for (int i = 0; i <= segments; i++) {
+            // Same products and order as the run-time sampling, so results are identical
+            if (mode == FaceProgram::CurveAxis::Constant) {
+                points[curve.points + i].*member = w0[i]*p0.value + w1[i]*c.value + w2[i]*p1.value;
+            } else {
+                data[offset + i] = w0[i]*p0.value;
+                data[offset + segments + 1 + i] = w2[i]*p1.value;
+            }
+        }
+    };
+    axis(0, &Point2::x, curve.x, curve.xData);
+    axis(1, &Point2::y, curve.y, curve.yData);
+
+    m_program.m_curves.push_back(curve);
+    return static_cast<uint16_t>(m_program.m_curves.size() - 1);
+}
+
+bool FaceCompiler::emit() {
+    for (const Statement& statement : m_statements) {
+        if (statement.kind != Statement::Kind::Draw) continue;
+        for (int i = 0; i < statement.operandCount; i++) markLive(statement.operands[i]);
+        markLive(statement.condition);
+    }
+
+    size_t layerStart = 0;
+    size_t skip = 0;
+    int openCondition = -1;   // Condition of the skip just emitted; adjacent draws share it
+    bool inLayer = false;     // Skipped when the canvas already has the layer
+    for (const Statement& statement : m_statements) {
+        if (statement.kind != Statement::Kind::Draw || statement.condition != openCondition) openCondition = -1;
+        switch (statement.kind) {
+            case Statement::Kind::Let:
+                if (m_nodes[statement.let].live) valueRegister(statement.let);
+                break;
+            case Statement::Kind::BeginLayer:
+                layerStart = m_program.m_code.size();
+                push(FaceOp::BeginGroup, 0);
+                inLayer = true;
+                break;
+            case Statement::Kind::EndLayer:
+                m_program.m_code[layerStart].b = static_cast<uint16_t>(m_program.m_code.size() - layerStart);
+                push(FaceOp::EndGroup, 0);
+                inLayer = false;
+                break;
+            case Statement::Kind::Draw: {
+                const bool conditional = statement.condition >= 0 &&
+                                         m_nodes[statement.condition].kind != Node::Kind::Constant;
+                if (statement.condition >= 0 && !conditional && m_nodes[statement.condition].value == 0.0f) {
+                    break;   // Never drawn
+                }
+                if (conditional && statement.condition != openCondition) {
+                    emitSkip(statement.condition);
+                    skip = m_program.m_code.size() - 1;
+                    openCondition = statement.condition;
+                }
+                m_conditional = conditional || inLayer;
+
+                const auto operands = static_cast<uint16_t>(m_program.m_operands.size());
+                for (int i = 0; i < statement.operandCount; i++) {
+                    const auto reg = static_cast<uint16_t>(valueRegister(statement.operands[i]));
+                    m_program.m_operands.push_back(reg);
+                }
+                const uint16_t extra = statement.op == FaceOp::Quad ? addCurve(statement) : statement.string;
+                push(statement.op, operands, statement.color, extra);
+
+                if (conditional) {
+                    FaceInstr& jump = m_program.m_code[skip];
+                    const auto length = static_cast<uint16_t>(m_program.m_code.size() - skip - 1);
+                    (jump.op == FaceOp::SkipIfZero ? jump.b : jump.dst) = length;
+                }
+                m_conditional = false;
+                break;
+            }
+        }
+        if (m_program.m_registers.size() > FaceProgram::kMaxRegisters || m_program.m_code.size() > 0xFFFF ||
+            m_program.m_operands.size() > 0xFFFF || m_program.m_curves.size() > 0xFFFF ||
+            m_program.m_curveData.size() > 0xFFFFFFFFu) {
+            return fail(statement.line, "description too large");
+        }
+    }
+    return true;
+}
+
+bool FaceCompiler::compile() {
+    if (!tokenize()) return false;
+
+    for (int i = 0; i < kInputCount; i++) {
+        m_nodes.push_back(Node{Node::Kind::Input, FaceOp::Add, static_cast<uint8_t>(1u << i), 0.0f, i, -1, -1});
+        m_names[kInputNames[i]] = i;
+        m_program.m_registers.push_back(0.0f);
+    }
+
+    while (peek().kind != Tok::End) {
+        if (!parseStatement()) return false;
+    }
+    if (m_inLayer) return fail(peek().line, "'layer' without 'end'");
+    return emit();
+}
+
+bool FaceProgram::compile(const char* source, size_t length, FaceProgramError* error) {
+    FaceProgram program;
+    program.m_hash = fnv1a(source, length);
+    FaceCompiler compiler(source, length, program, error);
+    if (!compiler.compile()) {
+        *this = FaceProgram{};
+        return false;
+    }
+    *this = std::move(program);
+    return true;
+}
+
+bool FaceProgram::load(const char* path, FaceProgramError* error) {
+    MappedFile file;
+    if (!file.open(path)) {
+        if (error) {
+            error->line = 0;
+            error->message = std::string("cannot open ") + path;
+        }
+        *this = FaceProgram{};
+        return false;
+    }
+    return compile(reinterpret_cast<const char*>(file.data()), file.size(), error);
+}
+
+// One axis of a sampled quad, evaluated like the tables::makeQuadraticBasis users do
+template <float Point2::*Axis>
+void FaceProgram::sampleAxis(CurveAxis mode, int count, const float* weights, const float* ends, float p0, float c,
+                             float p1, Point2* path) noexcept {
+    const float* w0 = weights;
+    const float* w1 = w0 + count;
+    const float* w2 = w1 + count;
+    switch (mode) {
+        case CurveAxis::Constant:
+            break;
+        case CurveAxis::Ends:
+            for (int i = 0; i < count; i++) path[i].*Axis = ends[i] + w1[i]*c + ends[count + i];
+            break;
+        case CurveAxis::Live:
+            for (int i = 0; i < count; i++) path[i].*Axis = w0[i]*p0 + w1[i]*c + w2[i]*p1;
+            break;
+    }
+}
+
+// Samples a quad into its path (constant axes stay as compiled) and strokes it.
+// Out of line: keeps the curve's locals out of the dispatch loop's registers.
+void FaceProgram::strokeCurve(Canvas& canvas, const Curve& curve, const float* r, const uint16_t* o, Rgba color) const {
+    // Operands: x0 y0 cx cy x1 y1 width
+    const int points = curve.segments + 1;
+    const float* data = m_curveData.data();
+    Point2* path = m_curvePoints.data() + curve.points;
+    sampleAxis<&Point2::x>(curve.x, points, data + curve.weights, data + curve.xData, r[o[0]], r[o[2]], r[o[4]], path);
+    sampleAxis<&Point2::y>(curve.y, points, data + curve.weights, data + curve.yData, r[o[1]], r[o[3]], r[o[5]], path);
+    canvas.strokePath(path, points, r[o[6]], color);
+}
+
+void FaceProgram::run(Canvas& canvas, const FaceInputs& inputs) const {
+    float* r = m_registers.data();
+    r[0] = inputs.happiness;
+    r[1] = inputs.blink;
+    r[2] = inputs.openness;
+    r[3] = inputs.gazeX;
+    r[4] = inputs.gazeY;
+    r[5] = inputs.width;
+    r[6] = inputs.height;
+
+    const FaceInstr* code = m_code.data();
+    const uint16_t* operandRegs = m_operands.data();
+    const Rgba* colors = m_colors.data();
+    const size_t count = m_code.size();
+
+    for (size_t pc = 0; pc < count; pc++) {
+        const FaceInstr& in = code[pc];
+        const uint16_t* o = operandRegs + in.dst;
+        switch (in.op) {
+            // Each op gets its own case so the arithmetic dispatches once (applyOp folds away)
+            case FaceOp::Add: r[in.dst] = applyOp(FaceOp::Add, r[in.a], r[in.b]); break;
+            case FaceOp::Sub: r[in.dst] = applyOp(FaceOp::Sub, r[in.a], r[in.b]); break;
+            case FaceOp::Mul: r[in.dst] = applyOp(FaceOp::Mul, r[in.a], r[in.b]); break;
+            case FaceOp::Div: r[in.dst] = applyOp(FaceOp::Div, r[in.a], r[in.b]); break;
+            case FaceOp::Min: r[in.dst] = applyOp(FaceOp::Min, r[in.a], r[in.b]); break;
+            case FaceOp::Max: r[in.dst] = applyOp(FaceOp::Max, r[in.a], r[in.b]); break;
+            case FaceOp::Abs: r[in.dst] = applyOp(FaceOp::Abs, r[in.a], 0.0f); break;
+            case FaceOp::Neg: r[in.dst] = applyOp(FaceOp::Neg, r[in.a], 0.0f); break;
+            case FaceOp::Less: r[in.dst] = applyOp(FaceOp::Less, r[in.a], r[in.b]); break;
+            case FaceOp::LessEqual: r[in.dst] = applyOp(FaceOp::LessEqual, r[in.a], r[in.b]); break;
+            case FaceOp::Greater: r[in.dst] = applyOp(FaceOp::Greater, r[in.a], r[in.b]); break;
+            case FaceOp::GreaterEqual: r[in.dst] = applyOp(FaceOp::GreaterEqual, r[in.a], r[in.b]); break;
+            case FaceOp::Equal: r[in.dst] = applyOp(FaceOp::Equal, r[in.a], r[in.b]); break;
+            case FaceOp::NotEqual: r[in.dst] = applyOp(FaceOp::NotEqual, r[in.a], r[in.b]); break;
+            case FaceOp::SkipIfZero:
+                if (r[in.a] == 0.0f) pc += in.b;
+                break;
+            case FaceOp::SkipUnlessLess:
+                if (!(r[in.a] < r[in.b])) pc += in.dst;
+                break;
+            case FaceOp::SkipUnlessLessEqual:
+                if (!(r[in.a] <= r[in.b])) pc += in.dst;
+                break;
+            case FaceOp::BeginGroup: {
+                const uint32_t key = m_hash ^ (static_cast<uint32_t>(r[5]) << 12) ^ static_cast<uint32_t>(r[6]);
+                if (!canvas.beginGroup(key)) pc += in.b;
+                break;
+            }
+            case FaceOp::EndGroup:
+                canvas.endGroup();
+                break;
+            case FaceOp::Clear:
+                canvas.clear(colors[in.a]);
+                break;
+            case FaceOp::Circle:
+                canvas.circle(Point2{r[o[0]], r[o[1]]}, r[o[2]], colors[in.a]);
+                break;
+            case FaceOp::Ring:
+                canvas.ring(Point2{r[o[0]], r[o[1]]}, r[o[2]], r[o[3]], colors[in.a]);
+                break;
+            case FaceOp::Quad:
+                strokeCurve(canvas, m_curves[in.b], r, o, colors[in.a]);
+                break;
+            case FaceOp::Text:
+                canvas.text(m_strings.data() + in.b, Point2{r[o[0]], r[o[1]]}, r[o[2]], colors[in.a]);
+                break;
+        }
+    }
+}
+
+} // namespace robotface
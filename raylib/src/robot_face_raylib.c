@@ -15,12 +15,23 @@
  *   - Mouse Click: Trigger blink
  *   - ESC: Exit
  *
+ *   Usage:
+ *     robot_face_raylib [--scenario frames]   # Scripted input, uncapped, prints frame time
+ *     robot_face_raylib --startup             # Print the cold start timeline and exit
+ *
  *******************************************************************************************/
 
 #include "raylib.h"
+#include "robot_face_blink.h"
+#include "robot_face_scenario.h"
+#include "robot_face_startup.h"
 #include <math.h>
 #include <stdio.h>
 
+#if defined(PLATFORM_WEB)
+#include <emscripten/emscripten.h>
+#endif
+
 // Robot face state structure
 typedef struct {
     float happiness;         // 0.0 (sad) to 1.0 (happy)
@@ -42,11 +53,8 @@ void InitRobotFace(RobotFace* face) {
 // Update robot face state (animations)
 void UpdateRobotFace(RobotFace* face, float deltaTime) {
     // Update blink timer for automatic blinking (every 3 seconds)
-    face->blink_timer += deltaTime;
-
-    if (face->blink_timer >= 3.0 && !face->is_blinking) {
+    if (RobotFaceAdvanceBlinkTimer(&face->blink_timer, deltaTime, 3.0, face->is_blinking)) {
         face->is_blinking = true;
-        face->blink_timer = 0.0;
     }
 
     // Animate blink
@@ -162,50 +170,122 @@ void TriggerBlink(RobotFace* face) {
 }
 
 //------------------------------------------------------------------------------------
-// Main entry point
+// Main loop
 //------------------------------------------------------------------------------------
-int main(void) {
-    // Initialization
-    const int screenWidth = 800;
-    const int screenHeight = 600;
-
-    InitWindow(screenWidth, screenHeight, "Robot Face - Raylib");
-    SetTargetFPS(60);
 
+// Everything a frame needs: on the web main() returns to the browser before the first one
+typedef struct {
+    RobotFaceStartup startup;
+    RobotFaceScenario scenario;
     RobotFace face;
-    InitRobotFace(&face);
-
-    // Main game loop
-    while (!WindowShouldClose()) {
-        // Update
-        float deltaTime = GetFrameTime();
-        UpdateRobotFace(&face, deltaTime);
+    int screenWidth;
+    int screenHeight;
+    int framesPresented;
+    bool done;               // Scenario finished, or --startup printed its timeline
+} RobotFaceApp;
+
+// One frame: input, update, draw, present
+static void UpdateDrawFrame(void* arg) {
+    RobotFaceApp* app = (RobotFaceApp*)arg;
+    RobotFace* face = &app->face;
+#if defined(PLATFORM_WEB)
+    if (app->done) {   // No loop to leave: stop being called
+        RobotFaceScenarioReport(&app->scenario, "robot_face_raylib");
+        emscripten_cancel_main_loop();
+        return;
+    }
+#endif
+
+    // Update
+    float deltaTime = GetFrameTime();
+    RobotFaceScenarioInput scripted = {0};
+    if (app->scenario.frames > 0) {
+        if (!RobotFaceScenarioNext(&app->scenario, &scripted)) {
+            app->done = true;
+            return;
+        }
+        deltaTime = scripted.deltaTime;
+    }
+    UpdateRobotFace(face, deltaTime);
 
+    bool hovering = scripted.hover;
+    if (app->scenario.frames > 0) {
+        if (scripted.happiness >= 0.0f) SetEmotion(face, scripted.happiness);
+        if (scripted.blink) TriggerBlink(face);
+    } else {
         // Keyboard controls
-        if (IsKeyPressed(KEY_H)) SetEmotion(&face, 1.0f);  // Happy
-        if (IsKeyPressed(KEY_N)) SetEmotion(&face, 0.5f);  // Neutral
-        if (IsKeyPressed(KEY_S)) SetEmotion(&face, 0.0f);  // Sad
+        if (IsKeyPressed(KEY_H)) SetEmotion(face, 1.0f);  // Happy
+        if (IsKeyPressed(KEY_N)) SetEmotion(face, 0.5f);  // Neutral
+        if (IsKeyPressed(KEY_S)) SetEmotion(face, 0.0f);  // Sad
 
         // Mouse controls
         if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
-            TriggerBlink(&face);
+            TriggerBlink(face);
         }
 
-        // Mouse hover effect (wider smile when hovering over mouth area)
         Vector2 mousePos = GetMousePosition();
-        if (mousePos.x > 300 && mousePos.x < 500 && mousePos.y > 350 && mousePos.y < 450) {
-            // Gradually increase happiness when hovering
-            face.happiness = fminf(face.happiness + deltaTime * 0.5f, 1.0f);
-        }
+        hovering = mousePos.x > 300 && mousePos.x < 500 && mousePos.y > 350 && mousePos.y < 450;
+    }
+
+    // Mouse hover effect (wider smile when hovering over mouth area)
+    if (hovering) {
+        // Gradually increase happiness when hovering
+        face->happiness = fminf(face->happiness + deltaTime * 0.5f, 1.0f);
+    }
 
-        // Draw
-        BeginDrawing();
-        DrawRobotFace(&face, screenWidth, screenHeight);
-        EndDrawing();
+    // Draw
+    BeginDrawing();
+    DrawRobotFace(face, app->screenWidth, app->screenHeight);
+    if (app->framesPresented == 0) RobotFaceStartupMark(&app->startup, "first-draw");
+    EndDrawing();
+
+    // Cold start timeline (--startup exits after the second frame)
+    if (app->framesPresented < 2 && ++app->framesPresented == 1) {
+        RobotFaceStartupMark(&app->startup, "present");
+        RobotFaceStartupFirstFrame(&app->startup);
+    } else if (app->framesPresented == 2) {
+        RobotFaceStartupMark(&app->startup, "deferred");
+        RobotFaceStartupReport(&app->startup);
+        app->framesPresented++;
+        if (app->startup.enabled) app->done = true;
     }
+}
+
+//------------------------------------------------------------------------------------
+// Main entry point
+//------------------------------------------------------------------------------------
+int main(int argc, char** argv) {
+    static RobotFaceApp app;   // Static: outlives main() on the web
+    RobotFaceStartupBegin(&app.startup, argc, argv);
+
+    // Scripted input with --scenario N (profile training, frame timing)
+    RobotFaceScenarioInit(&app.scenario, argc, argv);
+
+    // Initialization
+    app.screenWidth = 800;
+    app.screenHeight = 600;
+
+    InitWindow(app.screenWidth, app.screenHeight, "Robot Face - Raylib");
+    RobotFaceStartupMark(&app.startup, "window");   // Window, GL context, default font
+
+    InitRobotFace(&app.face);
+    RobotFaceStartupMark(&app.startup, "face-init");
+
+#if defined(PLATFORM_WEB)
+    // The browser calls the frame on requestAnimationFrame and main() returns to it. A
+    // blocking loop would need ASYNCIFY to yield inside WindowShouldClose / EndDrawing.
+    emscripten_set_main_loop_arg(UpdateDrawFrame, &app, 0, 1);
+#else
+    SetTargetFPS(app.scenario.frames > 0 ? 0 : 60);
+    while (!app.done && !WindowShouldClose()) {
+        UpdateDrawFrame(&app);
+    }
+#endif
 
     // De-Initialization
     CloseWindow();
 
+    RobotFaceScenarioReport(&app.scenario, "robot_face_raylib");
+
     return 0;
 }
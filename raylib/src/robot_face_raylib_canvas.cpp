@@ -0,0 +1,487 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Raylib Canvas Backend Implementation
+ *
+ *******************************************************************************************/
+
+#include "robot_face_raylib_canvas.hpp"
+#include "rlgl.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace robotface {
+
+namespace {
+
+// raylib 5.x tessellation (shapes.c / rlgl.h defaults)
+constexpr uint32_t kCircleSegments = 36;               // DrawCircle, DrawCircleLines
+constexpr uint32_t kBatchVertexCapacity = 8192 * 4;    // RL_DEFAULT_BATCH_BUFFER_ELEMENTS quads
+constexpr float kSmoothCircleErrorRate = 0.5f;         // SMOOTH_CIRCLE_ERROR_RATE
+constexpr size_t kGlyphsPerBatchCheck = 1024;          // Quads submitted between rlCheckRenderBatchLimit calls
+
+// Edge of the distance field: threshold at 0.5, antialiased over about one screen pixel
+// whatever the glyph size (the default vertex shader passes texcoord and color through)
+#if defined(PLATFORM_WEB) || defined(GRAPHICS_API_OPENGL_ES2)
+constexpr const char* kSdfFragmentShader = R"(#version 100
+#extension GL_OES_standard_derivatives : enable
+precision mediump float;
+varying vec2 fragTexCoord;
+varying vec4 fragColor;
+uniform sampler2D texture0;
+void main() {
+    float distance = texture2D(texture0, fragTexCoord).r;
+    float smoothing = 0.7 * fwidth(distance);
+    float alpha = smoothstep(0.5 - smoothing, 0.5 + smoothing, distance);
+    gl_FragColor = vec4(fragColor.rgb, fragColor.a * alpha);
+}
+)";
+#else
+constexpr const char* kSdfFragmentShader = R"(#version 330
+in vec2 fragTexCoord;
+in vec4 fragColor;
+uniform sampler2D texture0;
+out vec4 finalColor;
+void main() {
+    float distance = texture(texture0, fragTexCoord).r;
+    float smoothing = 0.7 * fwidth(distance);
+    float alpha = smoothstep(0.5 - smoothing, 0.5 + smoothing, distance);
+    finalColor = vec4(fragColor.rgb, fragColor.a * alpha);
+}
+)";
+#endif
+
+// Segment count DrawRing picks for a full ring when passed 0 segments
+uint32_t ringSegments(float outerRadius) noexcept {
+    const float rate = 1.0f - kSmoothCircleErrorRate / outerRadius;
+    const float th = std::acos(2.0f * rate * rate - 1.0f);
+    const int segments = static_cast<int>(std::ceil(2.0f * PI / th));
+    return segments > 0 ? static_cast<uint32_t>(segments) : 4u;
+}
+
+} // namespace
+
+// RaylibLayerCache
+RaylibLayerCache::~RaylibLayerCache() {
+    unload();
+}
+
+RaylibLayerCache::RaylibLayerCache(RaylibLayerCache&& other) noexcept
+    : m_target(other.m_target)
+    , m_key(other.m_key)
+    , m_valid(other.m_valid)
+    , m_enabled(other.m_enabled)
+{
+    other.m_target = RenderTexture2D{};
+    other.m_valid = false;
+}
+
+RaylibLayerCache& RaylibLayerCache::operator=(RaylibLayerCache&& other) noexcept {
+    if (this != &other) {
+        unload();
+        m_target = std::exchange(other.m_target, RenderTexture2D{});
+        m_key = other.m_key;
+        m_valid = std::exchange(other.m_valid, false);
+        m_enabled = other.m_enabled;
+    }
+    return *this;
+}
+
+// After CloseWindow the context (and the texture with it) is already gone
+void RaylibLayerCache::unload() {
+    if (m_target.id != 0 && IsWindowReady()) {
+        UnloadRenderTexture(m_target);
+    }
+    m_target = RenderTexture2D{};
+    m_valid = false;
+}
+
+void RaylibLayerCache::setEnabled(bool enabled) {
+    m_enabled = enabled;
+    if (!enabled) unload();
+}
+
+// RaylibSpriteCache
+RaylibSpriteCache::~RaylibSpriteCache() {
+    unload();
+}
+
+RaylibSpriteCache::RaylibSpriteCache(RaylibSpriteCache&& other) noexcept {
+    for (int i = 0; i < kMaxSprites; i++) {
+        m_slots[i] = std::exchange(other.m_slots[i], Slot{});
+    }
+}
+
+RaylibSpriteCache& RaylibSpriteCache::operator=(RaylibSpriteCache&& other) noexcept {
+    if (this != &other) {
+        unload();
+        for (int i = 0; i < kMaxSprites; i++) {
+            m_slots[i] = std::exchange(other.m_slots[i], Slot{});
+        }
+    }
+    return *this;
+}
+
+void RaylibSpriteCache::invalidate() noexcept {
+    for (Slot& slot : m_slots) slot.valid = false;
+}
+
+void RaylibSpriteCache::unload() {
+    for (Slot& slot : m_slots) {
+        if (slot.target.id != 0 && IsWindowReady()) {
+            UnloadRenderTexture(slot.target);
+        }
+        slot = Slot{};
+    }
+}
+
+RaylibSpriteCache::Slot* RaylibSpriteCache::find(uint32_t key) noexcept {
+    for (Slot& slot : m_slots) {
+        if (slot.target.id != 0 && slot.key == key) return &slot;
+    }
+    return nullptr;
+}
+
+RaylibSpriteCache::Slot* RaylibSpriteCache::acquire(uint32_t key, int size) {
+    Slot* slot = find(key);
+    if (slot && slot->target.texture.width != size) {
+        UnloadRenderTexture(slot->target);
+        *slot = Slot{};
+        slot = nullptr;
+    }
+    for (int i = 0; !slot && i < kMaxSprites; i++) {
+        if (m_slots[i].target.id == 0) slot = &m_slots[i];
+    }
+    if (!slot) return nullptr;
+
+    if (slot->target.id == 0) {
+        slot->target = LoadRenderTexture(size, size);
+        if (slot->target.id == 0) return nullptr;
+        SetTextureFilter(slot->target.texture, TEXTURE_FILTER_BILINEAR);   // Drawn scaled
+    }
+    slot->key = key;
+    slot->valid = false;
+    return slot;
+}
+
+// RaylibScaledTarget
+RaylibScaledTarget::~RaylibScaledTarget() {
+    unload();
+}
+
+RaylibScaledTarget::RaylibScaledTarget(RaylibScaledTarget&& other) noexcept
+    : m_target(std::exchange(other.m_target, RenderTexture2D{}))
+    , m_width(other.m_width)
+    , m_height(other.m_height)
+{
+}
+
+RaylibScaledTarget& RaylibScaledTarget::operator=(RaylibScaledTarget&& other) noexcept {
+    if (this != &other) {
+        unload();
+        m_target = std::exchange(other.m_target, RenderTexture2D{});
+        m_width = other.m_width;
+        m_height = other.m_height;
+    }
+    return *this;
+}
+
+void RaylibScaledTarget::unload() {
+    if (m_target.id != 0 && IsWindowReady()) {
+        UnloadRenderTexture(m_target);
+    }
+    m_target = RenderTexture2D{};
+}
+
+bool RaylibScaledTarget::begin(int width, int height, float scale) {
+    const int targetWidth = static_cast<int>(static_cast<float>(width) * scale);
+    const int targetHeight = static_cast<int>(static_cast<float>(height) * scale);
+    if (targetWidth <= 0 || targetHeight <= 0) return false;
+
+    if (m_target.id == 0 || m_target.texture.width != targetWidth || m_target.texture.height != targetHeight) {
+        unload();
+        m_target = LoadRenderTexture(targetWidth, targetHeight);
+        if (m_target.id == 0) return false;
+        SetTextureFilter(m_target.texture, TEXTURE_FILTER_BILINEAR);
+    }
+
+    m_width = width;
+    m_height = height;
+    BeginTextureMode(m_target);
+    BeginMode2D(Camera2D{Vector2{0.0f, 0.0f}, Vector2{0.0f, 0.0f}, 0.0f, scale});
+    m_active = true;
+    return true;
+}
+
+// Upscale: one textured quad over the window (render textures are stored bottom-up)
+void RaylibScaledTarget::end(FrameStats* stats) {
+    if (!m_active) return;
+
+    EndMode2D();
+    EndTextureMode();
+    m_active = false;
+
+    const Texture2D& texture = m_target.texture;
+    DrawTexturePro(texture, Rectangle{0.0f, 0.0f, static_cast<float>(texture.width), -static_cast<float>(texture.height)},
+                   Rectangle{0.0f, 0.0f, static_cast<float>(m_width), static_cast<float>(m_height)},
+                   Vector2{0.0f, 0.0f}, 0.0f, WHITE);
+    if (stats) {
+        stats->drawCalls++;
+        stats->vertices += 4;
+        stats->triangles += 2;
+        stats->batchFlushes += 2;   // EndTextureMode, plus the switch back to the window
+        stats->stateChanges++;
+    }
+}
+
+// RaylibSdfText
+RaylibSdfText::~RaylibSdfText() {
+    unload();
+}
+
+RaylibSdfText::RaylibSdfText(RaylibSdfText&& other) noexcept
+    : m_font(std::exchange(other.m_font, nullptr))
+    , m_atlas(std::exchange(other.m_atlas, Texture2D{}))
+    , m_shader(std::exchange(other.m_shader, Shader{}))
+    , m_batch(std::move(other.m_batch))
+{
+}
+
+RaylibSdfText& RaylibSdfText::operator=(RaylibSdfText&& other) noexcept {
+    if (this != &other) {
+        unload();
+        m_font = std::exchange(other.m_font, nullptr);
+        m_atlas = std::exchange(other.m_atlas, Texture2D{});
+        m_shader = std::exchange(other.m_shader, Shader{});
+        m_batch = std::move(other.m_batch);
+    }
+    return *this;
+}
+
+// A failed shader compile leaves raylib's default shader: no edge, so no SDF text
+bool RaylibSdfText::load(const SdfFont& font) {
+    unload();
+    m_font = &font;
+    if (!font.loaded()) return false;
+
+    // raylib only reads Image::data to upload it: no copy of the blob
+    const Image image{const_cast<uint8_t*>(font.pixels()), font.width(), font.height(), 1,
+                      PIXELFORMAT_UNCOMPRESSED_GRAYSCALE};
+    m_atlas = LoadTextureFromImage(image);
+    if (m_atlas.id == 0) return false;
+    SetTextureFilter(m_atlas, TEXTURE_FILTER_BILINEAR);
+
+    m_shader = LoadShaderFromMemory(nullptr, kSdfFragmentShader);
+    if (m_shader.id == 0 || m_shader.id == rlGetShaderIdDefault()) {
+        unload();
+        m_font = &font;
+        return false;
+    }
+    return true;
+}
+
+void RaylibSdfText::unload() {
+    if (m_atlas.id != 0 && IsWindowReady()) {
+        UnloadTexture(m_atlas);
+        UnloadShader(m_shader);
+    }
+    m_atlas = Texture2D{};
+    m_shader = Shader{};
+    m_font = nullptr;
+    m_batch.clear();
+}
+
+// Quads in raylib's DrawTexturePro order (top-left, bottom-left, bottom-right, top-right)
+void RaylibSdfText::flush() {
+    const std::vector<TextQuad>& quads = m_batch.quads();
+    BeginShaderMode(m_shader);
+    for (size_t first = 0; first < quads.size(); first += kGlyphsPerBatchCheck) {
+        const size_t last = std::min(quads.size(), first + kGlyphsPerBatchCheck);
+        rlCheckRenderBatchLimit(static_cast<int>(last - first) * 4);
+        rlSetTexture(m_atlas.id);
+        rlBegin(RL_QUADS);
+        for (size_t i = first; i < last; i++) {
+            const TextQuad& q = quads[i];
+            rlColor4ub(q.color.r, q.color.g, q.color.b, q.color.a);
+            rlTexCoord2f(q.u0, q.v0);
+            rlVertex2f(q.x0, q.y0);
+            rlTexCoord2f(q.u0, q.v1);
+            rlVertex2f(q.x0, q.y1);
+            rlTexCoord2f(q.u1, q.v1);
+            rlVertex2f(q.x1, q.y1);
+            rlTexCoord2f(q.u1, q.v0);
+            rlVertex2f(q.x1, q.y0);
+        }
+        rlEnd();
+    }
+    rlSetTexture(0);
+    EndShaderMode();
+    m_batch.clear();
+}
+
+// glClear, outside the batch
+void RaylibCanvas::clear(Rgba color) {
+    ClearBackground(toColor(color));
+    if (m_stats) m_stats->drawCalls++;
+}
+
+// Integer centers match the original DrawCircle calls pixel for pixel
+void RaylibCanvas::circle(Point2 center, float radius, Rgba color) {
+    DrawCircle(static_cast<int>(center.x), static_cast<int>(center.y), radius, toColor(color));
+    countDraw(BatchState::Quads, kCircleSegments / 2 * 4, kCircleSegments);   // Two sectors per quad
+}
+
+void RaylibCanvas::ring(Point2 center, float radius, float thickness, Rgba color) {
+    if (thickness <= 1.0f) {
+        DrawCircleLines(static_cast<int>(center.x), static_cast<int>(center.y), radius, toColor(color));
+        countDraw(BatchState::Lines, kCircleSegments * 2, 0);
+    } else {
+        const float half = thickness * 0.5f;
+        DrawRing(Vector2{center.x, center.y}, radius - half, radius + half, 0.0f, 360.0f, 0, toColor(color));
+        const uint32_t segments = ringSegments(radius + half);
+        countDraw(BatchState::Quads, segments * 4, segments * 2);
+    }
+}
+
+// One DrawLineEx per segment (same output as the original mouth loop)
+void RaylibCanvas::strokePath(const Point2* points, int count, float width, Rgba color) {
+    for (int i = 0; i + 1 < count; i++) {
+        DrawLineEx(Vector2{points[i].x, points[i].y}, Vector2{points[i + 1].x, points[i + 1].y},
+                   width, toColor(color));
+        countDraw(BatchState::Triangles, 6, 2);   // Two-triangle strip
+    }
+}
+
+// SDF: queued for flushText() / endGroup(). Otherwise one textured quad per glyph from the
+// default font atlas.
+void RaylibCanvas::text(const char* text, Point2 topLeft, float size, Rgba color) {
+    if (m_text && m_text->ready()) {
+        const uint32_t glyphs = m_text->m_batch.add(*m_text->m_font, text, topLeft, size, color);
+        if (m_stats) m_stats->glyphs += glyphs;
+        return;
+    }
+
+    DrawText(text, static_cast<int>(topLeft.x), static_cast<int>(topLeft.y), static_cast<int>(size), toColor(color));
+    if (!m_stats) return;
+
+    const uint32_t glyphs = countGlyphs(text);
+    countDraw(BatchState::FontTexture, glyphs * 4, glyphs * 2);
+    m_stats->glyphs += glyphs;
+}
+
+// One draw for all queued glyphs; the shader switch flushes the batch before and after
+void RaylibCanvas::flushText() {
+    if (!m_text || m_text->m_batch.empty()) return;
+
+    const uint32_t glyphs = m_text->m_batch.glyphCount();
+    countFlush();
+    m_text->flush();
+    countDraw(BatchState::SdfText, glyphs * 4, glyphs * 2);
+    countFlush();
+}
+
+void RaylibCanvas::countDraw(BatchState state, uint32_t vertices, uint32_t triangles) noexcept {
+    if (!m_stats) return;
+
+    m_stats->drawCalls++;
+    if (m_batchVertices + vertices >= kBatchVertexCapacity) countFlush();   // rlCheckRenderBatchLimit
+    if (state != m_batchState) {
+        m_stats->stateChanges++;
+        m_batchState = state;
+    }
+    m_stats->vertices += vertices;
+    m_stats->triangles += triangles;
+    m_batchVertices += vertices;
+}
+
+void RaylibCanvas::countFlush() noexcept {
+    if (!m_stats) return;
+
+    m_stats->batchFlushes++;
+    m_batchState = BatchState::None;
+    m_batchVertices = 0;
+}
+
+// Cache hit: one textured quad, group content skipped. Miss: record into the target.
+bool RaylibCanvas::beginGroup(uint32_t key) {
+    if (!m_cache || !m_cache->m_enabled || m_width <= 0 || m_height <= 0) return true;
+
+    if (m_cache->m_valid && m_cache->m_key == key) {
+        drawCachedLayer();
+        return false;
+    }
+
+    // New key (resize) or first use: (re)create the target at the group's size
+    if (m_cache->m_target.id == 0 || m_cache->m_key != key) {
+        m_cache->unload();
+        m_cache->m_target = LoadRenderTexture(m_width, m_height);
+        if (m_cache->m_target.id == 0) return true;   // No framebuffer support: draw directly
+    }
+
+    m_cache->m_key = key;
+    BeginTextureMode(m_cache->m_target);
+    countFlush();
+    m_recording = true;
+    return true;
+}
+
+// The group's text is drawn with it (into the cached layer, or below later shapes)
+void RaylibCanvas::endGroup() {
+    flushText();
+    if (!m_recording) return;
+
+    EndTextureMode();
+    countFlush();
+    m_recording = false;
+    m_cache->m_valid = true;
+    drawCachedLayer();
+}
+
+// Miss: record the sprite's shapes into its own target. Hit (or no cache): nothing to draw.
+bool RaylibCanvas::beginSprite(uint32_t key, int size) {
+    if (!m_sprites || m_recording || m_recordingSprite || size <= 0) return false;
+
+    RaylibSpriteCache::Slot* slot = m_sprites->find(key);
+    if (slot && slot->valid && slot->target.texture.width == size) return false;
+
+    slot = m_sprites->acquire(key, size);
+    if (!slot) return false;
+
+    BeginTextureMode(slot->target);
+    ClearBackground(BLANK);
+    countFlush();
+    m_recordingSprite = slot;
+    return true;
+}
+
+void RaylibCanvas::endSprite() {
+    if (!m_recordingSprite) return;
+
+    EndTextureMode();
+    countFlush();
+    m_recordingSprite->valid = true;
+    m_recordingSprite = nullptr;
+}
+
+bool RaylibCanvas::sprite(uint32_t key, Point2 center, float scale) {
+    if (!m_sprites) return false;
+    const RaylibSpriteCache::Slot* slot = m_sprites->find(key);
+    if (!slot || !slot->valid) return false;
+
+    const Texture2D& texture = slot->target.texture;
+    const float size = static_cast<float>(texture.width) * scale;
+    DrawTexturePro(texture, Rectangle{0.0f, 0.0f, static_cast<float>(texture.width), -static_cast<float>(texture.height)},
+                   Rectangle{center.x - size * 0.5f, center.y - size * 0.5f, size, size}, Vector2{0.0f, 0.0f}, 0.0f, WHITE);
+    countDraw(BatchState::SpriteTexture, 4, 2);
+    return true;
+}
+
+// Render textures are stored bottom-up: flip with a negative source height
+void RaylibCanvas::drawCachedLayer() {
+    const Texture2D& texture = m_cache->m_target.texture;
+    DrawTextureRec(texture, Rectangle{0.0f, 0.0f, static_cast<float>(texture.width), -static_cast<float>(texture.height)},
+                   Vector2{0.0f, 0.0f}, WHITE);
+    countDraw(BatchState::LayerTexture, 4, 2);
+}
+
+} // namespace robotface
@@ -0,0 +1,299 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Remote Rendering Protocol Implementation
+ *
+ *******************************************************************************************/
+
+#include "robot_face_remote.hpp"
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0  // macOS: SIGPIPE is disabled per socket below
+#endif
+
+namespace robotface {
+namespace remote {
+
+namespace {
+
+// Gaps shorter than this are sent as part of one patch (cheaper than a new patch header)
+constexpr size_t kPatchMergeGap = 8;
+constexpr size_t kPatchHeaderBytes = 6;
+
+template <typename T>
+void append(std::vector<uint8_t>& out, const T& value) {
+    const size_t at = out.size();
+    out.resize(at + sizeof(T));
+    std::memcpy(out.data() + at, &value, sizeof(T));
+}
+
+template <typename T>
+bool readValue(const uint8_t*& p, const uint8_t* end, T& value) {
+    if (static_cast<size_t>(end - p) < sizeof(T)) return false;
+    std::memcpy(&value, p, sizeof(T));
+    p += sizeof(T);
+    return true;
+}
+
+bool fillSockaddr(const char* path, sockaddr_un& addr) {
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (std::strlen(path) >= sizeof(addr.sun_path)) return false;
+    std::strcpy(addr.sun_path, path);
+    return true;
+}
+
+void disableSigpipe(int fd) {
+#ifdef SO_NOSIGPIPE
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#else
+    (void)fd;
+#endif
+}
+
+} // namespace
+
+uint64_t monotonicNs() noexcept {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+int listenUnix(const char* path) {
+    sockaddr_un addr;
+    if (!fillSockaddr(path, addr)) return -1;
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+
+    unlink(path);
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(fd, 8) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    return fd;
+}
+
+int acceptClient(int listenFd) {
+    int fd = accept(listenFd, nullptr, nullptr);
+    if (fd < 0) return -1;
+
+    // Client sockets stay blocking on the server: a frame is written whole or the client is dropped
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+    disableSigpipe(fd);
+    return fd;
+}
+
+int connectUnix(const char* path) {
+    sockaddr_un addr;
+    if (!fillSockaddr(path, addr)) return -1;
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    return fd;
+}
+
+void closeSocket(int fd) {
+    if (fd >= 0) close(fd);
+}
+
+size_t sendMessage(int fd, MessageType type, uint32_t frameId, const void* payload, size_t size) {
+    if (size > kMaxPayloadBytes) return 0;
+
+    MessageHeader header{};
+    header.type = static_cast<uint8_t>(type);
+    header.size = static_cast<uint32_t>(size);
+    header.frameId = frameId;
+    header.sentNs = monotonicNs();
+
+    const uint8_t* parts[2] = {reinterpret_cast<const uint8_t*>(&header), static_cast<const uint8_t*>(payload)};
+    size_t lengths[2] = {sizeof(header), size};
+
+    for (int i = 0; i < 2; i++) {
+        size_t sent = 0;
+        while (sent < lengths[i]) {
+            ssize_t n = send(fd, parts[i] + sent, lengths[i] - sent, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return 0;
+            sent += static_cast<size_t>(n);
+        }
+    }
+
+    return sizeof(header) + size;
+}
+
+void encodeDefineList(uint32_t key, const DisplayList& list, std::vector<uint8_t>& out) {
+    out.clear();
+    append(out, key);
+    append(out, list.opCount());
+    out.insert(out.end(), list.data(), list.data() + list.size());
+}
+
+void encodeFrame(const DisplayList& frame, std::vector<uint8_t>& out) {
+    out.clear();
+    append(out, frame.opCount());
+    out.insert(out.end(), frame.data(), frame.data() + frame.size());
+}
+
+// Byte-range patches against the previous frame (ops rarely change size between frames)
+void encodeFrameDelta(const DisplayList& previous, const DisplayList& next, std::vector<uint8_t>& out) {
+    out.clear();
+    append(out, next.opCount());
+    append(out, static_cast<uint32_t>(next.size()));
+    const size_t countOffset = out.size();
+    append(out, uint16_t{0});
+
+    const uint8_t* a = previous.data();
+    const uint8_t* b = next.data();
+    const size_t common = (previous.size() < next.size()) ? previous.size() : next.size();
+    uint16_t patchCount = 0;
+    size_t i = 0;
+
+    auto emit = [&](size_t begin, size_t end) {
+        while (begin < end) {
+            const size_t length = (end - begin > 0xFFFF) ? 0xFFFF : end - begin;
+            append(out, static_cast<uint32_t>(begin));
+            append(out, static_cast<uint16_t>(length));
+            out.insert(out.end(), b + begin, b + begin + length);
+            patchCount++;
+            begin += length;
+        }
+    };
+
+    while (i < common) {
+        if (a[i] == b[i]) {
+            i++;
+            continue;
+        }
+
+        // Extend the patch until kPatchMergeGap equal bytes in a row
+        size_t begin = i;
+        size_t end = i + 1;
+        size_t j = end;
+        while (j < common && j - end < kPatchMergeGap) {
+            if (a[j] != b[j]) end = j + 1;
+            j++;
+        }
+        emit(begin, end);
+        i = end;
+    }
+
+    // Appended tail (truncation is implied by newSize)
+    if (next.size() > common) emit(common, next.size());
+
+    std::memcpy(out.data() + countOffset, &patchCount, sizeof(patchCount));
+
+    // A single full-size patch is smaller when nearly everything changed
+    if (out.size() > next.size() + kPatchHeaderBytes * (next.size() / 0xFFFF + 1) + countOffset + 2) {
+        out.resize(countOffset + sizeof(uint16_t));
+        patchCount = 0;
+        emit(0, next.size());
+        std::memcpy(out.data() + countOffset, &patchCount, sizeof(patchCount));
+    }
+}
+
+bool applyDefineList(const uint8_t* payload, size_t size, DisplayListLibrary& library) {
+    const uint8_t* p = payload;
+    const uint8_t* end = payload + size;
+    uint32_t key = 0;
+    uint32_t opCount = 0;
+    if (!readValue(p, end, key) || !readValue(p, end, opCount)) return false;
+
+    library.insert(key).assign(p, static_cast<size_t>(end - p), opCount);
+    return true;
+}
+
+bool applyFrame(const uint8_t* payload, size_t size, DisplayList& frame) {
+    const uint8_t* p = payload;
+    const uint8_t* end = payload + size;
+    uint32_t opCount = 0;
+    if (!readValue(p, end, opCount)) return false;
+
+    frame.assign(p, static_cast<size_t>(end - p), opCount);
+    return true;
+}
+
+bool applyFrameDelta(const uint8_t* payload, size_t size, DisplayList& frame) {
+    const uint8_t* p = payload;
+    const uint8_t* end = payload + size;
+    uint32_t opCount = 0;
+    uint32_t newSize = 0;
+    uint16_t patchCount = 0;
+    if (!readValue(p, end, opCount) || !readValue(p, end, newSize) || !readValue(p, end, patchCount)) return false;
+    if (newSize > kMaxPayloadBytes) return false;
+
+    frame.resize(newSize, opCount);
+    for (uint16_t i = 0; i < patchCount; i++) {
+        uint32_t offset = 0;
+        uint16_t length = 0;
+        if (!readValue(p, end, offset) || !readValue(p, end, length)) return false;
+        if (static_cast<size_t>(end - p) < length || !frame.patch(offset, p, length)) return false;
+        p += length;
+    }
+
+    return p == end;
+}
+
+bool MessageReader::poll() {
+    // Drop consumed bytes before reading more
+    if (m_consumed > 0) {
+        m_buffer.erase(m_buffer.begin(), m_buffer.begin() + static_cast<std::ptrdiff_t>(m_consumed));
+        m_consumed = 0;
+    }
+
+    // One message fits whole; the rest stays in the socket until next() has drained the buffer
+    uint8_t chunk[16384];
+    for (;;) {
+        if (pendingTooLarge()) return false;
+        if (m_buffer.size() >= sizeof(MessageHeader) + kMaxPayloadBytes) return true;
+
+        ssize_t n = recv(m_fd, chunk, sizeof(chunk), 0);
+        if (n > 0) {
+            m_buffer.insert(m_buffer.end(), chunk, chunk + n);
+            m_bytesReceived += static_cast<uint64_t>(n);
+            continue;
+        }
+        if (n == 0) return false;
+        if (errno == EINTR) continue;
+        return errno == EAGAIN || errno == EWOULDBLOCK;
+    }
+}
+
+// The next message announces more than the protocol allows (a broken or hostile peer)
+bool MessageReader::pendingTooLarge() const noexcept {
+    if (m_buffer.size() - m_consumed < sizeof(MessageHeader)) return false;
+    MessageHeader header;
+    std::memcpy(&header, m_buffer.data() + m_consumed, sizeof(header));
+    return header.size > kMaxPayloadBytes;
+}
+
+bool MessageReader::next(MessageHeader& header, const uint8_t*& payload) {
+    const size_t available = m_buffer.size() - m_consumed;
+    if (available < sizeof(MessageHeader)) return false;
+
+    std::memcpy(&header, m_buffer.data() + m_consumed, sizeof(header));
+    if (header.size > kMaxPayloadBytes || available < sizeof(MessageHeader) + header.size) return false;
+
+    payload = m_buffer.data() + m_consumed + sizeof(MessageHeader);
+    m_consumed += sizeof(MessageHeader) + header.size;
+    return true;
+}
+
+} // namespace remote
+} // namespace robotface
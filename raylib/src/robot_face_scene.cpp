@@ -0,0 +1,255 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Multi-Face Scene Implementation
+ *
+ *******************************************************************************************/
+
+#include "robot_face_scene.hpp"
+#include "robot_face_tables.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace robotface {
+
+namespace {
+
+// Keyframe track at `time` (same segment rules as AnimationEngine)
+float sampleScript(const Keyframe* keys, size_t count, float time) noexcept {
+    if (time <= keys[0].time) return keys[0].value;
+    for (size_t i = 1; i < count; i++) {
+        if (time < keys[i].time) {
+            const Keyframe& from = keys[i - 1];
+            const Keyframe& to = keys[i];
+            const float t = (time - from.time) / std::max(to.time - from.time, 1e-6f);
+            return from.value + (to.value - from.value) * applyEase(from.ease, t);
+        }
+    }
+    return keys[count - 1].value;
+}
+
+} // namespace
+
+FaceScene::FaceScene(size_t capacity, size_t outputCount)
+    : m_capacity(capacity)
+    , m_gaze(capacity)
+    , m_outputOffset(std::max<size_t>(outputCount, 1) + 1, 0)
+    , m_outputCursor(m_outputOffset.size() - 1, 0)
+{
+    m_styles.push_back(FaceStyle{});
+
+    // About two buckets per face keeps the cells of a bucket few
+    const size_t outputs = m_outputOffset.size() - 1;
+    m_hitGrids.assign(outputs, HitGrid(kHitCellSize, std::max<size_t>(capacity * 2 / outputs, 64)));
+
+    m_transform.reserve(capacity);
+    for (auto* array : {&m_happiness, &m_happinessVelocity, &m_happinessTarget, &m_scriptTime, &m_blinkProgress,
+                        &m_blinkTimer, &m_mouthOpenness}) {
+        array->reserve(capacity);
+    }
+    m_blinking.reserve(capacity);
+    m_style.reserve(capacity);
+    m_script.reserve(capacity);
+    m_output.reserve(capacity);
+    m_slot.reserve(capacity);
+    m_instances.reserve(capacity);
+}
+
+FaceScene::StyleId FaceScene::addStyle(const FaceStyle& style) {
+    m_styles.push_back(style);
+    return static_cast<StyleId>(m_styles.size() - 1);
+}
+
+FaceScene::ScriptId FaceScene::addScript(const Keyframe* keys, size_t count) {
+    if (count == 0 || count > AnimationEngine::kMaxKeyframes || m_scripts.size() >= kNoScript) return kNoScript;
+
+    ScriptTrack track{};
+    std::copy(keys, keys + count, track.keys);
+    track.count = static_cast<uint8_t>(count);
+    track.length = keys[count - 1].time;
+    m_scripts.push_back(track);
+    return static_cast<ScriptId>(m_scripts.size() - 1);
+}
+
+FaceScene::FaceId FaceScene::add(const FaceTransform& transform, OutputId output, StyleId style,
+                                 ScriptId script, float happiness) {
+    if (m_output.size() >= m_capacity || output >= outputCount() || style >= m_styles.size()) return kInvalidFace;
+    if (script != kNoScript && script >= m_scripts.size()) return kInvalidFace;
+
+    const auto face = static_cast<FaceId>(m_output.size());
+    happiness = std::clamp(happiness, 0.0f, 1.0f);
+
+    m_transform.push_back(transform);
+    m_happiness.push_back(happiness);
+    m_happinessVelocity.push_back(0.0f);
+    m_happinessTarget.push_back(happiness);
+    m_scriptTime.push_back(0.0f);
+    m_blinkProgress.push_back(0.0f);
+    // Stagger automatic blinks so a crowd does not blink in unison
+    m_blinkTimer.push_back(m_styles[style].blinkInterval * static_cast<float>((face * 2654435761u) >> 24) / 256.0f);
+    m_blinking.push_back(0);
+    m_mouthOpenness.push_back(0.0f);
+    m_gaze.add();
+
+    m_style.push_back(style);
+    m_script.push_back(script);
+    m_output.push_back(output);
+    m_slot.push_back(0);
+    m_instances.push_back(FaceInstance{});
+    m_slotsDirty = true;
+    m_hitGrids[output].insert(face, outputBounds(transform));
+    return face;
+}
+
+void FaceScene::setTransform(FaceId face, const FaceTransform& transform) {
+    m_transform[face] = transform;
+    m_hitGrids[m_output[face]].move(face, outputBounds(transform));
+}
+
+void FaceScene::setOutput(FaceId face, OutputId output) {
+    if (output >= outputCount() || m_output[face] == output) return;
+    m_hitGrids[m_output[face]].remove(face);
+    m_hitGrids[output].insert(face, outputBounds(m_transform[face]));
+    m_output[face] = output;
+    m_slotsDirty = true;
+}
+
+void FaceScene::setScript(FaceId face, ScriptId script) noexcept {
+    if (script != kNoScript && script >= m_scripts.size()) return;
+    m_script[face] = script;
+    m_scriptTime[face] = 0.0f;
+}
+
+void FaceScene::setEmotion(FaceId face, float happiness) noexcept {
+    m_script[face] = kNoScript;
+    m_happinessTarget[face] = std::clamp(happiness, 0.0f, 1.0f);
+}
+
+void FaceScene::setMouthOpenness(FaceId face, float openness) noexcept {
+    m_mouthOpenness[face] = std::clamp(openness, 0.0f, 1.0f);
+}
+
+void FaceScene::triggerBlink(FaceId face) noexcept {
+    if (!m_blinking[face]) {
+        m_blinking[face] = 1;
+        m_blinkProgress[face] = 0.0f;
+    }
+}
+
+// Counting pass: faces of output o occupy [m_outputOffset[o], m_outputOffset[o + 1])
+void FaceScene::assignSlots() {
+    std::fill(m_outputOffset.begin(), m_outputOffset.end(), 0);
+    for (OutputId output : m_output) m_outputOffset[output + 1]++;
+    for (size_t o = 1; o < m_outputOffset.size(); o++) m_outputOffset[o] += m_outputOffset[o - 1];
+
+    std::copy(m_outputOffset.begin(), m_outputOffset.end() - 1, m_outputCursor.begin());
+    for (size_t face = 0; face < m_output.size(); face++) {
+        m_slot[face] = static_cast<uint32_t>(m_outputCursor[m_output[face]]++);
+    }
+    m_slotsDirty = false;
+}
+
+void FaceScene::update(float deltaTime) {
+    if (m_slotsDirty) assignSlots();
+    for (size_t begin = 0; begin < size(); begin += kChunkSize) {
+        updateRange(begin, std::min(begin + kChunkSize, size()), deltaTime);
+    }
+}
+
+void FaceScene::update(float deltaTime, WorkStealingPool& pool) {
+    if (m_slotsDirty) assignSlots();
+    pool.parallelFor(size(), kChunkSize, [this, deltaTime](size_t begin, size_t end, size_t) {
+        updateRange(begin, end, deltaTime);
+    });
+}
+
+// One chunk: every write goes to this chunk's faces or their own submission slots
+void FaceScene::updateRange(size_t begin, size_t end, float deltaTime) noexcept {
+    if (deltaTime <= 0.0f) deltaTime = 0.0f;
+    m_gaze.updateRange(begin, end, deltaTime);
+
+    const float* pupilX = m_gaze.offsetsX();
+    const float* pupilY = m_gaze.offsetsY();
+
+    for (size_t i = begin; i < end; i++) {
+        const FaceStyle& style = m_styles[m_style[i]];
+
+        // Script drives the emotion target; the spring follows it
+        if (m_script[i] != kNoScript) {
+            const ScriptTrack& track = m_scripts[m_script[i]];
+            float time = m_scriptTime[i] + deltaTime;
+            if (track.length > 0.0f && time >= track.length) time = std::fmod(time, track.length);
+            m_scriptTime[i] = time;
+            m_happinessTarget[i] = sampleScript(track.keys, track.count, time);
+        }
+
+        // Critically damped spring (the animation engine's step)
+        const float omega = 2.0f / std::max(style.emotionSmoothTime, 1e-4f);
+        springStep(m_happiness[i], m_happinessVelocity[i], m_happinessTarget[i], omega, std::exp(-omega * deltaTime),
+                   deltaTime);
+
+        // Automatic blink, same timer as RobotFace
+        if (advanceBlinkTimer(m_blinkTimer[i], deltaTime, style.blinkInterval, m_blinking[i] != 0)) {
+            m_blinking[i] = 1;
+        }
+        if (m_blinking[i]) {
+            m_blinkProgress[i] += style.blinkSpeed * deltaTime;
+            if (m_blinkProgress[i] >= Config::BLINK_COMPLETE_THRESHOLD) {
+                m_blinkProgress[i] = 0.0f;
+                m_blinking[i] = 0;
+            }
+        }
+
+        FaceInstance& instance = m_instances[m_slot[i]];
+        instance.transform = m_transform[i];
+        instance.happiness = std::clamp(m_happiness[i], 0.0f, 1.0f);
+        instance.blinkFactor = tables::blinkFactor<Config::BlinkEasing>(m_blinkProgress[i]);
+        instance.mouthOpenness = m_mouthOpenness[i];
+        instance.pupilX = pupilX[i];
+        instance.pupilY = pupilY[i];
+        instance.style = m_style[i];
+    }
+}
+
+FaceScene::Submissions FaceScene::submissions(OutputId output) const noexcept {
+    if (output >= outputCount()) return Submissions{nullptr, 0};
+    const size_t begin = m_outputOffset[output];
+    return Submissions{m_instances.data() + begin, m_outputOffset[output + 1] - begin};
+}
+
+void FaceScene::draw(OutputId output, Canvas& canvas) const {
+    const Submissions faces = submissions(output);
+    for (size_t i = 0; i < faces.size; i++) {
+        drawFaceInstance(canvas, faces.data[i], m_styles[faces.data[i].style]);
+    }
+}
+
+// The face's design space placed on its output
+HitBox FaceScene::outputBounds(const FaceTransform& t) noexcept {
+    return HitBox{t.x, t.y, t.x + static_cast<float>(Config::SCREEN_WIDTH) * t.scale,
+                  t.y + static_cast<float>(Config::SCREEN_HEIGHT) * t.scale};
+}
+
+FaceScene::Hit FaceScene::hitTest(OutputId output, Point2 point, float slop) const noexcept {
+    if (output >= outputCount()) return Hit{};
+    const FaceId face = m_hitGrids[output].query(point);
+    if (face == HitGrid::kNone) return Hit{};
+
+    const FaceTransform& t = m_transform[face];
+    const Point2 design{(point.x - t.x) / t.scale, (point.y - t.y) / t.scale};
+    return Hit{face, hitTestFace(kFaceGeometry, design, m_happiness[face], m_mouthOpenness[face], slop)};
+}
+
+// The face's design space placed by its transform, drawn like a RobotFace
+void drawFaceInstance(Canvas& canvas, const FaceInstance& face, const FaceStyle& style) {
+    FaceLook look;
+    look.origin = Point2{face.transform.x, face.transform.y};
+    look.scale = face.transform.scale;
+    look.eyeColor = style.eyeColor;
+    look.featureColor = style.featureColor;
+
+    drawEyeWhites(canvas, look);
+    drawFaceFeatures(canvas, FacePose{face.happiness, face.blinkFactor, face.mouthOpenness, face.pupilX, face.pupilY},
+                     look);
+}
+
+} // namespace robotface
@@ -0,0 +1,129 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Coroutine Expression Scripts Implementation (C++20)
+ *
+ *******************************************************************************************/
+
+#include "robot_face_script.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace robotface {
+namespace script {
+
+namespace {
+
+constexpr size_t alignUp(size_t value, size_t alignment) noexcept {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+// ScriptPool
+ScriptPool::ScriptPool(size_t blockCount, size_t blockSize)
+    : m_blockCount(blockCount)
+    , m_blockSize(alignUp(blockSize, alignof(std::max_align_t)))
+    , m_stride(sizeof(BlockHeader) + m_blockSize)
+{
+    // Over-allocate by one alignment step so every header lands on max_align_t
+    m_storage = std::make_unique<unsigned char[]>(m_stride * blockCount + alignof(std::max_align_t));
+    const auto address = reinterpret_cast<std::uintptr_t>(m_storage.get());
+    m_base = m_storage.get() + (alignUp(address, alignof(std::max_align_t)) - address);
+
+    // Lowest index on top so frames are handed out front to back
+    m_free.resize(blockCount);
+    for (size_t i = 0; i < blockCount; i++) {
+        m_free[i] = static_cast<uint32_t>(blockCount - 1 - i);
+    }
+}
+
+void* ScriptPool::allocate(size_t frameSize) noexcept {
+    m_largestRequest = std::max(m_largestRequest, frameSize);
+    if (frameSize > m_blockSize || m_free.empty()) {
+        m_failedRequests++;
+        return nullptr;
+    }
+
+    const uint32_t index = m_free.back();
+    m_free.pop_back();
+
+    auto* header = reinterpret_cast<BlockHeader*>(m_base + index * m_stride);
+    header->pool = this;
+    header->index = index;
+    return header + 1;
+}
+
+void ScriptPool::release(void* frame) noexcept {
+    if (!frame) return;
+
+    auto* header = static_cast<BlockHeader*>(frame) - 1;
+    header->pool->m_free.push_back(header->index);   // Never exceeds the reserved size
+}
+
+// ScriptRunner
+ScriptRunner::ScriptRunner(size_t capacity)
+    : m_capacity(capacity)
+{
+    m_scripts.reserve(capacity);
+}
+
+ScriptRunner::~ScriptRunner() {
+    stopAll();
+}
+
+bool ScriptRunner::start(Script&& script) {
+    if (!script.valid() || m_scripts.size() >= m_capacity) {
+        Script discarded = std::move(script);   // Frame goes back to its pool
+        return false;
+    }
+
+    // Run up to the first suspension point right away
+    Script::Handle handle = script.release();
+    handle.resume();
+    if (handle.done()) {
+        handle.destroy();
+        return true;
+    }
+
+    m_scripts.push_back(handle);
+    return true;
+}
+
+void ScriptRunner::update(float deltaTime) {
+    // Swap-remove keeps the array dense; a moved-in script is visited in the same pass
+    size_t i = 0;
+    while (i < m_scripts.size()) {
+        Script::Handle handle = m_scripts[i];
+        Script::promise_type& promise = handle.promise();
+
+        bool runnable;
+        if (promise.blinkFace) {
+            runnable = !promise.blinkFace->isBlinking();
+            if (runnable) promise.blinkFace = nullptr;
+        } else {
+            promise.waitRemaining -= deltaTime;
+            runnable = promise.waitRemaining <= 0.0f;
+        }
+
+        if (runnable) {
+            handle.resume();
+            if (handle.done()) {
+                handle.destroy();
+                m_scripts[i] = m_scripts.back();
+                m_scripts.pop_back();
+                continue;
+            }
+        }
+        i++;
+    }
+}
+
+void ScriptRunner::stopAll() {
+    for (Script::Handle handle : m_scripts) {
+        handle.destroy();
+    }
+    m_scripts.clear();
+}
+
+} // namespace script
+} // namespace robotface
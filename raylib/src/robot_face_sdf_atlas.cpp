@@ -0,0 +1,26 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Embedded SDF Font Atlas
+ *
+ *   The atlas blob robot_face_font_baker writes at build time, compiled into the binary
+ *   (read-only data: SdfFont views it in place)
+ *
+ *******************************************************************************************/
+
+#include "robot_face_raylib_canvas.hpp"
+
+namespace robotface {
+
+namespace {
+
+alignas(16) constexpr uint8_t kSdfAtlasBlob[] = {
+#include "robot_face_sdf_atlas.inc"
+};
+
+} // namespace
+
+bool loadEmbeddedSdfFont(SdfFont& font) noexcept {
+    return font.load(kSdfAtlasBlob, sizeof(kSdfAtlasBlob));
+}
+
+} // namespace robotface
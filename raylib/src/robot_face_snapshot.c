@@ -0,0 +1,204 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Compact Binary State Snapshots Implementation
+ *
+ *******************************************************************************************/
+
+#include "robot_face_snapshot.h"
+#include <string.h>
+
+#define HEADER_DELTA 0x08u
+#define HEADER_QUANT_SHIFT 4
+#define MASK_MORE 0x80u
+#define FLAG_BLINKING 0x01u
+
+// Quantization range per scalar field (FLAGS is unused)
+static const float FIELD_MIN[FACE_SNAPSHOT_FIELD_COUNT] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+static const float FIELD_MAX[FACE_SNAPSHOT_FIELD_COUNT] = {1.0f, 2.5f, 8.0f, 20.0f, 0.0f};
+
+//------------------------------------------------------------------------------------
+// Value <-> code
+//------------------------------------------------------------------------------------
+
+// Bytes of one scalar field in the given quantization
+static size_t ScalarBytes(int quant, int field) {
+    if (field == FACE_SNAPSHOT_FIELD_FLAGS) return 1;
+    if (quant == FACE_SNAPSHOT_Q16) return 2;
+    if (quant == FACE_SNAPSHOT_Q8) return 1;
+    return (field == FACE_SNAPSHOT_FIELD_BLINK_TIMER) ? 8 : 4;
+}
+
+static uint64_t Quantize(double value, int field, uint32_t levels) {
+    double t = (value - FIELD_MIN[field]) / (FIELD_MAX[field] - FIELD_MIN[field]);
+    if (!(t > 0.0)) t = 0.0;   // Also catches NaN
+    if (t > 1.0) t = 1.0;
+    return (uint64_t)(t * levels + 0.5);
+}
+
+static double Dequantize(uint64_t code, int field, uint32_t levels) {
+    return FIELD_MIN[field] + (double)code / levels * (FIELD_MAX[field] - FIELD_MIN[field]);
+}
+
+static uint64_t EncodeScalar(double value, int quant, int field) {
+    if (quant == FACE_SNAPSHOT_Q16) return Quantize(value, field, 0xFFFFu);
+    if (quant == FACE_SNAPSHOT_Q8) return Quantize(value, field, 0xFFu);
+
+    if (field == FACE_SNAPSHOT_FIELD_BLINK_TIMER) {
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    float f = (float)value;
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+static double DecodeScalar(uint64_t code, int quant, int field) {
+    if (quant == FACE_SNAPSHOT_Q16) return Dequantize(code, field, 0xFFFFu);
+    if (quant == FACE_SNAPSHOT_Q8) return Dequantize(code, field, 0xFFu);
+
+    if (field == FACE_SNAPSHOT_FIELD_BLINK_TIMER) {
+        double d;
+        memcpy(&d, &code, sizeof(d));
+        return d;
+    }
+
+    uint32_t bits = (uint32_t)code;
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+// Encoded value of every field of a face
+static void EncodeFields(const RobotFace* face, int quant, uint64_t codes[FACE_SNAPSHOT_FIELD_COUNT]) {
+    codes[FACE_SNAPSHOT_FIELD_HAPPINESS] = EncodeScalar(face->happiness, quant, FACE_SNAPSHOT_FIELD_HAPPINESS);
+    codes[FACE_SNAPSHOT_FIELD_BLINK_PROGRESS] = EncodeScalar(face->blink_progress, quant, FACE_SNAPSHOT_FIELD_BLINK_PROGRESS);
+    codes[FACE_SNAPSHOT_FIELD_BLINK_TIMER] = EncodeScalar(face->blink_timer, quant, FACE_SNAPSHOT_FIELD_BLINK_TIMER);
+    codes[FACE_SNAPSHOT_FIELD_BLINK_SPEED] = EncodeScalar(face->blink_speed, quant, FACE_SNAPSHOT_FIELD_BLINK_SPEED);
+    codes[FACE_SNAPSHOT_FIELD_FLAGS] = face->is_blinking ? FLAG_BLINKING : 0u;
+}
+
+//------------------------------------------------------------------------------------
+// Record writer
+//------------------------------------------------------------------------------------
+
+static size_t WriteRecord(int quant, bool delta, uint32_t mask, const uint64_t codes[FACE_SNAPSHOT_FIELD_COUNT],
+                          uint8_t* out, size_t capacity) {
+    size_t needed = 2;
+    for (int field = 0; field < FACE_SNAPSHOT_FIELD_COUNT; field++) {
+        if (mask & (1u << field)) needed += ScalarBytes(quant, field);
+    }
+    if (needed > capacity) return 0;
+
+    uint8_t* p = out;
+    *p++ = (uint8_t)(FACE_SNAPSHOT_VERSION | (delta ? HEADER_DELTA : 0u) | ((unsigned)quant << HEADER_QUANT_SHIFT));
+    *p++ = (uint8_t)mask;   // Version 1 fields fit in the first mask byte
+
+    for (int field = 0; field < FACE_SNAPSHOT_FIELD_COUNT; field++) {
+        if (!(mask & (1u << field))) continue;
+
+        size_t bytes = ScalarBytes(quant, field);
+        for (size_t i = 0; i < bytes; i++) {
+            *p++ = (uint8_t)(codes[field] >> (8 * i));
+        }
+    }
+
+    return (size_t)(p - out);
+}
+
+//------------------------------------------------------------------------------------
+// Public API
+//------------------------------------------------------------------------------------
+
+void InitFaceSnapshotEncoder(FaceSnapshotEncoder* encoder, FaceSnapshotQuant quant, int keyframeInterval) {
+    memset(encoder, 0, sizeof(*encoder));
+    encoder->quant = quant;
+    encoder->keyframe_interval = keyframeInterval;
+}
+
+void ResetFaceSnapshotEncoder(FaceSnapshotEncoder* encoder) {
+    encoder->has_previous = false;
+    encoder->since_keyframe = 0;
+}
+
+size_t EncodeFaceSnapshot(FaceSnapshotEncoder* encoder, const RobotFace* face, uint8_t* out, size_t capacity) {
+    uint64_t codes[FACE_SNAPSHOT_FIELD_COUNT];
+    EncodeFields(face, encoder->quant, codes);
+
+    bool keyframe = !encoder->has_previous ||
+                    (encoder->keyframe_interval > 0 && encoder->since_keyframe >= encoder->keyframe_interval);
+
+    uint32_t mask = (1u << FACE_SNAPSHOT_FIELD_COUNT) - 1u;
+    if (!keyframe) {
+        mask = 0;
+        for (int field = 0; field < FACE_SNAPSHOT_FIELD_COUNT; field++) {
+            if (codes[field] != encoder->previous[field]) mask |= 1u << field;
+        }
+    }
+
+    size_t written = WriteRecord(encoder->quant, !keyframe, mask, codes, out, capacity);
+    if (written == 0) return 0;
+
+    memcpy(encoder->previous, codes, sizeof(codes));
+    encoder->has_previous = true;
+    encoder->since_keyframe = keyframe ? 1 : encoder->since_keyframe + 1;
+    return written;
+}
+
+size_t EncodeFaceSnapshotFull(FaceSnapshotQuant quant, const RobotFace* face, uint8_t* out, size_t capacity) {
+    uint64_t codes[FACE_SNAPSHOT_FIELD_COUNT];
+    EncodeFields(face, quant, codes);
+    return WriteRecord(quant, false, (1u << FACE_SNAPSHOT_FIELD_COUNT) - 1u, codes, out, capacity);
+}
+
+size_t DecodeFaceSnapshot(const uint8_t* data, size_t size, RobotFace* face) {
+    const uint8_t* p = data;
+    const uint8_t* end = data + size;
+    if (size < 2) return 0;
+
+    uint8_t header = *p++;
+    int quant = (header >> HEADER_QUANT_SHIFT) & 0x3;
+    if ((header & 0x7u) != FACE_SNAPSHOT_VERSION || quant > FACE_SNAPSHOT_Q8) return 0;
+
+    // Field mask (7 fields per byte)
+    uint64_t mask = 0;
+    int maskBits = 0;
+    for (;;) {
+        if (p >= end || maskBits > 56) return 0;
+        uint8_t byte = *p++;
+        mask |= (uint64_t)(byte & 0x7Fu) << maskBits;
+        maskBits += 7;
+        if (!(byte & MASK_MORE)) break;
+    }
+
+    for (int field = 0; field < maskBits; field++) {
+        if (!(mask & ((uint64_t)1 << field))) continue;
+
+        // Unknown (newer) fields are scalars: skip them by size
+        size_t bytes = (field < FACE_SNAPSHOT_FIELD_COUNT) ? ScalarBytes(quant, field) : ScalarBytes(quant, FACE_SNAPSHOT_FIELD_HAPPINESS);
+        if ((size_t)(end - p) < bytes) return 0;
+
+        uint64_t code = 0;
+        for (size_t i = 0; i < bytes; i++) {
+            code |= (uint64_t)p[i] << (8 * i);
+        }
+        p += bytes;
+
+        switch (field) {
+            case FACE_SNAPSHOT_FIELD_HAPPINESS: face->happiness = (float)DecodeScalar(code, quant, field); break;
+            case FACE_SNAPSHOT_FIELD_BLINK_PROGRESS: face->blink_progress = (float)DecodeScalar(code, quant, field); break;
+            case FACE_SNAPSHOT_FIELD_BLINK_TIMER: face->blink_timer = DecodeScalar(code, quant, field); break;
+            case FACE_SNAPSHOT_FIELD_BLINK_SPEED: face->blink_speed = (float)DecodeScalar(code, quant, field); break;
+            case FACE_SNAPSHOT_FIELD_FLAGS: face->is_blinking = (code & FLAG_BLINKING) != 0; break;
+            default: break;
+        }
+    }
+
+    return (size_t)(p - data);
+}
+
+bool IsFaceSnapshotDelta(const uint8_t* data, size_t size) {
+    return size > 0 && (data[0] & HEADER_DELTA) != 0;
+}
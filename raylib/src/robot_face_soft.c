@@ -0,0 +1,249 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Software Rasterizer Implementation
+ *
+ *******************************************************************************************/
+
+#include "robot_face_soft.h"
+#include "robot_face_config.h"
+#include <math.h>
+#include <string.h>
+
+// Clamp a coverage value to [0, 1]
+static float Coverage(float value) {
+    if (value <= 0.0f) return 0.0f;
+    if (value >= 1.0f) return 1.0f;
+    return value;
+}
+
+// Blend a color into one pixel with the given coverage (source-over)
+static void BlendPixel(unsigned char* px, SoftColor color, float coverage) {
+    unsigned int alpha = (unsigned int)(coverage * (float)color.a + 0.5f);
+    if (alpha == 0) return;
+
+    if (alpha >= 255) {
+        px[0] = color.r;
+        px[1] = color.g;
+        px[2] = color.b;
+        px[3] = 255;
+        return;
+    }
+
+    unsigned int inv = 255 - alpha;
+    px[0] = (unsigned char)((color.r * alpha + px[0] * inv + 127) / 255);
+    px[1] = (unsigned char)((color.g * alpha + px[1] * inv + 127) / 255);
+    px[2] = (unsigned char)((color.b * alpha + px[2] * inv + 127) / 255);
+    px[3] = (unsigned char)(alpha + (px[3] * inv + 127) / 255);
+}
+
+// Convert a design-space edge distance to coverage (hard edge without antialiasing)
+static float EdgeCoverage(const SoftCanvas* canvas, float signedDistance) {
+    if (canvas->antialias) return Coverage(0.5f - signedDistance);
+    return (signedDistance <= 0.0f) ? 1.0f : 0.0f;
+}
+
+// Clip a pixel-space bounding box to the canvas
+static bool ClipBounds(const SoftCanvas* canvas, float minX, float minY, float maxX, float maxY,
+                       int* x0, int* y0, int* x1, int* y1) {
+    *x0 = (int)floorf(minX);
+    *y0 = (int)floorf(minY);
+    *x1 = (int)ceilf(maxX);
+    *y1 = (int)ceilf(maxY);
+
+    if (*x0 < 0) *x0 = 0;
+    if (*y0 < 0) *y0 = 0;
+    if (*x1 > canvas->width) *x1 = canvas->width;
+    if (*y1 > canvas->height) *y1 = canvas->height;
+
+    return *x0 < *x1 && *y0 < *y1;
+}
+
+// Distance from point (px, py) to segment (ax, ay)-(bx, by)
+static float SegmentDistance(float px, float py, float ax, float ay, float bx, float by) {
+    float dx = bx - ax;
+    float dy = by - ay;
+    float lengthSq = dx*dx + dy*dy;
+    float t = 0.0f;
+
+    if (lengthSq > 0.0f) {
+        t = ((px - ax)*dx + (py - ay)*dy) / lengthSq;
+        if (t < 0.0f) t = 0.0f;
+        if (t > 1.0f) t = 1.0f;
+    }
+
+    float ex = px - (ax + t*dx);
+    float ey = py - (ay + t*dy);
+    return sqrtf(ex*ex + ey*ey);
+}
+
+// Initialize canvas and fit the design space into it
+void InitSoftCanvas(SoftCanvas* canvas, unsigned char* pixels, int width, int height) {
+    float scaleX = (float)width / SCREEN_WIDTH;
+    float scaleY = (float)height / SCREEN_HEIGHT;
+
+    canvas->pixels = pixels;
+    canvas->width = width;
+    canvas->height = height;
+    canvas->stride = width * 4;
+    canvas->scale = (scaleX < scaleY) ? scaleX : scaleY;
+    canvas->offset_x = (width - SCREEN_WIDTH * canvas->scale) * 0.5f;
+    canvas->offset_y = (height - SCREEN_HEIGHT * canvas->scale) * 0.5f;
+    canvas->antialias = true;
+}
+
+// Fill the whole canvas with one color
+void SoftClear(SoftCanvas* canvas, SoftColor color) {
+    for (int y = 0; y < canvas->height; y++) {
+        unsigned char* row = canvas->pixels + (size_t)y * canvas->stride;
+        for (int x = 0; x < canvas->width; x++) {
+            memcpy(row + x*4, &color, 4);
+        }
+    }
+}
+
+// Filled circle
+void SoftFillCircle(SoftCanvas* canvas, float cx, float cy, float radius, SoftColor color) {
+    float pcx = canvas->offset_x + cx * canvas->scale;
+    float pcy = canvas->offset_y + cy * canvas->scale;
+    float r = radius * canvas->scale;
+    if (r <= 0.0f) return;
+
+    int x0, y0, x1, y1;
+    if (!ClipBounds(canvas, pcx - r - 1.0f, pcy - r - 1.0f, pcx + r + 1.0f, pcy + r + 1.0f,
+                    &x0, &y0, &x1, &y1)) return;
+
+    for (int y = y0; y < y1; y++) {
+        float dy = (float)y + 0.5f - pcy;
+        unsigned char* row = canvas->pixels + (size_t)y * canvas->stride;
+
+        // Pixels fully inside (r - 1) need no edge evaluation
+        float inner = (r - 1.0f)*(r - 1.0f) - dy*dy;
+        float innerHalf = (inner > 0.0f) ? sqrtf(inner) : -1.0f;
+
+        for (int x = x0; x < x1; x++) {
+            float dx = (float)x + 0.5f - pcx;
+            if (dx > -innerHalf && dx < innerHalf) {
+                BlendPixel(row + x*4, color, 1.0f);
+                continue;
+            }
+            float d = sqrtf(dx*dx + dy*dy);
+            float coverage = EdgeCoverage(canvas, d - r);
+            if (coverage > 0.0f) BlendPixel(row + x*4, color, coverage);
+        }
+    }
+}
+
+// Circle outline centered on the radius
+void SoftStrokeCircle(SoftCanvas* canvas, float cx, float cy, float radius, float thickness, SoftColor color) {
+    float pcx = canvas->offset_x + cx * canvas->scale;
+    float pcy = canvas->offset_y + cy * canvas->scale;
+    float r = radius * canvas->scale;
+    float halfWidth = thickness * canvas->scale * 0.5f;
+    if (halfWidth < 0.5f) halfWidth = 0.5f; // Never thinner than one pixel
+
+    float outer = r + halfWidth + 1.0f;
+    int x0, y0, x1, y1;
+    if (!ClipBounds(canvas, pcx - outer, pcy - outer, pcx + outer, pcy + outer,
+                    &x0, &y0, &x1, &y1)) return;
+
+    for (int y = y0; y < y1; y++) {
+        float dy = (float)y + 0.5f - pcy;
+        unsigned char* row = canvas->pixels + (size_t)y * canvas->stride;
+
+        for (int x = x0; x < x1; x++) {
+            float dx = (float)x + 0.5f - pcx;
+            float d = fabsf(sqrtf(dx*dx + dy*dy) - r);
+            float coverage = EdgeCoverage(canvas, d - halfWidth);
+            if (coverage > 0.0f) BlendPixel(row + x*4, color, coverage);
+        }
+    }
+}
+
+// Thick polyline with round caps and joins (points are x, y pairs)
+void SoftStrokePolyline(SoftCanvas* canvas, const float* points, int pointCount, float thickness, SoftColor color) {
+    if (pointCount < 2) return;
+
+    float halfWidth = thickness * canvas->scale * 0.5f;
+    float minX = points[0], maxX = points[0];
+    float minY = points[1], maxY = points[1];
+    for (int i = 1; i < pointCount; i++) {
+        minX = fminf(minX, points[i*2]);
+        maxX = fmaxf(maxX, points[i*2]);
+        minY = fminf(minY, points[i*2 + 1]);
+        maxY = fmaxf(maxY, points[i*2 + 1]);
+    }
+
+    float pad = halfWidth + 1.0f;
+    int x0, y0, x1, y1;
+    if (!ClipBounds(canvas,
+                    canvas->offset_x + minX * canvas->scale - pad,
+                    canvas->offset_y + minY * canvas->scale - pad,
+                    canvas->offset_x + maxX * canvas->scale + pad,
+                    canvas->offset_y + maxY * canvas->scale + pad,
+                    &x0, &y0, &x1, &y1)) return;
+
+    for (int y = y0; y < y1; y++) {
+        float py = (float)y + 0.5f;
+        unsigned char* row = canvas->pixels + (size_t)y * canvas->stride;
+
+        for (int x = x0; x < x1; x++) {
+            float px = (float)x + 0.5f;
+
+            // Distance to the closest segment (one coverage per pixel, no overlap seams)
+            float d = 1e30f;
+            for (int i = 0; i < pointCount - 1; i++) {
+                float ax = canvas->offset_x + points[i*2] * canvas->scale;
+                float ay = canvas->offset_y + points[i*2 + 1] * canvas->scale;
+                float bx = canvas->offset_x + points[i*2 + 2] * canvas->scale;
+                float by = canvas->offset_y + points[i*2 + 3] * canvas->scale;
+                d = fminf(d, SegmentDistance(px, py, ax, ay, bx, by));
+            }
+
+            float coverage = EdgeCoverage(canvas, d - halfWidth);
+            if (coverage > 0.0f) BlendPixel(row + x*4, color, coverage);
+        }
+    }
+}
+
+// Draw a single eye with blink animation
+static void DrawEyeSoft(SoftCanvas* canvas, float x, float y, float blinkProgress) {
+    // Eye white and outline
+    SoftFillCircle(canvas, x, y, EYE_RADIUS, SOFT_WHITE);
+    SoftStrokeCircle(canvas, x, y, EYE_RADIUS, 1.0f, SOFT_BLACK);
+
+    // Pupil
+    float pupilRadius = GetPupilRadius(blinkProgress);
+    SoftFillCircle(canvas, x, y, pupilRadius, SOFT_BLACK);
+
+    // Highlight
+    if (pupilRadius > 10.0f) {
+        float highlightSize = HIGHLIGHT_RADIUS * (pupilRadius / PUPIL_RADIUS);
+        SoftFillCircle(canvas, x + HIGHLIGHT_OFFSET_X, y + HIGHLIGHT_OFFSET_Y, highlightSize, SOFT_WHITE);
+    }
+}
+
+// Draw mouth as a Bezier curve
+static void DrawMouthSoft(SoftCanvas* canvas, float happiness) {
+    float points[(MOUTH_SEGMENTS + 1) * 2];
+    float controlY = GetMouthControlY(happiness);
+
+    // Quadratic Bezier formula: B(t) = (1-t)²P0 + 2(1-t)tP1 + t²P2, weights precomputed
+    const float* basis = GetMouthBezierBasis();
+    for (int i = 0; i <= MOUTH_SEGMENTS; i++) {
+        const float* w = &basis[i*3];
+        points[i*2] = w[0]*MOUTH_START_X + w[1]*MOUTH_CENTER_X + w[2]*MOUTH_END_X;
+        points[i*2 + 1] = w[0]*MOUTH_START_Y + w[1]*controlY + w[2]*MOUTH_END_Y;
+    }
+
+    SoftStrokePolyline(canvas, points, MOUTH_SEGMENTS + 1, MOUTH_STROKE_WIDTH, SOFT_BLACK);
+}
+
+// Draw complete robot face
+void DrawRobotFaceSoft(const RobotFace* face, SoftCanvas* canvas) {
+    SoftClear(canvas, SOFT_RAYWHITE);
+
+    DrawEyeSoft(canvas, LEFT_EYE_X, LEFT_EYE_Y, face->blink_progress);
+    DrawEyeSoft(canvas, RIGHT_EYE_X, RIGHT_EYE_Y, face->blink_progress);
+
+    DrawMouthSoft(canvas, face->happiness);
+}
@@ -0,0 +1,51 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Software Canvas Backend Implementation
+ *
+ *******************************************************************************************/
+
+#include "robot_face_soft_canvas.hpp"
+
+namespace robotface {
+
+namespace {
+
+SoftColor toSoftColor(Rgba color) noexcept {
+    return SoftColor{color.r, color.g, color.b, color.a};
+}
+
+} // namespace
+
+void SoftwareCanvas::clear(Rgba color) {
+    SoftClear(&m_target, toSoftColor(color));
+    if (m_stats) m_stats->drawCalls++;
+}
+
+void SoftwareCanvas::circle(Point2 center, float radius, Rgba color) {
+    SoftFillCircle(&m_target, center.x, center.y, radius, toSoftColor(color));
+    if (m_stats) m_stats->drawCalls++;
+}
+
+void SoftwareCanvas::ring(Point2 center, float radius, float thickness, Rgba color) {
+    SoftStrokeCircle(&m_target, center.x, center.y, radius, thickness, toSoftColor(color));
+    if (m_stats) m_stats->drawCalls++;
+}
+
+// Point2 is two packed floats, the layout SoftStrokePolyline expects
+void SoftwareCanvas::strokePath(const Point2* points, int count, float width, Rgba color) {
+    static_assert(sizeof(Point2) == 2 * sizeof(float), "Point2 must be two packed floats");
+    SoftStrokePolyline(&m_target, &points[0].x, count, width, toSoftColor(color));
+    if (m_stats) {
+        m_stats->drawCalls++;
+        m_stats->vertices += static_cast<uint32_t>(count > 0 ? count : 0);
+    }
+}
+
+void SoftwareCanvas::text(const char* text, Point2 topLeft, float size, Rgba color) {
+    (void)text;
+    (void)topLeft;
+    (void)size;
+    (void)color;
+}
+
+} // namespace robotface
@@ -0,0 +1,237 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Baked Sprite Sheet Decoder Implementation
+ *
+ *   Everything here runs from a read-only blob: no malloc, no static buffers.
+ *
+ *******************************************************************************************/
+
+#include "robot_face_sprite.h"
+#include <string.h>
+
+// Unaligned little-endian reads (flash blobs carry no alignment guarantee)
+static uint16_t ReadU16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t ReadU32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Bytes per RLE unit for a pixel format
+int RfsUnitBytes(uint8_t format) {
+    switch (format) {
+        case RFS_FORMAT_GRAY8: return 1;
+        case RFS_FORMAT_RGB565: return 2;
+        case RFS_FORMAT_MONO1: return 1;
+        case RFS_FORMAT_RGBA8888: return 4;
+        default: return 0;
+    }
+}
+
+// Bytes per row of pixels for a pixel format
+size_t RfsRowBytes(uint8_t format, int width) {
+    if (format == RFS_FORMAT_MONO1) return (size_t)(width + 7) / 8;
+    return (size_t)width * RfsUnitBytes(format);
+}
+
+// Units (pixels, or bytes of 8 pixels for MONO1) per row
+static int RowUnits(uint8_t format, int width) {
+    return (format == RFS_FORMAT_MONO1) ? (width + 7) / 8 : width;
+}
+
+// Parse and validate a sprite sheet header
+bool RfsOpen(RfsSheet* sheet, const void* blob, size_t size) {
+    const uint8_t* p = (const uint8_t*)blob;
+    if (size < RFS_HEADER_SIZE || memcmp(p, RFS_MAGIC, 4) != 0) return false;
+    if (ReadU16(p + 4) != RFS_VERSION) return false;
+
+    sheet->blob = p;
+    sheet->format = p[6];
+    sheet->index_bytes = p[7];
+    sheet->width = ReadU16(p + 8);
+    sheet->height = ReadU16(p + 10);
+    sheet->tile_width = ReadU16(p + 12);
+    sheet->tile_height = ReadU16(p + 14);
+    sheet->tiles_x = ReadU16(p + 16);
+    sheet->tiles_y = ReadU16(p + 18);
+    sheet->blink_steps = ReadU16(p + 20);
+    sheet->happy_steps = ReadU16(p + 22);
+    sheet->tile_count = ReadU32(p + 24);
+
+    uint32_t indexOffset = ReadU32(p + 28);
+    uint32_t tileOffsetsOffset = ReadU32(p + 32);
+    uint32_t dataOffset = ReadU32(p + 36);
+
+    if (RfsUnitBytes(sheet->format) == 0) return false;
+    if (sheet->format == RFS_FORMAT_MONO1 && (sheet->tile_width % 8) != 0) return false;
+    if (sheet->tile_width == 0 || sheet->tile_height == 0) return false;
+    if (sheet->index_bytes != 1 && sheet->index_bytes != 2) return false;
+    if (sheet->blink_steps == 0 || sheet->happy_steps == 0) return false;
+
+    size_t indexBytes = (size_t)RfsFrameCount(sheet) * sheet->tiles_x * sheet->tiles_y * sheet->index_bytes;
+    size_t offsetBytes = ((size_t)sheet->tile_count + 1) * 4;
+    if (indexOffset + indexBytes > size) return false;
+    if (tileOffsetsOffset + offsetBytes > size) return false;
+    if (dataOffset > size) return false;
+
+    sheet->frame_index = p + indexOffset;
+    sheet->tile_offsets = p + tileOffsetsOffset;
+    sheet->data = p + dataOffset;
+    sheet->data_size = ReadU32(sheet->tile_offsets + (size_t)sheet->tile_count * 4);
+
+    return dataOffset + (size_t)sheet->data_size <= size;
+}
+
+// Total number of baked frames
+int RfsFrameCount(const RfsSheet* sheet) {
+    return sheet->blink_steps * sheet->happy_steps;
+}
+
+// Nearest baked frame for a face state (blink 0..2 mirrors around 1)
+int RfsFrameForState(const RfsSheet* sheet, float blinkProgress, float happiness) {
+    float closing = (blinkProgress <= 1.0f) ? blinkProgress : 2.0f - blinkProgress;
+    if (closing < 0.0f) closing = 0.0f;
+    if (closing > 1.0f) closing = 1.0f;
+    if (happiness < 0.0f) happiness = 0.0f;
+    if (happiness > 1.0f) happiness = 1.0f;
+
+    int blinkIndex = (int)(closing * (sheet->blink_steps - 1) + 0.5f);
+    int happyIndex = (int)(happiness * (sheet->happy_steps - 1) + 0.5f);
+    return blinkIndex * sheet->happy_steps + happyIndex;
+}
+
+// Decode one RLE tile stream, clipped to clipUnits x clipRows
+static bool DecodeTileClipped(const RfsSheet* sheet, uint32_t tile, uint8_t* dst, size_t rowBytes,
+                              int clipUnits, int clipRows) {
+    if (tile >= sheet->tile_count) return false;
+
+    uint32_t begin = ReadU32(sheet->tile_offsets + (size_t)tile * 4);
+    uint32_t end = ReadU32(sheet->tile_offsets + (size_t)tile * 4 + 4);
+    if (begin > end || end > sheet->data_size) return false;
+
+    const uint8_t* src = sheet->data + begin;
+    const uint8_t* srcEnd = sheet->data + end;
+    const int unitBytes = RfsUnitBytes(sheet->format);
+    const int rowUnits = RowUnits(sheet->format, sheet->tile_width);
+    const int rows = sheet->tile_height;
+    int col = 0;
+    int row = 0;
+
+    while (src < srcEnd && row < rows) {
+        uint8_t control = *src++;
+        bool repeat = control >= 0x80;
+        int count = repeat ? (control - 0x80 + 2) : (control + 1);
+
+        if (src + (repeat ? unitBytes : count * unitBytes) > srcEnd) return false;
+
+        // Emit the run as spans that never cross a row boundary
+        const uint8_t* unit = src;
+        while (count > 0 && row < rows) {
+            int span = rowUnits - col;
+            if (span > count) span = count;
+
+            int visible = clipUnits - col;
+            if (visible > span) visible = span;
+
+            if (visible > 0 && row < clipRows) {
+                uint8_t* out = dst + (size_t)row * rowBytes + (size_t)col * unitBytes;
+                if (!repeat) {
+                    memcpy(out, unit, (size_t)visible * unitBytes);
+                } else if (unitBytes == 1) {
+                    memset(out, unit[0], (size_t)visible);
+                } else {
+                    for (int i = 0; i < visible; i++) memcpy(out + i * unitBytes, unit, unitBytes);
+                }
+            }
+
+            if (!repeat) unit += span * unitBytes;
+            count -= span;
+            col += span;
+            if (col == rowUnits) {
+                col = 0;
+                row++;
+            }
+        }
+
+        src = repeat ? src + unitBytes : unit;
+    }
+
+    return row == rows;
+}
+
+// Decode a full tile into a tile-sized buffer
+bool RfsDecodeTile(const RfsSheet* sheet, uint32_t tile, uint8_t* dst, size_t rowBytes) {
+    return DecodeTileClipped(sheet, tile, dst, rowBytes,
+                             RowUnits(sheet->format, sheet->tile_width), sheet->tile_height);
+}
+
+// Decode a complete frame into a width x height framebuffer
+bool RfsDecodeFrame(const RfsSheet* sheet, int frame, uint8_t* dst, size_t rowBytes) {
+    if (frame < 0 || frame >= RfsFrameCount(sheet)) return false;
+
+    const int unitBytes = RfsUnitBytes(sheet->format);
+    const int tileUnits = RowUnits(sheet->format, sheet->tile_width);
+    const int frameUnits = RowUnits(sheet->format, sheet->width);
+    const size_t tilesPerFrame = (size_t)sheet->tiles_x * sheet->tiles_y;
+    const uint8_t* ids = sheet->frame_index + (size_t)frame * tilesPerFrame * sheet->index_bytes;
+
+    for (int ty = 0; ty < sheet->tiles_y; ty++) {
+        int y = ty * sheet->tile_height;
+        int clipRows = sheet->height - y;
+        if (clipRows > sheet->tile_height) clipRows = sheet->tile_height;
+
+        for (int tx = 0; tx < sheet->tiles_x; tx++) {
+            int unitX = tx * tileUnits;
+            int clipUnits = frameUnits - unitX;
+            if (clipUnits > tileUnits) clipUnits = tileUnits;
+
+            size_t slot = (size_t)ty * sheet->tiles_x + tx;
+            uint32_t tile = (sheet->index_bytes == 1) ? ids[slot] : ReadU16(ids + slot * 2);
+            uint8_t* tileDst = dst + (size_t)y * rowBytes + (size_t)unitX * unitBytes;
+            if (!DecodeTileClipped(sheet, tile, tileDst, rowBytes, clipUnits, clipRows)) return false;
+        }
+    }
+
+    return true;
+}
+
+// PackBits-style RLE over fixed-size units
+size_t RfsRleEncode(const uint8_t* src, size_t units, int unitBytes, uint8_t* dst, size_t capacity) {
+    size_t out = 0;
+    size_t i = 0;
+
+    while (i < units) {
+        // Measure run of identical units starting at i
+        size_t run = 1;
+        while (i + run < units && run < 129 &&
+               memcmp(src + (i + run) * unitBytes, src + i * unitBytes, unitBytes) == 0) {
+            run++;
+        }
+
+        if (run >= 2) {
+            if (out + 1 + unitBytes > capacity) return 0;
+            dst[out++] = (uint8_t)(0x80 + run - 2);
+            memcpy(dst + out, src + i * unitBytes, unitBytes);
+            out += unitBytes;
+            i += run;
+            continue;
+        }
+
+        // Literal run until the next pair of identical units
+        size_t literal = 1;
+        while (i + literal < units && literal < 128) {
+            const uint8_t* a = src + (i + literal) * unitBytes;
+            if (i + literal + 1 < units && memcmp(a, a + unitBytes, unitBytes) == 0) break;
+            literal++;
+        }
+
+        if (out + 1 + literal * unitBytes > capacity) return 0;
+        dst[out++] = (uint8_t)(literal - 1);
+        memcpy(dst + out, src + i * unitBytes, literal * unitBytes);
+        out += literal * unitBytes;
+        i += literal;
+    }
+
+    return out;
+}
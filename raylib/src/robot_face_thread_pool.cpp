@@ -0,0 +1,133 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Work-Stealing Thread Pool Implementation
+ *
+ *******************************************************************************************/
+
+#include "robot_face_thread_pool.hpp"
+#include <algorithm>
+
+namespace robotface {
+
+WorkStealingPool::WorkStealingPool(size_t threadCount)
+    : m_workerCount(threadCount > 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency()))
+    , m_queues(new Queue[m_workerCount])
+{
+    m_threads.reserve(m_workerCount - 1);
+    for (size_t worker = 1; worker < m_workerCount; worker++) {
+        m_threads.emplace_back([this, worker] { workerLoop(worker); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (std::thread& thread : m_threads) thread.join();
+}
+
+void WorkStealingPool::run(Job job) {
+    if (job.count == 0) return;
+
+    // Chunk indices are packed as 32 bits: a job with more chunks gets proportionally larger ones
+    if ((job.count - 1) / job.chunkSize >= kMaxChunks) job.chunkSize = (job.count - 1) / kMaxChunks + 1;
+    const size_t chunkCount = (job.count - 1) / job.chunkSize + 1;
+
+    // Small jobs and single-threaded pools run inline
+    if (m_workerCount == 1 || chunkCount == 1) {
+        for (size_t begin = 0; begin < job.count; begin += job.chunkSize) {
+            job.invoke(job.context, begin, std::min(begin + job.chunkSize, job.count), 0);
+        }
+        return;
+    }
+
+    // Even split of the chunk indices; stealing evens out the rest
+    for (size_t worker = 0; worker < m_workerCount; worker++) {
+        const auto begin = static_cast<uint32_t>(chunkCount * worker / m_workerCount);
+        const auto end = static_cast<uint32_t>(chunkCount * (worker + 1) / m_workerCount);
+        m_queues[worker].range.store(pack(begin, end), std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_job = job;
+        m_busy = m_threads.size();
+        m_generation++;
+    }
+    m_wake.notify_all();
+
+    work(0);
+
+    // The body lives on the caller's stack: wait until no worker can still call it
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_busy == 0; });
+}
+
+void WorkStealingPool::workerLoop(size_t worker) {
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+            if (m_stop) return;
+            seen = m_generation;
+        }
+
+        work(worker);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_busy == 0) m_done.notify_one();
+    }
+}
+
+// Own chunks first, then steal until every queue is empty
+void WorkStealingPool::work(size_t worker) {
+    const Job& job = m_job;
+    uint32_t chunk = 0;
+    for (;;) {
+        while (popFront(worker, chunk)) {
+            const size_t begin = chunk * job.chunkSize;
+            job.invoke(job.context, begin, std::min(begin + job.chunkSize, job.count), worker);
+        }
+        if (!stealHalf(worker)) return;
+    }
+}
+
+bool WorkStealingPool::popFront(size_t worker, uint32_t& chunk) noexcept {
+    std::atomic<uint64_t>& range = m_queues[worker].range;
+    uint64_t current = range.load(std::memory_order_acquire);
+    for (;;) {
+        const auto begin = static_cast<uint32_t>(current >> 32);
+        const auto end = static_cast<uint32_t>(current);
+        if (begin >= end) return false;
+        if (range.compare_exchange_weak(current, pack(begin + 1, end), std::memory_order_acq_rel)) {
+            chunk = begin;
+            return true;
+        }
+    }
+}
+
+// Moves the back half of the next non-empty victim's range into the thief's own (empty) queue
+bool WorkStealingPool::stealHalf(size_t thief) noexcept {
+    for (size_t offset = 1; offset < m_workerCount; offset++) {
+        std::atomic<uint64_t>& victim = m_queues[(thief + offset) % m_workerCount].range;
+        uint64_t current = victim.load(std::memory_order_acquire);
+        for (;;) {
+            const auto begin = static_cast<uint32_t>(current >> 32);
+            const auto end = static_cast<uint32_t>(current);
+            if (begin >= end) break;
+
+            const uint32_t split = end - (end - begin + 1) / 2;
+            if (victim.compare_exchange_weak(current, pack(begin, split), std::memory_order_acq_rel)) {
+                m_queues[thief].range.store(pack(split, end), std::memory_order_release);
+                m_steals.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+} // namespace robotface
@@ -0,0 +1,119 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Modern C++ Implementation (window parts)
+ *
+ *   Immediate raylib drawing, its render targets and input. Only executables that open
+ *   a window compile this file; faces drawn into other canvases never call raylib.
+ *
+ *******************************************************************************************/
+
+#include "robot_face.hpp"
+#include "robot_face_raylib_canvas.hpp"
+
+namespace robotface {
+
+// Render targets of draw(width, height)
+struct RobotFace::WindowTargets {
+    RaylibLayerCache layerCache;     // Static layer
+    RaylibSpriteCache spriteCache;   // Pupil sprite (lower quality levels)
+    RaylibScaledTarget scaledTarget; // Reduced resolution (lower quality levels)
+    RaylibSdfText text;              // SDF status text
+};
+
+// Handle keyboard input
+void RobotFace::handleKeyboardInput() {
+    if (IsKeyPressed(KEY_H)) animateEmotion(Emotion::Happy);
+    if (IsKeyPressed(KEY_N)) animateEmotion(Emotion::Neutral);
+    if (IsKeyPressed(KEY_S)) animateEmotion(Emotion::Sad);
+    if (IsKeyPressed(KEY_F3)) m_statsOverlay = !m_statsOverlay;
+    if (IsKeyPressed(KEY_F4)) m_pacingOverlay = !m_pacingOverlay;
+}
+
+// Handle mouse input
+void RobotFace::handleMouseInput() {
+    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
+        triggerBlink();
+    }
+}
+
+// Check if mouse is over the mouth as it is drawn now (curve, speech opening)
+bool RobotFace::isMouseOverMouth() const {
+    const Vector2 mousePos = GetMousePosition();
+    return regionAt(Point2{mousePos.x, mousePos.y}, Config::HOVER_SLOP) == FaceRegion::Mouth;
+}
+
+// Draw complete robot face with raylib
+// Cold start: the first frame is the face alone, without the render texture and without
+// text (first use of the font atlas); both follow on the next frame. The targets are
+// allocated once, on the second frame.
+void RobotFace::draw(int width, int height) const {
+    FrameStats stats;
+    m_fps = GetFPS();
+    if (m_firstFrameDrawn) {
+        if (!m_window) {
+            m_window = {new WindowTargets, [](WindowTargets* targets) { delete targets; }};
+            m_window->layerCache.setEnabled(m_layerCacheEnabled);
+        }
+        WindowTargets& targets = *m_window;
+
+        // Sprites are recorded before a reduced-resolution pass (render targets do not nest)
+        if (m_quality.eyeSprites && !m_program) {
+            RaylibCanvas spriteCanvas;
+            spriteCanvas.setSpriteCache(&targets.spriteCache);
+            spriteCanvas.setStats(&stats);
+            preparePupilSprite(spriteCanvas);
+        }
+
+        // Reduced resolution: the static layer is drawn directly into the smaller target
+        const bool scaled = m_quality.resolutionScale < 1.0f &&
+                            targets.scaledTarget.begin(width, height, m_quality.resolutionScale);
+        if (m_font && targets.text.font() != m_font) targets.text.load(*m_font);
+        RaylibCanvas canvas(scaled ? nullptr : &targets.layerCache, width, height);
+        canvas.setSpriteCache(m_quality.eyeSprites ? &targets.spriteCache : nullptr);
+        canvas.setSdfText(m_font ? &targets.text : nullptr);
+        canvas.setStats(&stats);
+        draw(canvas, width, height);
+        canvas.flushText();
+        if (scaled) targets.scaledTarget.end(&stats);
+    } else if (m_program) {
+        // A described face is drawn as described, text included
+        RaylibCanvas canvas;
+        canvas.setStats(&stats);
+        m_program->run(canvas, programInputs(width, height));
+        m_firstFrameDrawn = true;
+    } else {
+        RaylibCanvas canvas;
+        canvas.setStats(&stats);
+        canvas.clear(toRgba(RAYWHITE));
+        drawEyeWhites(canvas, look());
+        drawFaceFeatures(canvas, pose(), look());
+        m_firstFrameDrawn = true;
+    }
+    m_frameStats = stats;
+}
+
+void RobotFace::invalidateStaticLayer() noexcept {
+    if (m_window) m_window->layerCache.invalidate();
+}
+
+void RobotFace::setStaticLayerCache(bool enabled) {
+    m_layerCacheEnabled = enabled;
+    if (m_window) m_window->layerCache.setEnabled(enabled);
+}
+
+void RobotFace::unloadStaticLayer() {
+    if (!m_window) return;
+    m_window->layerCache.unload();
+    m_window->spriteCache.unload();
+    m_window->scaledTarget.unload();
+    m_window->text.unload();
+}
+
+// The cached static layer holds text drawn with the previous font
+void RobotFace::setFont(const SdfFont* font) noexcept {
+    if (font == m_font) return;
+    m_font = font;
+    invalidateStaticLayer();
+}
+
+} // namespace robotface
@@ -0,0 +1,206 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Zero-Heap Render Loop Check
+ *
+ *   Runs each implementation headless (software rasterizer target) through a scripted
+ *   scenario: emotion sweep, automatic and triggered blinks. Every frame is wrapped
+ *   in the global allocation counter; after warm-up a frame must not allocate.
+ *
+ *   Each implementation runs in its own process so peak RSS is reported per
+ *   implementation. Exit status is 1 if any steady-state frame allocated, so the
+ *   tool can gate CI directly.
+ *
+ *   Usage:
+ *     robot_face_alloc_check [--warmup 180] [--frames 1200] [--impl c-soft|cpp-soft|cpp-record]
+ *
+ *******************************************************************************************/
+
+#define ROBOT_FACE_ALLOC_COUNTER_IMPLEMENTATION
+#include "robot_face_alloc_counter.hpp"
+
+#include "robot_face.h"
+#include "robot_face.hpp"
+#include "robot_face_display_list.hpp"
+#include "robot_face_soft.h"
+#include "robot_face_soft_canvas.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+constexpr int kWidth = 800;
+constexpr int kHeight = 600;
+
+struct Scenario {
+    int warmupFrames = 180;
+    int steadyFrames = 1200;
+};
+
+struct Result {
+    uint64_t warmupAllocations = 0;
+    uint64_t steadyAllocations = 0;
+    uint64_t maxPerFrame = 0;
+    int allocatingFrames = 0;
+};
+
+// Scripted input shared by all implementations
+float scenarioHappiness(int frame) {
+    return 0.5f + 0.5f * std::sin(frame * 0.05f);
+}
+
+bool scenarioBlink(int frame) {
+    return frame % 50 == 0;
+}
+
+template <typename FrameFn>
+Result runFrames(const Scenario& scenario, FrameFn&& frameFn) {
+    Result result;
+    const int total = scenario.warmupFrames + scenario.steadyFrames;
+
+    for (int frame = 0; frame < total; frame++) {
+        const uint64_t before = robotface::alloc::allocationCount();
+        frameFn(frame);
+        const uint64_t allocations = robotface::alloc::allocationCount() - before;
+
+        if (frame < scenario.warmupFrames) {
+            result.warmupAllocations += allocations;
+            continue;
+        }
+        if (allocations > 0) {
+            result.steadyAllocations += allocations;
+            result.allocatingFrames++;
+            if (allocations > result.maxPerFrame) result.maxPerFrame = allocations;
+        }
+    }
+
+    return result;
+}
+
+// Modular C face into the software rasterizer
+Result runCSoft(const Scenario& scenario) {
+    static unsigned char pixels[kWidth * kHeight * 4];
+    SoftCanvas canvas;
+    InitSoftCanvas(&canvas, pixels, kWidth, kHeight);
+
+    RobotFace face;
+    InitRobotFace(&face);
+
+    return runFrames(scenario, [&](int frame) {
+        UpdateRobotFace(&face, 1.0f / 60.0f);
+        SetEmotion(&face, scenarioHappiness(frame));
+        if (scenarioBlink(frame)) TriggerBlink(&face);
+        DrawRobotFaceSoft(&face, &canvas);
+    });
+}
+
+// Modern C++ face drawing straight into a Canvas backend
+Result runCppSoft(const Scenario& scenario) {
+    std::vector<unsigned char> pixels(kWidth * kHeight * 4);
+    SoftCanvas target;
+    InitSoftCanvas(&target, pixels.data(), kWidth, kHeight);
+    robotface::SoftwareCanvas canvas(target);
+
+    robotface::RobotFace face(0.8f);
+
+    return runFrames(scenario, [&](int frame) {
+        face.update(1.0f / 60.0f);
+        face.setEmotion(scenarioHappiness(frame));
+        if (scenarioBlink(frame)) face.triggerBlink();
+        face.draw(canvas, kWidth, kHeight);
+    });
+}
+
+// Modern C++ face recorded into a display list, then replayed
+Result runCppRecord(const Scenario& scenario) {
+    std::vector<unsigned char> pixels(kWidth * kHeight * 4);
+    SoftCanvas target;
+    InitSoftCanvas(&target, pixels.data(), kWidth, kHeight);
+    robotface::SoftwareCanvas canvas(target);
+
+    robotface::RobotFace face(0.8f);
+    robotface::DisplayList frameList;
+    robotface::DisplayListLibrary library;
+    frameList.reserve(4096);   // Fixed budget: no growth once recording starts
+
+    return runFrames(scenario, [&](int frame) {
+        face.update(1.0f / 60.0f);
+        face.setEmotion(scenarioHappiness(frame));
+        if (scenarioBlink(frame)) face.triggerBlink();
+
+        frameList.clear();
+        robotface::DisplayListRecorder recorder(frameList, &library);
+        face.draw(recorder, kWidth, kHeight);
+        robotface::replay(frameList, canvas, &library);
+    });
+}
+
+struct Implementation {
+    const char* name;
+    Result (*run)(const Scenario&);
+};
+
+const Implementation kImplementations[] = {
+    {"c-soft", runCSoft},
+    {"cpp-soft", runCppSoft},
+    {"cpp-record", runCppRecord},
+};
+
+// Runs one implementation in a child process; returns true if it stayed off the heap
+bool runIsolated(const Implementation& impl, const Scenario& scenario) {
+    std::fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) {
+        std::perror("fork");
+        return false;
+    }
+
+    if (pid == 0) {
+        const Result result = impl.run(scenario);
+        std::printf("%-12s %10llu %10llu %10.3f %10llu %10zu  %s\n", impl.name,
+                    static_cast<unsigned long long>(result.warmupAllocations),
+                    static_cast<unsigned long long>(result.steadyAllocations),
+                    static_cast<double>(result.steadyAllocations) / scenario.steadyFrames,
+                    static_cast<unsigned long long>(result.maxPerFrame),
+                    robotface::alloc::peakRssKb(),
+                    result.steadyAllocations ? "FAIL" : "ok");
+        std::fflush(stdout);
+        _exit(result.steadyAllocations ? 1 : 0);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Scenario scenario;
+    const char* only = nullptr;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--warmup") == 0) scenario.warmupFrames = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--frames") == 0) scenario.steadyFrames = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--impl") == 0) only = argv[i + 1];
+    }
+    if (scenario.warmupFrames < 0 || scenario.steadyFrames < 1) {
+        std::fprintf(stderr, "warmup must be >= 0 and frames >= 1\n");
+        return 1;
+    }
+
+    std::printf("%d warm-up + %d steady-state frames\n\n", scenario.warmupFrames, scenario.steadyFrames);
+    std::printf("%-12s %10s %10s %10s %10s %10s\n", "impl", "warmup", "steady", "per frame", "max/frame", "peak KiB");
+
+    bool ok = true;
+    for (const Implementation& impl : kImplementations) {
+        if (only && std::strcmp(only, impl.name) != 0) continue;
+        ok = runIsolated(impl, scenario) && ok;
+    }
+
+    return ok ? 0 : 1;
+}
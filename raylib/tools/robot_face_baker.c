@@ -0,0 +1,423 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Offline Animation Baker
+ *
+ *   Renders a (blinkProgress, happiness) grid with the software rasterizer, converts it
+ *   to the target pixel format, deduplicates identical tiles, RLE compresses them and
+ *   writes an indexed sprite sheet (see robot_face_sprite.h) for microcontroller heads.
+ *
+ *   Usage:
+ *     robot_face_baker [--width 240] [--height 180] [--format rgb565|gray8|mono1|rgba8888]
+ *                      [--tile 16] [--blink-steps 9] [--happy-steps 11] [--no-aa]
+ *                      [--out face.rfs] [--c-array face_sprites.h] [--symbol name]
+ *
+ *******************************************************************************************/
+
+#include "robot_face.h"
+#include "robot_face_soft.h"
+#include "robot_face_sprite.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct {
+    int width;
+    int height;
+    int tile;
+    int blinkSteps;
+    int happySteps;
+    uint8_t format;
+    bool antialias;
+    const char* outPath;
+    const char* cArrayPath;
+    const char* symbol;
+} BakerOptions;
+
+// Unique tile store with an open-addressing hash index
+typedef struct {
+    uint8_t* pixels;         // tileBytes * capacity
+    uint32_t* hashes;
+    uint32_t count;
+    uint32_t capacity;
+    size_t tileBytes;
+    int32_t* slots;          // Hash table of tile ids (-1 = empty)
+    uint32_t slotCount;
+} TileStore;
+
+static double NowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint32_t HashBytes(const uint8_t* data, size_t size) {
+    uint32_t hash = 2166136261u; // FNV-1a
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void WriteU16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void WriteU32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static bool ParseFormat(const char* name, uint8_t* format) {
+    if (strcmp(name, "gray8") == 0) *format = RFS_FORMAT_GRAY8;
+    else if (strcmp(name, "rgb565") == 0) *format = RFS_FORMAT_RGB565;
+    else if (strcmp(name, "mono1") == 0) *format = RFS_FORMAT_MONO1;
+    else if (strcmp(name, "rgba8888") == 0) *format = RFS_FORMAT_RGBA8888;
+    else return false;
+    return true;
+}
+
+static bool ParseOptions(int argc, char** argv, BakerOptions* opt) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (strcmp(arg, "--no-aa") == 0) { opt->antialias = false; continue; }
+        if (value == NULL) return false;
+
+        if (strcmp(arg, "--width") == 0) opt->width = atoi(value);
+        else if (strcmp(arg, "--height") == 0) opt->height = atoi(value);
+        else if (strcmp(arg, "--tile") == 0) opt->tile = atoi(value);
+        else if (strcmp(arg, "--blink-steps") == 0) opt->blinkSteps = atoi(value);
+        else if (strcmp(arg, "--happy-steps") == 0) opt->happySteps = atoi(value);
+        else if (strcmp(arg, "--format") == 0) { if (!ParseFormat(value, &opt->format)) return false; }
+        else if (strcmp(arg, "--out") == 0) opt->outPath = value;
+        else if (strcmp(arg, "--c-array") == 0) opt->cArrayPath = value;
+        else if (strcmp(arg, "--symbol") == 0) opt->symbol = value;
+        else return false;
+        i++;
+    }
+
+    if (opt->width <= 0 || opt->height <= 0 || opt->width > 65535 || opt->height > 65535) return false;
+    if (opt->tile <= 0 || opt->blinkSteps < 2 || opt->happySteps < 2) return false;
+    if (opt->format == RFS_FORMAT_MONO1 && (opt->tile % 8) != 0) return false;
+    return true;
+}
+
+// Convert an RGBA8888 canvas into the target format (padded frame, rowBytes per row)
+static void ConvertFrame(const SoftCanvas* canvas, uint8_t format, uint8_t* dst, size_t rowBytes,
+                         int paddedWidth, int paddedHeight) {
+    memset(dst, 0, rowBytes * paddedHeight);
+
+    for (int y = 0; y < paddedHeight; y++) {
+        uint8_t* row = dst + (size_t)y * rowBytes;
+        int sy = (y < canvas->height) ? y : canvas->height - 1;
+
+        for (int x = 0; x < paddedWidth; x++) {
+            int sx = (x < canvas->width) ? x : canvas->width - 1;
+            const uint8_t* px = canvas->pixels + (size_t)sy * canvas->stride + sx * 4;
+            uint8_t gray = (uint8_t)((px[0] * 77 + px[1] * 150 + px[2] * 29) >> 8);
+
+            switch (format) {
+                case RFS_FORMAT_GRAY8:
+                    row[x] = gray;
+                    break;
+                case RFS_FORMAT_RGB565: {
+                    uint16_t v = (uint16_t)(((px[0] >> 3) << 11) | ((px[1] >> 2) << 5) | (px[2] >> 3));
+                    WriteU16(row + x*2, v);
+                } break;
+                case RFS_FORMAT_MONO1:
+                    if (gray < 128) row[x / 8] |= (uint8_t)(0x80 >> (x % 8));
+                    break;
+                case RFS_FORMAT_RGBA8888:
+                    memcpy(row + x*4, px, 4);
+                    break;
+            }
+        }
+    }
+}
+
+static bool InitTileStore(TileStore* store, size_t tileBytes, uint32_t maxTiles) {
+    store->tileBytes = tileBytes;
+    store->capacity = maxTiles;
+    store->count = 0;
+    store->slotCount = 1;
+    while (store->slotCount < maxTiles * 2) store->slotCount <<= 1;
+
+    store->pixels = malloc(tileBytes * maxTiles);
+    store->hashes = malloc(sizeof(uint32_t) * maxTiles);
+    store->slots = malloc(sizeof(int32_t) * store->slotCount);
+    if (!store->pixels || !store->hashes || !store->slots) return false;
+
+    for (uint32_t i = 0; i < store->slotCount; i++) store->slots[i] = -1;
+    return true;
+}
+
+static void FreeTileStore(TileStore* store) {
+    free(store->pixels);
+    free(store->hashes);
+    free(store->slots);
+}
+
+// Return the id of an identical stored tile, adding it if new
+static uint32_t InternTile(TileStore* store, const uint8_t* tile) {
+    uint32_t hash = HashBytes(tile, store->tileBytes);
+    uint32_t slot = hash & (store->slotCount - 1);
+
+    while (store->slots[slot] >= 0) {
+        uint32_t id = (uint32_t)store->slots[slot];
+        if (store->hashes[id] == hash &&
+            memcmp(store->pixels + id * store->tileBytes, tile, store->tileBytes) == 0) {
+            return id;
+        }
+        slot = (slot + 1) & (store->slotCount - 1);
+    }
+
+    uint32_t id = store->count++;
+    memcpy(store->pixels + id * store->tileBytes, tile, store->tileBytes);
+    store->hashes[id] = hash;
+    store->slots[slot] = (int32_t)id;
+    return id;
+}
+
+static bool WriteCArray(const char* path, const char* symbol, const uint8_t* data, size_t size) {
+    FILE* file = fopen(path, "w");
+    if (!file) return false;
+
+    fprintf(file, "// Generated by robot_face_baker - do not edit\n");
+    fprintf(file, "#include <stdint.h>\n\n");
+    fprintf(file, "static const uint8_t %s[%zu] = {", symbol, size);
+    for (size_t i = 0; i < size; i++) {
+        fprintf(file, "%s0x%02x,", (i % 16 == 0) ? "\n    " : " ", data[i]);
+    }
+    fprintf(file, "\n};\n");
+
+    return fclose(file) == 0;
+}
+
+int main(int argc, char** argv) {
+    BakerOptions opt = {
+        .width = 240, .height = 180, .tile = 16,
+        .blinkSteps = 9, .happySteps = 11,
+        .format = RFS_FORMAT_RGB565, .antialias = true,
+        .outPath = "robot_face.rfs", .cArrayPath = NULL, .symbol = "robot_face_sprites"
+    };
+
+    if (!ParseOptions(argc, argv, &opt)) {
+        fprintf(stderr, "Usage: %s [--width N] [--height N] [--format rgb565|gray8|mono1|rgba8888]\n"
+                        "          [--tile N] [--blink-steps N] [--happy-steps N] [--no-aa]\n"
+                        "          [--out file.rfs] [--c-array file.h] [--symbol name]\n", argv[0]);
+        return 1;
+    }
+
+    const int tilesX = (opt.width + opt.tile - 1) / opt.tile;
+    const int tilesY = (opt.height + opt.tile - 1) / opt.tile;
+    const int paddedWidth = tilesX * opt.tile;
+    const int paddedHeight = tilesY * opt.tile;
+    const int frameCount = opt.blinkSteps * opt.happySteps;
+    const size_t tilesPerFrame = (size_t)tilesX * tilesY;
+    const size_t frameRowBytes = RfsRowBytes(opt.format, paddedWidth);
+    const size_t tileRowBytes = RfsRowBytes(opt.format, opt.tile);
+    const size_t tileBytes = tileRowBytes * opt.tile;
+
+    uint8_t* rgba = malloc((size_t)opt.width * opt.height * 4);
+    uint8_t* frame = malloc(frameRowBytes * paddedHeight);
+    uint8_t* tile = malloc(tileBytes);
+    uint16_t* frameIndex = malloc(sizeof(uint16_t) * tilesPerFrame * frameCount);
+    TileStore store;
+
+    if (!rgba || !frame || !tile || !frameIndex ||
+        !InitTileStore(&store, tileBytes, (uint32_t)(tilesPerFrame * frameCount))) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    // Render the state grid and intern every tile
+    SoftCanvas canvas;
+    InitSoftCanvas(&canvas, rgba, opt.width, opt.height);
+    canvas.antialias = opt.antialias;
+
+    double renderStart = NowSeconds();
+    for (int b = 0; b < opt.blinkSteps; b++) {
+        for (int h = 0; h < opt.happySteps; h++) {
+            RobotFace face;
+            InitRobotFace(&face);
+            face.blink_progress = (float)b / (opt.blinkSteps - 1);
+            face.happiness = (float)h / (opt.happySteps - 1);
+
+            DrawRobotFaceSoft(&face, &canvas);
+            ConvertFrame(&canvas, opt.format, frame, frameRowBytes, paddedWidth, paddedHeight);
+
+            uint16_t* ids = frameIndex + (size_t)(b * opt.happySteps + h) * tilesPerFrame;
+            for (int ty = 0; ty < tilesY; ty++) {
+                for (int tx = 0; tx < tilesX; tx++) {
+                    for (int row = 0; row < opt.tile; row++) {
+                        memcpy(tile + row * tileRowBytes,
+                               frame + (size_t)(ty * opt.tile + row) * frameRowBytes + tx * tileRowBytes,
+                               tileRowBytes);
+                    }
+                    uint32_t id = InternTile(&store, tile);
+                    if (id > 0xFFFF) {
+                        fprintf(stderr, "Too many unique tiles (max 65536), use a larger --tile\n");
+                        return 1;
+                    }
+                    ids[ty * tilesX + tx] = (uint16_t)id;
+                }
+            }
+        }
+    }
+    double renderTime = NowSeconds() - renderStart;
+
+    // Compress unique tiles
+    const int unitBytes = RfsUnitBytes(opt.format);
+    const size_t unitsPerTile = tileBytes / unitBytes;
+    const size_t worstCase = tileBytes + unitsPerTile + 1;
+    uint8_t* data = malloc(worstCase * store.count);
+    uint32_t* offsets = malloc(sizeof(uint32_t) * (store.count + 1));
+    size_t dataSize = 0;
+
+    if (!data || !offsets) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    for (uint32_t i = 0; i < store.count; i++) {
+        offsets[i] = (uint32_t)dataSize;
+        dataSize += RfsRleEncode(store.pixels + i * tileBytes, unitsPerTile, unitBytes,
+                                 data + dataSize, worstCase);
+    }
+    offsets[store.count] = (uint32_t)dataSize;
+
+    // Assemble the sheet
+    const int indexWidth = (store.count <= 256) ? 1 : 2;
+    const size_t indexBytes = tilesPerFrame * frameCount * indexWidth;
+    const size_t indexOffset = RFS_HEADER_SIZE;
+    const size_t offsetsOffset = (indexOffset + indexBytes + 3) & ~(size_t)3;
+    const size_t dataOffset = offsetsOffset + (store.count + 1) * 4;
+    const size_t totalSize = dataOffset + dataSize;
+    uint8_t* sheetBlob = calloc(1, totalSize);
+
+    if (!sheetBlob) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    memcpy(sheetBlob, RFS_MAGIC, 4);
+    WriteU16(sheetBlob + 4, RFS_VERSION);
+    sheetBlob[6] = opt.format;
+    sheetBlob[7] = (uint8_t)indexWidth;
+    WriteU16(sheetBlob + 8, (uint16_t)opt.width);
+    WriteU16(sheetBlob + 10, (uint16_t)opt.height);
+    WriteU16(sheetBlob + 12, (uint16_t)opt.tile);
+    WriteU16(sheetBlob + 14, (uint16_t)opt.tile);
+    WriteU16(sheetBlob + 16, (uint16_t)tilesX);
+    WriteU16(sheetBlob + 18, (uint16_t)tilesY);
+    WriteU16(sheetBlob + 20, (uint16_t)opt.blinkSteps);
+    WriteU16(sheetBlob + 22, (uint16_t)opt.happySteps);
+    WriteU32(sheetBlob + 24, store.count);
+    WriteU32(sheetBlob + 28, (uint32_t)indexOffset);
+    WriteU32(sheetBlob + 32, (uint32_t)offsetsOffset);
+    WriteU32(sheetBlob + 36, (uint32_t)dataOffset);
+
+    for (size_t i = 0; i < tilesPerFrame * frameCount; i++) {
+        if (indexWidth == 1) sheetBlob[indexOffset + i] = (uint8_t)frameIndex[i];
+        else WriteU16(sheetBlob + indexOffset + i * 2, frameIndex[i]);
+    }
+    for (uint32_t i = 0; i <= store.count; i++) {
+        WriteU32(sheetBlob + offsetsOffset + i * 4, offsets[i]);
+    }
+    memcpy(sheetBlob + dataOffset, data, dataSize);
+
+    // Round-trip through the decoder and time it
+    RfsSheet sheet;
+    if (!RfsOpen(&sheet, sheetBlob, totalSize)) {
+        fprintf(stderr, "Internal error: baked sheet failed validation\n");
+        return 1;
+    }
+
+    const size_t outRowBytes = RfsRowBytes(opt.format, opt.width);
+    uint8_t* decoded = malloc(outRowBytes * opt.height);
+
+    if (!decoded) {
+        fprintf(stderr, "Out of memory\n");
+        return 1;
+    }
+
+    // Every decoded frame must match the converted render it was baked from
+    for (int f = 0; f < frameCount; f++) {
+        RobotFace face;
+        InitRobotFace(&face);
+        face.blink_progress = (float)(f / opt.happySteps) / (opt.blinkSteps - 1);
+        face.happiness = (float)(f % opt.happySteps) / (opt.happySteps - 1);
+        DrawRobotFaceSoft(&face, &canvas);
+        ConvertFrame(&canvas, opt.format, frame, frameRowBytes, paddedWidth, paddedHeight);
+
+        if (!RfsDecodeFrame(&sheet, f, decoded, outRowBytes)) {
+            fprintf(stderr, "Internal error: frame %d failed to decode\n", f);
+            return 1;
+        }
+        for (int y = 0; y < opt.height; y++) {
+            if (memcmp(decoded + (size_t)y * outRowBytes, frame + (size_t)y * frameRowBytes, outRowBytes) != 0) {
+                fprintf(stderr, "Internal error: frame %d row %d differs from the source after decoding\n", f, y);
+                return 1;
+            }
+        }
+    }
+
+    // Decode cost
+    int iterations = 0;
+    double decodeStart = NowSeconds();
+    double decodeTime = 0.0;
+
+    do {
+        for (int f = 0; f < frameCount; f++) {
+            if (!RfsDecodeFrame(&sheet, f, decoded, outRowBytes)) {
+                fprintf(stderr, "Internal error: frame %d failed to decode\n", f);
+                return 1;
+            }
+        }
+        iterations++;
+        decodeTime = NowSeconds() - decodeStart;
+    } while (decodeTime < 0.25);
+
+    FILE* file = fopen(opt.outPath, "wb");
+    if (!file || fwrite(sheetBlob, 1, totalSize, file) != totalSize || fclose(file) != 0) {
+        fprintf(stderr, "Failed to write %s\n", opt.outPath);
+        return 1;
+    }
+    if (opt.cArrayPath && !WriteCArray(opt.cArrayPath, opt.symbol, sheetBlob, totalSize)) {
+        fprintf(stderr, "Failed to write %s\n", opt.cArrayPath);
+        return 1;
+    }
+
+    // Report
+    const size_t rawSize = RfsRowBytes(opt.format, opt.width) * opt.height * frameCount;
+    printf("Robot Face Baker\n");
+    printf("  Frames:        %d (%d blink x %d happiness)\n", frameCount, opt.blinkSteps, opt.happySteps);
+    printf("  Resolution:    %dx%d, %d-px tiles (%dx%d per frame)\n", opt.width, opt.height, opt.tile, tilesX, tilesY);
+    printf("  Unique tiles:  %u of %zu\n", store.count, tilesPerFrame * frameCount);
+    printf("  Raw frames:    %zu bytes\n", rawSize);
+    printf("  Sheet size:    %zu bytes (index %zu, offsets %zu, data %zu) = %.1f%% of raw\n",
+           totalSize, indexBytes, (size_t)(store.count + 1) * 4, dataSize, 100.0 * totalSize / rawSize);
+    printf("  Render time:   %.1f ms total\n", renderTime * 1000.0);
+    printf("  Decode cost:   %.1f us/frame (host), %zu bytes/frame output\n",
+           decodeTime * 1e6 / (iterations * frameCount), outRowBytes * opt.height);
+    printf("  Written:       %s%s%s\n", opt.outPath, opt.cArrayPath ? ", " : "", opt.cArrayPath ? opt.cArrayPath : "");
+
+    free(decoded);
+    free(sheetBlob);
+    free(data);
+    free(offsets);
+    FreeTileStore(&store);
+    free(frameIndex);
+    free(tile);
+    free(frame);
+    free(rgba);
+
+    return 0;
+}
@@ -0,0 +1,219 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Thin Remote Rendering Client
+ *
+ *   Receives display lists from robot_face_server and replays them. No face logic runs
+ *   here; the client only keeps the current frame and the static sub-list library.
+ *
+ *   Usage:
+ *     robot_face_client [--socket /tmp/robot_face.sock] [--software] [--seconds 0]
+ *                       [--outputs 800x600,320x240:rgb565,200x150]
+ *
+ *   --software replays into the software rasterizer without a window (headless boards,
+ *   CI); otherwise frames are presented with raylib. With --outputs the frame is
+ *   rasterized once, at the largest output's size, and the others are derived from it
+ *   (robot_face_outputs.hpp).
+ *
+ *******************************************************************************************/
+
+#include "raylib.h"
+#include "robot_face_display_list.hpp"
+#include "robot_face_outputs.hpp"
+#include "robot_face_raylib_canvas.hpp"
+#include "robot_face_remote.hpp"
+#include "robot_face_soft_canvas.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <poll.h>
+#include <vector>
+
+using namespace robotface;
+
+namespace {
+
+constexpr size_t kLatencySamples = 4096;
+
+// Send-to-present latency and received bandwidth
+class ClientStats {
+public:
+    void addFrame(uint64_t sentNs) {
+        const double ms = (remote::monotonicNs() - sentNs) * 1e-6;
+        m_samples[m_frames % kLatencySamples] = ms;
+        m_frames++;
+        m_totalMs += ms;
+    }
+
+    void print(const char* label, uint64_t bytesReceived) const {
+        if (m_frames == 0) return;
+
+        const size_t count = std::min<size_t>(m_frames, kLatencySamples);
+        std::vector<double> sorted(m_samples, m_samples + count);
+        std::sort(sorted.begin(), sorted.end());
+
+        std::printf("%s frames=%llu latency mean=%.3f ms p50=%.3f ms p99=%.3f ms bandwidth=%.1f B/frame\n",
+                    label, static_cast<unsigned long long>(m_frames), m_totalMs / m_frames,
+                    sorted[count / 2], sorted[std::min(count - 1, count * 99 / 100)],
+                    static_cast<double>(bytesReceived) / m_frames);
+        std::fflush(stdout);
+    }
+
+    [[nodiscard]] uint64_t frames() const noexcept { return m_frames; }
+
+private:
+    double m_samples[kLatencySamples] = {};
+    uint64_t m_frames = 0;
+    double m_totalMs = 0.0;
+};
+
+// Applies every complete message; returns true when a new frame is ready
+bool applyMessages(remote::MessageReader& reader, DisplayList& frame, DisplayListLibrary& library, uint64_t& sentNs) {
+    remote::MessageHeader header;
+    const uint8_t* payload = nullptr;
+    bool newFrame = false;
+
+    while (reader.next(header, payload)) {
+        bool ok = true;
+        switch (static_cast<remote::MessageType>(header.type)) {
+            case remote::MessageType::DefineList: ok = remote::applyDefineList(payload, header.size, library); break;
+            case remote::MessageType::Frame: ok = remote::applyFrame(payload, header.size, frame); break;
+            case remote::MessageType::FrameDelta: ok = remote::applyFrameDelta(payload, header.size, frame); break;
+            default: break;
+        }
+        if (!ok) {
+            std::fprintf(stderr, "Malformed message (type %u, frame %u)\n", header.type, header.frameId);
+            continue;
+        }
+        if (header.type != static_cast<uint8_t>(remote::MessageType::DefineList)) {
+            newFrame = true;
+            sentNs = header.sentNs;
+        }
+    }
+
+    return newFrame;
+}
+
+int runSoftware(int fd, double seconds, const std::vector<OutputSpec>& outputs) {
+    remote::MessageReader reader(fd);
+    DisplayList frame;
+    DisplayListLibrary library;
+    ClientStats stats;
+
+    // One render for every output, or a single 800x600 one
+    OutputPyramid pyramid;
+    const bool derived = !outputs.empty();
+    if (derived && !pyramid.configure(outputs.data(), outputs.size())) {
+        std::fprintf(stderr, "Outputs must share one aspect ratio\n");
+        return 1;
+    }
+    SoftCanvas target;
+    std::vector<unsigned char> pixels(derived ? 0 : 800 * 600 * 4);
+    if (!derived) InitSoftCanvas(&target, pixels.data(), 800, 600);
+    SoftwareCanvas canvas(derived ? pyramid.source() : target);
+
+    const uint64_t startNs = remote::monotonicNs();
+    uint64_t nextReportNs = startNs + 5000000000ull;
+    uint64_t sentNs = 0;
+
+    for (;;) {
+        pollfd pfd{fd, POLLIN, 0};
+        ::poll(&pfd, 1, 100);
+        if (!reader.poll()) break;
+
+        if (applyMessages(reader, frame, library, sentNs)) {
+            replay(frame, canvas, &library);
+            if (derived) pyramid.present();
+            stats.addFrame(sentNs);
+        }
+
+        const uint64_t now = remote::monotonicNs();
+        if (now >= nextReportNs) {
+            nextReportNs += 5000000000ull;
+            stats.print("[software]", reader.bytesReceived());
+        }
+        if (seconds > 0.0 && (now - startNs) * 1e-9 >= seconds) break;
+    }
+
+    stats.print("[software] final", reader.bytesReceived());
+    return 0;
+}
+
+int runWindow(int fd, double seconds) {
+    remote::MessageReader reader(fd);
+    DisplayList frame;
+    DisplayListLibrary library;
+    ClientStats stats;
+
+    InitWindow(800, 600, "Robot Face - Remote Client");
+    SetTargetFPS(60);
+
+    RaylibCanvas canvas;
+    const double startTime = GetTime();
+    double nextReport = startTime + 5.0;
+    uint64_t sentNs = 0;
+    bool connected = true;
+
+    while (!WindowShouldClose() && connected) {
+        connected = reader.poll();
+        const bool newFrame = applyMessages(reader, frame, library, sentNs);
+
+        BeginDrawing();
+        replay(frame, canvas, &library);
+        DrawText(TextFormat("Remote: %.1f B/frame", stats.frames() ? static_cast<double>(reader.bytesReceived()) / stats.frames() : 0.0),
+                 10, 570, 16, DARKGRAY);
+        EndDrawing();
+
+        // Latency is measured after the frame has been presented
+        if (newFrame) stats.addFrame(sentNs);
+
+        if (GetTime() >= nextReport) {
+            nextReport += 5.0;
+            stats.print("[raylib]", reader.bytesReceived());
+        }
+        if (seconds > 0.0 && GetTime() - startTime >= seconds) break;
+    }
+
+    CloseWindow();
+    stats.print("[raylib] final", reader.bytesReceived());
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* socketPath = remote::kDefaultSocketPath;
+    bool software = false;
+    double seconds = 0.0;
+    std::vector<OutputSpec> outputs;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--software") == 0) software = true;
+        else if (std::strcmp(argv[i], "--socket") == 0 && i + 1 < argc) socketPath = argv[++i];
+        else if (std::strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) seconds = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--outputs") == 0 && i + 1 < argc) {
+            // Comma-separated WxH[:format]
+            const char* text = argv[++i];
+            std::vector<char> list(text, text + std::strlen(text) + 1);
+            for (char* item = std::strtok(list.data(), ","); item; item = std::strtok(nullptr, ",")) {
+                OutputSpec spec;
+                if (!parseOutputSpec(item, spec)) {
+                    std::fprintf(stderr, "Bad output '%s' (WxH or WxH:rgba8888|rgb565|gray8)\n", item);
+                    return 1;
+                }
+                outputs.push_back(spec);
+            }
+            software = true;
+        }
+    }
+
+    int fd = remote::connectUnix(socketPath);
+    if (fd < 0) {
+        std::fprintf(stderr, "Cannot connect to %s (is robot_face_server running?)\n", socketPath);
+        return 1;
+    }
+
+    int result = software ? runSoftware(fd, seconds, outputs) : runWindow(fd, seconds);
+    remote::closeSocket(fd);
+    return result;
+}
@@ -0,0 +1,192 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Display List Tool
+ *
+ *   Inspects and replays frame captures (.rfdl) written by robot_face_cpp (F12).
+ *
+ *   Usage:
+ *     robot_face_dl_tool dump capture.rfdl
+ *     robot_face_dl_tool render capture.rfdl out.ppm [width height]
+ *     robot_face_dl_tool stats capture.rfdl            # Software backend submission counters
+ *     robot_face_dl_tool diff a.rfdl b.rfdl
+ *
+ *******************************************************************************************/
+
+#include "robot_face_display_list.hpp"
+#include "robot_face_soft_canvas.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace robotface;
+
+namespace {
+
+// Canvas that prints one line per op
+class DumpCanvas final : public Canvas {
+public:
+    explicit DumpCanvas(FILE* out) : m_out(out) {}
+
+    void clear(Rgba c) override {
+        indent();
+        std::fprintf(m_out, "clear      #%02x%02x%02x%02x\n", c.r, c.g, c.b, c.a);
+    }
+    void circle(Point2 p, float r, Rgba c) override {
+        indent();
+        std::fprintf(m_out, "circle     (%.2f, %.2f) r=%.2f #%02x%02x%02x%02x\n", p.x, p.y, r, c.r, c.g, c.b, c.a);
+    }
+    void ring(Point2 p, float r, float t, Rgba c) override {
+        indent();
+        std::fprintf(m_out, "ring       (%.2f, %.2f) r=%.2f w=%.2f #%02x%02x%02x%02x\n", p.x, p.y, r, t, c.r, c.g, c.b, c.a);
+    }
+    void strokePath(const Point2* pts, int count, float w, Rgba c) override {
+        indent();
+        std::fprintf(m_out, "strokePath %d points w=%.2f #%02x%02x%02x%02x (%.2f, %.2f) .. (%.2f, %.2f)\n",
+                     count, w, c.r, c.g, c.b, c.a, pts[0].x, pts[0].y, pts[count - 1].x, pts[count - 1].y);
+    }
+    void text(const char* text, Point2 p, float size, Rgba c) override {
+        indent();
+        std::fprintf(m_out, "text       (%.0f, %.0f) size=%.0f #%02x%02x%02x%02x \"%s\"\n", p.x, p.y, size, c.r, c.g, c.b, c.a, text);
+    }
+    bool beginGroup(uint32_t key) override {
+        indent();
+        std::fprintf(m_out, "group      0x%08x {\n", key);
+        m_depth++;
+        return true;
+    }
+    void endGroup() override {
+        m_depth--;
+        indent();
+        std::fprintf(m_out, "}\n");
+    }
+
+private:
+    void indent() { for (int i = 0; i < m_depth; i++) std::fputs("  ", m_out); }
+
+    FILE* m_out;
+    int m_depth = 0;
+};
+
+bool readFile(const char* path, std::vector<uint8_t>& bytes) {
+    FILE* file = std::fopen(path, "rb");
+    if (!file) return false;
+
+    std::fseek(file, 0, SEEK_END);
+    long size = std::ftell(file);
+    std::fseek(file, 0, SEEK_SET);
+    bytes.resize(size > 0 ? static_cast<size_t>(size) : 0);
+    bool ok = std::fread(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    std::fclose(file);
+    return ok;
+}
+
+bool loadCapture(const char* path, DisplayList& frame, DisplayListLibrary& library) {
+    std::vector<uint8_t> bytes;
+    if (!readFile(path, bytes) || !deserializeFrame(bytes.data(), bytes.size(), frame, library)) {
+        std::fprintf(stderr, "Cannot read display list capture: %s\n", path);
+        return false;
+    }
+    return true;
+}
+
+int dump(const char* path) {
+    DisplayList frame;
+    DisplayListLibrary library;
+    if (!loadCapture(path, frame, library)) return 1;
+
+    std::printf("# %u ops, %zu bytes, %zu sub-lists\n", frame.opCount(), frame.size(), library.size());
+    DumpCanvas canvas(stdout);
+    return replay(frame, canvas, &library) ? 0 : 1;
+}
+
+int render(const char* path, const char* outPath, int width, int height) {
+    DisplayList frame;
+    DisplayListLibrary library;
+    if (!loadCapture(path, frame, library)) return 1;
+
+    std::vector<unsigned char> pixels(static_cast<size_t>(width) * height * 4);
+    SoftCanvas target;
+    InitSoftCanvas(&target, pixels.data(), width, height);
+    SoftwareCanvas canvas(target);
+    if (!replay(frame, canvas, &library)) {
+        std::fprintf(stderr, "Malformed display list\n");
+        return 1;
+    }
+
+    FILE* out = std::fopen(outPath, "wb");
+    if (!out) return 1;
+    std::fprintf(out, "P6\n%d %d\n255\n", width, height);
+    for (size_t i = 0; i < pixels.size(); i += 4) std::fwrite(&pixels[i], 1, 3, out);
+    return std::fclose(out) == 0 ? 0 : 1;
+}
+
+// Submission counters of one software replay
+int stats(const char* path) {
+    DisplayList frame;
+    DisplayListLibrary library;
+    if (!loadCapture(path, frame, library)) return 1;
+
+    std::vector<unsigned char> pixels(static_cast<size_t>(800) * 600 * 4);
+    SoftCanvas target;
+    InitSoftCanvas(&target, pixels.data(), 800, 600);
+    FrameStats counters;
+    SoftwareCanvas canvas(target);
+    canvas.setStats(&counters);
+    if (!replay(frame, canvas, &library)) {
+        std::fprintf(stderr, "Malformed display list\n");
+        return 1;
+    }
+
+    std::printf("draws %u  vertices %u  triangles %u  flushes %u  state changes %u  glyphs %u\n",
+                counters.drawCalls, counters.vertices, counters.triangles, counters.batchFlushes,
+                counters.stateChanges, counters.glyphs);
+    return 0;
+}
+
+// Reports whether two captures draw the same frame (sub-lists expanded)
+int diff(const char* pathA, const char* pathB) {
+    DisplayList frames[2];
+    DisplayListLibrary libraries[2];
+    DisplayList flat[2];
+    const char* paths[2] = {pathA, pathB};
+
+    for (int i = 0; i < 2; i++) {
+        if (!loadCapture(paths[i], frames[i], libraries[i])) return 1;
+        DisplayListRecorder recorder(flat[i]);
+        replay(frames[i], recorder, &libraries[i]);
+    }
+
+    if (flat[0] == flat[1]) {
+        std::printf("identical (%u ops)\n", flat[0].opCount());
+        return 0;
+    }
+
+    size_t common = 0;
+    while (common < flat[0].size() && common < flat[1].size() &&
+           flat[0].data()[common] == flat[1].data()[common]) {
+        common++;
+    }
+    std::printf("differ: %u vs %u ops, first difference at byte %zu\n",
+                flat[0].opCount(), flat[1].opCount(), common);
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc >= 3 && std::strcmp(argv[1], "dump") == 0) return dump(argv[2]);
+    if (argc >= 4 && std::strcmp(argv[1], "render") == 0) {
+        int width = (argc >= 6) ? std::atoi(argv[4]) : 800;
+        int height = (argc >= 6) ? std::atoi(argv[5]) : 600;
+        return render(argv[2], argv[3], width, height);
+    }
+    if (argc >= 3 && std::strcmp(argv[1], "stats") == 0) return stats(argv[2]);
+    if (argc >= 4 && std::strcmp(argv[1], "diff") == 0) return diff(argv[2], argv[3]);
+
+    std::fprintf(stderr, "Usage: %s dump file.rfdl\n"
+                         "       %s render file.rfdl out.ppm [width height]\n"
+                         "       %s stats file.rfdl\n"
+                         "       %s diff a.rfdl b.rfdl\n", argv[0], argv[0], argv[0], argv[0]);
+    return 1;
+}
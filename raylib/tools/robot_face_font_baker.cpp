@@ -0,0 +1,79 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - SDF Font Atlas Baker
+ *
+ *   Bakes the status text font (see robot_face_sdf_font.hpp) into an atlas blob and
+ *   writes it as a binary file and/or as the initializer of a byte array. The build
+ *   runs it to embed the atlas in robot_face_cpp (src/robot_face_sdf_atlas.cpp), so
+ *   the app loads its font without baking or reading a file.
+ *
+ *   Usage:
+ *     robot_face_font_baker [--out font.rfsf] [--c-array robot_face_sdf_atlas.inc]
+ *
+ *******************************************************************************************/
+
+#include "robot_face_sdf_font.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+bool writeBinary(const char* path, const std::vector<uint8_t>& blob) {
+    FILE* file = std::fopen(path, "wb");
+    if (!file) return false;
+    const bool ok = std::fwrite(blob.data(), 1, blob.size(), file) == blob.size();
+    return std::fclose(file) == 0 && ok;
+}
+
+// Comma-separated bytes, to be #included between the braces of an array
+bool writeArray(const char* path, const std::vector<uint8_t>& blob) {
+    FILE* file = std::fopen(path, "w");
+    if (!file) return false;
+    std::fprintf(file, "// Generated by robot_face_font_baker: SDF font atlas blob, %zu bytes\n", blob.size());
+    for (size_t i = 0; i < blob.size(); i++) {
+        std::fprintf(file, "%u,%s", blob[i], (i % 24 == 23) ? "\n" : "");
+    }
+    std::fprintf(file, "\n");
+    return std::fclose(file) == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* outPath = nullptr;
+    const char* arrayPath = nullptr;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--out") == 0) outPath = argv[i + 1];
+        else if (std::strcmp(argv[i], "--c-array") == 0) arrayPath = argv[i + 1];
+    }
+    if (!outPath && !arrayPath) {
+        std::fprintf(stderr, "Usage: %s [--out font.rfsf] [--c-array atlas.inc]\n", argv[0]);
+        return 1;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<uint8_t> blob;
+    robotface::bakeSdfAtlas(blob);
+    const double bakeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    robotface::SdfFont font;
+    if (!font.load(blob.data(), blob.size())) {
+        std::fprintf(stderr, "Baked atlas does not load\n");
+        return 1;
+    }
+    if (outPath && !writeBinary(outPath, blob)) {
+        std::fprintf(stderr, "Cannot write %s\n", outPath);
+        return 1;
+    }
+    if (arrayPath && !writeArray(arrayPath, blob)) {
+        std::fprintf(stderr, "Cannot write %s\n", arrayPath);
+        return 1;
+    }
+
+    std::printf("SDF atlas: %d glyphs, %dx%d, %zu bytes, baked in %.1f ms\n", font.header().glyphCount, font.width(),
+                font.height(), blob.size(), bakeMs);
+    return 0;
+}
@@ -0,0 +1,189 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Gaze Benchmark
+ *
+ *   Simulates a perception stack publishing look-at targets for every face at 1 kHz
+ *   while the faces update and record a frame at 60 Hz (display lists, headless).
+ *   The same workload runs without gaze (pupils centred) and with it; the frame-time
+ *   difference is the cost of gaze. Also compares the batched update with one
+ *   GazeBatch per face.
+ *
+ *   Exit status is 1 when gaze adds more than 5% of a 60 FPS frame.
+ *
+ *   Usage:
+ *     robot_face_gaze_bench [--faces 256] [--seconds 5] [--rate 1000]
+ *
+ *******************************************************************************************/
+
+#include "robot_face.hpp"
+#include "robot_face_display_list.hpp"
+#include "robot_face_gaze.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using namespace robotface;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr float kFrameTime = 1.0f / 60.0f;
+constexpr double kFrameBudgetMs = 1000.0 / 60.0;
+constexpr double kMaxRegression = 0.05;   // Share of the frame budget gaze may add
+
+struct Options {
+    size_t faces = 256;
+    int seconds = 5;
+    int rate = 1000;
+};
+
+// Tracked people wander across the view: one target per face per perception tick
+std::vector<GazePoint> makeTargets(size_t faces, size_t ticks) {
+    std::vector<GazePoint> targets(faces * ticks);
+    std::vector<GazePoint> position(faces, GazePoint{400.0f, 300.0f});
+    uint32_t seed = 7u;
+    auto random = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<float>(seed >> 8) / static_cast<float>(1u << 24) - 0.5f;
+    };
+
+    for (size_t t = 0; t < ticks; t++) {
+        for (size_t f = 0; f < faces; f++) {
+            position[f].x = std::clamp(position[f].x + random() * 8.0f, 0.0f, 800.0f);
+            position[f].y = std::clamp(position[f].y + random() * 8.0f, 0.0f, 600.0f);
+            targets[t * faces + f] = position[f];
+        }
+    }
+    return targets;
+}
+
+struct FrameTiming {
+    double meanMs = 0.0;
+    double p99Ms = 0.0;
+    double gazeNs = 0.0;   // Target hand-over and update, per frame
+};
+
+FrameTiming run(const Options& options, const std::vector<GazePoint>& targets, bool withGaze) {
+    std::vector<RobotFace> faces;
+    faces.reserve(options.faces);
+    for (size_t i = 0; i < options.faces; i++) faces.emplace_back(0.5f);
+
+    GazeBatch gaze(options.faces);
+    for (size_t i = 0; i < options.faces; i++) gaze.add(static_cast<uint32_t>(i + 1));
+
+    DisplayList frameList;
+    DisplayListLibrary library;
+    frameList.reserve(4096);
+
+    const int frames = options.seconds * 60;
+    const size_t ticks = targets.size() / options.faces;
+    std::vector<double> frameMs;
+    frameMs.reserve(static_cast<size_t>(frames));
+    double gazeNs = 0.0;
+    size_t tick = 0;
+
+    for (int frame = 0; frame < frames; frame++) {
+        const auto start = Clock::now();
+
+        if (withGaze) {
+            // Every perception tick that happened during this frame
+            const size_t until = std::min(ticks, static_cast<size_t>((frame + 1) * static_cast<double>(options.rate) / 60.0));
+            for (; tick < until; tick++) {
+                gaze.setTargets(targets.data() + tick * options.faces, options.faces);
+            }
+            gaze.update(kFrameTime);
+            const float* offsetX = gaze.offsetsX();
+            const float* offsetY = gaze.offsetsY();
+            for (size_t i = 0; i < options.faces; i++) faces[i].setPupilOffset(offsetX[i], offsetY[i]);
+            gazeNs += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        }
+
+        for (RobotFace& face : faces) {
+            face.update(kFrameTime);
+            frameList.clear();
+            DisplayListRecorder recorder(frameList, &library);
+            face.draw(recorder, Config::SCREEN_WIDTH, Config::SCREEN_HEIGHT);
+        }
+
+        frameMs.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+
+    FrameTiming stats;
+    for (double ms : frameMs) stats.meanMs += ms;
+    stats.meanMs /= static_cast<double>(frameMs.size());
+    std::sort(frameMs.begin(), frameMs.end());
+    stats.p99Ms = frameMs[frameMs.size() * 99 / 100];
+    stats.gazeNs = gazeNs / frames;
+    return stats;
+}
+
+// Batched update vs one GazeBatch per face, same targets
+void compareBatching(const Options& options, const std::vector<GazePoint>& targets) {
+    const int rounds = 2000;
+
+    GazeBatch batch(options.faces);
+    std::vector<std::unique_ptr<GazeBatch>> single;
+    for (size_t i = 0; i < options.faces; i++) {
+        batch.add(static_cast<uint32_t>(i + 1));
+        single.push_back(std::make_unique<GazeBatch>(1));
+        single.back()->add(static_cast<uint32_t>(i + 1));
+    }
+
+    batch.setTargets(targets.data(), options.faces);
+    for (size_t i = 0; i < options.faces; i++) single[i]->setTarget(0, targets[i]);
+
+    auto start = Clock::now();
+    for (int r = 0; r < rounds; r++) batch.update(kFrameTime);
+    const double batchNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    start = Clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (auto& gaze : single) gaze->update(kFrameTime);
+    }
+    const double singleNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    const double perFace = static_cast<double>(rounds) * static_cast<double>(options.faces);
+    std::printf("Gaze update:  batched %.2f ns/face, per-face objects %.2f ns/face (%.1fx)\n",
+                batchNs / perFace, singleNs / perFace, singleNs / batchNs);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--faces") == 0) options.faces = static_cast<size_t>(std::atol(argv[i + 1]));
+        else if (std::strcmp(argv[i], "--seconds") == 0) options.seconds = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--rate") == 0) options.rate = std::atoi(argv[i + 1]);
+    }
+    if (options.faces == 0 || options.seconds < 1 || options.rate < 1) {
+        std::fprintf(stderr, "faces, seconds and rate must be positive\n");
+        return 1;
+    }
+
+    const size_t ticks = static_cast<size_t>(options.seconds) * static_cast<size_t>(options.rate);
+    const std::vector<GazePoint> targets = makeTargets(options.faces, ticks);
+
+    std::printf("Faces: %zu, targets at %d Hz, rendering at 60 Hz for %d s\n\n",
+                options.faces, options.rate, options.seconds);
+
+    run(options, targets, false);   // Warm caches and the display list library
+    const FrameTiming baseline = run(options, targets, false);
+    const FrameTiming gazed = run(options, targets, true);
+
+    std::printf("%-10s %10s %10s %12s\n", "", "mean ms", "p99 ms", "gaze us");
+    std::printf("%-10s %10.3f %10.3f %12s\n", "baseline", baseline.meanMs, baseline.p99Ms, "-");
+    std::printf("%-10s %10.3f %10.3f %12.1f\n", "gaze", gazed.meanMs, gazed.p99Ms, gazed.gazeNs / 1000.0);
+
+    compareBatching(options, targets);
+
+    const double added = gazed.meanMs - baseline.meanMs;
+    const bool ok = added < kFrameBudgetMs * kMaxRegression;
+    std::printf("\nGaze adds %.3f ms per frame (%.1f%% of the 60 FPS budget): %s\n",
+                added, 100.0 * added / kFrameBudgetMs, ok ? "no regression" : "REGRESSION");
+    return ok ? 0 : 1;
+}
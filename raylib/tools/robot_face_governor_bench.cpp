@@ -0,0 +1,191 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Adaptive Quality Governor Benchmark
+ *
+ *   Opens a window and first times the C++ face at every quality level. Then it plays
+ *   a stress profile twice, once with the level pinned at full quality and once with
+ *   the QualityGovernor: calm, then a load phase, then calm again while the governor
+ *   climbs back. The load phase draws the face several times per frame, like a device
+ *   that renders N times slower, so lower quality levels really do take less time.
+ *   Reports over-budget frames and p99 for each run, every level change, and how long
+ *   the governor takes to get back to full quality once the load is gone.
+ *
+ *   Frame time is the busy part of the frame (update and draw, without EndDrawing),
+ *   the same value robot_face_cpp feeds its governor.
+ *
+ *   On GPU-less hosts run it on Mesa llvmpipe:
+ *     LIBGL_ALWAYS_SOFTWARE=1 ./robot_face_governor_bench
+ *
+ *   Usage:
+ *     robot_face_governor_bench [--budget 16.67] [--load N] [--calm 300] [--stress 600]
+ *                               [--recover 900]
+ *
+ *******************************************************************************************/
+
+#include "robot_face.hpp"
+#include "robot_face_quality.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace robotface;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr int kWidth = Config::SCREEN_WIDTH;
+constexpr int kHeight = Config::SCREEN_HEIGHT;
+constexpr int kWarmupFrames = 60;
+constexpr int kCalibrationFrames = 120;
+constexpr float kDeltaTime = 1.0f / 60.0f;
+
+// calm frames, then stress frames drawing the face `loadDraws` times, then recovery (calm) frames
+struct Profile {
+    int calmFrames = 300;
+    int stressFrames = 600;
+    int recoverFrames = 900;
+    int loadDraws = 0;   // 0: derived from calibration
+    [[nodiscard]] int frames() const noexcept { return calmFrames + stressFrames + recoverFrames; }
+    [[nodiscard]] bool stressed(int frame) const noexcept {
+        return frame >= calmFrames && frame < calmFrames + stressFrames;
+    }
+};
+
+struct Run {
+    std::vector<double> frameMs;
+    int overBudget = 0;
+    int overBudgetStressed = 0;
+    int changes = 0;
+    int recoveryFrames = -1;   // Frames after the load ends until level 0 again (-1: never)
+    int lowestLevel = 0;
+};
+
+// Busy time of one frame: update and `draws` draws
+double frame(RobotFace& face, int draws) {
+    const auto start = Clock::now();
+    face.update(kDeltaTime);
+    BeginDrawing();
+    for (int i = 0; i < draws; i++) face.draw(kWidth, kHeight);
+    const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    EndDrawing();
+    return ms;
+}
+
+double calibrate(int level) {
+    RobotFace face(0.8f);
+    face.setQuality(kQualityLevels[level]);
+    double totalMs = 0.0;
+    for (int i = 0; i < kWarmupFrames + kCalibrationFrames && !WindowShouldClose(); i++) {
+        const double ms = frame(face, 1);
+        if (i >= kWarmupFrames) totalMs += ms;
+    }
+    face.unloadStaticLayer();
+    return totalMs / kCalibrationFrames;
+}
+
+Run play(const Profile& profile, const GovernorConfig& config, bool governed) {
+    RobotFace face(0.8f);
+    QualityGovernor governor(config);
+    face.setQuality(governor.settings());
+    for (int i = 0; i < kWarmupFrames && !WindowShouldClose(); i++) frame(face, 1);
+
+    Run run;
+    run.frameMs.reserve(static_cast<size_t>(profile.frames()));
+    const int loadEnd = profile.calmFrames + profile.stressFrames;
+    for (int i = 0; i < profile.frames() && !WindowShouldClose(); i++) {
+        const bool stressed = profile.stressed(i);
+        const double ms = frame(face, stressed ? profile.loadDraws : 1);
+        run.frameMs.push_back(ms);
+        if (ms > config.budgetMs) {
+            run.overBudget++;
+            if (stressed) run.overBudgetStressed++;
+        }
+
+        if (governed && governor.addFrame(static_cast<float>(ms))) {
+            run.changes++;
+            run.lowestLevel = std::max(run.lowestLevel, governor.level());
+            std::printf("  frame %5d %-8s %-11s -> %-11s (%.2f ms)\n", i, stressed ? "stress" : "calm",
+                        kQualityLevelNames[governor.previousLevel()], governor.levelName(), ms);
+            face.setQuality(governor.settings());
+            if (i >= loadEnd && governor.level() == 0) run.recoveryFrames = i - loadEnd + 1;
+        }
+    }
+    if (governed && run.recoveryFrames < 0 && run.lowestLevel == 0) run.recoveryFrames = 0;
+
+    face.unloadStaticLayer();
+    return run;
+}
+
+double percentile(std::vector<double> values, int percent) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    return values[values.size() * static_cast<size_t>(percent) / 100];
+}
+
+void report(const char* name, const Run& run) {
+    std::printf("%-10s %9.3f %9.3f %11d %13d %8d", name, percentile(run.frameMs, 50), percentile(run.frameMs, 99),
+                run.overBudget, run.overBudgetStressed, run.changes);
+    if (run.recoveryFrames >= 0) std::printf(" %9d\n", run.recoveryFrames);
+    else std::printf(" %9s\n", "-");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    GovernorConfig config;
+    Profile profile;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--budget") == 0) config.budgetMs = static_cast<float>(std::atof(argv[i + 1]));
+        else if (std::strcmp(argv[i], "--load") == 0) profile.loadDraws = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--calm") == 0) profile.calmFrames = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--stress") == 0) profile.stressFrames = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--recover") == 0) profile.recoverFrames = std::atoi(argv[i + 1]);
+    }
+    if (config.budgetMs <= 0.0f || profile.calmFrames < 1 || profile.stressFrames < 1 || profile.recoverFrames < 1 ||
+        profile.loadDraws < 0) {
+        std::fprintf(stderr, "budget, calm, stress and recover must be positive, load must not be negative\n");
+        return 1;
+    }
+
+    InitWindow(kWidth, kHeight, "Robot Face - Quality Governor Benchmark");
+    SetTargetFPS(0);              // Uncapped: the budget is checked against busy time
+
+    double levelMs[kQualityLevelCount];
+    for (int level = 0; level < kQualityLevelCount; level++) levelMs[level] = calibrate(level);
+
+    // Default load: full quality lands about a quarter over budget
+    if (profile.loadDraws == 0) {
+        const double draws = std::ceil(config.budgetMs * 1.25 / std::max(levelMs[0], 1e-6));
+        profile.loadDraws = static_cast<int>(std::clamp(draws, 2.0, 100000.0));
+    }
+
+    std::printf("\n%dx%d, budget %.2f ms, load phase draws the face %d times per frame\n", kWidth, kHeight,
+                static_cast<double>(config.budgetMs), profile.loadDraws);
+    std::printf("\n%-12s %9s %12s\n", "level", "ms/frame", "under load");
+    for (int level = 0; level < kQualityLevelCount; level++) {
+        std::printf("%d %-10s %9.3f %12.3f\n", level, kQualityLevelNames[level], levelMs[level],
+                    levelMs[level] * profile.loadDraws);
+    }
+
+    std::printf("\nprofile: %d calm, %d stress, %d recovery frames\n", profile.calmFrames, profile.stressFrames,
+                profile.recoverFrames);
+    const Run pinned = play(profile, config, false);
+    std::printf("governor level changes:\n");
+    const Run governed = play(profile, config, true);
+
+    CloseWindow();
+
+    std::printf("\n%-10s %9s %9s %11s %13s %8s %9s\n", "", "p50 ms", "p99 ms", "over budget", "during stress",
+                "changes", "recovery");
+    report("pinned", pinned);
+    report("governed", governed);
+    if (governed.lowestLevel > 0 && governed.recoveryFrames < 0) {
+        std::printf("\ngovernor did not return to full quality within %d recovery frames\n", profile.recoverFrames);
+    }
+    return 0;
+}
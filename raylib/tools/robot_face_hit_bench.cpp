@@ -0,0 +1,192 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Hit Testing Benchmark
+ *
+ *   Tiles a fleet dashboard of faces on one output (some faces dragged on top of
+ *   others, some speaking) and times FaceScene::hitTest at random pointer positions,
+ *   against a linear scan over every face. Then drags a share of the faces each frame
+ *   and times the incremental grid update against rebuilding the grid from scratch.
+ *   Every grid answer is checked against the linear scan, before and after the moves.
+ *
+ *   Usage:
+ *     robot_face_hit_bench [--faces 10000] [--queries 2000000] [--frames 100]
+ *
+ *******************************************************************************************/
+
+#include "robot_face_scene.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace robotface;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr int kColumns = 100;
+constexpr float kScale = 0.1f;                                   // 80 x 60 pixel tiles
+constexpr float kTileWidth = Config::SCREEN_WIDTH * kScale + 4.0f;
+constexpr float kTileHeight = Config::SCREEN_HEIGHT * kScale + 4.0f;
+constexpr float kTouchSlop = 10.0f;                              // Design units
+constexpr float kDragShare = 0.01f;                              // Faces moved per frame
+
+// Deterministic, so every run queries the same points
+struct Random {
+    uint32_t state = 12345u;
+    float next() noexcept {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<float>(state >> 8) / 16777216.0f;
+    }
+};
+
+struct Fleet {
+    std::vector<FaceTransform> transforms;
+    std::vector<float> openness;
+    float width = 0.0f;
+    float height = 0.0f;
+};
+
+// Reference: every face, topmost first
+FaceScene::Hit linearHitTest(const FaceScene& scene, const Fleet& fleet, Point2 p, float slop) {
+    for (size_t i = fleet.transforms.size(); i-- > 0;) {
+        const FaceTransform& t = fleet.transforms[i];
+        const HitBox box{t.x, t.y, t.x + Config::SCREEN_WIDTH * t.scale, t.y + Config::SCREEN_HEIGHT * t.scale};
+        if (!box.contains(p)) continue;
+        const Point2 design{(p.x - t.x) / t.scale, (p.y - t.y) / t.scale};
+        const auto face = static_cast<FaceScene::FaceId>(i);
+        return FaceScene::Hit{face, hitTestFace(kFaceGeometry, design, scene.happiness(face), fleet.openness[i], slop)};
+    }
+    return FaceScene::Hit{};
+}
+
+std::vector<Point2> makeQueries(const Fleet& fleet, size_t count, Random& random) {
+    std::vector<Point2> points(count);
+    for (Point2& p : points) p = Point2{random.next() * fleet.width, random.next() * fleet.height};
+    return points;
+}
+
+int verify(const FaceScene& scene, const Fleet& fleet, const std::vector<Point2>& points, size_t count) {
+    int mismatches = 0;
+    for (size_t i = 0; i < std::min(count, points.size()); i++) {
+        const FaceScene::Hit grid = scene.hitTest(0, points[i], kTouchSlop);
+        const FaceScene::Hit linear = linearHitTest(scene, fleet, points[i], kTouchSlop);
+        if ((grid.face != linear.face || grid.region != linear.region) && mismatches++ == 0) {
+            std::printf("(%.1f, %.1f): grid face %u %s, linear face %u %s\n", static_cast<double>(points[i].x),
+                        static_cast<double>(points[i].y), grid.face, kFaceRegionNames[static_cast<int>(grid.region)],
+                        linear.face, kFaceRegionNames[static_cast<int>(linear.region)]);
+        }
+    }
+    return mismatches;
+}
+
+template <typename Fn>
+double seconds(Fn fn) {
+    const auto start = Clock::now();
+    fn();
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t faces = 10000;
+    size_t queries = 2000000;
+    int frames = 100;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--faces") == 0) faces = static_cast<size_t>(std::atol(argv[i + 1]));
+        else if (std::strcmp(argv[i], "--queries") == 0) queries = static_cast<size_t>(std::atol(argv[i + 1]));
+        else if (std::strcmp(argv[i], "--frames") == 0) frames = std::atoi(argv[i + 1]);
+    }
+    if (faces < 1 || queries < 1 || frames < 0) {
+        std::fprintf(stderr, "faces and queries must be positive\n");
+        return 1;
+    }
+
+    // Tiled dashboard; every 16th face is dragged half a tile off its slot, over a neighbour
+    FaceScene scene(faces, 1);
+    Fleet fleet;
+    const int rows = static_cast<int>((faces + kColumns - 1) / kColumns);
+    fleet.width = kColumns * kTileWidth;
+    fleet.height = static_cast<float>(rows) * kTileHeight;
+    for (size_t i = 0; i < faces; i++) {
+        FaceTransform t{static_cast<float>(i % kColumns) * kTileWidth, static_cast<float>(i / kColumns) * kTileHeight,
+                        kScale};
+        if (i % 16 == 0) {
+            t.x += kTileWidth * 0.5f;
+            t.y += kTileHeight * 0.5f;
+        }
+        scene.add(t, 0, 0, FaceScene::kNoScript, static_cast<float>(i % 5) * 0.25f);
+        const float openness = i % 3 == 0 ? static_cast<float>(i % 7) / 6.0f : 0.0f;
+        scene.setMouthOpenness(static_cast<FaceScene::FaceId>(i), openness);
+        fleet.transforms.push_back(t);
+        fleet.openness.push_back(openness);
+    }
+    for (int i = 0; i < 30; i++) scene.update(1.0f / 60.0f);   // Emotions settle
+
+    Random random;
+    const std::vector<Point2> points = makeQueries(fleet, queries, random);
+    int mismatches = verify(scene, fleet, points, 200000);
+
+    // Queries
+    int regions[5] = {};
+    const double gridSeconds = seconds([&] {
+        for (const Point2& p : points) regions[static_cast<int>(scene.hitTest(0, p, kTouchSlop).region)]++;
+    });
+    const size_t linearQueries = std::max<size_t>(queries / 1000, 100);
+    uint32_t linearSum = 0;
+    const double linearSeconds = seconds([&] {
+        for (size_t i = 0; i < linearQueries; i++) linearSum += linearHitTest(scene, fleet, points[i], kTouchSlop).face;
+    });
+
+    // Drags: a share of the faces moves every frame
+    const auto dragged = std::max<size_t>(static_cast<size_t>(faces * kDragShare), 1);
+    std::vector<FaceScene::FaceId> moving(dragged);
+    std::vector<FaceTransform> targets(dragged);
+    double moveSeconds = 0.0;
+    for (int frame = 0; frame < frames; frame++) {
+        for (size_t i = 0; i < dragged; i++) {
+            moving[i] = static_cast<FaceScene::FaceId>(random.next() * faces) % static_cast<FaceScene::FaceId>(faces);
+            FaceTransform t = fleet.transforms[moving[i]];
+            t.x = std::clamp(t.x + (random.next() - 0.5f) * 60.0f, 0.0f, fleet.width - kTileWidth);
+            t.y = std::clamp(t.y + (random.next() - 0.5f) * 60.0f, 0.0f, fleet.height - kTileHeight);
+            targets[i] = t;
+            fleet.transforms[moving[i]] = t;
+        }
+        moveSeconds += seconds([&] {
+            for (size_t i = 0; i < dragged; i++) scene.setTransform(moving[i], targets[i]);
+        });
+    }
+    mismatches += verify(scene, fleet, points, 200000);
+
+    // What a rebuild per frame would cost instead
+    const double rebuildSeconds = seconds([&] {
+        HitGrid grid(FaceScene::kHitCellSize, faces * 2);
+        for (size_t i = 0; i < faces; i++) {
+            const FaceTransform& t = fleet.transforms[i];
+            grid.insert(static_cast<uint32_t>(i), HitBox{t.x, t.y, t.x + Config::SCREEN_WIDTH * t.scale,
+                                                          t.y + Config::SCREEN_HEIGHT * t.scale});
+        }
+    });
+
+    std::printf("%zu faces on a %.0f x %.0f output, %zu random queries (slop %.0f)\n", faces,
+                static_cast<double>(fleet.width), static_cast<double>(fleet.height), queries,
+                static_cast<double>(kTouchSlop));
+    std::printf("  regions: none %d, face %d, left-eye %d, right-eye %d, mouth %d\n", regions[0], regions[1],
+                regions[2], regions[3], regions[4]);
+    std::printf("\n%-28s %14s %12s\n", "", "queries/s", "ns/query");
+    std::printf("%-28s %14.0f %12.1f\n", "grid", queries / gridSeconds, gridSeconds * 1e9 / queries);
+    std::printf("%-28s %14.0f %12.1f\n", "linear scan", linearQueries / linearSeconds,
+                linearSeconds * 1e9 / linearQueries);
+    if (frames > 0) {
+        std::printf("\n%zu faces dragged per frame, %d frames\n", dragged, frames);
+        std::printf("  incremental update %10.1f us/frame\n", moveSeconds * 1e6 / frames);
+        std::printf("  full rebuild       %10.1f us/frame\n", rebuildSeconds * 1e6);
+    }
+    std::printf("\n%d mismatches against the linear scan (checksum %u)\n", mismatches, linearSum);
+
+    return mismatches == 0 ? 0 : 1;
+}
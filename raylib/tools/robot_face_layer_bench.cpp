@@ -0,0 +1,169 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Static Layer Cache Benchmark
+ *
+ *   Opens a window and renders the face with the static layer drawn directly every
+ *   frame, then from its cached render texture, for the C++ and the modular C version.
+ *   Reports frame time (uncapped, including EndDrawing / buffer swap) and, for C++,
+ *   the per-frame submission counters of the raylib canvas (FrameStats).
+ *
+ *   On GPU-less hosts run it on Mesa llvmpipe:
+ *     LIBGL_ALWAYS_SOFTWARE=1 ./robot_face_layer_bench
+ *   (raylib logs "GL: Renderer: llvmpipe ..." at startup)
+ *
+ *   Usage:
+ *     robot_face_layer_bench [--frames 600] [--impl cpp|c|both]
+ *
+ *******************************************************************************************/
+
+#include "robot_face.h"
+#include "robot_face.hpp"
+#include "robot_face_frame_stats.hpp"
+#include "robot_face_raylib_canvas.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr int kWidth = robotface::Config::SCREEN_WIDTH;
+constexpr int kHeight = robotface::Config::SCREEN_HEIGHT;
+constexpr int kWarmupFrames = 60;
+
+struct Result {
+    double meanMs = 0.0;
+    double p99Ms = 0.0;
+    bool counted = false;
+    robotface::FrameStats stats;   // Per frame (totals / measured frames)
+};
+
+template <typename FrameFn>
+Result timeFrames(int frames, FrameFn drawFrame) {
+    std::vector<double> frameMs;
+    frameMs.reserve(static_cast<size_t>(frames));
+
+    for (int i = 0; i < kWarmupFrames + frames && !WindowShouldClose(); i++) {
+        const auto start = Clock::now();
+        BeginDrawing();
+        drawFrame(i >= kWarmupFrames);
+        EndDrawing();
+        if (i >= kWarmupFrames) frameMs.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+
+    Result result;
+    if (frameMs.empty()) return result;
+    for (double ms : frameMs) result.meanMs += ms;
+    result.meanMs /= static_cast<double>(frameMs.size());
+    std::sort(frameMs.begin(), frameMs.end());
+    result.p99Ms = frameMs[frameMs.size() * 99 / 100];
+    return result;
+}
+
+Result runCpp(int frames, bool cached) {
+    robotface::RobotFace face(0.8f);
+    robotface::RaylibLayerCache cache;
+    cache.setEnabled(cached);
+
+    robotface::FrameStats total;
+    uint32_t measured = 0;
+    Result result = timeFrames(frames, [&](bool measure) {
+        face.update(1.0f / 60.0f);
+        robotface::FrameStats stats;
+        robotface::RaylibCanvas canvas(&cache, kWidth, kHeight);
+        canvas.setStats(&stats);
+        face.draw(canvas, kWidth, kHeight);
+        if (measure) {
+            total += stats;
+            measured++;
+        }
+    });
+
+    cache.unload();
+    if (measured > 0) {
+        result.counted = true;
+        result.stats.drawCalls = total.drawCalls / measured;
+        result.stats.vertices = total.vertices / measured;
+        result.stats.triangles = total.triangles / measured;
+        result.stats.batchFlushes = total.batchFlushes / measured;
+        result.stats.stateChanges = total.stateChanges / measured;
+        result.stats.glyphs = total.glyphs / measured;
+    }
+    return result;
+}
+
+Result runC(int frames, bool cached) {
+    ::RobotFace face;
+    InitRobotFace(&face);
+    SetRobotFaceStaticLayerCache(cached);
+
+    Result result = timeFrames(frames, [&](bool) {
+        UpdateRobotFace(&face, 1.0f / 60.0f);
+        DrawRobotFace(&face, kWidth, kHeight);
+    });
+
+    UnloadRobotFaceStaticLayer();
+    return result;
+}
+
+void report(const char* name, const Result& result) {
+    std::printf("%-12s %9.3f %9.3f", name, result.meanMs, result.p99Ms);
+    if (result.counted) {
+        const robotface::FrameStats& s = result.stats;
+        std::printf(" %6u %6u %6u %8u %7u %7u\n", s.drawCalls, s.vertices, s.triangles, s.batchFlushes,
+                    s.stateChanges, s.glyphs);
+    } else {
+        std::printf(" %6s %6s %6s %8s %7s %7s\n", "-", "-", "-", "-", "-", "-");
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int frames = 600;
+    const char* impl = "both";
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--frames") == 0) frames = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--impl") == 0) impl = argv[i + 1];
+    }
+    if (frames < 1) {
+        std::fprintf(stderr, "frames must be positive\n");
+        return 1;
+    }
+
+    const bool runCppImpl = std::strcmp(impl, "c") != 0;
+    const bool runCImpl = std::strcmp(impl, "cpp") != 0;
+
+    InitWindow(kWidth, kHeight, "Robot Face - Static Layer Benchmark");
+    SetTargetFPS(0);              // Uncapped: measure the frame, not the limiter
+
+    Result cppDirect, cppCached, cDirect, cCached;
+    if (runCppImpl) {
+        cppDirect = runCpp(frames, false);
+        cppCached = runCpp(frames, true);
+    }
+    if (runCImpl) {
+        cDirect = runC(frames, false);
+        cCached = runC(frames, true);
+    }
+
+    CloseWindow();
+
+    std::printf("\n%d frames, %dx%d\n", frames, kWidth, kHeight);
+    std::printf("%-12s %9s %9s %6s %6s %6s %8s %7s %7s\n", "", "mean ms", "p99 ms", "draws", "verts", "tris",
+                "flushes", "states", "glyphs");
+    if (runCppImpl) {
+        report("cpp direct", cppDirect);
+        report("cpp cached", cppCached);
+    }
+    if (runCImpl) {
+        report("c direct", cDirect);
+        report("c cached", cCached);
+    }
+    return 0;
+}
@@ -0,0 +1,227 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Lip Sync Latency Check
+ *
+ *   Plays a WAV fixture into LipSync in real time and measures, for every speech onset,
+ *   the wall time until the published mouth openness crosses the threshold:
+ *   - ring: samples pushed in 1 ms chunks (live capture, TTS callback)
+ *   - file: startFile() with real-time pacing (audio clock starts at the call)
+ *
+ *   Without --fixture, a synthetic fixture (voiced bursts separated by silence) is written
+ *   to lipsync_fixture.wav and used. Onsets are detected in the clip itself, so any
+ *   recording with pauses works. Exit status is 1 when a latency exceeds one 60 FPS frame.
+ *
+ *   Usage:
+ *     robot_face_lipsync_bench [--fixture speech.wav] [--threshold 0.5] [--bands]
+ *
+ *******************************************************************************************/
+
+#include "robot_face_lipsync.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace robotface;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr double kFrameMs = 1000.0 / 60.0;
+constexpr int kOnsetLevel = 1000;          // |sample| that counts as speech
+constexpr double kOnsetGapSeconds = 0.1;   // Silence required before an onset
+
+// Voiced bursts: 140 Hz fundamental with harmonics, 2 ms ramps
+PcmClip makeFixture() {
+    PcmClip clip;
+    clip.sampleRate = 16000;
+    const int syllables = 12;
+    const double spacing = 0.5;
+    const double length = 0.18;
+    clip.samples.assign(static_cast<size_t>(clip.sampleRate * (0.3 + syllables * spacing)), 0);
+
+    for (int s = 0; s < syllables; s++) {
+        const size_t begin = static_cast<size_t>((0.3 + s * spacing) * clip.sampleRate);
+        const size_t count = static_cast<size_t>(length * clip.sampleRate);
+        for (size_t i = 0; i < count; i++) {
+            const double t = static_cast<double>(i) / clip.sampleRate;
+            const double ramp = std::min({1.0, t / 0.002, (length - t) / 0.002});
+            double value = 0.0;
+            for (int h = 1; h <= 6; h++) value += std::sin(2.0 * 3.14159265358979 * 140.0 * h * t) / h;
+            clip.samples[begin + i] = static_cast<int16_t>(std::lround(value * ramp * 9000.0));
+        }
+    }
+    return clip;
+}
+
+std::vector<size_t> findOnsets(const PcmClip& clip) {
+    std::vector<size_t> onsets;
+    const size_t gap = static_cast<size_t>(kOnsetGapSeconds * clip.sampleRate);
+    size_t lastLoud = 0;
+    bool seenLoud = false;
+
+    for (size_t i = 0; i < clip.samples.size(); i++) {
+        if (std::abs(static_cast<int>(clip.samples[i])) < kOnsetLevel) continue;
+        if (!seenLoud || i - lastLoud > gap) onsets.push_back(i);
+        seenLoud = true;
+        lastLoud = i;
+    }
+    return onsets;
+}
+
+constexpr auto kPollInterval = std::chrono::microseconds(100);   // Sleep, so one core is enough
+
+// Poll until the openness crosses the threshold (or the deadline passes)
+bool waitForOpen(const LipSync& lipSync, float threshold, Clock::time_point deadline) {
+    while (Clock::now() < deadline) {
+        if (lipSync.openness() >= threshold) return true;
+        std::this_thread::sleep_for(kPollInterval);
+    }
+    return false;
+}
+
+struct Stats {
+    std::vector<double> latencies;
+    int missed = 0;
+};
+
+// Push 1 ms chunks on the audio clock; poll the published value in between
+Stats measureRing(const PcmClip& clip, const std::vector<size_t>& onsets, float threshold, bool bands) {
+    LipSyncConfig config;
+    config.sampleRate = clip.sampleRate;
+    config.bands = bands;
+    LipSync lipSync(config);
+    lipSync.startStream();
+
+    Stats stats;
+    const size_t chunk = static_cast<size_t>(clip.sampleRate / 1000);
+    const auto start = Clock::now();
+    auto dueAt = [&](size_t samples) {
+        return start + std::chrono::microseconds(samples * 1000000 / static_cast<size_t>(clip.sampleRate));
+    };
+
+    size_t pos = 0;
+    size_t next = 0;
+    bool waiting = false;
+    Clock::time_point pushedAt;
+
+    while (pos < clip.samples.size() || waiting) {
+        // Everything the audio clock has played so far
+        while (pos < clip.samples.size() && dueAt(pos + chunk) <= Clock::now()) {
+            const size_t count = std::min(chunk, clip.samples.size() - pos);
+            lipSync.push(clip.samples.data() + pos, count);
+            if (!waiting && next < onsets.size() && onsets[next] < pos + count) {
+                pushedAt = Clock::now();   // The onset sample is in the buffer: the clock starts here
+                waiting = true;
+            }
+            pos += count;
+        }
+
+        if (waiting) {
+            const auto now = Clock::now();
+            if (lipSync.openness() >= threshold) {
+                stats.latencies.push_back(std::chrono::duration<double, std::milli>(now - pushedAt).count());
+                waiting = false;
+                next++;
+            } else if (now - pushedAt > std::chrono::milliseconds(100)) {
+                stats.missed++;
+                waiting = false;
+                next++;
+            }
+        }
+
+        std::this_thread::sleep_for(kPollInterval);
+    }
+
+    lipSync.stop();
+    return stats;
+}
+
+// File source, paced by LipSync itself; onsets are due at start + sample / rate
+Stats measureFile(const char* path, const PcmClip& clip, const std::vector<size_t>& onsets, float threshold, bool bands) {
+    LipSyncConfig config;
+    config.bands = bands;
+    LipSync lipSync(config);
+
+    Stats stats;
+    const auto start = Clock::now();
+    if (!lipSync.startFile(path, LipSync::Pacing::RealTime)) {
+        stats.missed = static_cast<int>(onsets.size());
+        return stats;
+    }
+
+    for (size_t onset : onsets) {
+        const auto due = start + std::chrono::microseconds(onset * 1000000 / static_cast<size_t>(clip.sampleRate));
+        std::this_thread::sleep_until(due);
+
+        if (waitForOpen(lipSync, threshold, due + std::chrono::milliseconds(100))) {
+            stats.latencies.push_back(std::chrono::duration<double, std::milli>(Clock::now() - due).count());
+        } else {
+            stats.missed++;
+        }
+    }
+
+    lipSync.stop();
+    return stats;
+}
+
+bool report(const char* name, Stats stats) {
+    if (stats.latencies.empty()) {
+        std::printf("%-5s no onset detected (%d missed)\n", name, stats.missed);
+        return false;
+    }
+
+    std::sort(stats.latencies.begin(), stats.latencies.end());
+    double sum = 0.0;
+    for (double value : stats.latencies) sum += value;
+    const double worst = stats.latencies.back();
+
+    std::printf("%-5s %6zu %9.2f %9.2f %9.2f %7d  %s\n", name, stats.latencies.size(),
+                sum / static_cast<double>(stats.latencies.size()),
+                stats.latencies[stats.latencies.size() / 2], worst, stats.missed,
+                (worst < kFrameMs && stats.missed == 0) ? "under one frame" : "OVER BUDGET");
+    return worst < kFrameMs && stats.missed == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* fixture = nullptr;
+    float threshold = 0.5f;
+    bool bands = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--fixture") == 0 && i + 1 < argc) fixture = argv[++i];
+        else if (std::strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) threshold = static_cast<float>(std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--bands") == 0) bands = true;
+    }
+
+    PcmClip clip;
+    if (!fixture) {
+        fixture = "lipsync_fixture.wav";
+        clip = makeFixture();
+        if (!saveWav(fixture, clip)) {
+            std::fprintf(stderr, "cannot write %s\n", fixture);
+            return 1;
+        }
+    }
+    if (!loadWav(fixture, clip)) {
+        std::fprintf(stderr, "cannot read %s (PCM16 WAV expected)\n", fixture);
+        return 1;
+    }
+
+    const std::vector<size_t> onsets = findOnsets(clip);
+    std::printf("Fixture: %s, %d Hz, %.2f s, %zu onsets, threshold %.2f%s\n", fixture, clip.sampleRate,
+                static_cast<double>(clip.samples.size()) / clip.sampleRate, onsets.size(), threshold,
+                bands ? ", band energies on" : "");
+    std::printf("Frame budget: %.2f ms\n\n", kFrameMs);
+    std::printf("%-5s %6s %9s %9s %9s %7s\n", "input", "onsets", "mean ms", "p50 ms", "max ms", "missed");
+
+    const bool ringOk = report("ring", measureRing(clip, onsets, threshold, bands));
+    const bool fileOk = report("file", measureFile(fixture, clip, onsets, threshold, bands));
+    return (ringOk && fileOk) ? 0 : 1;
+}
@@ -0,0 +1,244 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Multi-Output Benchmark
+ *
+ *   Three outputs of one face: an 800x600 head display, a 320x240 RGB565 status LCD and a
+ *   200x150 console thumbnail. Drives the face through a sweep of emotions, blinks, speech
+ *   and gaze and times, per frame:
+ *   - independent renders: the software rasterizer once per output (+ RGB565 packing)
+ *   - render once, every pyramid level and output recomputed (portable loops, then SSE2)
+ *   - render once, only what the frame's damage covers recomputed (SSE2)
+ *   The SSE2 and portable paths must match byte for byte, and so must the damage-tracked
+ *   and the full pyramid. The derived outputs' mean difference from independent renders
+ *   is printed (filtering, not rasterization, so they are close but not equal).
+ *
+ *   No window: software rasterizer only.
+ *
+ *   Usage:
+ *     robot_face_output_bench [--frames 600]
+ *
+ *******************************************************************************************/
+
+#include "robot_face.hpp"
+#include "robot_face_outputs.hpp"
+#include "robot_face_soft_canvas.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace robotface;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+using RobotFace = robotface::RobotFace;   // Not the C face from robot_face_soft.h
+
+constexpr float kDeltaTime = 1.0f / 60.0f;
+constexpr int kRepeats = 3;
+constexpr OutputSpec kOutputs[] = {
+    {800, 600, PixelFormat::Rgba8888},   // Head display
+    {320, 240, PixelFormat::Rgb565},     // Status LCD
+    {200, 150, PixelFormat::Rgba8888},   // Console thumbnail
+};
+constexpr size_t kOutputCount = sizeof(kOutputs) / sizeof(kOutputs[0]);
+
+// Deterministic input sweep: emotion steps, blinks, speech bursts, a circling gaze
+void driveFace(RobotFace& face, int frame) {
+    const float t = static_cast<float>(frame) * kDeltaTime;
+    if (frame % 90 == 0) face.animateEmotion(static_cast<float>((frame / 90) % 5) * 0.25f);
+    if (frame % 47 == 0) face.triggerBlink();
+    face.update(kDeltaTime);
+    const float speech = std::sin(t * 9.0f) * std::sin(t * 0.7f);
+    face.setMouthOpenness(speech > 0.0f ? speech : 0.0f);
+    face.setPupilOffset(20.0f * std::cos(t * 1.3f), 20.0f * std::sin(t * 1.7f));
+}
+
+// Full detail, no status text (the software rasterizer draws no text)
+constexpr QualitySettings kQuality{Config::MOUTH_SEGMENTS, true, false, false, 1.0f};
+
+void render(const RobotFace& face, SoftCanvas& target) {
+    SoftwareCanvas canvas(target);
+    face.draw(canvas, Config::SCREEN_WIDTH, Config::SCREEN_HEIGHT);
+}
+
+// One software render per output, the way it is done without a pyramid
+class IndependentOutputs {
+public:
+    IndependentOutputs() {
+        for (size_t i = 0; i < kOutputCount; i++) {
+            const OutputSpec& spec = kOutputs[i];
+            m_rgba[i].resize(static_cast<size_t>(spec.width) * spec.height * 4);
+            m_converted[i].resize(static_cast<size_t>(spec.width) * spec.height * bytesPerPixel(spec.format));
+            InitSoftCanvas(&m_targets[i], m_rgba[i].data(), spec.width, spec.height);
+        }
+    }
+
+    void draw(const RobotFace& face) {
+        for (size_t i = 0; i < kOutputCount; i++) {
+            render(face, m_targets[i]);
+            if (kOutputs[i].format != PixelFormat::Rgba8888) {
+                convertPixels(m_rgba[i].data(), m_converted[i].data(), kOutputs[i].width * kOutputs[i].height,
+                              kOutputs[i].format);
+            }
+        }
+    }
+
+    [[nodiscard]] const uint8_t* pixels(size_t i) const noexcept {
+        return kOutputs[i].format == PixelFormat::Rgba8888 ? m_rgba[i].data() : m_converted[i].data();
+    }
+
+private:
+    SoftCanvas m_targets[kOutputCount];
+    std::vector<uint8_t> m_rgba[kOutputCount];
+    std::vector<uint8_t> m_converted[kOutputCount];
+};
+
+size_t outputBytes(size_t i) {
+    return static_cast<size_t>(kOutputs[i].width) * kOutputs[i].height * bytesPerPixel(kOutputs[i].format);
+}
+
+bool sameOutputs(const OutputPyramid& a, const OutputPyramid& b) {
+    for (size_t i = 0; i < kOutputCount; i++) {
+        if (std::memcmp(a.pixels(i), b.pixels(i), outputBytes(i)) != 0) return false;
+    }
+    return true;
+}
+
+// Mean per-channel difference (RGB565 compared in its 5/6/5-bit channels)
+double meanDifference(const uint8_t* a, const uint8_t* b, size_t i) {
+    const size_t pixels = static_cast<size_t>(kOutputs[i].width) * kOutputs[i].height;
+    double sum = 0.0;
+    if (kOutputs[i].format == PixelFormat::Rgb565) {
+        for (size_t p = 0; p < pixels; p++) {
+            const int va = a[2 * p] | a[2 * p + 1] << 8;
+            const int vb = b[2 * p] | b[2 * p + 1] << 8;
+            sum += std::abs((va >> 11) - (vb >> 11)) + std::abs(((va >> 5) & 63) - ((vb >> 5) & 63)) +
+                   std::abs((va & 31) - (vb & 31));
+        }
+        return sum / (pixels * 3);
+    }
+    for (size_t p = 0; p < pixels * 4; p++) sum += std::abs(a[p] - b[p]);
+    return sum / (pixels * 4);
+}
+
+// One pass over the input sweep, milliseconds per frame
+template <typename DrawFn>
+double timePass(int frames, DrawFn draw) {
+    RobotFace face(0.8f);
+    face.setQuality(kQuality);
+    const auto start = Clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        driveFace(face, frame);
+        draw(face);
+    }
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count() / frames;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int frames = 600;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--frames") == 0) frames = std::atoi(argv[i + 1]);
+    }
+    if (frames < 1) {
+        std::fprintf(stderr, "frames must be positive\n");
+        return 1;
+    }
+
+    OutputPyramid tracked;    // SSE2, damage-tracked
+    OutputPyramid full;       // SSE2, everything every frame
+    OutputPyramid portable;   // Portable loops, everything every frame
+    for (OutputPyramid* pyramid : {&tracked, &full, &portable}) {
+        if (!pyramid->configure(kOutputs, kOutputCount)) {
+            std::fprintf(stderr, "Output configuration rejected\n");
+            return 1;
+        }
+    }
+    portable.setVectorized(false);
+    IndependentOutputs independent;
+
+    std::printf("Rendered at %dx%d, %d levels, %d damage tiles, SSE2 %s\n", tracked.source().width,
+                tracked.source().height, tracked.levelCount(), tracked.tileCount(),
+                OutputPyramid::vectorAvailable() ? "on" : "not built");
+    for (size_t i = 0; i < kOutputCount; i++) {
+        const bool bilinear = (kOutputs[0].width >> tracked.sourceLevel(i)) != kOutputs[i].width;
+        std::printf("  output %zu: %dx%d %s from level %d (%s)\n", i, kOutputs[i].width, kOutputs[i].height,
+                    kPixelFormatNames[static_cast<int>(kOutputs[i].format)], tracked.sourceLevel(i),
+                    bilinear ? "bilinear" : tracked.sourceLevel(i) == 0 ? "the frame" : "box level");
+    }
+
+    // Correctness: every path frame by frame
+    robotface::RobotFace face(0.8f);
+    face.setQuality(kQuality);
+    int mismatches = 0;
+    long long damaged = 0;
+    double difference[kOutputCount] = {};
+    for (int frame = 0; frame < frames; frame++) {
+        driveFace(face, frame);
+        for (OutputPyramid* pyramid : {&tracked, &full, &portable}) render(face, pyramid->source());
+        full.invalidate();
+        portable.invalidate();
+        tracked.present();
+        full.present();
+        portable.present();
+        independent.draw(face);
+        damaged += tracked.damagedTiles();
+
+        if ((!sameOutputs(tracked, full) || !sameOutputs(full, portable)) && mismatches++ == 0) {
+            std::printf("frame %d: outputs differ (damage-tracked %s full, SSE2 %s portable)\n", frame,
+                        sameOutputs(tracked, full) ? "==" : "!=", sameOutputs(full, portable) ? "==" : "!=");
+        }
+        for (size_t i = 0; i < kOutputCount; i++) {
+            difference[i] += meanDifference(tracked.pixels(i), independent.pixels(i), i);
+        }
+    }
+    std::printf("%d frames compared, %d differ; %.1f%% of tiles damaged per frame\n", frames, mismatches,
+                100.0 * damaged / (static_cast<double>(frames) * tracked.tileCount()));
+    std::printf("mean channel difference from independent renders:");
+    for (size_t i = 0; i < kOutputCount; i++) std::printf(" %.2f", difference[i] / frames);
+    std::printf("\n");
+
+    // Timing: best of kRepeats, passes interleaved; driving the face is subtracted
+    double driveOnly = 1e30;
+    double best[5] = {1e30, 1e30, 1e30, 1e30, 1e30};
+    for (int repeat = 0; repeat < kRepeats; repeat++) {
+        driveOnly = std::min(driveOnly, timePass(frames, [](robotface::RobotFace&) {}));
+        best[0] = std::min(best[0], timePass(frames, [&](robotface::RobotFace& f) { independent.draw(f); }));
+        best[1] = std::min(best[1], timePass(frames, [&](robotface::RobotFace& f) { render(f, full.source()); }));
+        best[2] = std::min(best[2], timePass(frames, [&](robotface::RobotFace& f) {
+            render(f, portable.source());
+            portable.invalidate();
+            portable.present();
+        }));
+        best[3] = std::min(best[3], timePass(frames, [&](robotface::RobotFace& f) {
+            render(f, full.source());
+            full.invalidate();
+            full.present();
+        }));
+        best[4] = std::min(best[4], timePass(frames, [&](robotface::RobotFace& f) {
+            render(f, tracked.source());
+            tracked.present();
+        }));
+    }
+    for (double& ms : best) ms -= driveOnly;
+
+    const char* labels[] = {
+        "independent renders (3)",
+        "render once (no outputs)",
+        "render once + full, portable",
+        "render once + full, SSE2",
+        "render once + damage, SSE2",
+    };
+    std::printf("\n%-30s %10s %10s %8s\n", "ms/frame", "total", "outputs", "vs 3x");
+    for (int row = 0; row < 5; row++) {
+        std::printf("%-30s %10.3f %10.3f %8.2f\n", labels[row], best[row], row >= 2 ? best[row] - best[1] : 0.0,
+                    best[row] / best[0]);
+    }
+
+    return mismatches == 0 ? 0 : 1;
+}
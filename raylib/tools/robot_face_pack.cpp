@@ -0,0 +1,135 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Asset Pack Tool
+ *
+ *   Packs baked assets (SDF font atlases from robot_face_font_baker, sprite sheets from
+ *   robot_face_baker, any other file as raw bytes) into one read-only, memory-mapped
+ *   asset pack (see robot_face_asset_pack.hpp), or lists and verifies a pack. The build
+ *   runs it to make robot_face_assets.rfpk for robot_face_cpp --assets.
+ *
+ *   The section type comes from the file's first four bytes (RFSF, RFSS, else RAW);
+ *   atlases and sprite sheets are parsed before they are packed and again, in place in
+ *   the mapping, by --list.
+ *
+ *   Usage:
+ *     robot_face_pack --out robot_face_assets.rfpk [--align 4096] name=file ...
+ *     robot_face_pack --list robot_face_assets.rfpk
+ *
+ *******************************************************************************************/
+
+#include "robot_face_asset_pack.hpp"
+#include "robot_face_sdf_font.hpp"
+#include "robot_face_sprite.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace robotface;
+
+namespace {
+
+bool readFile(const char* path, std::vector<uint8_t>& bytes) {
+    MappedFile file;
+    if (!file.open(path)) return false;
+    bytes.assign(file.data(), file.data() + file.size());
+    return true;
+}
+
+uint32_t sectionType(const std::vector<uint8_t>& bytes) {
+    uint32_t magic = 0;
+    if (bytes.size() >= sizeof(magic)) std::memcpy(&magic, bytes.data(), sizeof(magic));
+    return (magic == kAssetTypeSdfAtlas || magic == kAssetTypeSpriteSheet) ? magic : kAssetTypeRaw;
+}
+
+// Parses the formats the face knows; raw sections are only checksummed
+bool parses(uint32_t type, const uint8_t* data, size_t size) {
+    if (type == kAssetTypeSdfAtlas) {
+        SdfFont font;
+        return font.load(data, size);
+    }
+    if (type == kAssetTypeSpriteSheet) {
+        RfsSheet sheet;
+        return RfsOpen(&sheet, data, size);
+    }
+    return true;
+}
+
+std::string typeName(uint32_t type) {
+    char name[5] = {};
+    std::memcpy(name, &type, 4);
+    return name;
+}
+
+int list(const char* path) {
+    AssetPack pack;
+    if (!pack.open(path)) {
+        std::fprintf(stderr, "%s: %s\n", path, pack.error());
+        return 1;
+    }
+    std::printf("%s: %zu bytes, %zu sections, %u-byte alignment\n", path, pack.size(), pack.entries().size(),
+                pack.header().alignment);
+    bool ok = true;
+    for (const AssetEntry& entry : pack.entries()) {
+        const AssetView bytes = pack.view(entry);
+        const bool valid = pack.verify(entry);
+        const bool parsed = valid && parses(entry.type, bytes.data, bytes.size);
+        std::printf("  %-40s %s %10llu bytes at %8llu  crc %08x %s\n", entry.name, typeName(entry.type).c_str(),
+                    static_cast<unsigned long long>(entry.size), static_cast<unsigned long long>(entry.offset),
+                    entry.checksum, !valid ? "CHECKSUM MISMATCH" : (parsed ? "ok" : "DOES NOT PARSE"));
+        ok = ok && parsed;
+    }
+    return ok ? 0 : 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* outPath = nullptr;
+    uint32_t alignment = kAssetPackDefaultAlignment;
+    AssetPackWriter writer;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--list") == 0 && i + 1 < argc) return list(argv[i + 1]);
+        if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            outPath = argv[++i];
+            continue;
+        }
+        if (std::strcmp(argv[i], "--align") == 0 && i + 1 < argc) {
+            alignment = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+            continue;
+        }
+
+        const char* separator = std::strchr(argv[i], '=');
+        if (!separator || separator == argv[i]) {
+            std::fprintf(stderr, "Expected name=file, got %s\n", argv[i]);
+            return 1;
+        }
+        const std::string name(argv[i], static_cast<size_t>(separator - argv[i]));
+        std::vector<uint8_t> bytes;
+        if (!readFile(separator + 1, bytes)) {
+            std::fprintf(stderr, "Cannot read %s\n", separator + 1);
+            return 1;
+        }
+        const uint32_t type = sectionType(bytes);
+        if (!parses(type, bytes.data(), bytes.size())) {
+            std::fprintf(stderr, "%s is not a valid %s\n", separator + 1, typeName(type).c_str());
+            return 1;
+        }
+        if (!writer.add(name.c_str(), type, std::move(bytes))) {
+            std::fprintf(stderr, "Section name %s is too long or repeated\n", name.c_str());
+            return 1;
+        }
+    }
+    if (!outPath || writer.sectionCount() == 0) {
+        std::fprintf(stderr, "Usage: %s --out pack.rfpk [--align 4096] name=file ...\n       %s --list pack.rfpk\n",
+                     argv[0], argv[0]);
+        return 1;
+    }
+    if (!writer.write(outPath, alignment)) {
+        std::fprintf(stderr, "Cannot write %s (alignment must be a power of two >= 64)\n", outPath);
+        return 1;
+    }
+    return list(outPath);
+}
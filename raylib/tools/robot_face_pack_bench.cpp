@@ -0,0 +1,367 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Asset Pack Benchmark
+ *
+ *   Startup: time until the status font and the sprite sheet are ready to draw (atlas
+ *   pixels read as a texture upload would, first sprite frame decoded), three ways:
+ *   - pack:  map robot_face_assets.rfpk, verify both sections, parse in place
+ *            (and without the section checksums: what the mapping itself costs)
+ *   - files: read the baked files into the heap, parse the copies
+ *   - bake:  bake the atlas at startup (what robot_face_skia does without a pack)
+ *   Cold runs drop the files from the page cache first (posix_fadvise; the share of
+ *   pages actually evicted is printed, tmpfs and some overlays keep them), warm runs
+ *   are the best of --runs.
+ *
+ *   Sharing: --procs face processes load the assets at the same time and report, from
+ *   /proc/self/smaps, what the assets cost each of them: mapped pack pages are shared
+ *   page cache (the proportional share, PSS, falls with every process), copies are
+ *   private to each process.
+ *
+ *   Run it from the build directory (the build bakes and packs the assets there).
+ *
+ *   Usage:
+ *     robot_face_pack_bench [--pack robot_face_assets.rfpk] [--font generated/robot_face_status.rfsf]
+ *                           [--sprites generated/robot_face_sprites.rfs] [--runs 20] [--procs 4]
+ *
+ *******************************************************************************************/
+
+#include "robot_face_asset_pack.hpp"
+#include "robot_face_sdf_font.hpp"
+#include "robot_face_sprite.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace robotface;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr const char* kFontSection = "font/status";
+constexpr const char* kSpriteSection = "sprites/face";
+
+struct Paths {
+    const char* pack = "robot_face_assets.rfpk";
+    const char* font = "generated/robot_face_status.rfsf";
+    const char* sprites = "generated/robot_face_sprites.rfs";
+};
+
+// What a face process holds once its assets are loaded
+struct Loaded {
+    AssetPack pack;
+    std::vector<uint8_t> fontCopy;
+    std::vector<uint8_t> spriteCopy;
+    std::vector<uint8_t> atlasCopy;   // bake only
+    SdfFont font;
+    RfsSheet sheet{};
+    std::vector<uint8_t> frame;
+    uint32_t atlasSum = 0;             // Keeps the "upload" read from being optimized away
+    const void* mapping = nullptr;     // Start of the pack mapping (pack only)
+};
+
+enum class Strategy { Pack, PackUnverified, Files, Bake };
+constexpr const char* kStrategyNames[] = {"pack (mmap)", "pack, no crc", "files (read)", "bake font"};
+
+bool readFile(const char* path, std::vector<uint8_t>& bytes) {
+    std::FILE* file = std::fopen(path, "rb");
+    if (!file) return false;
+    std::fseek(file, 0, SEEK_END);
+    const long size = std::ftell(file);
+    std::fseek(file, 0, SEEK_SET);
+    bytes.resize(size > 0 ? static_cast<size_t>(size) : 0);
+    const bool ok = size >= 0 && std::fread(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    std::fclose(file);
+    return ok;
+}
+
+// Reads the atlas as a texture upload does and decodes the neutral, eyes-open frame
+bool finish(Loaded& loaded, bool sprites) {
+    if (!loaded.font.loaded()) return false;
+    const uint8_t* pixels = loaded.font.pixels();
+    const size_t count = static_cast<size_t>(loaded.font.width()) * loaded.font.height();
+    for (size_t i = 0; i < count; i++) loaded.atlasSum += pixels[i];
+    if (!sprites) return true;
+
+    const RfsSheet& sheet = loaded.sheet;
+    const size_t rowBytes = RfsRowBytes(sheet.format, sheet.width);
+    loaded.frame.resize(rowBytes * sheet.height);
+    return RfsDecodeFrame(&sheet, RfsFrameForState(&sheet, 0.0f, 0.5f), loaded.frame.data(), rowBytes);
+}
+
+bool load(Strategy strategy, const Paths& paths, Loaded& loaded) {
+    switch (strategy) {
+    case Strategy::Pack:
+    case Strategy::PackUnverified: {
+        if (!loaded.pack.open(paths.pack)) return false;
+        AssetView atlas;
+        AssetView sprites;
+        if (strategy == Strategy::Pack) {
+            atlas = loaded.pack.section(kFontSection, kAssetTypeSdfAtlas);
+            sprites = loaded.pack.section(kSpriteSection, kAssetTypeSpriteSheet);
+        } else if (loaded.pack.find(kFontSection) && loaded.pack.find(kSpriteSection)) {
+            atlas = loaded.pack.view(*loaded.pack.find(kFontSection));
+            sprites = loaded.pack.view(*loaded.pack.find(kSpriteSection));
+        }
+        if (atlas.empty() || sprites.empty()) return false;
+        loaded.mapping = loaded.pack.data();
+        return loaded.font.load(atlas.data, atlas.size) && RfsOpen(&loaded.sheet, sprites.data, sprites.size) &&
+               finish(loaded, true);
+    }
+    case Strategy::Files:
+        return readFile(paths.font, loaded.fontCopy) && readFile(paths.sprites, loaded.spriteCopy) &&
+               loaded.font.load(loaded.fontCopy.data(), loaded.fontCopy.size()) &&
+               RfsOpen(&loaded.sheet, loaded.spriteCopy.data(), loaded.spriteCopy.size()) && finish(loaded, true);
+    case Strategy::Bake:
+        bakeSdfAtlas(loaded.atlasCopy);
+        return loaded.font.load(loaded.atlasCopy.data(), loaded.atlasCopy.size()) && finish(loaded, false);
+    }
+    return false;
+}
+
+// Drops a file's clean pages from the page cache; returns the fraction still resident
+double evict(const char* path) {
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return 1.0;
+    struct stat info;
+    double resident = 1.0;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+#ifdef POSIX_FADV_DONTNEED
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+#endif
+        const size_t size = static_cast<size_t>(info.st_size);
+        void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            const long pageSize = sysconf(_SC_PAGESIZE);
+            const size_t pages = (size + pageSize - 1) / pageSize;
+#ifdef __APPLE__
+            std::vector<char> vec(pages);
+#else
+            std::vector<unsigned char> vec(pages);
+#endif
+            if (mincore(data, size, vec.data()) == 0) {
+                size_t count = 0;
+                for (const auto page : vec) count += (page & 1) ? 1 : 0;
+                resident = static_cast<double>(count) / pages;
+            }
+            munmap(data, size);
+        }
+    }
+    ::close(fd);
+    return resident;
+}
+
+double evictAll(Strategy strategy, const Paths& paths) {
+    if (strategy == Strategy::Pack || strategy == Strategy::PackUnverified) return evict(paths.pack);
+    if (strategy == Strategy::Files) return (evict(paths.font) + evict(paths.sprites)) * 0.5;
+    return 0.0;   // Nothing to read
+}
+
+// One load in a fresh child process (a cold start also starts with an empty heap), in ms
+double timeInChild(Strategy strategy, const Paths& paths) {
+    int fds[2];
+    if (pipe(fds) != 0) return -1.0;
+    const pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        Loaded loaded;
+        const auto start = Clock::now();
+        const bool ok = load(strategy, paths, loaded);
+        const double ms = ok ? std::chrono::duration<double, std::milli>(Clock::now() - start).count() : -1.0;
+        const ssize_t written = write(fds[1], &ms, sizeof(ms));
+        _exit(written == sizeof(ms) ? 0 : 1);
+    }
+    close(fds[1]);
+    double ms = -1.0;
+    if (pid < 0 || read(fds[0], &ms, sizeof(ms)) != sizeof(ms)) ms = -1.0;
+    close(fds[0]);
+    if (pid > 0) waitpid(pid, nullptr, 0);
+    return ms;
+}
+
+// kB of one mapping (or of the whole process) from /proc/self/smaps
+struct Usage {
+    long rss = 0;
+    long pss = 0;
+    long sharedClean = 0;
+    long privateDirty = 0;
+};
+
+#ifdef __linux__
+Usage smapsUsage(const void* mapping) {
+    Usage usage;
+    std::FILE* file = std::fopen(mapping ? "/proc/self/smaps" : "/proc/self/smaps_rollup", "r");
+    if (!file) return usage;
+    char line[512];
+    bool inside = mapping == nullptr;
+    while (std::fgets(line, sizeof(line), file)) {
+        unsigned long start = 0;
+        unsigned long end = 0;
+        if (mapping && std::sscanf(line, "%lx-%lx ", &start, &end) == 2) {
+            inside = start == reinterpret_cast<unsigned long>(mapping);
+            continue;
+        }
+        if (!inside) continue;
+        long kb = 0;
+        if (std::sscanf(line, "Rss: %ld kB", &kb) == 1) usage.rss += kb;
+        else if (std::sscanf(line, "Pss: %ld kB", &kb) == 1) usage.pss += kb;
+        else if (std::sscanf(line, "Shared_Clean: %ld kB", &kb) == 1) usage.sharedClean += kb;
+        else if (std::sscanf(line, "Private_Dirty: %ld kB", &kb) == 1) usage.privateDirty += kb;
+    }
+    std::fclose(file);
+    return usage;
+}
+#endif
+
+// procs processes load at once, then each reports what its assets cost it (summed)
+bool measureSharing(Strategy strategy, const Paths& paths, int procs, size_t frameBytes, Usage& total) {
+#ifdef __linux__
+    int ready[2];
+    int go[2];
+    int results[2];
+    if (pipe(ready) != 0 || pipe(go) != 0 || pipe(results) != 0) return false;
+
+    std::vector<pid_t> children;
+    for (int i = 0; i < procs; i++) {
+        const pid_t pid = fork();
+        if (pid < 0) break;
+        if (pid == 0) {
+            close(ready[0]);
+            close(go[1]);
+            close(results[0]);
+            Loaded loaded;
+            loaded.frame.resize(frameBytes);   // Both ways decode into it: not part of the assets
+            const Usage before = smapsUsage(nullptr);
+            Usage usage;
+            const bool ok = load(strategy, paths, loaded);
+            char byte = ok ? 1 : 0;
+            ssize_t io = write(ready[1], &byte, 1);
+            io = read(go[0], &byte, 1);   // EOF once every process has loaded
+            if (loaded.mapping) {
+                usage = smapsUsage(loaded.mapping);
+            } else {
+                const Usage after = smapsUsage(nullptr);   // The copies: heap growth
+                usage.rss = after.rss - before.rss;
+                usage.pss = after.pss - before.pss;
+                usage.privateDirty = after.privateDirty - before.privateDirty;
+            }
+            usage.rss = ok ? usage.rss : -1;
+            io = write(results[1], &usage, sizeof(usage));
+            _exit(io == sizeof(usage) ? 0 : 1);
+        }
+        children.push_back(pid);
+    }
+    close(ready[1]);
+    close(go[0]);
+    close(results[1]);
+
+    bool ok = static_cast<int>(children.size()) == procs;
+    for (size_t i = 0; i < children.size(); i++) {
+        char byte = 0;
+        ok = read(ready[0], &byte, 1) == 1 && byte == 1 && ok;
+    }
+    close(go[1]);   // Everyone measures while everyone still holds the assets
+    total = Usage{};
+    for (size_t i = 0; i < children.size(); i++) {
+        Usage usage;
+        ok = read(results[0], &usage, sizeof(usage)) == sizeof(usage) && usage.rss >= 0 && ok;
+        total.rss += usage.rss;
+        total.pss += usage.pss;
+        total.sharedClean += usage.sharedClean;
+        total.privateDirty += usage.privateDirty;
+    }
+    for (const pid_t pid : children) waitpid(pid, nullptr, 0);
+    close(ready[0]);
+    close(results[0]);
+    return ok;
+#else
+    (void)strategy;
+    (void)paths;
+    (void)procs;
+    (void)frameBytes;
+    (void)total;
+    return false;
+#endif
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Paths paths;
+    int runs = 20;
+    int procs = 4;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--pack") == 0) paths.pack = argv[i + 1];
+        else if (std::strcmp(argv[i], "--font") == 0) paths.font = argv[i + 1];
+        else if (std::strcmp(argv[i], "--sprites") == 0) paths.sprites = argv[i + 1];
+        else if (std::strcmp(argv[i], "--runs") == 0) runs = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--procs") == 0) procs = std::atoi(argv[i + 1]);
+    }
+    if (runs < 1 || procs < 1) {
+        std::fprintf(stderr, "runs and procs must be positive\n");
+        return 1;
+    }
+
+    Loaded probe;
+    if (!load(Strategy::Pack, paths, probe)) {
+        std::fprintf(stderr, "%s: %s (run from the build directory, or pass --pack)\n", paths.pack,
+                     probe.pack.isOpen() ? probe.pack.error() : "cannot open or not a valid pack");
+        return 1;
+    }
+    std::printf("Asset pack %s: %zu bytes, %zu sections, atlas %dx%d, sprite sheet %dx%d x %d frames\n", paths.pack,
+                probe.pack.size(), probe.pack.entries().size(), probe.font.width(), probe.font.height(),
+                probe.sheet.width, probe.sheet.height, RfsFrameCount(&probe.sheet));
+    const size_t frameBytes = probe.frame.size();
+    probe.pack.close();   // Mapped pages cannot be dropped from the page cache
+
+    std::printf("\nStartup: font and sprite sheet ready (ms, fresh process each run)\n");
+    std::printf("%-14s %10s %10s %10s\n", "", "cold", "evicted", "warm");
+    for (const Strategy strategy : {Strategy::Pack, Strategy::PackUnverified, Strategy::Files, Strategy::Bake}) {
+        const int index = static_cast<int>(strategy);
+        double cold = 1e30;
+        double evicted = 0.0;
+        for (int run = 0; run < std::min(runs, 5); run++) {
+            evicted += 1.0 - evictAll(strategy, paths);
+            cold = std::min(cold, timeInChild(strategy, paths));
+        }
+        double warm = 1e30;
+        for (int run = 0; run < runs; run++) warm = std::min(warm, timeInChild(strategy, paths));
+        if (warm < 0.0 || cold < 0.0) {
+            std::printf("%-14s %10s\n", kStrategyNames[index], "failed");
+            continue;
+        }
+        if (strategy == Strategy::Bake) {   // Reads no file
+            std::printf("%-14s %10.3f %10s %10.3f\n", kStrategyNames[index], cold, "-", warm);
+            continue;
+        }
+        std::printf("%-14s %10.3f %9.0f%% %10.3f\n", kStrategyNames[index], cold, 100.0 * evicted / std::min(runs, 5),
+                    warm);
+    }
+
+    std::printf("\nMemory for the assets across %d face processes (kB, summed over the processes)\n", procs);
+    std::printf("%-14s %10s %10s %10s %10s\n", "", "RSS", "PSS", "shared", "private");
+    bool shared = true;
+    for (const Strategy strategy : {Strategy::Pack, Strategy::Files}) {
+        Usage usage;
+        if (!measureSharing(strategy, paths, procs, frameBytes, usage)) {
+            std::printf("%-14s %10s\n", kStrategyNames[static_cast<int>(strategy)], "n/a (needs /proc/self/smaps)");
+            continue;
+        }
+        std::printf("%-14s %10ld %10ld %10ld %10ld\n", kStrategyNames[static_cast<int>(strategy)], usage.rss, usage.pss,
+                    usage.sharedClean, usage.privateDirty);
+        if (strategy == Strategy::Pack) shared = usage.privateDirty == 0;
+    }
+    if (!shared) std::printf("(pack pages were not all shared: check the mapping is read-only)\n");
+    return 0;
+}
@@ -0,0 +1,224 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Face Description Benchmark
+ *
+ *   Loads a face description (mmap + compile), then drives one RobotFace through a
+ *   sweep of emotions, blinks, speech and gaze. Every frame is recorded twice, once
+ *   with the built-in drawing code and once from the compiled program, and the two
+ *   display lists must match byte for byte (faces/robot.face describes the built-in
+ *   face). Then both paths are timed into a canvas that only consumes the calls (pure
+ *   interpreter overhead), into a display list recorder that caches the static layer and
+ *   into the software rasterizer (pixels, like a real frame).
+ *
+ *   No window: only the face logic and the canvas calls are measured.
+ *
+ *   Usage:
+ *     robot_face_program_bench [--face faces/robot.face] [--frames 20000]
+ *
+ *******************************************************************************************/
+
+#include "robot_face.hpp"
+#include "robot_face_display_list.hpp"
+#include "robot_face_program.hpp"
+#include "robot_face_soft_canvas.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#ifndef ROBOT_FACE_DEFAULT_FACE
+#define ROBOT_FACE_DEFAULT_FACE "faces/robot.face"
+#endif
+
+using namespace robotface;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+using RobotFace = robotface::RobotFace;   // Not the C face from robot_face_soft.h
+
+constexpr int kWidth = Config::SCREEN_WIDTH;
+constexpr int kHeight = Config::SCREEN_HEIGHT;
+constexpr float kDeltaTime = 1.0f / 60.0f;
+constexpr int kRepeats = 7;
+
+// Consumes every call so none of the work can be optimised away
+class SinkCanvas final : public Canvas {
+public:
+    void clear(Rgba color) override { m_sum += color.r; }
+    void circle(Point2 center, float radius, Rgba color) override { m_sum += center.x + center.y + radius + color.a; }
+    void ring(Point2 center, float radius, float thickness, Rgba color) override {
+        m_sum += center.x + center.y + radius + thickness + color.a;
+    }
+    void strokePath(const Point2* points, int count, float width, Rgba color) override {
+        for (int i = 0; i < count; i++) m_sum += points[i].x + points[i].y;
+        m_sum += width + color.a;
+    }
+    void text(const char* text, Point2 topLeft, float size, Rgba color) override {
+        m_sum += static_cast<double>(text[0]) + topLeft.x + topLeft.y + size + color.a;
+    }
+
+    [[nodiscard]] double sum() const noexcept { return m_sum; }
+
+private:
+    double m_sum = 0.0;
+};
+
+// Deterministic input sweep: emotion steps, blinks, speech bursts, a circling gaze
+void driveFace(RobotFace& face, int frame) {
+    const float t = static_cast<float>(frame) * kDeltaTime;
+    if (frame % 90 == 0) face.animateEmotion(static_cast<float>((frame / 90) % 5) * 0.25f);
+    if (frame % 47 == 0) face.triggerBlink();
+    face.update(kDeltaTime);
+    const float speech = std::sin(t * 9.0f) * std::sin(t * 0.7f);
+    face.setMouthOpenness(speech > 0.0f ? speech : 0.0f);
+    face.setPupilOffset(20.0f * std::cos(t * 1.3f), 20.0f * std::sin(t * 1.7f));
+}
+
+int verify(RobotFace& face, const FaceProgram& program, int frames) {
+    DisplayList builtIn;
+    DisplayList described;
+    int mismatches = 0;
+    for (int frame = 0; frame < frames; frame++) {
+        driveFace(face, frame);
+
+        builtIn.clear();
+        face.setProgram(nullptr);
+        DisplayListRecorder builtInRecorder(builtIn);
+        face.draw(builtInRecorder, kWidth, kHeight);
+
+        described.clear();
+        face.setProgram(&program);
+        DisplayListRecorder describedRecorder(described);
+        face.draw(describedRecorder, kWidth, kHeight);
+
+        if (builtIn != described && mismatches++ == 0) {
+            std::printf("frame %d differs: built-in %u ops / %zu bytes, program %u ops / %zu bytes\n", frame,
+                        builtIn.opCount(), builtIn.size(), described.opCount(), described.size());
+        }
+    }
+    face.setProgram(nullptr);
+    return mismatches;
+}
+
+// One pass over the input sweep, nanoseconds per frame (one clock read per pass: per frame
+// it would cost as much as the draw itself)
+template <typename DrawFn>
+double timePass(int frames, DrawFn draw) {
+    RobotFace face(0.8f);
+    face.setQuality(QualitySettings{Config::MOUTH_SEGMENTS, true, false, false, 1.0f});
+    const auto start = Clock::now();
+    for (int frame = 0; frame < frames; frame++) {
+        driveFace(face, frame);
+        draw(face);
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / frames;
+}
+
+struct Comparison {
+    double builtIn;
+    double program;
+};
+
+// Best of kRepeats, passes interleaved so machine noise hits both paths alike; the cost of
+// driving the face is measured the same way and subtracted
+template <typename BuiltInFn, typename ProgramFn>
+Comparison compare(int frames, BuiltInFn builtIn, ProgramFn described) {
+    double driveOnly = 1e30;
+    Comparison best{1e30, 1e30};
+    for (int repeat = 0; repeat < kRepeats; repeat++) {
+        driveOnly = std::min(driveOnly, timePass(frames, [](RobotFace&) {}));
+        best.builtIn = std::min(best.builtIn, timePass(frames, builtIn));
+        best.program = std::min(best.program, timePass(frames, described));
+    }
+    return Comparison{best.builtIn - driveOnly, best.program - driveOnly};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* path = ROBOT_FACE_DEFAULT_FACE;
+    int frames = 20000;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--face") == 0) path = argv[i + 1];
+        else if (std::strcmp(argv[i], "--frames") == 0) frames = std::atoi(argv[i + 1]);
+    }
+    if (frames < 1) {
+        std::fprintf(stderr, "frames must be positive\n");
+        return 1;
+    }
+
+    FaceProgram program;
+    FaceProgramError error;
+    const auto loadStart = Clock::now();
+    if (!program.load(path, &error)) {
+        std::fprintf(stderr, "%s:%d: %s\n", path, error.line, error.message.c_str());
+        return 1;
+    }
+    const double loadUs = std::chrono::duration<double, std::micro>(Clock::now() - loadStart).count();
+
+    std::printf("%s: %zu instructions (%zu bytes), %zu registers, %zu expressions folded, %zu shared, loaded in %.1f us\n",
+                path, program.code().size(), program.code().size() * sizeof(FaceInstr), program.registerCount(),
+                program.foldedExpressions(), program.sharedExpressions(), loadUs);
+
+    // Output must match the built-in face (status text off: it is not part of the description)
+    robotface::RobotFace face(0.8f);
+    face.setQuality(QualitySettings{Config::MOUTH_SEGMENTS, true, false, false, 1.0f});
+    const int verifyFrames = std::min(frames, 5000);
+    const int mismatches = verify(face, program, verifyFrames);
+    std::printf("%d frames compared, %d differ\n", verifyFrames, mismatches);
+
+    double sinkSum = 0.0;
+    const Comparison sink = compare(
+        frames,
+        [&](robotface::RobotFace& f) {
+            SinkCanvas canvas;
+            f.draw(canvas, kWidth, kHeight);
+            sinkSum += canvas.sum();
+        },
+        [&](robotface::RobotFace& f) {
+            SinkCanvas canvas;
+            program.run(canvas, f.programInputs(kWidth, kHeight));
+            sinkSum += canvas.sum();
+        });
+
+    // Separate libraries: the two paths key their static layers differently
+    DisplayList frame;
+    DisplayListLibrary builtInLibrary;
+    DisplayListLibrary programLibrary;
+    const Comparison record = compare(
+        frames,
+        [&](robotface::RobotFace& f) {
+            frame.clear();
+            DisplayListRecorder recorder(frame, &builtInLibrary);
+            f.draw(recorder, kWidth, kHeight);
+        },
+        [&](robotface::RobotFace& f) {
+            frame.clear();
+            DisplayListRecorder recorder(frame, &programLibrary);
+            program.run(recorder, f.programInputs(kWidth, kHeight));
+        });
+
+    // Rasterized frames cost far more than the calls; fewer of them
+    std::vector<unsigned char> pixels(static_cast<size_t>(kWidth) * kHeight * 4);
+    SoftCanvas target;
+    InitSoftCanvas(&target, pixels.data(), kWidth, kHeight);
+    SoftwareCanvas soft(target);
+    const Comparison raster = compare(
+        std::max(frames / 20, 1), [&](robotface::RobotFace& f) { f.draw(soft, kWidth, kHeight); },
+        [&](robotface::RobotFace& f) { program.run(soft, f.programInputs(kWidth, kHeight)); });
+
+    std::printf("\n%-26s %12s %12s %8s\n", "ns/frame", "built-in", "program", "ratio");
+    std::printf("%-26s %12.1f %12.1f %8.2f\n", "sink canvas", sink.builtIn, sink.program, sink.program / sink.builtIn);
+    std::printf("%-26s %12.1f %12.1f %8.2f\n", "recorder (cached layer)", record.builtIn, record.program,
+                record.program / record.builtIn);
+    std::printf("%-26s %12.1f %12.1f %8.2f\n", "software canvas", raster.builtIn, raster.program,
+                raster.program / raster.builtIn);
+    std::printf("(checksum %.0f)\n", sinkSum);
+
+    return mismatches == 0 ? 0 : 1;
+}
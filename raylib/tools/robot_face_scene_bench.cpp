@@ -0,0 +1,153 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Multi-Face Scene Scaling Benchmark
+ *
+ *   Builds a scene of heterogeneous faces (four styles, three looping scripts, four
+ *   outputs, moving gaze targets, some faces speaking) and times FaceScene::update,
+ *   which also rebuilds every output's draw submissions, on work-stealing pools of
+ *   1, 2, 4, ... threads. Reports time per update, speedup over one thread and
+ *   parallel efficiency, then checks that each thread count gives the same result.
+ *
+ *   No window: this measures the update side only. Draw the submissions with
+ *   FaceScene::draw on any Canvas.
+ *
+ *   Usage:
+ *     robot_face_scene_bench [--faces 10000] [--frames 600] [--threads N]
+ *
+ *******************************************************************************************/
+
+#include "robot_face_scene.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace robotface;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr float kDeltaTime = 1.0f / 60.0f;
+constexpr int kWarmupFrames = 30;
+constexpr size_t kOutputs = 4;
+
+void buildScene(FaceScene& scene, size_t faces) {
+    const FaceStyle calm{4.0f, 4.0f, 0.4f, {255, 255, 255, 255}, {0, 0, 0, 255}};
+    const FaceStyle lively{2.0f, 7.0f, 0.15f, {240, 250, 255, 255}, {20, 40, 90, 255}};
+    const FaceStyle sleepy{6.0f, 2.5f, 0.6f, {255, 245, 230, 255}, {60, 30, 10, 255}};
+    scene.addStyle(calm);
+    scene.addStyle(lively);
+    scene.addStyle(sleepy);
+
+    const Keyframe greet[] = {{0.0f, 0.5f, Ease::Smooth}, {0.5f, 1.0f, Ease::Linear}, {2.0f, 1.0f, Ease::Sine},
+                              {3.0f, 0.5f, Ease::Linear}};
+    const Keyframe mope[] = {{0.0f, 0.4f, Ease::Sine}, {1.5f, 0.1f, Ease::Sine}, {4.0f, 0.4f, Ease::Linear}};
+    const Keyframe nod[] = {{0.0f, 0.6f, Ease::Spring}, {0.8f, 0.9f, Ease::Spring}, {1.6f, 0.6f, Ease::Linear}};
+    const FaceScene::ScriptId scripts[] = {scene.addScript(greet, 4), scene.addScript(mope, 3),
+                                           scene.addScript(nod, 3), FaceScene::kNoScript};
+
+    // 64 faces per row on each output, interleaved so every chunk mixes outputs
+    for (size_t i = 0; i < faces; i++) {
+        const size_t onOutput = i / kOutputs;
+        const FaceTransform transform{static_cast<float>(onOutput % 64) * 80.0f,
+                                      static_cast<float>(onOutput / 64) * 60.0f, 0.1f};
+        scene.add(transform, static_cast<FaceScene::OutputId>(i % kOutputs),
+                  static_cast<FaceScene::StyleId>(i % 4), scripts[(i / 3) % 4], 0.5f);
+    }
+}
+
+void driveInputs(FaceScene& scene, int frame) {
+    const float t = static_cast<float>(frame) * kDeltaTime;
+    for (size_t i = 0; i < scene.size(); i++) {
+        const auto face = static_cast<FaceScene::FaceId>(i);
+        const float phase = static_cast<float>(i % 97) * 0.13f;
+        scene.setGazeTarget(face, GazePoint{400.0f + 300.0f * std::sin(t + phase), 200.0f + 120.0f * std::cos(t * 0.7f + phase)});
+        if (i % 8 == 0) scene.setMouthOpenness(face, 0.5f + 0.5f * std::sin(t * 12.0f + phase));
+    }
+}
+
+struct Result {
+    double meanMs = 0.0;
+    double checksum = 0.0;
+    uint64_t steals = 0;
+};
+
+Result run(size_t faces, int frames, size_t threads) {
+    FaceScene scene(faces, kOutputs);
+    buildScene(scene, faces);
+    WorkStealingPool pool(threads);
+
+    double totalMs = 0.0;
+    for (int frame = 0; frame < kWarmupFrames + frames; frame++) {
+        driveInputs(scene, frame);
+        const auto start = Clock::now();
+        scene.update(kDeltaTime, pool);
+        if (frame >= kWarmupFrames) totalMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    Result result;
+    result.meanMs = totalMs / frames;
+    result.steals = pool.steals();
+    for (size_t output = 0; output < kOutputs; output++) {
+        const FaceScene::Submissions submissions = scene.submissions(static_cast<FaceScene::OutputId>(output));
+        for (size_t i = 0; i < submissions.size; i++) {
+            const FaceInstance& face = submissions.data[i];
+            result.checksum += face.happiness + face.blinkFactor + face.pupilX + face.pupilY + face.mouthOpenness;
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t faces = 10000;
+    int frames = 600;
+    size_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--faces") == 0) faces = static_cast<size_t>(std::atol(argv[i + 1]));
+        else if (std::strcmp(argv[i], "--frames") == 0) frames = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--threads") == 0) maxThreads = static_cast<size_t>(std::atol(argv[i + 1]));
+    }
+    if (faces == 0 || frames < 1 || maxThreads == 0) {
+        std::fprintf(stderr, "faces, frames and threads must be positive\n");
+        return 1;
+    }
+
+    std::vector<size_t> threadCounts;
+    for (size_t threads = 1; threads < maxThreads; threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    std::printf("%zu faces, %zu outputs, %d frames, %zu hardware threads\n", faces, kOutputs, frames,
+                static_cast<size_t>(std::thread::hardware_concurrency()));
+    std::printf("%8s %12s %12s %9s %11s %8s\n", "threads", "ms/update", "us/face", "speedup", "efficiency", "steals");
+
+    double baselineMs = 0.0;
+    double baselineChecksum = 0.0;
+    bool consistent = true;
+    for (size_t threads : threadCounts) {
+        const Result result = run(faces, frames, threads);
+        if (threads == 1) {
+            baselineMs = result.meanMs;
+            baselineChecksum = result.checksum;
+        }
+        const double speedup = baselineMs / result.meanMs;
+        std::printf("%8zu %12.4f %12.5f %9.2f %10.0f%% %8llu\n", threads, result.meanMs,
+                    result.meanMs * 1000.0 / static_cast<double>(faces), speedup,
+                    100.0 * speedup / static_cast<double>(threads), static_cast<unsigned long long>(result.steals));
+
+        // Chunks are independent, so the thread count must not change the result
+        if (result.checksum != baselineChecksum) consistent = false;
+    }
+
+    if (!consistent) {
+        std::printf("\nresults differ between thread counts\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,126 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Expression Script Benchmark (C++20)
+ *
+ *   Runs a fleet of faces, each driven by a looping coroutine script (blink twice,
+ *   smile, hold, back to neutral), plus short one-shot scripts started and finished
+ *   every frame to exercise the pool. Reports per-update cost, pool usage and heap
+ *   allocations after warm-up (expected: 0).
+ *
+ *   Usage:
+ *     robot_face_script_bench [--faces 5000] [--frames 1200] [--warmup 120] [--churn 100]
+ *
+ *******************************************************************************************/
+
+#define ROBOT_FACE_ALLOC_COUNTER_IMPLEMENTATION
+#include "robot_face_alloc_counter.hpp"
+
+#include "robot_face_script.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace robotface;
+using namespace robotface::script;
+
+namespace {
+
+constexpr float kFrameTime = 1.0f / 60.0f;
+
+Script greeting([[maybe_unused]] ScriptPool& pool, RobotFace& face, float phase) {
+    co_await wait(phase);
+    for (;;) {
+        co_await blink(face);
+        co_await blink(face);
+        co_await tween(face, FaceChannel::Happiness, 1.0f, 0.5f);
+        co_await wait(1.0f);
+        co_await tween(face, FaceChannel::Happiness, 0.5f, 0.3f, Ease::Smooth);
+        co_await wait(2.0f);
+    }
+}
+
+Script nudge([[maybe_unused]] ScriptPool& pool, RobotFace& face) {
+    co_await tween(face, FaceChannel::Happiness, 0.6f, 0.1f);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t faceCount = 5000;
+    int frames = 1200;
+    int warmup = 120;
+    size_t churn = 100;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--faces") == 0) faceCount = static_cast<size_t>(std::atol(argv[i + 1]));
+        else if (std::strcmp(argv[i], "--frames") == 0) frames = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--warmup") == 0) warmup = std::atoi(argv[i + 1]);
+        else if (std::strcmp(argv[i], "--churn") == 0) churn = static_cast<size_t>(std::atol(argv[i + 1]));
+    }
+    if (faceCount == 0 || frames < 1 || warmup < 0) {
+        std::fprintf(stderr, "faces and frames must be positive\n");
+        return 1;
+    }
+
+    // Everything sized up front: faces, pool blocks and runner slots
+    std::vector<RobotFace> faces;
+    faces.reserve(faceCount);
+    for (size_t i = 0; i < faceCount; i++) faces.emplace_back(0.5f);
+
+    // One-shot scripts live ~6 frames; leave room for 8 frames of churn
+    const size_t capacity = faceCount + churn * 8;
+    ScriptPool pool(capacity);
+    ScriptRunner runner(capacity);
+
+    for (size_t i = 0; i < faceCount; i++) {
+        const float phase = static_cast<float>(i % 97) * 0.031f;
+        if (!runner.start(greeting(pool, faces[i], phase))) {
+            std::fprintf(stderr, "failed to start script %zu (frame %zu bytes, block %zu bytes)\n",
+                         i, pool.largestRequest(), pool.blockSize());
+            return 1;
+        }
+    }
+
+    uint64_t steadyAllocations = 0;
+    size_t rejected = 0;
+    size_t peakUsed = 0;
+    double scriptNs = 0.0;
+    double faceNs = 0.0;
+
+    for (int frame = 0; frame < warmup + frames; frame++) {
+        const uint64_t allocationsBefore = alloc::allocationCount();
+
+        // One-shot scripts on a rotating subset of faces
+        for (size_t c = 0; c < churn; c++) {
+            RobotFace& face = faces[(static_cast<size_t>(frame) * churn + c) % faceCount];
+            if (!runner.start(nudge(pool, face))) rejected++;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        runner.update(kFrameTime);
+        const auto scripted = std::chrono::steady_clock::now();
+        for (RobotFace& face : faces) face.update(kFrameTime);
+        const auto end = std::chrono::steady_clock::now();
+
+        peakUsed = std::max(peakUsed, pool.used());
+        if (frame >= warmup) {
+            steadyAllocations += alloc::allocationCount() - allocationsBefore;
+            scriptNs += std::chrono::duration<double, std::nano>(scripted - start).count();
+            faceNs += std::chrono::duration<double, std::nano>(end - scripted).count();
+        }
+    }
+
+    std::printf("Faces: %zu, scripts active: %zu, churn: %zu/frame, frames: %d (+%d warm-up)\n",
+                faceCount, runner.active(), churn, frames, warmup);
+    std::printf("Coroutine frame: %zu bytes (block %zu), pool peak %zu / %zu, rejected %zu\n",
+                pool.largestRequest(), pool.blockSize(), peakUsed, pool.capacity(), rejected);
+    std::printf("Script update: %.1f us/frame (%.1f ns/script)\n",
+                scriptNs / frames / 1000.0, scriptNs / frames / static_cast<double>(faceCount));
+    std::printf("Face update:   %.1f us/frame\n", faceNs / frames / 1000.0);
+    std::printf("Heap allocations after warm-up: %llu\n", static_cast<unsigned long long>(steadyAllocations));
+
+    return steadyAllocations == 0 ? 0 : 1;
+}
@@ -0,0 +1,183 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Headless Remote Rendering Server
+ *
+ *   Runs the face logic without a window and streams per-frame display-list deltas
+ *   to any number of thin clients (robot_face_client) over a Unix socket.
+ *
+ *   Usage:
+ *     robot_face_server [--socket /tmp/robot_face.sock] [--fps 60] [--seconds 0]
+ *
+ *******************************************************************************************/
+
+#include "robot_face.hpp"
+#include "robot_face_display_list.hpp"
+#include "robot_face_remote.hpp"
+#include <algorithm>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+using namespace robotface;
+
+namespace {
+
+volatile std::sig_atomic_t g_running = 1;
+
+void onSignal(int) {
+    g_running = 0;
+}
+
+void sleepUntil(uint64_t deadlineNs) {
+    uint64_t now = remote::monotonicNs();
+    if (deadlineNs <= now) return;
+
+    const uint64_t wait = deadlineNs - now;
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(wait / 1000000000ull);
+    ts.tv_nsec = static_cast<long>(wait % 1000000000ull);
+    nanosleep(&ts, nullptr);
+}
+
+struct ServerStats {
+    uint64_t frames = 0;
+    uint64_t frameBytes = 0;       // Per-frame delta messages (header included)
+    uint64_t setupBytes = 0;       // DefineList + full frames for new clients
+    uint64_t maxFrameBytes = 0;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* socketPath = remote::kDefaultSocketPath;
+    int fps = 60;
+    double seconds = 0.0;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--socket") == 0) socketPath = argv[i + 1];
+        else if (std::strcmp(argv[i], "--fps") == 0) fps = std::max(1, std::atoi(argv[i + 1]));
+        else if (std::strcmp(argv[i], "--seconds") == 0) seconds = std::atof(argv[i + 1]);
+    }
+
+    int listenFd = remote::listenUnix(socketPath);
+    if (listenFd < 0) {
+        std::fprintf(stderr, "Cannot listen on %s\n", socketPath);
+        return 1;
+    }
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+    std::signal(SIGPIPE, SIG_IGN);
+    std::printf("Robot face server on %s at %d fps\n", socketPath, fps);
+
+    RobotFace face(0.8f);
+    DisplayListLibrary library;
+    DisplayList frames[2];
+    std::vector<uint32_t> sentKeys;
+    std::vector<int> clients;
+    std::vector<uint8_t> payload;
+    ServerStats stats;
+
+    const float deltaTime = 1.0f / fps;
+    const uint64_t frameNs = 1000000000ull / static_cast<uint64_t>(fps);
+    const uint64_t startNs = remote::monotonicNs();
+    uint64_t nextFrameNs = startNs;
+    uint64_t nextReportNs = startNs + 5000000000ull;
+    uint32_t frameId = 0;
+
+    while (g_running) {
+        DisplayList& previous = frames[frameId % 2];
+        DisplayList& current = frames[(frameId + 1) % 2];
+        const double elapsed = (remote::monotonicNs() - startNs) * 1e-9;
+        if (seconds > 0.0 && elapsed >= seconds) break;
+
+        // Scripted scenario: slow emotion sweep plus the automatic blink
+        face.update(deltaTime);
+        face.setEmotion(0.5f + 0.5f * static_cast<float>(std::sin(elapsed * 0.8)));
+
+        current.clear();
+        DisplayListRecorder recorder(current, &library);
+        face.draw(recorder, Config::SCREEN_WIDTH, Config::SCREEN_HEIGHT);
+
+        // Broadcast sub-lists recorded for the first time
+        library.forEach([&](uint32_t key, const DisplayList& list) {
+            if (std::find(sentKeys.begin(), sentKeys.end(), key) != sentKeys.end()) return;
+            sentKeys.push_back(key);
+            remote::encodeDefineList(key, list, payload);
+            for (int& fd : clients) {
+                size_t sent = remote::sendMessage(fd, remote::MessageType::DefineList, frameId, payload.data(), payload.size());
+                if (sent == 0) { remote::closeSocket(fd); fd = -1; }
+                stats.setupBytes += sent;
+            }
+        });
+
+        // Per-frame delta for connected clients
+        remote::encodeFrameDelta(previous, current, payload);
+        size_t frameBytes = 0;
+        for (int& fd : clients) {
+            if (fd < 0) continue;
+            size_t sent = remote::sendMessage(fd, remote::MessageType::FrameDelta, frameId, payload.data(), payload.size());
+            if (sent == 0) { remote::closeSocket(fd); fd = -1; }
+            frameBytes = std::max(frameBytes, sent);
+        }
+        clients.erase(std::remove(clients.begin(), clients.end(), -1), clients.end());
+
+        if (!clients.empty()) {
+            stats.frames++;
+            stats.frameBytes += frameBytes;
+            stats.maxFrameBytes = std::max<uint64_t>(stats.maxFrameBytes, frameBytes);
+        }
+
+        // New clients get every sub-list and one full frame, then deltas from the next frame on
+        for (int fd = remote::acceptClient(listenFd); fd >= 0; fd = remote::acceptClient(listenFd)) {
+            bool ok = true;
+            library.forEach([&](uint32_t key, const DisplayList& list) {
+                remote::encodeDefineList(key, list, payload);
+                size_t sent = remote::sendMessage(fd, remote::MessageType::DefineList, frameId, payload.data(), payload.size());
+                ok = ok && sent > 0;
+                stats.setupBytes += sent;
+            });
+            remote::encodeFrame(current, payload);
+            size_t sent = remote::sendMessage(fd, remote::MessageType::Frame, frameId, payload.data(), payload.size());
+            stats.setupBytes += sent;
+
+            if (ok && sent > 0) {
+                clients.push_back(fd);
+                std::printf("Client connected (%zu total)\n", clients.size());
+            } else {
+                remote::closeSocket(fd);
+            }
+        }
+
+        const uint64_t now = remote::monotonicNs();
+        if (now >= nextReportNs) {
+            nextReportNs += 5000000000ull;
+            if (stats.frames > 0) {
+                std::printf("frames=%llu clients=%zu avg=%.1f B/frame max=%llu B full=%zu B (%.1f KB/s per client)\n",
+                            static_cast<unsigned long long>(stats.frames), clients.size(),
+                            static_cast<double>(stats.frameBytes) / stats.frames,
+                            static_cast<unsigned long long>(stats.maxFrameBytes),
+                            current.size() + sizeof(remote::MessageHeader) + sizeof(uint32_t),
+                            static_cast<double>(stats.frameBytes) / stats.frames * fps / 1024.0);
+                std::fflush(stdout);
+            }
+        }
+
+        frameId++;
+        nextFrameNs += frameNs;
+        sleepUntil(nextFrameNs);
+    }
+
+    for (int fd : clients) remote::closeSocket(fd);
+    remote::closeSocket(listenFd);
+
+    std::printf("Sent %llu frames, %.1f B/frame average, %llu B setup\n",
+                static_cast<unsigned long long>(stats.frames),
+                stats.frames ? static_cast<double>(stats.frameBytes) / stats.frames : 0.0,
+                static_cast<unsigned long long>(stats.setupBytes));
+    return 0;
+}
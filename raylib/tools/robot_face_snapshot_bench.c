@@ -0,0 +1,180 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Snapshot Stream Benchmark
+ *
+ *   Simulates a stream of N faces updated at 60 Hz (automatic blinks, a share of faces
+ *   changing emotion every frame), encodes every face every frame and decodes the
+ *   stream into mirror faces. Reports snapshots/s, bytes per update and the worst
+ *   reconstruction error for each quantization, with and without delta records.
+ *
+ *   Usage:
+ *     robot_face_snapshot_bench [--faces 1000] [--frames 600] [--keyframe 60]
+ *
+ *******************************************************************************************/
+
+#include "robot_face.h"
+#include "robot_face_snapshot.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define RECORD_ID_BYTES 2   // Face id in front of each record in the stream
+
+typedef struct {
+    const char* name;
+    FaceSnapshotQuant quant;
+    int keyframe_interval;   // 1 = every record is a full snapshot
+} BenchCase;
+
+static double NowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Small deterministic generator so runs are comparable
+static unsigned int NextRandom(unsigned int* state) {
+    *state = *state * 1664525u + 1013904223u;
+    return *state >> 8;
+}
+
+static void InitFaces(RobotFace* faces, int count) {
+    unsigned int seed = 12345u;
+    for (int i = 0; i < count; i++) {
+        InitRobotFace(&faces[i]);
+        faces[i].happiness = (NextRandom(&seed) % 1000) / 999.0f;
+        faces[i].blink_timer = (NextRandom(&seed) % 3000) / 1000.0;   // Stagger blinks
+    }
+}
+
+// One 60 Hz tick: every face animates, ~10% of them change emotion
+static void StepFaces(RobotFace* faces, int count, unsigned int* seed) {
+    for (int i = 0; i < count; i++) {
+        UpdateRobotFace(&faces[i], 1.0f / 60.0f);
+        if (NextRandom(seed) % 10 == 0) {
+            float step = ((int)(NextRandom(seed) % 201) - 100) / 2000.0f;
+            SetEmotion(&faces[i], faces[i].happiness + step);
+        }
+    }
+}
+
+static double MaxError(const RobotFace* a, const RobotFace* b, int count) {
+    double worst = 0.0;
+    for (int i = 0; i < count; i++) {
+        double errors[4] = {
+            fabs(a[i].happiness - b[i].happiness),
+            fabs(a[i].blink_progress - b[i].blink_progress),
+            fabs(a[i].blink_timer - b[i].blink_timer),
+            (a[i].is_blinking != b[i].is_blinking) ? 1.0 : 0.0
+        };
+        for (int k = 0; k < 4; k++) {
+            if (errors[k] > worst) worst = errors[k];
+        }
+    }
+    return worst;
+}
+
+static void RunCase(const BenchCase* bench, int faceCount, int frames) {
+    RobotFace* faces = malloc(sizeof(RobotFace) * faceCount);
+    RobotFace* mirror = malloc(sizeof(RobotFace) * faceCount);
+    FaceSnapshotEncoder* encoders = malloc(sizeof(FaceSnapshotEncoder) * faceCount);
+    uint8_t* stream = malloc((size_t)faceCount * (FACE_SNAPSHOT_MAX_BYTES + RECORD_ID_BYTES));
+
+    InitFaces(faces, faceCount);
+    for (int i = 0; i < faceCount; i++) {
+        InitRobotFace(&mirror[i]);
+        InitFaceSnapshotEncoder(&encoders[i], bench->quant, bench->keyframe_interval);
+    }
+
+    unsigned int seed = 987u;
+    double encodeTime = 0.0;
+    double decodeTime = 0.0;
+    double worstError = 0.0;
+    unsigned long long totalBytes = 0;
+    int malformed = 0;
+
+    for (int frame = 0; frame < frames; frame++) {
+        StepFaces(faces, faceCount, &seed);
+
+        // Encode the whole stream for this tick
+        double start = NowSeconds();
+        size_t size = 0;
+        for (int i = 0; i < faceCount; i++) {
+            stream[size] = (uint8_t)(i & 0xFF);
+            stream[size + 1] = (uint8_t)(i >> 8);
+            size += RECORD_ID_BYTES;
+            size += EncodeFaceSnapshot(&encoders[i], &faces[i], stream + size, FACE_SNAPSHOT_MAX_BYTES);
+        }
+        encodeTime += NowSeconds() - start;
+        totalBytes += size;
+
+        // Decode in place into the mirrors
+        start = NowSeconds();
+        size_t offset = 0;
+        while (offset + RECORD_ID_BYTES <= size) {
+            int id = stream[offset] | (stream[offset + 1] << 8);
+            offset += RECORD_ID_BYTES;
+            size_t used = DecodeFaceSnapshot(stream + offset, size - offset, &mirror[id]);
+            if (used == 0) {
+                malformed++;
+                break;
+            }
+            offset += used;
+        }
+        decodeTime += NowSeconds() - start;
+
+        double error = MaxError(faces, mirror, faceCount);
+        if (error > worstError) worstError = error;
+    }
+
+    double updates = (double)faceCount * frames;
+    printf("%-14s %12.2f %12.2f %10.2f %12.1f %10.6f%s\n",
+           bench->name,
+           updates / encodeTime / 1e6,
+           updates / decodeTime / 1e6,
+           totalBytes / updates,
+           totalBytes / (double)frames * 60.0 / 1024.0,
+           worstError,
+           malformed ? "  (MALFORMED)" : "");
+
+    free(stream);
+    free(encoders);
+    free(mirror);
+    free(faces);
+}
+
+int main(int argc, char** argv) {
+    int faceCount = 1000;
+    int frames = 600;
+    int keyframe = 60;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--faces") == 0) faceCount = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--frames") == 0) frames = atoi(argv[i + 1]);
+        else if (strcmp(argv[i], "--keyframe") == 0) keyframe = atoi(argv[i + 1]);
+    }
+    if (faceCount < 1 || faceCount > 65536 || frames < 1) {
+        fprintf(stderr, "faces must be 1..65536 and frames >= 1\n");
+        return 1;
+    }
+
+    const BenchCase cases[] = {
+        {"exact/full", FACE_SNAPSHOT_EXACT, 1},
+        {"exact/delta", FACE_SNAPSHOT_EXACT, keyframe},
+        {"q16/full", FACE_SNAPSHOT_Q16, 1},
+        {"q16/delta", FACE_SNAPSHOT_Q16, keyframe},
+        {"q8/full", FACE_SNAPSHOT_Q8, 1},
+        {"q8/delta", FACE_SNAPSHOT_Q8, keyframe},
+    };
+
+    printf("%d faces x %d frames at 60 Hz (keyframe every %d updates)\n\n", faceCount, frames, keyframe);
+    printf("%-14s %12s %12s %10s %12s %10s\n", "mode", "enc M/s", "dec M/s", "B/update", "KB/s @60Hz", "max err");
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        RunCase(&cases[i], faceCount, frames);
+    }
+
+    return 0;
+}
@@ -0,0 +1,384 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Accelerated-Clock Soak Test
+ *
+ *   Runs the update and headless draw paths through weeks or months of simulated time
+ *   in minutes. A virtual clock hands out 60 Hz frame times with jitter and occasional
+ *   hitches; every frame is updated, a software-rasterized frame is drawn every few
+ *   simulated minutes. Per simulated day (epoch) it reports:
+ *   - automatic blinks, their mean interval error (ppm) and the worst phase error
+ *     (start of blink n versus n * BLINK_INTERVAL)
+ *   - current RSS and heap allocations (after the first simulated hour)
+ *   - update and draw cost of the soaked face, and its ratio to a freshly built face run
+ *     interleaved with it (host noise cancels out; a creep shows as a ratio above 1)
+ *
+ *   Frame times are whole multiples of 2^-26 s below 0.25 s, so each one is exact as a
+ *   float and the clock's own sum is exact: any drift measured is the face's.
+ *
+ *   Each implementation runs in its own process. Exit status is 1 if any epoch drifts,
+ *   grows or slows beyond the thresholds, so the tool can gate CI directly.
+ *
+ *   Usage:
+ *     robot_face_soak [--days 90] [--epoch-hours 24] [--draw-every 600] [--impl c|cpp]
+ *                     [--max-ppm 50] [--max-phase 0.5] [--rss-slack 1024] [--max-creep 1.5]
+ *
+ *******************************************************************************************/
+
+#define ROBOT_FACE_ALLOC_COUNTER_IMPLEMENTATION
+#include "robot_face_alloc_counter.hpp"
+
+#include "robot_face.h"
+#include "robot_face.hpp"
+#include "robot_face_soft.h"
+#include "robot_face_soft_canvas.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr int kWidth = 800;
+constexpr int kHeight = 600;
+constexpr double kBlinkInterval = robotface::Config::BLINK_INTERVAL;   // Same 3 s in the C face
+constexpr double kWarmupSeconds = 3600.0;
+
+struct Soak {
+    double days = 90.0;
+    double epochHours = 24.0;
+    double drawEvery = 600.0;     // Simulated seconds between drawn frames
+    double maxPpm = 50.0;         // Mean blink interval error per epoch
+    double maxPhase = 0.5;        // Seconds, any blink
+    size_t rssSlackKb = 1024;     // RSS growth over the first epoch
+    double maxCreep = 1.5;        // Soaked face cost over a fresh face's
+};
+
+// Deterministic frame times: 60 Hz +-2 ms, a 100-200 ms hitch about every 80 s
+class VirtualClock {
+public:
+    static constexpr int kTickBits = 26;   // 2^-26 s ticks: < 2^24 of them fit a float exactly
+
+    float advance() noexcept {
+        int64_t ticks = kNominal + static_cast<int64_t>(next() % (2 * kJitter + 1)) - kJitter;
+        if (next() % 5000 == 0) ticks = kHitchMin + static_cast<int64_t>(next() % (kHitchMax - kHitchMin));
+        m_ticks += ticks;
+        return std::ldexp(static_cast<float>(ticks), -kTickBits);
+    }
+
+    [[nodiscard]] double seconds() const noexcept { return std::ldexp(static_cast<double>(m_ticks), -kTickBits); }
+
+private:
+    static constexpr int64_t kNominal = (int64_t{1} << kTickBits) / 60;
+    static constexpr int64_t kJitter = (int64_t{1} << kTickBits) / 500;
+    static constexpr int64_t kHitchMin = (int64_t{1} << kTickBits) / 10;
+    static constexpr int64_t kHitchMax = (int64_t{1} << kTickBits) / 5;
+
+    uint32_t next() noexcept {
+        m_state = m_state * 6364136223846793005ull + 1442695040888963407ull;
+        return static_cast<uint32_t>(m_state >> 33);
+    }
+
+    uint64_t m_state = 0x5eed;
+    int64_t m_ticks = 0;
+};
+
+// Modular C face into the software rasterizer (emotion only; no mouth or gaze input)
+class CFace {
+public:
+    explicit CFace(unsigned char* pixels) {
+        InitSoftCanvas(&m_canvas, pixels, kWidth, kHeight);
+        InitRobotFace(&m_face);
+    }
+
+    void update(float deltaTime) { UpdateRobotFace(&m_face, deltaTime); }
+    void drive(int step) { SetEmotion(&m_face, static_cast<float>(step % 5) * 0.25f); }
+    void steer(float) {}
+    [[nodiscard]] bool blinking() const { return IsBlinking(&m_face); }
+    void draw() { DrawRobotFaceSoft(&m_face, &m_canvas); }
+    void mirror(const CFace& other) { m_face = other.m_face; }   // The struct is all its state
+
+private:
+    SoftCanvas m_canvas;
+    RobotFace m_face;
+};
+
+// Modern C++ face drawing straight into the software Canvas backend
+class CppFace {
+public:
+    explicit CppFace(unsigned char* pixels) : m_face(0.8f) {
+        InitSoftCanvas(&m_target, pixels, kWidth, kHeight);
+    }
+
+    void update(float deltaTime) { m_face.update(deltaTime); }
+    void drive(int step) { m_face.animateEmotion(static_cast<float>(step % 5) * 0.25f); }
+    void steer(float phase) {
+        const float speech = std::sin(phase * 9.0f) * std::sin(phase * 0.7f);
+        m_face.setMouthOpenness(speech > 0.0f ? speech : 0.0f);
+        m_face.setPupilOffset(20.0f * std::cos(phase * 1.3f), 20.0f * std::sin(phase * 1.7f));
+    }
+    [[nodiscard]] bool blinking() const { return m_face.isBlinking(); }
+    void draw() {
+        robotface::SoftwareCanvas canvas(m_target);
+        m_face.draw(canvas, kWidth, kHeight);
+    }
+    void mirror(const CppFace& other) {
+        m_face.setState(other.m_face.state());
+        m_face.setMouthOpenness(other.m_face.mouthOpenness());
+        m_face.setPupilOffset(other.m_face.pupilOffset().x, other.m_face.pupilOffset().y);
+    }
+
+private:
+    SoftCanvas m_target;
+    robotface::RobotFace m_face;
+};
+
+struct Epoch {
+    int blinks = 0;
+    double firstBlink = 0.0;
+    double lastBlink = 0.0;
+    double worstPhase = 0.0;
+
+    // Mean interval over the epoch's blinks, relative error in ppm
+    [[nodiscard]] double intervalPpm() const {
+        if (blinks < 2) return 0.0;
+        return ((lastBlink - firstBlink) / (blinks - 1) / kBlinkInterval - 1.0) * 1e6;
+    }
+};
+
+// One simulated face: its clock, the scripted input, blink bookkeeping and scheduled draws.
+// Per-frame work must not depend on how long it has run (no fmod or sin of the clock).
+template <typename Face>
+class Run {
+public:
+    Run(unsigned char* pixels, double drawEvery) : m_face(pixels), m_drawEvery(drawEvery) {}
+
+    void step() {
+        m_face.update(m_clock.advance());
+        const double now = m_clock.seconds();
+        if (now >= m_nextDrive) {
+            m_face.drive(m_driveStep++);
+            m_nextDrive += 37.0;
+        }
+        if (now >= m_nextSteer) m_nextSteer += 600.0;
+        m_face.steer(static_cast<float>(now - (m_nextSteer - 600.0)));
+
+        const bool isBlinking = m_face.blinking();
+        if (isBlinking && !m_wasBlinking) {
+            m_blinks++;
+            m_epoch.worstPhase = std::max(m_epoch.worstPhase, std::fabs(now - m_blinks * kBlinkInterval));
+            if (m_epoch.blinks++ == 0) m_epoch.firstBlink = now;
+            m_epoch.lastBlink = now;
+        }
+        m_wasBlinking = isBlinking;
+
+        if (now >= m_nextDraw) {
+            m_face.draw();
+            m_nextDraw += m_drawEvery;
+        }
+    }
+
+    void draw() { m_face.draw(); }
+
+    // Same clock, schedule and face state as `other` (the face itself stays freshly built)
+    void mirror(const Run& other) {
+        m_face.mirror(other.m_face);
+        m_clock = other.m_clock;
+        m_nextDraw = other.m_nextDraw;
+        m_nextDrive = other.m_nextDrive;
+        m_nextSteer = other.m_nextSteer;
+        m_driveStep = other.m_driveStep;
+        m_wasBlinking = other.m_wasBlinking;
+        m_blinks = other.m_blinks;
+    }
+
+    [[nodiscard]] double seconds() const noexcept { return m_clock.seconds(); }
+    [[nodiscard]] long long blinks() const noexcept { return m_blinks; }   // Blink n is due at n * interval
+    [[nodiscard]] const Epoch& epoch() const noexcept { return m_epoch; }
+    void nextEpoch() noexcept { m_epoch = Epoch{}; }
+
+private:
+    Face m_face;
+    VirtualClock m_clock;
+    double m_drawEvery;
+    double m_nextDraw = 0.0;
+    double m_nextDrive = 0.0;
+    double m_nextSteer = 0.0;
+    int m_driveStep = 0;
+    bool m_wasBlinking = false;
+    long long m_blinks = 0;
+    Epoch m_epoch;
+};
+
+template <typename Fn>
+double milliseconds(Fn fn) {
+    const auto start = Clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+struct Cost {
+    double updateNs = 1e30;
+    double drawMs = 1e30;
+};
+
+constexpr int kProbeBlocks = 8;
+constexpr int kProbeFrames = 1200;
+
+// Fastest block of frames and fastest draw over the probe (noise only ever adds time)
+template <typename Face>
+void probeBlock(Cost& cost, Run<Face>& run) {
+    const double ms = milliseconds([&] {
+        for (int frame = 0; frame < kProbeFrames; frame++) run.step();
+    });
+    cost.updateNs = std::min(cost.updateNs, ms * 1e6 / kProbeFrames);
+    cost.drawMs = std::min(cost.drawMs, milliseconds([&] { run.draw(); }));
+}
+
+template <typename Face>
+bool soak(const Soak& config) {
+    std::vector<unsigned char> pixels(kWidth * kHeight * 4);
+    std::vector<unsigned char> controlPixels(kWidth * kHeight * 4);
+    Run<Face> run(pixels.data(), config.drawEvery);
+
+    const double end = config.days * 86400.0;
+    const double epochSeconds = config.epochHours * 3600.0;
+    bool ok = true;
+    size_t baselineRss = 0;
+    uint64_t allocationsBefore = 0;
+    bool counting = false;
+
+    for (double epochEnd = epochSeconds; run.seconds() < end; epochEnd += epochSeconds) {
+        while (run.seconds() < std::min(epochEnd, end)) {
+            run.step();
+            if (!counting && run.seconds() >= kWarmupSeconds) {
+                counting = true;
+                allocationsBefore = robotface::alloc::allocationCount();
+            }
+        }
+
+        // Allocations first: reading RSS, building the control face and printing may allocate
+        const uint64_t allocations = counting ? robotface::alloc::allocationCount() - allocationsBefore : 0;
+        const size_t rss = robotface::alloc::currentRssKb();
+        if (baselineRss == 0) baselineRss = rss;
+
+        // Cost probe: the soaked face against a freshly built one in the same state, fed the
+        // same frames, interleaved so host noise (frequency scaling, neighbours) hits both alike
+        Cost soaked;
+        Cost fresh;
+        Run<Face> control(controlPixels.data(), config.drawEvery);
+        control.mirror(run);
+        for (int block = 0; block < kProbeBlocks; block++) {
+            probeBlock(soaked, run);
+            probeBlock(fresh, control);
+        }
+        const double creep = std::max(soaked.updateNs / fresh.updateNs, soaked.drawMs / fresh.drawMs);
+
+        const Epoch& epoch = run.epoch();
+        const double ppm = epoch.intervalPpm();
+        const bool drift = std::fabs(ppm) > config.maxPpm || epoch.worstPhase > config.maxPhase;
+        const bool growth = rss > baselineRss + config.rssSlackKb || allocations > 0;
+        const bool slower = creep > config.maxCreep;
+        ok = ok && !drift && !growth && !slower;
+
+        std::printf("%7.2f %7d %9.2f %8.3f %9zu %7llu %9.1f %8.3f %6.2fx  %s\n", run.seconds() / 86400.0,
+                    epoch.blinks, ppm, epoch.worstPhase, rss, static_cast<unsigned long long>(allocations),
+                    soaked.updateNs, soaked.drawMs, creep,
+                    drift ? "DRIFT" : growth ? "GROWTH" : slower ? "CREEP" : "ok");
+        std::fflush(stdout);
+
+        if (counting) allocationsBefore = robotface::alloc::allocationCount();
+        run.nextEpoch();
+    }
+
+    const double due = std::floor(run.seconds() / kBlinkInterval);
+    std::printf("%lld automatic blinks over %.2f days, %.0f due (interval %.1f s)\n", run.blinks(),
+                run.seconds() / 86400.0, due, kBlinkInterval);
+    return ok && std::fabs(static_cast<double>(run.blinks()) - due) <= 1.0;
+}
+
+struct Implementation {
+    const char* name;
+    bool (*run)(const Soak&);
+};
+
+const Implementation kImplementations[] = {
+    {"c", soak<CFace>},
+    {"cpp", soak<CppFace>},
+};
+
+// Runs one implementation in a child process so RSS is its own; returns true if it passed
+bool runIsolated(const Implementation& impl, const Soak& config) {
+    std::printf("\n[%s]\n%7s %7s %9s %8s %9s %7s %9s %8s %7s\n", impl.name, "day", "blinks", "ppm", "phase s",
+                "RSS KiB", "allocs", "update ns", "draw ms", "/fresh");
+    std::fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) {
+        std::perror("fork");
+        return false;
+    }
+
+    if (pid == 0) {
+        const auto start = Clock::now();
+        const bool ok = impl.run(config);
+        std::printf("%s: %s in %.1f s wall\n", impl.name, ok ? "ok" : "FAIL",
+                    std::chrono::duration<double>(Clock::now() - start).count());
+        std::fflush(stdout);
+        _exit(ok ? 0 : 1);
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Soak config;
+    const char* only = nullptr;
+
+    // --help, an unknown flag or a missing value prints the usage (a typo must not start a multi-day run)
+    bool usage = false;
+    for (int i = 1; i < argc && !usage; i += 2) {
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (std::strcmp(argv[i], "--help") == 0 || value == nullptr) usage = true;
+        else if (std::strcmp(argv[i], "--days") == 0) config.days = std::atof(value);
+        else if (std::strcmp(argv[i], "--epoch-hours") == 0) config.epochHours = std::atof(value);
+        else if (std::strcmp(argv[i], "--draw-every") == 0) config.drawEvery = std::atof(value);
+        else if (std::strcmp(argv[i], "--impl") == 0) only = value;
+        else if (std::strcmp(argv[i], "--max-ppm") == 0) config.maxPpm = std::atof(value);
+        else if (std::strcmp(argv[i], "--max-phase") == 0) config.maxPhase = std::atof(value);
+        else if (std::strcmp(argv[i], "--rss-slack") == 0) config.rssSlackKb = std::strtoul(value, nullptr, 10);
+        else if (std::strcmp(argv[i], "--max-creep") == 0) config.maxCreep = std::atof(value);
+        else usage = true;
+    }
+    if (usage) {
+        std::fprintf(stderr, "Usage: %s [--days 90] [--epoch-hours 24] [--draw-every 600] [--impl c|cpp]\n"
+                             "          [--max-ppm 50] [--max-phase 0.5] [--rss-slack 1024] [--max-creep 1.5]\n", argv[0]);
+        return 1;
+    }
+    if (config.days <= 0.0 || config.epochHours < 1.0 || config.drawEvery <= 0.0) {
+        std::fprintf(stderr, "days and draw-every must be positive, epoch-hours >= 1\n");
+        return 1;
+    }
+
+    std::printf("%.2f simulated days, %.0f h epochs, a frame drawn every %.0f s\n", config.days, config.epochHours,
+                config.drawEvery);
+    std::printf("limits: %.0f ppm interval, %.2f s phase, %zu KiB RSS, %.2fx cost\n", config.maxPpm,
+                config.maxPhase, config.rssSlackKb, config.maxCreep);
+
+    bool ok = true;
+    for (const Implementation& impl : kImplementations) {
+        if (only && std::strcmp(only, impl.name) != 0) continue;
+        ok = runIsolated(impl, config) && ok;
+    }
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,142 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Cold Start Benchmark
+ *
+ *   Launches each executable several times with --startup and measures, from the outside,
+ *   the time from fork/exec until the "startup: first-frame" line arrives on its stdout.
+ *   The executable reports its own phases relative to main() (robot_face_startup.h), so
+ *   the difference is the exec-to-main time: dynamic loading, relocations, static
+ *   constructors. Reports the median of every phase over all runs.
+ *
+ *   Run it from the build directory. On GPU-less hosts:
+ *     LIBGL_ALWAYS_SOFTWARE=1 xvfb-run -a ./robot_face_startup_bench
+ *
+ *   Usage:
+ *     robot_face_startup_bench [--runs 10] [executable ...]
+ *     (default: ./robot_face_raylib ./robot_face_c ./robot_face_cpp)
+ *
+ *******************************************************************************************/
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Phase {
+    std::string name;
+    std::vector<double> ms;
+};
+
+struct Timeline {
+    std::vector<Phase> phases;     // In the order the executable reports them
+
+    void add(const std::string& name, double ms) {
+        for (Phase& phase : phases) {
+            if (phase.name == name) {
+                phase.ms.push_back(ms);
+                return;
+            }
+        }
+        phases.push_back({name, {ms}});
+    }
+};
+
+double median(std::vector<double> values) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+// One cold start; false when the executable could not be run or printed no first frame
+bool runOnce(const char* executable, Timeline& timeline) {
+    int pipeFds[2];
+    if (pipe(pipeFds) != 0) return false;
+
+    const auto start = Clock::now();
+    const pid_t pid = fork();
+    if (pid < 0) {
+        close(pipeFds[0]);
+        close(pipeFds[1]);
+        return false;
+    }
+    if (pid == 0) {
+        dup2(pipeFds[1], STDOUT_FILENO);
+        close(pipeFds[0]);
+        close(pipeFds[1]);
+        execl(executable, executable, "--startup", static_cast<char*>(nullptr));
+        _exit(127);
+    }
+    close(pipeFds[1]);
+
+    FILE* output = fdopen(pipeFds[0], "r");
+    bool firstFrame = false;
+    char line[256];
+    while (output && std::fgets(line, sizeof(line), output)) {
+        char name[64];
+        double ms = 0.0;
+        if (std::sscanf(line, "startup: %63s %lf ms", name, &ms) != 2) continue;
+
+        if (std::strcmp(name, "first-frame") == 0) {
+            const double externalMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            timeline.add("exec-to-main", externalMs - ms);
+            timeline.add("first-frame", externalMs);
+            firstFrame = true;
+        } else {
+            timeline.add(name, ms);
+        }
+    }
+    if (output) std::fclose(output);
+    else close(pipeFds[0]);
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return firstFrame && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int runs = 10;
+    std::vector<const char*> executables;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--runs") == 0 && i + 1 < argc) runs = std::atoi(argv[++i]);
+        else executables.push_back(argv[i]);
+    }
+    if (runs < 1) {
+        std::fprintf(stderr, "runs must be positive\n");
+        return 1;
+    }
+    if (executables.empty()) executables = {"./robot_face_raylib", "./robot_face_c", "./robot_face_cpp"};
+
+    int failures = 0;
+    for (const char* executable : executables) {
+        Timeline timeline;
+        int completed = 0;
+        for (int run = 0; run < runs; run++) {
+            if (runOnce(executable, timeline)) completed++;
+        }
+
+        std::printf("\n%s (%d/%d runs, median ms)\n", executable, completed, runs);
+        if (completed == 0) {
+            std::printf("  no first frame reported\n");
+            failures++;
+            continue;
+        }
+        for (const Phase& phase : timeline.phases) {
+            std::printf("  %-14s %9.3f\n", phase.name.c_str(), median(phase.ms));
+        }
+    }
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,159 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Lookup Table Microbenchmark
+ *
+ *   Compares the compile-time tables in robot_face_tables.hpp with libm:
+ *   - ns per evaluation (blink factor, sine in/out, spring, mouth Bezier)
+ *   - worst absolute error over a dense sweep, against double-precision libm
+ *
+ *   Usage:
+ *     robot_face_table_bench [--samples 1000000] [--rounds 20]
+ *
+ *******************************************************************************************/
+
+#include "robot_face_tables.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace robotface::tables;
+
+namespace {
+
+constexpr float kPi = 3.14159265358979323846f;
+constexpr int kMouthSegments = 30;
+
+#if defined(__x86_64__) || defined(_M_X64)
+constexpr const char* kArch = "x86_64";
+#elif defined(__aarch64__) || defined(_M_ARM64)
+constexpr const char* kArch = "arm64";
+#elif defined(__arm__)
+constexpr const char* kArch = "arm";
+#else
+constexpr const char* kArch = "other";
+#endif
+
+volatile float g_sink = 0.0f;
+
+template <typename Fn>
+double nsPerCall(const std::vector<float>& inputs, int rounds, Fn fn) {
+    float sum = 0.0f;
+    const auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (float x : inputs) sum += fn(x);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    g_sink = sum;
+    return std::chrono::duration<double, std::nano>(end - start).count() / (static_cast<double>(inputs.size()) * rounds);
+}
+
+template <typename Fast, typename Exact>
+double maxError(float lo, float hi, Fast fast, Exact exact) {
+    double worst = 0.0;
+    const int steps = 1 << 20;
+    for (int i = 0; i <= steps; i++) {
+        const float x = lo + (hi - lo) * static_cast<float>(i) / steps;
+        const double error = std::fabs(static_cast<double>(fast(x)) - exact(static_cast<double>(x)));
+        if (error > worst) worst = error;
+    }
+    return worst;
+}
+
+// libm versions of the same curves (what the face computed before the tables)
+float libmBlink(float p) {
+    return (p < 1.0f) ? std::sin(p * kPi / 2.0f) : std::sin((2.0f - p) * kPi / 2.0f);
+}
+
+float libmSineInOut(float t) {
+    return 0.5f - 0.5f * std::cos(t * kPi);
+}
+
+float libmSpring(float t) {
+    return 1.0f - std::exp(-6.0f * t) * std::cos(2.5f * kPi * t);
+}
+
+void report(const char* name, double libmNs, double tableNs, double error) {
+    std::printf("%-16s %10.2f %10.2f %9.2fx %12.2e\n", name, libmNs, tableNs, libmNs / tableNs, error);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t samples = 1000000;
+    int rounds = 20;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--samples") == 0) samples = static_cast<size_t>(std::atol(argv[i + 1]));
+        else if (std::strcmp(argv[i], "--rounds") == 0) rounds = std::atoi(argv[i + 1]);
+    }
+    if (samples == 0 || rounds < 1) {
+        std::fprintf(stderr, "samples and rounds must be positive\n");
+        return 1;
+    }
+
+    // Pseudo-random inputs so branch prediction and caches see realistic access
+    std::vector<float> progress(samples);
+    std::vector<float> unit(samples);
+    unsigned int seed = 2024u;
+    for (size_t i = 0; i < samples; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        unit[i] = static_cast<float>(seed >> 8) / static_cast<float>(1u << 24);
+        progress[i] = unit[i] * 2.0f;
+    }
+
+    std::printf("Architecture: %s, %zu samples x %d rounds, table size %zu\n\n", kArch, samples, rounds, kCurveTableSize);
+    std::printf("%-16s %10s %10s %10s %12s\n", "curve", "libm ns", "table ns", "speedup", "max error");
+
+    report("blink (sine)",
+           nsPerCall(progress, rounds, libmBlink),
+           nsPerCall(progress, rounds, [](float p) { return blinkFactor<easing::Sine>(p); }),
+           maxError(0.0f, 2.0f, blinkFactor<easing::Sine>, [](double p) {
+               return std::sin((p < 1.0 ? p : 2.0 - p) * 3.14159265358979323846 / 2.0);
+           }));
+
+    report("sine in/out",
+           nsPerCall(unit, rounds, libmSineInOut),
+           nsPerCall(unit, rounds, [](float t) { return easing::SineInOut::apply(t); }),
+           maxError(0.0f, 1.0f, easing::SineInOut::apply, [](double t) {
+               return 0.5 - 0.5 * std::cos(t * 3.14159265358979323846);
+           }));
+
+    report("spring",
+           nsPerCall(unit, rounds, libmSpring),
+           nsPerCall(unit, rounds, [](float t) { return easing::Spring::apply(t); }),
+           maxError(0.0f, 1.0f, easing::Spring::apply, [](double t) {
+               return 1.0 - std::exp(-6.0 * t) * std::cos(2.5 * 3.14159265358979323846 * t);
+           }));
+
+    // Cubic is an exact polynomial (no table); listed for comparison with the table curves
+    report("cubic",
+           nsPerCall(unit, rounds, [](float t) { return t * t * (3.0f - 2.0f * t); }),
+           nsPerCall(unit, rounds, [](float t) { return easing::Cubic::apply(t); }),
+           0.0);
+
+    // Mouth polyline: per-point basis weights vs the constexpr basis (per curve, 31 points)
+    static constexpr auto kBasis = makeQuadraticBasis<kMouthSegments>();
+    const double libmMouth = nsPerCall(unit, rounds / 4 + 1, [](float controlY) {
+        float sum = 0.0f;
+        for (int i = 0; i <= kMouthSegments; i++) {
+            const float t = static_cast<float>(i) / kMouthSegments;
+            sum += (1-t)*(1-t)*400.0f + 2*(1-t)*t*(370.0f + controlY * 60.0f) + t*t*400.0f;
+        }
+        return sum;
+    });
+    const double tableMouth = nsPerCall(unit, rounds / 4 + 1, [](float controlY) {
+        float sum = 0.0f;
+        for (int i = 0; i <= kMouthSegments; i++) {
+            sum += kBasis.w0[i]*400.0f + kBasis.w1[i]*(370.0f + controlY * 60.0f) + kBasis.w2[i]*400.0f;
+        }
+        return sum;
+    });
+    report("mouth bezier", libmMouth, tableMouth, 0.0);
+
+    std::printf("\nCompile-time bounds: sine %.2e, sine in/out %.2e, spring %.2e\n",
+                kSineOutTable.maxError, kSineInOutTable.maxError, kSpringTable.maxError);
+    return 0;
+}
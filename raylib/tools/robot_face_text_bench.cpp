@@ -0,0 +1,163 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Text Rendering Benchmark
+ *
+ *   Compares the two raylib text paths of the canvas for the status overlay:
+ *   - DrawText: raylib's default bitmap font, one textured quad per glyph, scaled
+ *     (and blurred) for any size but 10
+ *   - SDF: the embedded distance field atlas, the frame's text queued into one quad
+ *     buffer and submitted in one draw under the edge shader
+ *   CPU side (no window): atlas bake time, blob load time and TextBatch throughput.
+ *   Window side: pages of overlay text at sizes 10, 20, 40 and 80, glyphs per
+ *   millisecond of frame time (uncapped, including EndDrawing / buffer swap).
+ *
+ *   On GPU-less hosts run it on Mesa llvmpipe:
+ *     LIBGL_ALWAYS_SOFTWARE=1 ./robot_face_text_bench
+ *
+ *   Usage:
+ *     robot_face_text_bench [--frames 300] [--no-window]
+ *
+ *******************************************************************************************/
+
+#include "robot_face_raylib_canvas.hpp"
+#include "robot_face_sdf_font.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace robotface;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr int kWidth = 800;
+constexpr int kHeight = 600;
+constexpr int kWarmupFrames = 30;
+constexpr float kSizes[] = {10.0f, 20.0f, 40.0f, 80.0f};
+constexpr const char* kLine = "Emotion: Happy (0.80)  FPS: 60  Draws 12  Verts 512";
+
+template <typename Fn>
+double milliseconds(Fn fn) {
+    const auto start = Clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Lines of kLine filling the window at a size
+int linesFor(float size) {
+    return std::max(1, static_cast<int>(static_cast<float>(kHeight) / size));
+}
+
+struct Result {
+    double frameMs = 0.0;
+    uint32_t glyphs = 0;       // Per frame
+    FrameStats stats;          // Last frame
+};
+
+Result timeText(int frames, float size, RaylibSdfText* sdf) {
+    Result result;
+    double totalMs = 0.0;
+    for (int frame = 0; frame < kWarmupFrames + frames && !WindowShouldClose(); frame++) {
+        FrameStats stats;
+        const double ms = milliseconds([&] {
+            BeginDrawing();
+            RaylibCanvas canvas;
+            canvas.setSdfText(sdf);
+            canvas.setStats(&stats);
+            canvas.clear(Rgba{245, 245, 245, 255});
+            for (int line = 0; line < linesFor(size); line++) {
+                canvas.text(kLine, Point2{4.0f, static_cast<float>(line) * size}, size, Rgba{80, 80, 80, 255});
+            }
+            canvas.flushText();
+            EndDrawing();
+        });
+        if (frame >= kWarmupFrames) totalMs += ms;
+        result.stats = stats;
+    }
+    result.frameMs = totalMs / frames;
+    result.glyphs = result.stats.glyphs;
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int frames = 300;
+    bool window = true;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc) frames = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--no-window") == 0) window = false;
+    }
+    if (frames < 1) {
+        std::fprintf(stderr, "frames must be positive\n");
+        return 1;
+    }
+
+    // Atlas: baked at startup vs viewed in the binary
+    std::vector<uint8_t> blob;
+    double bakeMs = 1e30;
+    for (int i = 0; i < 5; i++) bakeMs = std::min(bakeMs, milliseconds([&] { bakeSdfAtlas(blob); }));
+    SdfFont font;
+    const double loadMs = milliseconds([&] {
+        for (int i = 0; i < 1000; i++) (void)loadEmbeddedSdfFont(font);
+    }) / 1000.0;
+    if (!font.loaded()) {
+        std::fprintf(stderr, "Embedded SDF atlas does not load\n");
+        return 1;
+    }
+    const bool sameAtlas = std::memcmp(font.pixels(), blob.data() + font.header().pixelOffset,
+                                       static_cast<size_t>(font.width()) * font.height()) == 0;
+    std::printf("SDF atlas %dx%d, %d glyphs, %zu bytes\n", font.width(), font.height(), font.header().glyphCount,
+                blob.size());
+    std::printf("  bake at startup %10.3f ms\n", bakeMs);
+    std::printf("  load embedded   %10.6f ms (zero-copy view; %s the startup bake)\n", loadMs,
+                sameAtlas ? "identical to" : "DIFFERS from");
+
+    // Batching cost alone: what the SDF path spends on the CPU per glyph
+    TextBatch batch;
+    constexpr int kBatchLines = 200000;
+    const double batchMs = milliseconds([&] {
+        for (int i = 0; i < kBatchLines; i++) {
+            if (i % 64 == 0) batch.clear();
+            batch.add(font, kLine, Point2{4.0f, static_cast<float>(i % 64) * 20.0f}, 20.0f, Rgba{80, 80, 80, 255});
+        }
+    });
+    const double batchGlyphs = static_cast<double>(countGlyphs(kLine)) * kBatchLines;
+    std::printf("  TextBatch::add  %10.0f glyphs/ms\n", batchGlyphs / batchMs);
+    if (!window) return sameAtlas ? 0 : 1;
+
+    InitWindow(kWidth, kHeight, "Robot Face - Text Benchmark");
+    SetTargetFPS(0);   // Uncapped: measure the frame, not the limiter
+
+    RaylibSdfText sdf;
+    if (!sdf.load(font)) {
+        CloseWindow();
+        std::fprintf(stderr, "SDF text not available (texture upload or shader compile failed)\n");
+        return 1;
+    }
+
+    Result drawText[4];
+    Result sdfText[4];
+    for (int i = 0; i < 4; i++) {
+        drawText[i] = timeText(frames, kSizes[i], nullptr);
+        sdfText[i] = timeText(frames, kSizes[i], &sdf);
+    }
+    sdf.unload();
+    CloseWindow();
+
+    std::printf("\n%d frames, %dx%d, uncapped\n", frames, kWidth, kHeight);
+    std::printf("%5s %7s | %10s %10s %6s | %10s %10s %6s\n", "size", "glyphs", "DrawText", "glyphs/ms", "draws",
+                "SDF", "glyphs/ms", "draws");
+    for (int i = 0; i < 4; i++) {
+        const Result& a = drawText[i];
+        const Result& b = sdfText[i];
+        std::printf("%5.0f %7u | %7.3f ms %10.0f %6u | %7.3f ms %10.0f %6u\n", static_cast<double>(kSizes[i]), a.glyphs,
+                    a.frameMs, a.glyphs / a.frameMs, a.stats.drawCalls, b.frameMs, b.glyphs / b.frameMs,
+                    b.stats.drawCalls);
+    }
+    return sameAtlas ? 0 : 1;
+}
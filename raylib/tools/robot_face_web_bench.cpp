@@ -0,0 +1,157 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Web Build Benchmark (headless, runs under Node)
+ *
+ *   The software backend the way a browser console would run it: the C face updated and
+ *   drawn by the software rasterizer into an 800x600 frame, then a 320x240 RGB565 and a
+ *   200x150 output derived from it (box pyramid). Times each part per frame, with the
+ *   portable loops and with the vectorized kernels (SSE2 natively; WebAssembly SIMD128
+ *   when built with emcc -msimd128 -msse2), with damage tracking and with every level
+ *   and output recomputed (what the kernels cost on a frame that changes everywhere).
+ *   All must produce the same pixels: the last frame's checksum is printed, equal
+ *   across builds too.
+ *
+ *   web/build_wasm.sh builds it for Node twice (scalar and SIMD128) and runs both:
+ *     node web_output/robot_face_web_bench.js
+ *     node web_output/robot_face_web_bench_simd.js
+ *
+ *   Usage:
+ *     robot_face_web_bench [--frames 600]
+ *
+ *******************************************************************************************/
+
+#include "robot_face_outputs.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace robotface;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+constexpr float kDeltaTime = 1.0f / 60.0f;
+constexpr int kRepeats = 3;
+constexpr OutputSpec kOutputs[] = {
+    {800, 600, PixelFormat::Rgba8888},   // Console view
+    {320, 240, PixelFormat::Rgb565},     // Status LCD preview
+    {200, 150, PixelFormat::Rgba8888},   // Thumbnail
+};
+constexpr size_t kOutputCount = sizeof(kOutputs) / sizeof(kOutputs[0]);
+
+const char* buildName() {
+#if defined(__wasm_simd128__)
+    return "wasm32 + SIMD128";
+#elif defined(__wasm__)
+    return "wasm32, scalar";
+#elif defined(__SSE2__) || defined(_M_X64)
+    return "native, SSE2";
+#else
+    return "native, portable";
+#endif
+}
+
+struct Timing {
+    double updateMs = 0.0;
+    double renderMs = 0.0;
+    double presentMs = 0.0;
+    uint32_t checksum = 0;   // FNV-1a of the last frame's outputs
+
+    [[nodiscard]] double totalMs() const noexcept { return updateMs + renderMs + presentMs; }
+};
+
+double since(Clock::time_point& mark) {
+    const Clock::time_point now = Clock::now();
+    const double ms = std::chrono::duration<double, std::milli>(now - mark).count();
+    mark = now;
+    return ms;
+}
+
+uint32_t checksum(const OutputPyramid& outputs) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < outputs.outputCount(); i++) {
+        const OutputSpec& spec = outputs.spec(i);
+        for (int y = 0; y < spec.height; y++) {
+            const uint8_t* row = outputs.pixels(i) + static_cast<size_t>(y) * outputs.stride(i);
+            for (int x = 0; x < spec.width * bytesPerPixel(spec.format); x++) hash = (hash ^ row[x]) * 16777619u;
+        }
+    }
+    return hash;
+}
+
+// One pass over a deterministic sweep (emotion steps, blinks), per-frame milliseconds
+Timing timePass(int frames, bool vectorized, bool full) {
+    OutputPyramid outputs;
+    outputs.configure(kOutputs, kOutputCount);
+    outputs.setVectorized(vectorized);
+
+    RobotFace face;
+    InitRobotFace(&face);
+    Timing timing;
+    for (int frame = 0; frame < frames; frame++) {
+        Clock::time_point mark = Clock::now();
+        if (frame % 90 == 0) SetEmotion(&face, static_cast<float>((frame / 90) % 5) * 0.25f);
+        if (frame % 47 == 0) TriggerBlink(&face);
+        UpdateRobotFace(&face, kDeltaTime);
+        timing.updateMs += since(mark);
+        DrawRobotFaceSoft(&face, &outputs.source());
+        timing.renderMs += since(mark);
+        if (full) outputs.invalidate();
+        outputs.present();
+        timing.presentMs += since(mark);
+    }
+    timing.updateMs /= frames;
+    timing.renderMs /= frames;
+    timing.presentMs /= frames;
+    timing.checksum = checksum(outputs);
+    return timing;
+}
+
+// Best of kRepeats by total (the host is shared: keep the least disturbed pass)
+Timing bestPass(int frames, bool vectorized, bool full) {
+    Timing best = timePass(frames, vectorized, full);
+    for (int i = 1; i < kRepeats; i++) {
+        const Timing timing = timePass(frames, vectorized, full);
+        if (timing.totalMs() < best.totalMs()) best = timing;
+    }
+    return best;
+}
+
+void printRow(const char* name, const Timing& timing) {
+    std::printf("%-18s %8.3f %8.3f %8.3f %8.3f   %08x\n", name, timing.updateMs, timing.renderMs, timing.presentMs,
+                timing.totalMs(), timing.checksum);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int frames = 600;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--frames") == 0) frames = std::atoi(argv[i + 1]);
+    }
+    if (frames < 1) {
+        std::fprintf(stderr, "frames must be positive\n");
+        return 1;
+    }
+
+    std::printf("robot_face_web_bench (%s): %d frames, 800x600 + 320x240:rgb565 + 200x150\n", buildName(), frames);
+    std::printf("%-18s %8s %8s %8s %8s   %s\n", "ms per frame", "update", "render", "present", "total", "checksum");
+    const Timing portable = bestPass(frames, false, false);
+    const Timing portableFull = bestPass(frames, false, true);
+    printRow("portable", portable);
+    printRow("portable, full", portableFull);
+    if (!OutputPyramid::vectorAvailable()) return portable.checksum == portableFull.checksum ? 0 : 1;
+
+    const Timing vectorized = bestPass(frames, true, false);
+    const Timing vectorizedFull = bestPass(frames, true, true);
+    printRow("vectorized", vectorized);
+    printRow("vectorized, full", vectorizedFull);
+    if (vectorized.checksum != portable.checksum || vectorizedFull.checksum != portable.checksum ||
+        portableFull.checksum != portable.checksum) {
+        std::fprintf(stderr, "Outputs differ between kernels or damage tracking\n");
+        return 1;
+    }
+    std::printf("full present %.2fx faster vectorized\n", portableFull.presentMs / vectorizedFull.presentMs);
+    return 0;
+}
@@ -40,20 +40,45 @@ fi
 
 echo -e "${YELLOW}Building robot face WASM...${NC}"
 
-# Build the robot face with the raylib library
+# The browser drives the frame loop (emscripten_set_main_loop in robot_face_raylib.c),
+# so no ASYNCIFY: no unwind/rewind instrumentation around every call, smaller wasm.
+# 16 MB start (the Emscripten default) instead of 64 MB; the face needs a few MB.
 emcc ../src/robot_face_raylib.c \
     -o web_output/robot_face_raylib.html \
     -I raylib_src/src \
+    -I ../../common \
     raylib_src/src/libraylib.a \
     -s USE_GLFW=3 \
-    -s ASYNCIFY \
-    -s TOTAL_MEMORY=67108864 \
+    -s INITIAL_MEMORY=16777216 \
     -s ALLOW_MEMORY_GROWTH=1 \
+    -s ENVIRONMENT=web \
     -DPLATFORM_WEB \
     -Os \
     -Wall \
     --shell-file shell_minimal.html
 
+# Headless benchmark of the software backend for Node, scalar and SIMD128 (the output
+# kernels are SSE2 intrinsics, which Emscripten maps to WebAssembly SIMD with -msse2)
+build_bench() {
+    local name=$1
+    shift
+    local objects=web_output/obj/${name}
+    mkdir -p "${objects}"
+    emcc -c ../src/robot_face.c -o "${objects}/robot_face.o" -I ../include -I ../../common -std=c11 -O3 "$@"
+    emcc -c ../src/robot_face_soft.c -o "${objects}/robot_face_soft.o" -I ../include -std=c11 -O3 "$@"
+    emcc -c ../src/robot_face_outputs.cpp -o "${objects}/robot_face_outputs.o" -I ../include -std=c++17 -O3 "$@"
+    emcc -c ../tools/robot_face_web_bench.cpp -o "${objects}/robot_face_web_bench.o" -I ../include -std=c++17 -O3 "$@"
+    emcc "${objects}"/*.o -o "web_output/${name}.js" \
+        -s ENVIRONMENT=node \
+        -s INITIAL_MEMORY=16777216 \
+        -s ALLOW_MEMORY_GROWTH=1 \
+        -O3 "$@"
+}
+
+echo -e "${YELLOW}Building the Node benchmark (scalar, SIMD128)...${NC}"
+build_bench robot_face_web_bench
+build_bench robot_face_web_bench_simd -msimd128 -msse2
+
 if [ -f "web_output/robot_face_raylib.html" ]; then
     echo -e "${GREEN}✓ Build successful!${NC}"
     echo ""
@@ -65,8 +90,18 @@ if [ -f "web_output/robot_face_raylib.html" ]; then
         JS_SIZE=$(du -h web_output/robot_face_raylib.js | awk '{print $1}')
         echo "WASM size: ${WASM_SIZE}"
         echo "JS size: ${JS_SIZE}"
+        # What the browser downloads (servers compress both)
+        BUNDLE=$(cat web_output/robot_face_raylib.wasm web_output/robot_face_raylib.js | wc -c)
+        BUNDLE_GZ=$(cat web_output/robot_face_raylib.wasm web_output/robot_face_raylib.js | gzip -9 | wc -c)
+        echo "Bundle (wasm + js): ${BUNDLE} bytes, ${BUNDLE_GZ} gzipped"
     fi
     echo ""
+    if command -v node &> /dev/null; then
+        echo -e "${YELLOW}Software backend under Node:${NC}"
+        node web_output/robot_face_web_bench.js
+        node web_output/robot_face_web_bench_simd.js
+        echo ""
+    fi
     echo "To test, run:"
     echo "  cd web_output && python3 -m http.server 8000"
     echo "  Then open: http://localhost:8000/robot_face_raylib.html"
@@ -7,32 +7,69 @@
  *   - Automatic blinking every 3 seconds with smooth animation
  *   - Interactive emotion control (keyboard H/S/N or mouse hover)
  *   - High-quality antialiasing and advanced rendering effects
+ *   - Face recorded into a display list and replayed through SkiaFaceCanvas, which
+ *     counts what each frame submits (C shows the counters)
+ *   - Adaptive quality: drops antialiasing and status text when frames run over budget
+ *   - Status text from a signed distance field atlas (robot_face_sdf_font.hpp): baked
+ *     after the first frame instead of scanning fonts (or mapped from an asset pack,
+ *     robot_face_asset_pack.hpp), one drawAtlas per text style
  *
  *   Controls:
  *   - H: Happy emotion
  *   - S: Sad emotion
  *   - N: Neutral emotion
  *   - Mouse Click: Trigger blink
+ *   - P: Toggle the frame pacing graph (last ~4 s of present intervals)
+ *   - C: Toggle draw call / vertex counters
  *   - ESC: Exit
  *
+ *   Usage:
+ *     robot_face_skia --startup      # Print the cold start timeline and exit
+ *     robot_face_skia --text-bench   # SkFont vs SDF text, glyphs/ms on a raster surface, then exit
+ *     robot_face_skia --skfont       # Status text with SkFont instead of the SDF atlas
+ *     robot_face_skia --metrics 9464 # Prometheus metrics on 127.0.0.1:9464 (or a Unix socket path)
+ *     robot_face_skia --assets pack  # SDF atlas from a mapped asset pack instead of the startup bake
+ *     robot_face_skia --pacing       # Print frame pacing (jitter, missed vsyncs, double presents) at exit
+ *
  *******************************************************************************************/
 
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkPaint.h"
-#include "include/core/SkPath.h"
 #include "include/core/SkSurface.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkFontMgr.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkRSXform.h"
+#include "include/effects/SkRuntimeEffect.h"
 #include "include/effects/SkGradientShader.h"
 #include "include/effects/SkImageFilters.h"
 #include "tools/sk_app/Application.h"
 #include "tools/sk_app/Window.h"
-
+#include "robot_face_asset_pack.hpp"
+#include "robot_face_blink.h"
+#include "robot_face_display_list.hpp"
+#include "robot_face_frame_stats.hpp"
+#include "robot_face_hit.hpp"
+#include "robot_face_metrics.hpp"
+#include "robot_face_pacing.hpp"
+#include "robot_face_quality.hpp"
+#include "robot_face_sdf_font.hpp"
+#include "robot_face_skia_canvas.h"
+#include "robot_face_startup.h"
+
+#include <algorithm>
 #include <chrono>
 #include <cmath>
-#include <sstream>
-#include <iomanip>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#ifdef ROBOT_FACE_ALLOC_CHECK
+#define ROBOT_FACE_ALLOC_COUNTER_IMPLEMENTATION
+#include "robot_face_alloc_counter.hpp"
+#endif
 
 using namespace sk_app;
 
@@ -46,6 +83,8 @@ public:
         , m_blinkSpeed(5.0f)
         , m_frameCount(0)
         , m_lastTime(std::chrono::steady_clock::now())
+        , m_font(nullptr, 20)
+        , m_faceCanvas(nullptr)
     {}
 
     void update(float deltaTime) {
@@ -60,11 +99,8 @@ public:
         }
 
         // Update blink timer for automatic blinking (every 3 seconds)
-        m_blinkTimer += deltaTime;
-
-        if (m_blinkTimer >= 3.0 && !m_isBlinking) {
+        if (robotface::advanceBlinkTimer(m_blinkTimer, deltaTime, 3.0f, m_isBlinking)) {
             m_isBlinking = true;
-            m_blinkTimer = 0.0;
         }
 
         // Animate blink
@@ -79,44 +115,13 @@ public:
     }
 
     void draw(SkCanvas* canvas, int width, int height) {
-        // Clear background
-        canvas->clear(SK_ColorWHITE);
+        m_stats.reset();
+        drawFace(canvas);
 
-        // Draw title
-        SkPaint textPaint;
-        textPaint.setColor(SK_ColorDKGRAY);
-        textPaint.setAntiAlias(true);
-
-        SkFont font(nullptr, 20);
-        canvas->drawString("Skia Robot Face", 10, 30, font, textPaint);
-
-        // Draw eyes
-        drawEye(canvas, 250, 200, m_blinkProgress);
-        drawEye(canvas, 550, 200, m_blinkProgress);
-
-        // Draw mouth
-        drawMouth(canvas, 400, 400, m_happiness);
-
-        // Draw emotion indicator
-        const char* emotion = "Neutral";
-        if (m_happiness > 0.7f) emotion = "Happy";
-        else if (m_happiness < 0.3f) emotion = "Sad";
-
-        std::ostringstream oss;
-        oss << "Emotion: " << emotion << " (" << std::fixed << std::setprecision(2) << m_happiness << ")";
-        canvas->drawString(oss.str().c_str(), 10, 60, font, textPaint);
-
-        // Draw FPS
-        std::ostringstream fpsText;
-        fpsText << "FPS: " << static_cast<int>(m_fps);
-        textPaint.setColor(SK_ColorGREEN);
-        canvas->drawString(fpsText.str().c_str(), 10, 90, font, textPaint);
-
-        // Draw controls
-        font.setSize(16);
-        textPaint.setColor(SK_ColorGRAY);
-        canvas->drawString("Controls: H=Happy, S=Sad, N=Neutral, Click=Blink, ESC=Exit",
-                         10, height - 20, font, textPaint);
+        // First frame: shapes only. Text needs the SDF atlas (or the font manager and a
+        // typeface), which are set up after the first present (loadFont).
+        if (m_fontLoaded) drawOverlay(canvas, height);
+        m_frameStats = m_stats;
     }
 
     void setEmotion(float happiness) {
@@ -131,9 +136,244 @@ public:
     }
 
     float getHappiness() const { return m_happiness; }
+    bool isBlinking() const { return m_isBlinking; }
+
+    // Static string, no allocation
+    const char* getEmotionLabel() const {
+        if (m_happiness > 0.7f) return "Happy";
+        if (m_happiness < 0.3f) return "Sad";
+        return "Neutral";
+    }
+
+    // Anti-aliasing, overlay and mouth segments apply here; the eyes are drawn live and
+    // at full resolution, so sprites and resolution do not
+    void setQuality(const robotface::QualitySettings& quality) { m_quality = quality; }
+
+    // Deferred until the first frame is on screen: the SDF atlas bake, or the font manager
+    // scan and typeface load (also the fallback when the atlas cannot be set up)
+    void loadFont(bool sdf = true, const char* assets = nullptr) {
+        m_useSdf = sdf && loadSdfFont(assets);
+        sk_sp<SkFontMgr> fontMgr = SkFontMgr::RefDefault();
+        if (!m_useSdf) m_font.setTypeface(fontMgr->legacyMakeTypeface(nullptr, SkFontStyle()));
+        m_faceCanvas.setFontManager(std::move(fontMgr));
+        m_fontLoaded = true;
+
+        // Start-up frames do not count towards the FPS readout
+        m_frameCount = 0;
+        m_lastTime = std::chrono::steady_clock::now();
+    }
+
+    // Text at a baseline: drawn now with SkFont, or queued for flushText with the SDF atlas
+    void drawText(SkCanvas* canvas, const char* text, float x, float baseline, float size, SkColor color) {
+        if (m_useSdf) {
+            const robotface::Rgba rgba{static_cast<uint8_t>(SkColorGetR(color)), static_cast<uint8_t>(SkColorGetG(color)),
+                                       static_cast<uint8_t>(SkColorGetB(color)), static_cast<uint8_t>(SkColorGetA(color))};
+            m_textBatch.add(m_sdfFont, text, robotface::Point2{x, baseline - m_sdfFont.baseline(size)}, size, rgba);
+            return;
+        }
+
+        SkPaint textPaint;
+        textPaint.setColor(color);
+        textPaint.setAntiAlias(m_quality.antiAlias);
+        m_font.setSize(size);
+        canvas->drawString(text, x, baseline, m_font, textPaint);
+        m_stats.drawCalls++;
+        m_stats.glyphs += robotface::countGlyphs(text);
+    }
+
+    // Queued SDF text: one drawAtlas per run (size and color), glyph transforms and atlas
+    // rectangles in reused arrays
+    void flushText(SkCanvas* canvas) {
+        if (m_textBatch.empty()) return;
+
+        const std::vector<robotface::TextQuad>& quads = m_textBatch.quads();
+        const robotface::SdfAtlasHeader& atlas = m_sdfFont.header();
+        m_xforms.resize(quads.size());
+        m_atlasRects.resize(quads.size());
+        for (size_t i = 0; i < quads.size(); i++) {
+            const robotface::TextQuad& q = quads[i];
+            m_xforms[i] = SkRSXform::Make((q.x1 - q.x0) / atlas.cellWidth, 0.0f, q.x0, q.y0);
+            m_atlasRects[i] = SkRect::MakeLTRB(q.u0 * atlas.width, q.v0 * atlas.height, q.u1 * atlas.width,
+                                               q.v1 * atlas.height);
+        }
+
+        const SkSamplingOptions sampling(SkFilterMode::kLinear);
+        for (const robotface::TextRun& run : m_textBatch.runs()) {
+            SkPaint paint;
+            paint.setColorFilter(sdfFilter(run.size, run.color));
+            canvas->drawAtlas(m_atlasImage.get(), &m_xforms[run.first], &m_atlasRects[run.first], nullptr,
+                              static_cast<int>(run.count), SkBlendMode::kSrcOver, sampling, nullptr, &paint);
+
+            // One quad (two triangles) per glyph; every run switches the color filter
+            m_stats.drawCalls++;
+            m_stats.vertices += static_cast<uint32_t>(run.count) * 4;
+            m_stats.triangles += static_cast<uint32_t>(run.count) * 2;
+            m_stats.stateChanges++;
+            m_stats.glyphs += static_cast<uint32_t>(run.count);
+        }
+        m_textBatch.clear();
+    }
+
+    // Frame pacing graph of the loop's analyzer in the overlay (P); the analyzer must outlive its use
+    void setPacing(const robotface::PacingAnalyzer* pacing) { m_pacing = pacing; }
+    void togglePacingOverlay() { m_pacingOverlay = !m_pacingOverlay; }
+    void toggleStatsOverlay() { m_statsOverlay = !m_statsOverlay; }
+
+    // Submission counters of the previous frame
+    [[nodiscard]] const robotface::FrameStats& frameStats() const { return m_frameStats; }
+
+    [[nodiscard]] bool usesSdf() const { return m_useSdf; }
+    void setUseSdf(bool sdf) { m_useSdf = sdf && m_atlasImage; }
 
 private:
-    void drawEye(SkCanvas* canvas, float x, float y, float blinkProgress) {
+    // Edge of the distance field in the atlas alpha: smoothstep around 0.5, colored
+    static constexpr const char* kSdfEdgeFilter = R"(
+        uniform half4 color;
+        uniform half smoothing;
+        half4 main(half4 sample) {
+            return color * smoothstep(0.5 - smoothing, 0.5 + smoothing, sample.a);
+        }
+    )";
+
+    struct SdfFilter {
+        float size = 0.0f;
+        SkColor color = 0;
+        sk_sp<SkColorFilter> filter;
+    };
+    static constexpr int kSdfFilterSlots = 8;
+    static constexpr int kMaxMouthSegments = 30;   // kQualityLevels[0].mouthSegments
+
+    // From the asset pack when one is given and holds the atlas (the pages are shared with
+    // every other face process), else baked into a heap blob
+    bool loadSdfFont(const char* assets) {
+        const robotface::AssetView atlas = (assets && m_assets.open(assets))
+                                               ? m_assets.section("font/status", robotface::kAssetTypeSdfAtlas)
+                                               : robotface::AssetView{};
+        if (assets && atlas.empty()) {
+            std::fprintf(stderr, "ASSETS: %s: %s (baking the atlas)\n", assets, m_assets.error());
+        }
+        if (atlas.empty() || !m_sdfFont.load(atlas.data, atlas.size)) {
+            robotface::bakeSdfAtlas(m_atlasBlob);
+            if (!m_sdfFont.load(m_atlasBlob.data(), m_atlasBlob.size())) return false;
+        }
+
+        // The image views the pixels in the pack or the blob (no copy); both live as long as the face
+        const SkPixmap pixmap(SkImageInfo::MakeA8(m_sdfFont.width(), m_sdfFont.height()), m_sdfFont.pixels(),
+                              static_cast<size_t>(m_sdfFont.width()));
+        m_atlasImage = SkImages::RasterFromPixmap(pixmap, nullptr, nullptr);
+        m_sdfEffect = SkRuntimeEffect::MakeForColorFilter(SkString(kSdfEdgeFilter)).effect;
+        return m_atlasImage && m_sdfEffect;
+    }
+
+    // Filters are made once per text style (the smoothing depends on the size) and kept:
+    // the steady-state frame must not touch the heap
+    sk_sp<SkColorFilter> sdfFilter(float size, robotface::Rgba rgba) {
+        const SkColor color = SkColorSetARGB(rgba.a, rgba.r, rgba.g, rgba.b);
+        for (const SdfFilter& slot : m_sdfFilters) {
+            if (slot.filter && slot.size == size && slot.color == color) return slot.filter;
+        }
+
+        struct {
+            SkColor4f color;
+            float smoothing;
+        } uniforms{SkColor4f::FromColor(color).premul(), m_sdfFont.edgeSmoothing(size)};
+        SdfFilter& slot = m_sdfFilters[m_nextSdfFilter++ % kSdfFilterSlots];
+        slot = SdfFilter{size, color, m_sdfEffect->makeColorFilter(SkData::MakeWithCopy(&uniforms, sizeof(uniforms)))};
+        return slot.filter;
+    }
+
+    // The face is recorded into a display list and replayed into the Skia canvas, the path
+    // captures and remote frames take; the canvas counts what it submits. The list keeps
+    // its storage between frames.
+    void drawFace(SkCanvas* canvas) {
+        m_faceList.clear();
+        robotface::DisplayListRecorder recorder(m_faceList);
+        recorder.clear(kWhite);
+        drawEye(recorder, 250, 200, m_blinkProgress);
+        drawEye(recorder, 550, 200, m_blinkProgress);
+        drawMouth(recorder, 400, 400, m_happiness);
+
+        m_faceCanvas.setCanvas(canvas);
+        m_faceCanvas.setAntiAlias(m_quality.antiAlias);
+        m_faceCanvas.setStats(&m_stats);
+        robotface::replay(m_faceList, m_faceCanvas);
+    }
+
+    // Title, status text, counters and pacing graph (SDF text is queued and drawn by
+    // flushText, on top of the shapes)
+    void drawOverlay(SkCanvas* canvas, int height) {
+        drawText(canvas, "Skia Robot Face", 10, 30, 20, SK_ColorDKGRAY);
+
+        // Status text is the first detail the quality governor drops
+        if (m_quality.overlay) {
+            // Fixed stack buffers: the steady-state frame must not touch the heap
+            char emotionText[64];
+            std::snprintf(emotionText, sizeof(emotionText), "Emotion: %s (%.2f)", getEmotionLabel(), m_happiness);
+            drawText(canvas, emotionText, 10, 60, 20, SK_ColorDKGRAY);
+
+            char fpsText[32];
+            std::snprintf(fpsText, sizeof(fpsText), "FPS: %d", static_cast<int>(m_fps));
+            drawText(canvas, fpsText, 10, 90, 20, SK_ColorGREEN);
+
+            if (m_statsOverlay) {
+                char statsText[128];
+                std::snprintf(statsText, sizeof(statsText),
+                              "Draws %u  Verts %u  Tris %u  Flushes %u  States %u  Glyphs %u",
+                              m_frameStats.drawCalls, m_frameStats.vertices, m_frameStats.triangles,
+                              m_frameStats.batchFlushes, m_frameStats.stateChanges, m_frameStats.glyphs);
+                drawText(canvas, statsText, 10, 115, 16, SkColorSetRGB(190, 33, 55));
+            }
+
+            if (m_pacingOverlay && m_pacing) drawPacing(canvas, height);
+        }
+
+        drawControls(canvas, height);
+        flushText(canvas);
+    }
+
+    void drawControls(SkCanvas* canvas, int height) {
+        drawText(canvas, "Controls: H=Happy, S=Sad, N=Neutral, P=Pacing, C=Counters, Click=Blink, ESC=Exit", 10,
+                 height - 20, 16, SK_ColorGRAY);
+    }
+
+    // Last ~4 s of present intervals above the controls line: interval / expected, reference
+    // lines at on-time and one missed vsync, a dot per late, early or uneven present
+    void drawPacing(SkCanvas* canvas, int height) {
+        char pacingText[128];
+        m_pacing->summary(pacingText, sizeof(pacingText));
+        drawText(canvas, pacingText, 10, height - 150, 16, SK_ColorDKGRAY);
+
+        m_pacingGraph.layout(*m_pacing, 10.0f, static_cast<float>(height - 140), 300.0f, 90.0f);
+        SkPaint paint;
+        paint.setAntiAlias(m_quality.antiAlias);
+        paint.setStrokeWidth(1.0f);
+        paint.setColor(SkColorSetARGB(160, 130, 130, 130));
+        canvas->drawLine(m_pacingGraph.onTime[0].x, m_pacingGraph.onTime[0].y, m_pacingGraph.onTime[1].x,
+                         m_pacingGraph.onTime[1].y, paint);
+        paint.setColor(SkColorSetARGB(120, 230, 41, 55));
+        canvas->drawLine(m_pacingGraph.missed[0].x, m_pacingGraph.missed[0].y, m_pacingGraph.missed[1].x,
+                         m_pacingGraph.missed[1].y, paint);
+
+        for (int i = 0; i < m_pacingGraph.lineCount; i++) {
+            m_pacingPoints[i] = SkPoint::Make(m_pacingGraph.line[i].x, m_pacingGraph.line[i].y);
+        }
+        paint.setStrokeWidth(1.5f);
+        paint.setColor(SkColorSetRGB(80, 80, 80));
+        canvas->drawPoints(SkCanvas::kPolygon_PointMode, m_pacingGraph.lineCount, m_pacingPoints, paint);
+
+        for (int i = 0; i < m_pacingGraph.markerCount; i++) {
+            const robotface::Rgba color = robotface::kPacingEventColors[static_cast<int>(m_pacingGraph.markerEvents[i])];
+            paint.setColor(SkColorSetARGB(color.a, color.r, color.g, color.b));
+            canvas->drawCircle(m_pacingGraph.markers[i].x, m_pacingGraph.markers[i].y, 2.5f, paint);
+        }
+
+        // Two reference lines and the polyline submit their points; markers are analytic circles
+        m_stats.drawCalls += 3 + static_cast<uint32_t>(m_pacingGraph.markerCount);
+        m_stats.vertices += 4 + static_cast<uint32_t>(m_pacingGraph.lineCount);
+        m_stats.stateChanges += 3;
+    }
+
+    void drawEye(robotface::Canvas& canvas, float x, float y, float blinkProgress) {
         // Calculate blink factor (0 = open, 1 = closed) using sine wave
         float blinkFactor = 0.0f;
         if (blinkProgress < 1.0f) {
@@ -144,67 +384,44 @@ private:
             blinkFactor = std::sin((2.0f - blinkProgress) * M_PI / 2.0f);
         }
 
-        // Eye white (outer circle)
-        SkPaint eyeWhitePaint;
-        eyeWhitePaint.setColor(SK_ColorWHITE);
-        eyeWhitePaint.setAntiAlias(true);
-        eyeWhitePaint.setStyle(SkPaint::kFill_Style);
-        canvas->drawCircle(x, y, 60, eyeWhitePaint);
-
-        // Eye outline
-        SkPaint outlinePaint;
-        outlinePaint.setColor(SK_ColorBLACK);
-        outlinePaint.setAntiAlias(true);
-        outlinePaint.setStyle(SkPaint::kStroke_Style);
-        outlinePaint.setStrokeWidth(2);
-        canvas->drawCircle(x, y, 60, outlinePaint);
+        // Eye white (outer circle) and outline
+        const robotface::Point2 center{x, y};
+        canvas.circle(center, 60, kWhite);
+        canvas.ring(center, 60, 2, kBlack);
 
         // Pupil size changes during blink
         float pupilRadius = 40.0f * (1.0f - blinkFactor * 0.875f);
 
         // Pupil (black circle)
-        SkPaint pupilPaint;
-        pupilPaint.setColor(SK_ColorBLACK);
-        pupilPaint.setAntiAlias(true);
-        canvas->drawCircle(x, y, pupilRadius, pupilPaint);
+        canvas.circle(center, pupilRadius, kBlack);
 
-        // Highlight (gives eyes a "shiny" look)
+        // Highlight (gives eyes a "shiny" look, with some transparency)
         if (pupilRadius > 10.0f) {
             float highlightSize = 15.0f * (pupilRadius / 40.0f);
-            SkPaint highlightPaint;
-            highlightPaint.setColor(SK_ColorWHITE);
-            highlightPaint.setAntiAlias(true);
-
-            // Add some transparency for a nice effect
-            highlightPaint.setAlpha(200);
-            canvas->drawCircle(x - 15, y - 15, highlightSize, highlightPaint);
+            canvas.circle(robotface::Point2{x - 15, y - 15}, highlightSize, robotface::Rgba{255, 255, 255, 200});
         }
     }
 
-    void drawMouth(SkCanvas* canvas, float centerX, float centerY, float happiness) {
+    void drawMouth(robotface::Canvas& canvas, float centerX, float centerY, float happiness) {
         // Mouth positions
-        SkPoint start = SkPoint::Make(300, 400);
-        SkPoint end = SkPoint::Make(500, 400);
+        const robotface::Point2 start{300, 400};
+        const robotface::Point2 end{500, 400};
 
         // Control point Y varies with emotion
         float controlY = 400.0f + (happiness - 0.5f) * 60.0f;
-        SkPoint control = SkPoint::Make(400, controlY);
-
-        // Create quadratic bezier curve path
-        SkPath mouthPath;
-        mouthPath.moveTo(start);
-        mouthPath.quadTo(control, end);
-
-        // Draw mouth with high-quality stroke
-        SkPaint mouthPaint;
-        mouthPaint.setColor(SK_ColorBLACK);
-        mouthPaint.setAntiAlias(true);
-        mouthPaint.setStyle(SkPaint::kStroke_Style);
-        mouthPaint.setStrokeWidth(8);
-        mouthPaint.setStrokeCap(SkPaint::kRound_Cap);
-        mouthPaint.setStrokeJoin(SkPaint::kRound_Join);
-
-        canvas->drawPath(mouthPath, mouthPaint);
+        const robotface::Point2 control{400, controlY};
+
+        // Quadratic Bezier sampled at the quality level's segment count into a reused array
+        const int segments = std::max(1, std::min(m_quality.mouthSegments, kMaxMouthSegments));
+        for (int i = 0; i <= segments; i++) {
+            const float t = static_cast<float>(i) / static_cast<float>(segments);
+            const float u = 1.0f - t;
+            m_mouthPoints[i] = robotface::Point2{u * u * start.x + 2.0f * u * t * control.x + t * t * end.x,
+                                                 u * u * start.y + 2.0f * u * t * control.y + t * t * end.y};
+        }
+
+        // Round caps and joins (SkiaFaceCanvas::strokePath)
+        canvas.strokePath(m_mouthPoints, segments + 1, 8, kBlack);
     }
 
     float m_happiness;
@@ -217,13 +434,48 @@ private:
     int m_frameCount;
     std::chrono::steady_clock::time_point m_lastTime;
     float m_fps = 0.0f;
+
+    static constexpr robotface::Rgba kWhite{255, 255, 255, 255};
+    static constexpr robotface::Rgba kBlack{0, 0, 0, 255};
+
+    // Reused every frame
+    SkFont m_font;
+    robotface::Point2 m_mouthPoints[kMaxMouthSegments + 1];
+    robotface::DisplayList m_faceList;
+    SkiaFaceCanvas m_faceCanvas;
+    bool m_fontLoaded = false;
+
+    // Submission counters: this frame (face canvas, text, pacing graph) and the previous one
+    robotface::FrameStats m_stats;
+    robotface::FrameStats m_frameStats;
+    bool m_statsOverlay = false;
+
+    // SDF status text: atlas mapped from the pack or baked at loadFont, viewed by the font and the image
+    robotface::AssetPack m_assets;
+    std::vector<uint8_t> m_atlasBlob;
+    robotface::SdfFont m_sdfFont;
+    sk_sp<SkImage> m_atlasImage;
+    sk_sp<SkRuntimeEffect> m_sdfEffect;
+    SdfFilter m_sdfFilters[kSdfFilterSlots];
+    int m_nextSdfFilter = 0;
+    robotface::TextBatch m_textBatch;
+    std::vector<SkRSXform> m_xforms;
+    std::vector<SkRect> m_atlasRects;
+    bool m_useSdf = false;
+
+    robotface::QualitySettings m_quality = robotface::kQualityLevels[0];
+
+    // Pacing overlay, laid out into reused arrays
+    const robotface::PacingAnalyzer* m_pacing = nullptr;
+    bool m_pacingOverlay = false;
+    robotface::PacingGraph m_pacingGraph;
+    SkPoint m_pacingPoints[robotface::PacingAnalyzer::kHistory];
 };
 
 class RobotFaceApplication : public Application {
 public:
     RobotFaceApplication(int argc, char** argv, void* platformData)
         : Application(argc, argv, platformData) {
-        m_robotFace = std::make_unique<RobotFace>();
         m_lastFrameTime = std::chrono::steady_clock::now();
     }
 
@@ -236,7 +488,7 @@ public:
         m_lastFrameTime = currentTime;
 
         // Update robot face
-        m_robotFace->update(deltaTime);
+        m_robotFace.update(deltaTime);
 
         // Request redraw
         if (fWindow) {
@@ -246,68 +498,246 @@ public:
 
     void onPaint(SkSurface* surface) override {
         auto canvas = surface->getCanvas();
-        m_robotFace->draw(canvas, fWindow->width(), fWindow->height());
+        m_robotFace.draw(canvas, fWindow->width(), fWindow->height());
     }
 
     void onChar(SkUnichar c, skui::ModifierKey modifiers) override {
+        noteInput();
         switch (c) {
             case 'h':
             case 'H':
-                m_robotFace->setEmotion(1.0f); // Happy
+                m_robotFace.setEmotion(1.0f); // Happy
                 break;
             case 'n':
             case 'N':
-                m_robotFace->setEmotion(0.5f); // Neutral
+                m_robotFace.setEmotion(0.5f); // Neutral
                 break;
             case 's':
             case 'S':
-                m_robotFace->setEmotion(0.0f); // Sad
+                m_robotFace.setEmotion(0.0f); // Sad
+                break;
+            case 'p':
+            case 'P':
+                m_robotFace.togglePacingOverlay();
+                break;
+            case 'c':
+            case 'C':
+                m_robotFace.toggleStatsOverlay();
                 break;
         }
     }
 
     bool onMouse(int x, int y, skui::InputState state, skui::ModifierKey modifiers) override {
         if (state == skui::InputState::kDown) {
-            // Mouse hover effect (wider smile when hovering over mouth area)
-            if (x > 300 && x < 500 && y > 350 && y < 450) {
-                float currentHappiness = m_robotFace->getHappiness();
-                m_robotFace->setEmotion(std::min(currentHappiness + 0.1f, 1.0f));
+            noteInput();
+
+            // Mouse hover effect (wider smile when clicking on the mouth as drawn)
+            const robotface::Point2 point{static_cast<float>(x), static_cast<float>(y)};
+            if (robotface::hitTestFace(robotface::FaceGeometry{}, point, m_robotFace.getHappiness(), 0.0f,
+                                       kHoverSlop) == robotface::FaceRegion::Mouth) {
+                float currentHappiness = m_robotFace.getHappiness();
+                m_robotFace.setEmotion(std::min(currentHappiness + 0.1f, 1.0f));
             }
 
             // Trigger blink on click
-            m_robotFace->triggerBlink();
+            m_robotFace.triggerBlink();
         }
         return true;
     }
 
+    void loadFont(bool sdf, const char* assets) { m_robotFace.loadFont(sdf, assets); }
+    void setQuality(const robotface::QualitySettings& quality) { m_robotFace.setQuality(quality); }
+    void setPacing(const robotface::PacingAnalyzer* pacing) { m_robotFace.setPacing(pacing); }
+    const RobotFace& face() const { return m_robotFace; }
+
+    // Time from the first input event since the last present to `presentedAt` (-1: none)
+    float takeInputLatencyMs(std::chrono::steady_clock::time_point presentedAt) {
+        if (!m_inputPending) return -1.0f;
+        m_inputPending = false;
+        return std::chrono::duration<float, std::milli>(presentedAt - m_inputAt).count();
+    }
+
 private:
-    std::unique_ptr<RobotFace> m_robotFace;
+    static constexpr float kHoverSlop = 20.0f;  // Pointer tolerance around the mouth
+
+    void noteInput() {
+        if (m_inputPending) return;
+        m_inputPending = true;
+        m_inputAt = std::chrono::steady_clock::now();
+    }
+
+    RobotFace m_robotFace;  // Owned inline, no heap
     std::chrono::steady_clock::time_point m_lastFrameTime;
+    std::chrono::steady_clock::time_point m_inputAt;
+    bool m_inputPending = false;
 };
 
+// SkFont vs SDF status text on a raster surface (no window): glyphs per millisecond of
+// drawing, pages of overlay lines at a few sizes
+static int runTextBench() {
+    constexpr float kSizes[] = {10.0f, 20.0f, 40.0f, 80.0f};
+    constexpr const char* kLine = "Emotion: Happy (0.80)  FPS: 60  Draws 12  Verts 512";
+    constexpr int kWarmupFrames = 10;
+    constexpr int kFrames = 200;
+    using Clock = std::chrono::steady_clock;
+
+    sk_sp<SkSurface> surface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(800, 600));
+    if (!surface) return 1;
+    SkCanvas* canvas = surface->getCanvas();
+
+    RobotFace face;
+    auto start = Clock::now();
+    face.loadFont(true);
+    const double bakeMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    if (!face.usesSdf()) {
+        std::fprintf(stderr, "SDF text not available (atlas image or color filter)\n");
+        return 1;
+    }
+    start = Clock::now();
+    face.loadFont(false);   // Typeface too; the atlas stays
+    const double typefaceMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    std::printf("SDF atlas bake %.2f ms, font manager + typeface %.2f ms\n", bakeMs, typefaceMs);
+
+    std::printf("%5s %7s | %10s %10s | %10s %10s\n", "size", "glyphs", "SkFont", "glyphs/ms", "SDF", "glyphs/ms");
+    for (const float size : kSizes) {
+        const int lines = static_cast<int>(600.0f / size);
+        const double glyphs = static_cast<double>(robotface::countGlyphs(kLine)) * lines;
+        double frameMs[2] = {};
+        for (int sdf = 0; sdf < 2; sdf++) {
+            face.setUseSdf(sdf == 1);
+            for (int frame = 0; frame < kWarmupFrames + kFrames; frame++) {
+                if (frame == kWarmupFrames) start = Clock::now();
+                canvas->clear(SK_ColorWHITE);
+                for (int line = 0; line < lines; line++) {
+                    face.drawText(canvas, kLine, 4, static_cast<float>(line) * size + size * 0.8f, size, SK_ColorDKGRAY);
+                }
+                face.flushText(canvas);
+            }
+            frameMs[sdf] = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / kFrames;
+        }
+        std::printf("%5.0f %7.0f | %7.3f ms %10.0f | %7.3f ms %10.0f\n", static_cast<double>(size), glyphs, frameMs[0],
+                    glyphs / frameMs[0], frameMs[1], glyphs / frameMs[1]);
+    }
+    return 0;
+}
+
 // Main entry point
 Application* Application::Create(int argc, char** argv, void* platformData) {
     return new RobotFaceApplication(argc, argv, platformData);
 }
 
 int main(int argc, char** argv) {
+    bool skFont = false;
+    const char* metricsAddress = nullptr;
+    const char* assetsPath = nullptr;
+    bool pacingReport = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--text-bench") == 0) return runTextBench();
+        if (std::strcmp(argv[i], "--skfont") == 0) skFont = true;
+        if (std::strcmp(argv[i], "--pacing") == 0) pacingReport = true;
+        if (std::strcmp(argv[i], "--metrics") == 0 && i + 1 < argc) metricsAddress = argv[++i];
+        else if (std::strcmp(argv[i], "--assets") == 0 && i + 1 < argc) assetsPath = argv[++i];
+    }
+
+    RobotFaceStartup startup;
+    RobotFaceStartupBegin(&startup, argc, argv);
+
     Application* app = Application::Create(argc, argv, nullptr);
 
     if (app) {
+        RobotFaceStartupMark(&startup, "face-init");
+
         // Create window
         app->fWindow = Window::CreateNativeWindow(nullptr);
         app->fWindow->attach(Window::kRaster_BackendType);
         app->fWindow->resize(800, 600);
         app->fWindow->setTitle("Robot Face - Skia");
         app->fWindow->show();
+        RobotFaceStartupMark(&startup, "window");
+
+        // Quality governor: fed the time of each update and paint once the font is loaded
+        robotface::QualityGovernor governor;
+        unsigned long long framesDrawn = 0;
+
+        // Prometheus endpoint: the loop publishes each frame, the exporter's thread serves scrapes
+        robotface::MetricsRegistry metrics("skia");
+        robotface::MetricsExporter exporter;
+        if (metricsAddress && !exporter.start(metrics, metricsAddress)) {
+            std::fprintf(stderr, "METRICS: cannot listen on %s\n", metricsAddress);
+        }
+        auto lastPresent = std::chrono::steady_clock::now();
+
+        // Frame pacing once the font is loaded. The loop is uncapped: every interval is held
+        // against the display's refresh period, so presents faster than it count as doubled.
+        robotface::PacingAnalyzer pacing;
+        static_cast<RobotFaceApplication*>(app)->setPacing(&pacing);
 
         // Run application
+#ifdef ROBOT_FACE_ALLOC_CHECK
+        const int warmupFrames = 120;
+        int frame = 0;
+        uint64_t steadyAllocations = 0;
+#endif
         while (!app->fWindow->shouldQuit()) {
+#ifdef ROBOT_FACE_ALLOC_CHECK
+            const uint64_t before = robotface::alloc::allocationCount();
+#endif
+            const auto frameStart = std::chrono::steady_clock::now();
             app->onIdle();
             app->fWindow->onPaint();
+            const auto presentedAt = std::chrono::steady_clock::now();
+            const float frameMs = std::chrono::duration<float, std::milli>(presentedAt - frameStart).count();
+            if (++framesDrawn > 2 && governor.addFrame(frameMs)) {
+                std::printf("QUALITY: %s -> %s at frame %llu (%.2f ms, budget %.2f ms)\n",
+                            robotface::kQualityLevelNames[governor.previousLevel()], governor.levelName(), framesDrawn,
+                            static_cast<double>(frameMs), static_cast<double>(governor.config().budgetMs));
+                static_cast<RobotFaceApplication*>(app)->setQuality(governor.settings());
+            }
+            if (startup.count == 2) {
+                RobotFaceStartupMark(&startup, "first-draw");   // Paint and present
+                RobotFaceStartupFirstFrame(&startup);
+                static_cast<RobotFaceApplication*>(app)->loadFont(!skFont, assetsPath);
+                RobotFaceStartupMark(&startup, skFont ? "fontmgr" : "sdf-atlas");
+                RobotFaceStartupReport(&startup);
+                if (startup.enabled) break;
+            }
+            if (framesDrawn > 2) {
+                pacing.addPresent(std::chrono::duration<double>(presentedAt.time_since_epoch()).count());
+            }
+#ifdef ROBOT_FACE_ALLOC_CHECK
+            const uint64_t allocations = robotface::alloc::allocationCount() - before;
+            if (++frame > warmupFrames && allocations > 0) {
+                steadyAllocations += allocations;
+                std::fprintf(stderr, "frame %d allocated %llu times\n", frame, static_cast<unsigned long long>(allocations));
+            }
+#endif
+
+            if (exporter.running()) {
+                auto* faceApp = static_cast<RobotFaceApplication*>(app);
+                robotface::FrameSample sample;
+                sample.intervalMs = std::chrono::duration<float, std::milli>(presentedAt - lastPresent).count();
+                sample.busyMs = frameMs;   // No frame limiter in this loop: no drops counted
+                sample.inputLatencyMs = faceApp->takeInputLatencyMs(presentedAt);
+                sample.happiness = faceApp->face().getHappiness();
+                sample.emotion = faceApp->face().getEmotionLabel();
+                sample.blinking = faceApp->face().isBlinking();
+                sample.qualityLevel = governor.level();
+#ifdef ROBOT_FACE_ALLOC_CHECK
+                sample.allocations = static_cast<int64_t>(allocations);
+#endif
+                metrics.publish(sample);
+            }
+            lastPresent = presentedAt;
         }
 
         delete app;
+        if (pacingReport) pacing.report(stdout, "robot_face_skia");
+
+#ifdef ROBOT_FACE_ALLOC_CHECK
+        std::printf("Skia: %d frames, %llu steady-state allocations, peak RSS %zu KiB\n", frame,
+                    static_cast<unsigned long long>(steadyAllocations), robotface::alloc::peakRssKb());
+        if (steadyAllocations > 0) return 1;
+#endif
     }
 
     return 0;
@@ -0,0 +1,90 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Skia Canvas Backend Implementation
+ *
+ *******************************************************************************************/
+
+#include "robot_face_skia_canvas.h"
+#include "include/core/SkPaint.h"
+
+namespace {
+
+SkColor toSkColor(robotface::Rgba color) {
+    return SkColorSetARGB(color.a, color.r, color.g, color.b);
+}
+
+SkPaint makePaint(robotface::Rgba color, SkPaint::Style style, bool antiAlias) {
+    SkPaint paint;
+    paint.setColor(toSkColor(color));
+    paint.setAntiAlias(antiAlias);
+    paint.setStyle(style);
+    return paint;
+}
+
+} // namespace
+
+void SkiaFaceCanvas::clear(robotface::Rgba color) {
+    m_canvas->clear(toSkColor(color));
+    if (m_stats) m_stats->drawCalls++;
+}
+
+void SkiaFaceCanvas::circle(robotface::Point2 center, float radius, robotface::Rgba color) {
+    m_canvas->drawCircle(center.x, center.y, radius, makePaint(color, SkPaint::kFill_Style, m_antiAlias));
+    countDraw(color, SkPaint::kFill_Style, 0.0f, 0);
+}
+
+void SkiaFaceCanvas::ring(robotface::Point2 center, float radius, float thickness, robotface::Rgba color) {
+    SkPaint paint = makePaint(color, SkPaint::kStroke_Style, m_antiAlias);
+    paint.setStrokeWidth(thickness);
+    m_canvas->drawCircle(center.x, center.y, radius, paint);
+    countDraw(color, SkPaint::kStroke_Style, thickness, 0);
+}
+
+void SkiaFaceCanvas::strokePath(const robotface::Point2* points, int count, float width, robotface::Rgba color) {
+    if (count < 2) return;
+
+    m_path.rewind();
+    m_path.moveTo(points[0].x, points[0].y);
+    for (int i = 1; i < count; i++) {
+        m_path.lineTo(points[i].x, points[i].y);
+    }
+
+    SkPaint paint = makePaint(color, SkPaint::kStroke_Style, m_antiAlias);
+    paint.setStrokeWidth(width);
+    paint.setStrokeCap(SkPaint::kRound_Cap);
+    paint.setStrokeJoin(SkPaint::kRound_Join);
+    m_canvas->drawPath(m_path, paint);
+    countDraw(color, SkPaint::kStroke_Style, width, static_cast<uint32_t>(m_path.countPoints()));
+}
+
+// Canvas text is positioned by its top-left corner; Skia draws from the baseline
+void SkiaFaceCanvas::text(const char* text, robotface::Point2 topLeft, float size, robotface::Rgba color) {
+    if (!m_hasTypeface) {
+        if (!m_fontMgr) return;
+        m_font.setTypeface(m_fontMgr->legacyMakeTypeface(nullptr, SkFontStyle()));
+        m_hasTypeface = true;
+    }
+
+    m_font.setSize(size);
+    m_canvas->drawString(text, topLeft.x, topLeft.y + size, m_font,
+                         makePaint(color, SkPaint::kFill_Style, m_antiAlias));
+    if (!m_stats) return;
+
+    countDraw(color, -1, size, 0);
+    m_stats->glyphs += robotface::countGlyphs(text);
+}
+
+void SkiaFaceCanvas::countDraw(robotface::Rgba color, int style, float width, uint32_t vertices) {
+    if (!m_stats) return;
+
+    m_stats->drawCalls++;
+    m_stats->vertices += vertices;
+
+    const PaintKey paint{color, style, width};
+    if (!m_hasPaint || !(paint.color == m_lastPaint.color) || paint.style != m_lastPaint.style ||
+        paint.width != m_lastPaint.width) {
+        m_stats->stateChanges++;
+        m_lastPaint = paint;
+        m_hasPaint = true;
+    }
+}
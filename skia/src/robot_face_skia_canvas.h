@@ -0,0 +1,76 @@
+/*******************************************************************************************
+ *
+ *   Robot Face - Skia Canvas Backend
+ *
+ *   Executes robotface::Canvas draw calls on an SkCanvas (used to replay
+ *   display lists recorded by any implementation)
+ *
+ *   Stats: circles are analytic (no vertices), paths submit their points, and a state
+ *   change is a paint (color, style, stroke width, font size) differing from the
+ *   previous draw, which is what breaks Skia's op batching. Flushes happen on the
+ *   surface, outside the canvas.
+ *
+ *   Text: the typeface is made from the font manager given with setFontManager() on the
+ *   first text call, so canvases that only draw shapes never scan the system fonts.
+ *
+ *******************************************************************************************/
+
+#ifndef ROBOT_FACE_SKIA_CANVAS_H
+#define ROBOT_FACE_SKIA_CANVAS_H
+
+#include "include/core/SkCanvas.h"
+#include "include/core/SkFont.h"
+#include "include/core/SkFontMgr.h"
+#include "include/core/SkPath.h"
+#include "robot_face_canvas.hpp"
+#include "robot_face_frame_stats.hpp"
+
+#include <utility>
+
+class SkiaFaceCanvas final : public robotface::Canvas {
+public:
+    explicit SkiaFaceCanvas(SkCanvas* canvas) : m_canvas(canvas) {}
+
+    // Surface canvases can change between frames (window resize, backend switch)
+    void setCanvas(SkCanvas* canvas) noexcept { m_canvas = canvas; }
+
+    void clear(robotface::Rgba color) override;
+    void circle(robotface::Point2 center, float radius, robotface::Rgba color) override;
+    void ring(robotface::Point2 center, float radius, float thickness, robotface::Rgba color) override;
+    void strokePath(const robotface::Point2* points, int count, float width, robotface::Rgba color) override;
+    void text(const char* text, robotface::Point2 topLeft, float size, robotface::Rgba color) override;
+
+    // Submission counters (nullptr: not counted)
+    void setStats(robotface::FrameStats* stats) noexcept {
+        m_stats = stats;
+        m_hasPaint = false;   // The first draw of a frame sets up its paint
+    }
+
+    // Source of the text typeface (nullptr: text is skipped)
+    void setFontManager(sk_sp<SkFontMgr> fontMgr) noexcept { m_fontMgr = std::move(fontMgr); }
+
+    // Anti-aliased paints (QualitySettings::antiAlias)
+    void setAntiAlias(bool antiAlias) noexcept { m_antiAlias = antiAlias; }
+
+private:
+    // Paint of the previous draw, for state change counting
+    struct PaintKey {
+        robotface::Rgba color;
+        int style;       // SkPaint::Style, or -1 for text
+        float width;     // Stroke width or font size
+    };
+
+    void countDraw(robotface::Rgba color, int style, float width, uint32_t vertices);
+
+    SkCanvas* m_canvas;
+    SkPath m_path;   // Reused between strokePath calls
+    SkFont m_font;
+    sk_sp<SkFontMgr> m_fontMgr;
+    bool m_hasTypeface = false;
+    robotface::FrameStats* m_stats = nullptr;
+    PaintKey m_lastPaint{};
+    bool m_hasPaint = false;
+    bool m_antiAlias = true;
+};
+
+#endif // ROBOT_FACE_SKIA_CANVAS_H